@@ -0,0 +1,101 @@
+export module cmoon.benchmarking.benchmark_environment;
+
+import <string>;
+import <string_view>;
+import <array>;
+import <cstddef>;
+import <cstdlib>;
+import <fstream>;
+import <chrono>;
+import <format>;
+import <thread>;
+
+import cmoon.platform;
+
+namespace cmoon::benchmarking
+{
+	constexpr std::array<std::string_view, 9> compiler_names {
+		"clang", "como", "compaq", "gcc", "intel", "msvc", "mingw32", "mingw64", "unknown"
+	};
+
+	constexpr std::array<std::string_view, 21> operating_system_names {
+		"aix", "android", "amigaos", "beos", "bluegene", "freebsd", "netbsd", "openbsd", "convexos", "cygwin", "dragonfly",
+		"gnu", "linux", "mac", "minix", "msdos", "win16", "win32", "win64", "wince", "unknown"
+	};
+
+	constexpr std::array<std::string_view, 9> architecture_names {
+		"alpha", "amd64", "amd32", "arm", "arm_thumb", "i386", "mips", "powerpc", "unknown"
+	};
+
+	[[nodiscard]] std::string compiler_version()
+	{
+		#if defined(__clang__)
+		return __clang_version__;
+		#elif defined(__GNUC__)
+		return __VERSION__;
+		#elif defined(_MSC_FULL_VER)
+		return std::to_string(_MSC_FULL_VER);
+		#else
+		return {};
+		#endif
+	}
+
+	[[nodiscard]] std::string detect_cpu_model()
+	{
+		if (std::ifstream cpuinfo {"/proc/cpuinfo"})
+		{
+			std::string line;
+			while (std::getline(cpuinfo, line))
+			{
+				if (line.starts_with("model name") || line.starts_with("Hardware"))
+				{
+					if (const auto colon {line.find(':')}; colon != std::string::npos)
+					{
+						const auto start {line.find_first_not_of(" \t", colon + 1)};
+						return start == std::string::npos ? std::string{} : line.substr(start);
+					}
+				}
+			}
+		}
+
+		if (const auto identifier {std::getenv("PROCESSOR_IDENTIFIER")})
+		{
+			return identifier;
+		}
+
+		return "unknown";
+	}
+
+	// Where and how a set of benchmark results was produced, so that results
+	// from different machines or builds are not mistaken for one another.
+	export
+	struct benchmark_environment
+	{
+		std::string cpu_model;
+		std::string compiler;
+		std::string compiler_version;
+		std::string operating_system;
+		std::string architecture;
+		std::size_t hardware_threads {0};
+		bool debug {false};
+
+		// UTC, in ISO 8601.
+		std::string timestamp;
+
+		[[nodiscard]] static benchmark_environment detect()
+		{
+			return {
+				.cpu_model = detect_cpu_model(),
+				.compiler = std::string{compiler_names[static_cast<std::size_t>(cmoon::compiler)]},
+				.compiler_version = benchmarking::compiler_version(),
+				.operating_system = std::string{operating_system_names[static_cast<std::size_t>(cmoon::operating_system)]},
+				.architecture = std::string{architecture_names[static_cast<std::size_t>(cmoon::architecture)]},
+				.hardware_threads = std::thread::hardware_concurrency(),
+				.debug = cmoon::debugging,
+				.timestamp = std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()))
+			};
+		}
+
+		[[nodiscard]] friend bool operator==(const benchmark_environment&, const benchmark_environment&) = default;
+	};
+}
\ No newline at end of file
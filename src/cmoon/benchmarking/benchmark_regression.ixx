@@ -0,0 +1,424 @@
+export module cmoon.benchmarking.benchmark_regression;
+
+import <iostream>;
+import <fstream>;
+import <string>;
+import <string_view>;
+import <vector>;
+import <span>;
+import <chrono>;
+import <cmath>;
+import <limits>;
+import <cstddef>;
+import <charconv>;
+import <stdexcept>;
+import <algorithm>;
+import <ranges>;
+import <format>;
+import <utility>;
+
+import cmoon.benchmarking.benchmark_environment;
+import cmoon.benchmarking.benchmark_report;
+import cmoon.benchmarking.json_report;
+
+namespace cmoon::benchmarking
+{
+	// Lentz's method for the continued fraction of the incomplete beta
+	// function, as in Numerical Recipes.
+	[[nodiscard]] double incomplete_beta_fraction(double a, double b, double x) noexcept
+	{
+		constexpr int max_iterations {300};
+		constexpr double epsilon {1e-14};
+		constexpr double tiny {1e-300};
+
+		const auto qab {a + b};
+		const auto qap {a + 1};
+		const auto qam {a - 1};
+		auto c {1.0};
+		auto d {1 - qab * x / qap};
+		if (std::abs(d) < tiny)
+		{
+			d = tiny;
+		}
+		d = 1 / d;
+		auto h {d};
+
+		for (int m {1}; m <= max_iterations; ++m)
+		{
+			const auto m2 {2 * m};
+			auto aa {m * (b - m) * x / ((qam + m2) * (a + m2))};
+			d = 1 + aa * d;
+			if (std::abs(d) < tiny)
+			{
+				d = tiny;
+			}
+			c = 1 + aa / c;
+			if (std::abs(c) < tiny)
+			{
+				c = tiny;
+			}
+			d = 1 / d;
+			h *= d * c;
+
+			aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+			d = 1 + aa * d;
+			if (std::abs(d) < tiny)
+			{
+				d = tiny;
+			}
+			c = 1 + aa / c;
+			if (std::abs(c) < tiny)
+			{
+				c = tiny;
+			}
+			d = 1 / d;
+			const auto delta {d * c};
+			h *= delta;
+			if (std::abs(delta - 1) < epsilon)
+			{
+				break;
+			}
+		}
+
+		return h;
+	}
+
+	[[nodiscard]] double regularized_incomplete_beta(double a, double b, double x) noexcept
+	{
+		if (x <= 0)
+		{
+			return 0;
+		}
+		else if (x >= 1)
+		{
+			return 1;
+		}
+
+		const auto front {std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log1p(-x))};
+		if (x < (a + 1) / (a + b + 2))
+		{
+			return front * incomplete_beta_fraction(a, b, x) / a;
+		}
+
+		return 1 - front * incomplete_beta_fraction(b, a, 1 - x) / b;
+	}
+
+	export
+	struct t_test_result
+	{
+		double t {0};
+		double degrees_of_freedom {0};
+
+		// Two-sided: the chance of a difference in means at least this large
+		// if both samples came from distributions with the same mean.
+		double p_value {1};
+	};
+
+	// Welch's t-test, which unlike Student's does not assume both samples
+	// have the same variance. Samples of fewer than two values cannot be
+	// tested and give a p-value of 1.
+	export
+	[[nodiscard]] t_test_result welch_t_test(std::span<const double> a, std::span<const double> b) noexcept
+	{
+		if (std::size(a) < 2 || std::size(b) < 2)
+		{
+			return {};
+		}
+
+		const auto mean_variance = [](std::span<const double> s) {
+			auto mean {0.0};
+			for (const auto x : s)
+			{
+				mean += x;
+			}
+			mean /= std::size(s);
+
+			auto variance {0.0};
+			for (const auto x : s)
+			{
+				variance += (x - mean) * (x - mean);
+			}
+			variance /= std::size(s) - 1;
+
+			return std::pair{mean, variance};
+		};
+
+		const auto [mean_a, variance_a] {mean_variance(a)};
+		const auto [mean_b, variance_b] {mean_variance(b)};
+		const auto se_a {variance_a / std::size(a)};
+		const auto se_b {variance_b / std::size(b)};
+		const auto se {se_a + se_b};
+
+		if (se == 0)
+		{
+			const auto df {static_cast<double>(std::size(a) + std::size(b) - 2)};
+			if (mean_a == mean_b)
+			{
+				return {0, df, 1};
+			}
+
+			return {std::copysign(std::numeric_limits<double>::infinity(), mean_b - mean_a), df, 0};
+		}
+
+		const auto t {(mean_b - mean_a) / std::sqrt(se)};
+		const auto df {se * se / (se_a * se_a / (std::size(a) - 1) + se_b * se_b / (std::size(b) - 1))};
+
+		return {t, df, regularized_incomplete_beta(df / 2, 0.5, df / (df + t * t))};
+	}
+
+	export
+	enum class benchmark_change
+	{
+		unchanged,
+		improved,
+		regressed,
+		added,
+		removed
+	};
+
+	export
+	struct regression_options
+	{
+		// The smallest relative change in mean iteration time that counts,
+		// so that 0.05 ignores anything within 5%.
+		double threshold {0.05};
+
+		// The p-value a change must be under to count.
+		double alpha {0.05};
+	};
+
+	export
+	struct benchmark_comparison
+	{
+		std::string name;
+		std::chrono::duration<double, std::nano> baseline {};
+		std::chrono::duration<double, std::nano> current {};
+
+		// (current - baseline) / baseline
+		double change {0};
+
+		t_test_result test {};
+		benchmark_change verdict {benchmark_change::unchanged};
+	};
+
+	[[nodiscard]] std::vector<double> run_means(const benchmark_record& record)
+	{
+		std::vector<double> means;
+		means.reserve(std::size(record.runs));
+		for (const auto& run : record.runs)
+		{
+			means.push_back(run.mean_iteration_time().count());
+		}
+
+		return means;
+	}
+
+	// Compares each benchmark's per-run mean iteration times between the two
+	// reports. A benchmark has regressed or improved only when the change is
+	// both larger than options.threshold and significant at options.alpha.
+	export
+	[[nodiscard]] std::vector<benchmark_comparison> compare_reports(const benchmark_report& baseline, const benchmark_report& current, const regression_options& options = {})
+	{
+		std::vector<benchmark_comparison> comparisons;
+
+		for (const auto& record : current)
+		{
+			auto& c {comparisons.emplace_back()};
+			c.name = record.name;
+			c.current = record.average_iteration_time();
+
+			const auto base {baseline.find(record.name)};
+			if (base == nullptr)
+			{
+				c.verdict = benchmark_change::added;
+				continue;
+			}
+
+			c.baseline = base->average_iteration_time();
+			c.change = c.baseline.count() != 0 ? (c.current - c.baseline) / c.baseline : 0;
+			c.test = welch_t_test(run_means(*base), run_means(record));
+
+			if (c.test.p_value < options.alpha && std::abs(c.change) > options.threshold)
+			{
+				c.verdict = c.change > 0 ? benchmark_change::regressed : benchmark_change::improved;
+			}
+		}
+
+		for (const auto& record : baseline)
+		{
+			if (current.find(record.name) == nullptr)
+			{
+				auto& c {comparisons.emplace_back()};
+				c.name = record.name;
+				c.baseline = record.average_iteration_time();
+				c.verdict = benchmark_change::removed;
+			}
+		}
+
+		return comparisons;
+	}
+
+	export
+	[[nodiscard]] bool has_regressions(std::span<const benchmark_comparison> comparisons) noexcept
+	{
+		return std::ranges::any_of(comparisons, [](const auto& c) { return c.verdict == benchmark_change::regressed; });
+	}
+
+	[[nodiscard]] constexpr std::string_view verdict_name(benchmark_change change) noexcept
+	{
+		switch (change)
+		{
+			case benchmark_change::improved:
+				return "improved";
+			case benchmark_change::regressed:
+				return "REGRESSED";
+			case benchmark_change::added:
+				return "added";
+			case benchmark_change::removed:
+				return "removed";
+			default:
+				return "unchanged";
+		}
+	}
+
+	[[nodiscard]] std::string describe(const benchmark_environment& env)
+	{
+		return std::format("{} ({} hardware thread{}), {} {} on {} {}{}, {}",
+						   env.cpu_model,
+						   env.hardware_threads,
+						   env.hardware_threads == 1 ? "" : "s",
+						   env.compiler,
+						   env.compiler_version,
+						   env.operating_system,
+						   env.architecture,
+						   env.debug ? " (debug)" : "",
+						   env.timestamp);
+	}
+
+	export
+	void write_comparison(std::ostream& os, const benchmark_report& baseline, const benchmark_report& current, std::span<const benchmark_comparison> comparisons)
+	{
+		os << "Baseline: " << describe(baseline.environment()) << '\n'
+		   << "Current:  " << describe(current.environment()) << '\n';
+
+		const auto& b {baseline.environment()};
+		const auto& c {current.environment()};
+		if (b.cpu_model != c.cpu_model || b.compiler != c.compiler || b.compiler_version != c.compiler_version || b.debug != c.debug)
+		{
+			os << "Warning: the results come from different environments\n";
+		}
+		os << '\n';
+
+		if (std::ranges::empty(comparisons))
+		{
+			os << "No benchmark results\n";
+			return;
+		}
+
+		const auto name_width {std::max(std::size_t{9}, std::ranges::max(comparisons | std::views::transform([](const auto& c) { return std::size(c.name); })))};
+		os << std::format("{: <{}}  {: >14}  {: >14}  {: >8}  {: >8}  {}\n", "Benchmark", name_width, "Baseline (ns)", "Current (ns)", "Change", "p", "Verdict");
+		for (const auto& comparison : comparisons)
+		{
+			switch (comparison.verdict)
+			{
+				case benchmark_change::added:
+					os << std::format("{: <{}}  {: >14}  {: >14.2f}  {: >8}  {: >8}  {}\n", comparison.name, name_width, "-", comparison.current.count(), "", "", verdict_name(comparison.verdict));
+					break;
+				case benchmark_change::removed:
+					os << std::format("{: <{}}  {: >14.2f}  {: >14}  {: >8}  {: >8}  {}\n", comparison.name, name_width, comparison.baseline.count(), "-", "", "", verdict_name(comparison.verdict));
+					break;
+				default:
+					os << std::format("{: <{}}  {: >14.2f}  {: >14.2f}  {: >+7.1f}%  {: >8.4f}  {}\n",
+									  comparison.name,
+									  name_width,
+									  comparison.baseline.count(),
+									  comparison.current.count(),
+									  comparison.change * 100,
+									  comparison.test.p_value,
+									  verdict_name(comparison.verdict));
+					break;
+			}
+		}
+	}
+
+	[[nodiscard]] double parse_fraction(std::string_view flag, std::string_view value)
+	{
+		double d;
+		const auto [end, ec] {std::from_chars(value.data(), value.data() + value.size(), d)};
+		if (ec != std::errc{} || end != value.data() + value.size() || d < 0)
+		{
+			throw std::invalid_argument{std::string{flag} + " expects a non-negative number, got '" + std::string{value} + "'"};
+		}
+
+		return d;
+	}
+
+	[[nodiscard]] benchmark_report load_report(const std::string& path)
+	{
+		std::ifstream file {path};
+		if (!file)
+		{
+			throw std::runtime_error{"cannot open " + path};
+		}
+
+		try
+		{
+			return read_json_report(file);
+		}
+		catch (const std::exception& e)
+		{
+			throw std::runtime_error{path + ": " + e.what()};
+		}
+	}
+
+	// The body of a comparison program: given
+	//
+	//     baseline.json current.json [--threshold 0.05] [--alpha 0.05]
+	//
+	// it loads two reports written by write_json_report, writes the
+	// comparison to os and returns 0, or 1 if any benchmark regressed, or 2
+	// if the arguments or files are bad.
+	export
+	[[nodiscard]] int run_benchmark_comparison(int argc, const char* const argv[], std::ostream& os)
+	{
+		try
+		{
+			regression_options options;
+			std::vector<std::string> paths;
+			for (int i {1}; i < argc; ++i)
+			{
+				const std::string_view arg {argv[i]};
+				if (arg == "--threshold" || arg == "--alpha")
+				{
+					if (i + 1 == argc)
+					{
+						throw std::invalid_argument{std::string{arg} + " expects a value"};
+					}
+
+					(arg == "--threshold" ? options.threshold : options.alpha) = parse_fraction(arg, argv[++i]);
+				}
+				else
+				{
+					paths.emplace_back(arg);
+				}
+			}
+
+			if (std::size(paths) != 2)
+			{
+				throw std::invalid_argument{"usage: baseline.json current.json [--threshold 0.05] [--alpha 0.05]"};
+			}
+
+			const auto baseline {load_report(paths[0])};
+			const auto current {load_report(paths[1])};
+			const auto comparisons {compare_reports(baseline, current, options)};
+			write_comparison(os, baseline, current, comparisons);
+
+			return has_regressions(comparisons) ? 1 : 0;
+		}
+		catch (const std::exception& e)
+		{
+			os << e.what() << '\n';
+			return 2;
+		}
+	}
+}
\ No newline at end of file
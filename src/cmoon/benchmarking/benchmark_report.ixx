@@ -0,0 +1,199 @@
+export module cmoon.benchmarking.benchmark_report;
+
+import <string>;
+import <string_view>;
+import <vector>;
+import <chrono>;
+import <cstddef>;
+import <utility>;
+import <numeric>;
+import <algorithm>;
+import <ranges>;
+import <functional>;
+import <memory>;
+
+import cmoon.benchmarking.run_result;
+import cmoon.benchmarking.benchmark_result;
+import cmoon.benchmarking.benchmark;
+import cmoon.benchmarking.benchmark_suite;
+import cmoon.benchmarking.benchmark_environment;
+
+namespace cmoon::benchmarking
+{
+	// The statistics of one run_result, without its iterations.
+	export
+	struct run_record
+	{
+		std::size_t iterations {0};
+		std::chrono::nanoseconds total_time {std::chrono::nanoseconds::zero()};
+		std::chrono::nanoseconds average {std::chrono::nanoseconds::zero()};
+		std::chrono::nanoseconds fastest {std::chrono::nanoseconds::zero()};
+		std::chrono::nanoseconds slowest {std::chrono::nanoseconds::zero()};
+
+		run_record() noexcept = default;
+
+		explicit run_record(const run_result& run) noexcept
+			: iterations{std::ranges::size(run)}, total_time{run.total_time()}, average{run.average()}, fastest{run.fastest()}, slowest{run.slowest()} {}
+
+		// Unlike average, not rounded down to a whole nanosecond.
+		[[nodiscard]] std::chrono::duration<double, std::nano> mean_iteration_time() const noexcept
+		{
+			if (iterations == 0)
+			{
+				return std::chrono::duration<double, std::nano>::zero();
+			}
+
+			return std::chrono::duration<double, std::nano>{total_time} / static_cast<double>(iterations);
+		}
+
+		[[nodiscard]] friend bool operator==(const run_record&, const run_record&) noexcept = default;
+	};
+
+	export
+	struct benchmark_record
+	{
+		std::string name;
+		std::size_t iterations_per_run {0};
+		std::vector<run_record> runs;
+
+		benchmark_record() = default;
+
+		benchmark_record(std::string name, std::size_t iterations_per_run, const benchmark_result& result)
+			: name{std::move(name)}, iterations_per_run{iterations_per_run}
+		{
+			runs.reserve(std::ranges::size(result));
+			for (const auto& run : result)
+			{
+				runs.emplace_back(run);
+			}
+		}
+
+		[[nodiscard]] std::size_t total_iterations() const noexcept
+		{
+			return std::transform_reduce(std::begin(runs), std::end(runs), std::size_t{0}, std::plus{}, [](const auto& run) {
+				return run.iterations;
+			});
+		}
+
+		[[nodiscard]] std::chrono::nanoseconds total_run_time() const noexcept
+		{
+			return std::transform_reduce(std::begin(runs), std::end(runs), std::chrono::nanoseconds::zero(), std::plus{}, [](const auto& run) {
+				return run.total_time;
+			});
+		}
+
+		[[nodiscard]] std::chrono::duration<double, std::nano> average_iteration_time() const noexcept
+		{
+			const auto iterations {total_iterations()};
+			if (iterations == 0)
+			{
+				return std::chrono::duration<double, std::nano>::zero();
+			}
+
+			return std::chrono::duration<double, std::nano>{total_run_time()} / static_cast<double>(iterations);
+		}
+
+		[[nodiscard]] std::chrono::nanoseconds fastest_iteration() const noexcept
+		{
+			if (runs.empty())
+			{
+				return std::chrono::nanoseconds::zero();
+			}
+
+			return std::ranges::min(runs | std::views::transform(&run_record::fastest));
+		}
+
+		[[nodiscard]] std::chrono::nanoseconds slowest_iteration() const noexcept
+		{
+			if (runs.empty())
+			{
+				return std::chrono::nanoseconds::zero();
+			}
+
+			return std::ranges::max(runs | std::views::transform(&run_record::slowest));
+		}
+
+		[[nodiscard]] friend bool operator==(const benchmark_record&, const benchmark_record&) = default;
+	};
+
+	// The results of running benchmarks, with the environment they ran in,
+	// in a form that can be written out and read back to compare against
+	// later.
+	export
+	class benchmark_report
+	{
+		public:
+			benchmark_report()
+				: environment_{benchmark_environment::detect()} {}
+
+			explicit benchmark_report(benchmark_environment environment) noexcept
+				: environment_{std::move(environment)} {}
+
+			[[nodiscard]] const benchmark_environment& environment() const noexcept
+			{
+				return environment_;
+			}
+
+			void add(benchmark_record record)
+			{
+				records_.push_back(std::move(record));
+			}
+
+			void add(const benchmark& bench, const benchmark_result& result)
+			{
+				records_.emplace_back(bench.name(), bench.iterations_per_run(), result);
+			}
+
+			void run(benchmark& bench)
+			{
+				add(bench, run_benchmark(bench));
+			}
+
+			void run(benchmark&& bench)
+			{
+				run(bench);
+			}
+
+			void run(benchmark_suite& suite)
+			{
+				for (auto bench : suite)
+				{
+					run(*bench);
+				}
+			}
+
+			void run(benchmark_suite&& suite)
+			{
+				run(suite);
+			}
+
+			[[nodiscard]] const benchmark_record* find(std::string_view name) const noexcept
+			{
+				const auto it {std::ranges::find(records_, name, &benchmark_record::name)};
+				return it != std::ranges::end(records_) ? std::addressof(*it) : nullptr;
+			}
+
+			[[nodiscard]] auto begin() const noexcept
+			{
+				return std::ranges::begin(records_);
+			}
+
+			[[nodiscard]] auto end() const noexcept
+			{
+				return std::ranges::end(records_);
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return std::ranges::size(records_);
+			}
+
+			[[nodiscard]] bool empty() const noexcept
+			{
+				return std::ranges::empty(records_);
+			}
+		private:
+			benchmark_environment environment_;
+			std::vector<benchmark_record> records_;
+	};
+}
\ No newline at end of file
@@ -7,4 +7,9 @@ export import cmoon.benchmarking.benchmark_function;
 export import cmoon.benchmarking.noop_benchmark;
 export import cmoon.benchmarking.benchmark_suite;
 export import cmoon.benchmarking.text_benchmark_runner;
-export import cmoon.benchmarking.benchmark_compare;
\ No newline at end of file
+export import cmoon.benchmarking.benchmark_compare;
+export import cmoon.benchmarking.benchmark_environment;
+export import cmoon.benchmarking.benchmark_report;
+export import cmoon.benchmarking.json_report;
+export import cmoon.benchmarking.csv_report;
+export import cmoon.benchmarking.benchmark_regression;
\ No newline at end of file
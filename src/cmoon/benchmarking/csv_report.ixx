@@ -0,0 +1,54 @@
+export module cmoon.benchmarking.csv_report;
+
+import <iostream>;
+import <string>;
+import <cstddef>;
+import <utility>;
+
+import cmoon.csv;
+
+import cmoon.benchmarking.benchmark_report;
+
+namespace cmoon::benchmarking
+{
+	// Writes report with one row per run, for spreadsheets and plotting.
+	// The environment comes first as '#' comment lines, which most CSV
+	// readers can be told to skip.
+	export
+	void write_csv_report(std::ostream& os, const benchmark_report& report, cmoon::csv::dialect dialect = {})
+	{
+		const auto& env {report.environment()};
+		const std::pair<const char*, const std::string&> environment[] {
+			{"cpu_model", env.cpu_model},
+			{"compiler", env.compiler},
+			{"compiler_version", env.compiler_version},
+			{"operating_system", env.operating_system},
+			{"architecture", env.architecture},
+			{"timestamp", env.timestamp}
+		};
+
+		for (const auto& [key, value] : environment)
+		{
+			os << "# " << key << ": " << value << '\n';
+		}
+		os << "# hardware_threads: " << env.hardware_threads << '\n'
+		   << "# debug: " << (env.debug ? "true" : "false") << '\n';
+
+		cmoon::csv::csv_writer writer {os, std::move(dialect)};
+		writer.write_row("benchmark", "run", "iterations", "total_ns", "average_ns", "fastest_ns", "slowest_ns");
+		for (const auto& record : report)
+		{
+			for (std::size_t i {0}; i < std::size(record.runs); ++i)
+			{
+				const auto& run {record.runs[i]};
+				writer.write_row(record.name,
+								 i,
+								 run.iterations,
+								 run.total_time.count(),
+								 run.average.count(),
+								 run.fastest.count(),
+								 run.slowest.count());
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+export module cmoon.benchmarking.json_report;
+
+import <iostream>;
+import <string>;
+import <chrono>;
+import <cstddef>;
+import <cstdint>;
+import <utility>;
+import <variant>;
+import <stdexcept>;
+
+import cmoon.json;
+
+import cmoon.benchmarking.benchmark_environment;
+import cmoon.benchmarking.benchmark_report;
+
+namespace cmoon::benchmarking
+{
+	using json_t = cmoon::json::json_value<>;
+
+	inline constexpr std::intmax_t json_report_version {1};
+
+	[[nodiscard]] json_t to_json(std::size_t n)
+	{
+		return json_t{static_cast<std::intmax_t>(n)};
+	}
+
+	[[nodiscard]] json_t to_json(std::chrono::nanoseconds ns)
+	{
+		return json_t{static_cast<std::intmax_t>(ns.count())};
+	}
+
+	[[nodiscard]] std::size_t size_from_json(const json_t& json)
+	{
+		return static_cast<std::size_t>(json.as_integer());
+	}
+
+	[[nodiscard]] std::chrono::nanoseconds nanoseconds_from_json(const json_t& json)
+	{
+		return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(json.as_integer())};
+	}
+
+	// Writes report as one JSON object. Times are whole nanoseconds, and
+	// every run of every benchmark is kept, so that read_json_report gives
+	// back the same report.
+	export
+	void write_json_report(std::ostream& os, const benchmark_report& report)
+	{
+		const auto& env {report.environment()};
+		json_t environment {json_t::object_type{}};
+		environment["cpu_model"] = env.cpu_model;
+		environment["compiler"] = env.compiler;
+		environment["compiler_version"] = env.compiler_version;
+		environment["operating_system"] = env.operating_system;
+		environment["architecture"] = env.architecture;
+		environment["hardware_threads"] = to_json(env.hardware_threads);
+		environment["debug"] = env.debug;
+		environment["timestamp"] = env.timestamp;
+
+		json_t::list_type benchmarks;
+		for (const auto& record : report)
+		{
+			json_t::list_type runs;
+			for (const auto& run : record.runs)
+			{
+				json_t r {json_t::object_type{}};
+				r["iterations"] = to_json(run.iterations);
+				r["total_ns"] = to_json(run.total_time);
+				r["average_ns"] = to_json(run.average);
+				r["fastest_ns"] = to_json(run.fastest);
+				r["slowest_ns"] = to_json(run.slowest);
+				runs.push_back(std::move(r));
+			}
+
+			json_t b {json_t::object_type{}};
+			b["name"] = record.name;
+			b["iterations_per_run"] = to_json(record.iterations_per_run);
+			b["total_ns"] = to_json(record.total_run_time());
+			b["fastest_iteration_ns"] = to_json(record.fastest_iteration());
+			b["slowest_iteration_ns"] = to_json(record.slowest_iteration());
+			b["runs"] = std::move(runs);
+			benchmarks.push_back(std::move(b));
+		}
+
+		json_t root {json_t::object_type{}};
+		root["version"] = json_report_version;
+		root["environment"] = std::move(environment);
+		root["benchmarks"] = std::move(benchmarks);
+
+		os << root << '\n';
+	}
+
+	// Reads a report written by write_json_report. Throws invalid_json if
+	// the input is not one.
+	export
+	[[nodiscard]] benchmark_report read_json_report(std::istream& is)
+	{
+		json_t root;
+		if (!(is >> root) || !root.is_object())
+		{
+			throw cmoon::json::invalid_json{"benchmark report is not a JSON object"};
+		}
+
+		try
+		{
+			if (root.at("version").as_integer() != json_report_version)
+			{
+				throw cmoon::json::invalid_json{"unsupported benchmark report version " + std::to_string(root.at("version").as_integer())};
+			}
+
+			const auto& env {root.at("environment")};
+			benchmark_report report {benchmark_environment{
+				.cpu_model = env.at("cpu_model").as_string(),
+				.compiler = env.at("compiler").as_string(),
+				.compiler_version = env.at("compiler_version").as_string(),
+				.operating_system = env.at("operating_system").as_string(),
+				.architecture = env.at("architecture").as_string(),
+				.hardware_threads = size_from_json(env.at("hardware_threads")),
+				.debug = env.at("debug").as_boolean(),
+				.timestamp = env.at("timestamp").as_string()
+			}};
+
+			for (const auto& b : root.at("benchmarks").as_list())
+			{
+				benchmark_record record;
+				record.name = b.at("name").as_string();
+				record.iterations_per_run = size_from_json(b.at("iterations_per_run"));
+				for (const auto& r : b.at("runs").as_list())
+				{
+					auto& run {record.runs.emplace_back()};
+					run.iterations = size_from_json(r.at("iterations"));
+					run.total_time = nanoseconds_from_json(r.at("total_ns"));
+					run.average = nanoseconds_from_json(r.at("average_ns"));
+					run.fastest = nanoseconds_from_json(r.at("fastest_ns"));
+					run.slowest = nanoseconds_from_json(r.at("slowest_ns"));
+				}
+
+				report.add(std::move(record));
+			}
+
+			return report;
+		}
+		catch (const std::out_of_range& e)
+		{
+			throw cmoon::json::invalid_json{std::string{"benchmark report is missing a field: "} + e.what()};
+		}
+		catch (const std::bad_variant_access&)
+		{
+			throw cmoon::json::invalid_json{"benchmark report has a field of the wrong type"};
+		}
+	}
+}
\ No newline at end of file
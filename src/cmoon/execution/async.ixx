@@ -4,6 +4,11 @@ import <future>;
 import <concepts>;
 import <utility>;
 import <exception>;
+import <memory>;
+import <cstddef>;
+import <type_traits>;
+
+import cmoon.memory;
 
 import cmoon.execution.scheduler;
 import cmoon.execution.then;
@@ -34,10 +39,9 @@ namespace cmoon::execution
 			}
 	};
 
-	template<sender S, class R>
+	template<sender S, class R, class Alloc>
 	struct async_impl
 	{
-		template<class R>
 		struct wrap_r
 		{
 			public:
@@ -56,48 +60,67 @@ namespace cmoon::execution
 						r.promise_.set_exception(std::current_exception());
 					}
 
-					delete r.impl;
+					r.impl->destroy();
 				}
 
 				template<class E>
 				friend void tag_invoke(set_error_t, wrap_r&& r, E&& e) noexcept
 				{
 					r.promise_.set_exception(std::make_exception_ptr(std::forward<E>(e)));
-					delete r.impl;
+					r.impl->destroy();
 				}
 
 				friend void tag_invoke(set_done_t, wrap_r&& r) noexcept
 				{
 					r.promise_.set_exception(std::make_exception_ptr(future_done_exception{}));
-					delete r.impl;
+					r.impl->destroy();
 				}
 			private:
 				async_impl* impl;
 				std::promise<R> promise_;
 		};
-		connect_result_t<S, wrap_r<R>> state;
 
-		async_impl(S&& s, std::promise<R>&& p)
-			: state{execution::connect(std::forward<S>(s), wrap_r{this, std::move(p)})} {}
-	};
+		Alloc alloc;
+		connect_result_t<S, wrap_r> state;
 
-	template<sender S, class R>
-	async_impl(S&&, std::promise<R>&&) -> async_impl<S, R>;
+		async_impl(S&& s, std::promise<R>&& p, const Alloc& alloc)
+			: alloc{alloc},
+			  state{execution::connect(std::forward<S>(s), wrap_r{this, std::move(p)})} {}
 
+		void destroy() noexcept
+		{
+			using traits = typename std::allocator_traits<Alloc>::template rebind_traits<async_impl>;
+			typename traits::allocator_type a {alloc};
+			traits::destroy(a, this);
+			traits::deallocate(a, this, 1);
+		}
+	};
+
+	// Both the operation state and the shared state of the future are kept
+	// in memory from alloc.
 	export
-	template<scheduler Sch, class F, class...Args>
-	[[nodiscard]] auto async(Sch&& sch, F&& f, Args&&... args)
+	template<class Alloc, scheduler Sch, class F, class...Args>
+	[[nodiscard]] auto async(std::allocator_arg_t, const Alloc& alloc, Sch&& sch, F&& f, Args&&... args)
 	{
 		auto work = execution::just(std::forward<Args>(args)...) |
 					execution::then(std::forward<F>(f)) |
 					execution::on(std::forward<Sch>(sch));
 
-		std::promise<std::invoke_result_t<F, Args...>> p;
+		using result_t = std::invoke_result_t<F, Args...>;
+		std::promise<result_t> p {std::allocator_arg, alloc};
 		auto future = p.get_future();
 
-		auto impl {new async_impl{std::move(work), std::move(p)}};
-		execution::start(impl->state);
+		using impl_t = async_impl<decltype(work), result_t, Alloc>;
+		auto impl {cmoon::allocate_unique<impl_t>(Alloc{alloc}, std::move(work), std::move(p), alloc)};
+		execution::start(impl.release()->state);
 
 		return future;
 	}
+
+	export
+	template<scheduler Sch, class F, class...Args>
+	[[nodiscard]] auto async(Sch&& sch, F&& f, Args&&... args)
+	{
+		return execution::async(std::allocator_arg, cmoon::recycling_allocator<std::byte>{}, std::forward<Sch>(sch), std::forward<F>(f), std::forward<Args>(args)...);
+	}
 }
\ No newline at end of file
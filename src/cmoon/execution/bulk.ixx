@@ -4,12 +4,27 @@ import <utility>;
 import <functional>;
 import <exception>;
 import <concepts>;
+import <atomic>;
+import <algorithm>;
+import <memory>;
+import <optional>;
+import <thread>;
+import <tuple>;
+import <type_traits>;
+import <vector>;
 
 import cmoon.meta;
 import cmoon.concepts;
 import cmoon.functional;
+import cmoon.memory;
 
 import cmoon.execution.get_completion_scheduler;
+import cmoon.execution.get_forward_progress_guarantee;
+import cmoon.execution.forward_progress_guarantee;
+import cmoon.execution.get_stop_token;
+import cmoon.execution.get_allocator;
+import cmoon.execution.schedule;
+import cmoon.execution.scheduler;
 import cmoon.execution.set_value;
 import cmoon.execution.set_error;
 import cmoon.execution.set_done;
@@ -22,6 +37,24 @@ import cmoon.execution.sender_adapter;
 
 namespace cmoon::execution
 {
+	template<class Shape, class F, class R, class... Args>
+	constexpr void serial_bulk(Shape shape, F& f, R&& r, Args&&... args) noexcept
+	{
+		try
+		{
+			for (Shape i {0}; i < shape; ++i)
+			{
+				std::invoke(f, i, args...);
+			}
+
+			execution::set_value(std::move(r), std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			execution::set_error(std::move(r), std::current_exception());
+		}
+	}
+
 	template<class Shape, class F, class R>
 	struct bulk_receiver
 	{
@@ -32,32 +65,296 @@ namespace cmoon::execution
 			template<class... Args>
 			constexpr friend void tag_invoke(set_value_t, bulk_receiver&& r, Args&&... args) noexcept
 			{
+				serial_bulk(r.shape, r.f_, std::move(r.out_r), std::forward<Args>(args)...);
+			}
+
+			template<class E>
+			constexpr friend void tag_invoke(set_error_t, bulk_receiver&& r, E&& e) noexcept
+			{
+				execution::set_error(std::move(r.out_r), std::forward<E>(e));
+			}
+
+			constexpr friend void tag_invoke(set_done_t, bulk_receiver&& r) noexcept
+			{
+				execution::set_done(std::move(r.out_r));
+			}
+		private:
+			Shape shape;
+			F f_;
+			R out_r;
+	};
+
+	// Converts to the result of calling F, so that emplace can build an
+	// operation state, which need not be movable, straight from connect.
+	template<class F>
+	struct connect_in_place
+	{
+		F f;
+
+		operator std::invoke_result_t<F&>()
+		{
+			return f();
+		}
+	};
+
+	template<class F>
+	connect_in_place(F) -> connect_in_place<F>;
+
+	// The shape split into chunks, each run by a task scheduled on Sch, once
+	// the values it is given have arrived. The thread that delivers them runs
+	// the first chunk itself. The state is allocated then, from the
+	// receiver's allocator, since the value types are only known then, and
+	// whichever chunk finishes last completes the receiver and frees it.
+	template<class Sch, class Shape, class F, class R, class Alloc, class... Args>
+	struct parallel_bulk_state
+	{
+		public:
+			struct chunk_receiver
+			{
+				public:
+					parallel_bulk_state* s;
+					Shape begin;
+					Shape end;
+
+					friend void tag_invoke(set_value_t, chunk_receiver&& r) noexcept
+					{
+						r.set_value_helper();
+					}
+
+					template<class E>
+					friend void tag_invoke(set_error_t, chunk_receiver&& r, E&& e) noexcept
+					{
+						if constexpr (std::same_as<std::remove_cvref_t<E>, std::exception_ptr>)
+						{
+							r.set_error_helper(std::forward<E>(e));
+						}
+						else
+						{
+							r.set_error_helper(std::make_exception_ptr(std::forward<E>(e)));
+						}
+					}
+
+					friend void tag_invoke(set_done_t, chunk_receiver&& r) noexcept
+					{
+						r.set_done_helper();
+					}
+
+					friend auto tag_invoke(get_stop_token_t, const chunk_receiver& r) noexcept
+					{
+						return r.get_stop_token_helper();
+					}
+
+					friend Alloc tag_invoke(get_allocator_t, const chunk_receiver& r) noexcept
+					{
+						return r.get_allocator_helper();
+					}
+				private:
+					void set_value_helper() noexcept
+					{
+						s->run(begin, end);
+						s->finish();
+					}
+
+					void set_error_helper(std::exception_ptr e) noexcept
+					{
+						s->fail(std::move(e));
+						s->finish();
+					}
+
+					void set_done_helper() noexcept
+					{
+						s->done_.store(true, std::memory_order_relaxed);
+						s->finish();
+					}
+
+					auto get_stop_token_helper() const noexcept
+					{
+						return execution::get_stop_token(s->out_r);
+					}
+
+					Alloc get_allocator_helper() const noexcept
+					{
+						return s->alloc_;
+					}
+			};
+
+			template<class... Args2>
+			parallel_bulk_state(const Alloc& alloc, Sch& sch, Shape shape, F& f, R& r, Args2&&... args)
+				: alloc_{alloc},
+				  chunks_{static_cast<std::size_t>(std::min<std::common_type_t<Shape, std::size_t>>(shape, std::max(std::thread::hardware_concurrency(), 1u)))},
+				  ops_(chunks_ - 1, alloc),
+				  remaining_{chunks_},
+				  sch_{std::move(sch)},
+				  shape_{shape},
+				  f_{std::move(f)},
+				  args_{std::forward<Args2>(args)...},
+				  out_r{std::move(r)} {}
+
+			// Takes ownership of this.
+			void start() noexcept
+			{
+				const auto base {shape_ / static_cast<Shape>(chunks_)};
+				const auto extra {shape_ % static_cast<Shape>(chunks_)};
+				const auto bounds = [base, extra](std::size_t i) {
+					const auto c {static_cast<Shape>(i)};
+					return c * base + std::min(c, extra);
+				};
+
 				try
 				{
-					for (Shape i {0}; i < r.shape; ++i)
+					for (std::size_t i {1}; i < chunks_; ++i)
+					{
+						ops_[i - 1].emplace(connect_in_place{[&] {
+							return execution::connect(execution::schedule(sch_), chunk_receiver{this, bounds(i), bounds(i + 1)});
+						}});
+					}
+				}
+				catch (...)
+				{
+					execution::set_error(std::move(out_r), std::current_exception());
+					destroy();
+					return;
+				}
+
+				// The first chunk keeps this alive until it finishes.
+				for (std::size_t i {0}; i < chunks_ - 1; ++i)
+				{
+					execution::start(*ops_[i]);
+				}
+
+				run(0, bounds(1));
+				finish();
+			}
+		private:
+			using op_t = connect_result_t<schedule_result_t<Sch&>, chunk_receiver>;
+			using ops_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<std::optional<op_t>>;
+
+			Alloc alloc_;
+			std::size_t chunks_;
+			std::vector<std::optional<op_t>, ops_allocator> ops_;
+			std::atomic<std::size_t> remaining_;
+			std::atomic_flag errored_;
+			std::atomic<bool> done_ {false};
+			std::exception_ptr error_;
+			Sch sch_;
+			Shape shape_;
+			F f_;
+			std::tuple<Args...> args_;
+			R out_r;
+
+			[[nodiscard]] bool should_stop() const noexcept
+			{
+				return errored_.test(std::memory_order_relaxed) || execution::get_stop_token(out_r).stop_requested();
+			}
+
+			void fail(std::exception_ptr e) noexcept
+			{
+				if (!errored_.test_and_set())
+				{
+					error_ = std::move(e);
+				}
+			}
+
+			// Stops early once another chunk has failed or stop is requested.
+			void run(Shape begin, Shape end) noexcept
+			{
+				for (auto i {begin}; i < end && !should_stop(); ++i)
+				{
+					try
 					{
-						std::invoke(r.f_, i, args...);
+						std::apply([this, i](Args&... args) { std::invoke(f_, i, args...); }, args_);
 					}
+					catch (...)
+					{
+						fail(std::current_exception());
+					}
+				}
+			}
+
+			void finish() noexcept
+			{
+				if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					return;
+				}
+
+				if (errored_.test())
+				{
+					execution::set_error(std::move(out_r), std::move(error_));
+				}
+				else if (done_.load(std::memory_order_relaxed) || execution::get_stop_token(out_r).stop_requested())
+				{
+					execution::set_done(std::move(out_r));
+				}
+				else
+				{
+					std::apply([this](Args&... args) { execution::set_value(std::move(out_r), std::move(args)...); }, args_);
+				}
+
+				destroy();
+			}
+
+			void destroy() noexcept
+			{
+				using traits = typename std::allocator_traits<Alloc>::template rebind_traits<parallel_bulk_state>;
+				typename traits::allocator_type a {alloc_};
+				traits::destroy(a, this);
+				traits::deallocate(a, this, 1);
+			}
+	};
+
+	// Used when the predecessor names the scheduler it completes on. If that
+	// scheduler's forward progress guarantee is parallel the shape is spread
+	// over it, otherwise it runs serially as bulk_receiver does.
+	template<scheduler Sch, class Shape, class F, class R>
+	struct parallel_bulk_receiver
+	{
+		public:
+			constexpr parallel_bulk_receiver(Sch&& sch, Shape shape, F&& f, R&& r)
+				: sch_{std::forward<Sch>(sch)}, shape{shape}, f_{std::forward<F>(f)}, out_r{std::forward<R>(r)} {}
+
+			template<class... Args>
+			friend void tag_invoke(set_value_t, parallel_bulk_receiver&& r, Args&&... args) noexcept
+			{
+				if (r.shape <= 1 || execution::get_forward_progress_guarantee(r.sch_) != forward_progress_guarantee::parallel)
+				{
+					serial_bulk(r.shape, r.f_, std::move(r.out_r), std::forward<Args>(args)...);
+					return;
+				}
 
-					execution::set_value(std::move(r.out_r), args...);
+				const auto alloc {execution::allocator_of(r.out_r)};
+				using state_t = parallel_bulk_state<Sch, Shape, F, R, std::remove_const_t<decltype(alloc)>, std::decay_t<Args>...>;
+				state_t* s;
+				try
+				{
+					s = cmoon::allocate_unique<state_t>(alloc, alloc, r.sch_, r.shape, r.f_, r.out_r, std::forward<Args>(args)...).release();
 				}
 				catch (...)
 				{
 					execution::set_error(std::move(r.out_r), std::current_exception());
+					return;
 				}
+
+				s->start();
 			}
 
 			template<class E>
-			constexpr friend void tag_invoke(set_error_t, bulk_receiver&& r, E&& e) noexcept
+			constexpr friend void tag_invoke(set_error_t, parallel_bulk_receiver&& r, E&& e) noexcept
 			{
 				execution::set_error(std::move(r.out_r), std::forward<E>(e));
 			}
 
-			constexpr friend void tag_invoke(set_done_t, bulk_receiver&& r) noexcept
+			constexpr friend void tag_invoke(set_done_t, parallel_bulk_receiver&& r) noexcept
 			{
 				execution::set_done(std::move(r.out_r));
 			}
+
+			friend auto tag_invoke(get_stop_token_t, const parallel_bulk_receiver& r) noexcept
+			{
+				return execution::get_stop_token(r.out_r);
+			}
 		private:
+			Sch sch_;
 			Shape shape;
 			F f_;
 			R out_r;
@@ -73,8 +370,24 @@ namespace cmoon::execution
 			template<receiver R>
 			constexpr friend auto tag_invoke(connect_t, bulk_sender&& s, R&& out_r)
 			{
-				return execution::connect(std::move(s.s_),
-										  bulk_receiver<Shape, F, R>{s.shape, std::move(s.f_), std::forward<R>(out_r)});
+				if constexpr (requires { get_completion_scheduler<set_value_t>(s.s_); })
+				{
+					using sch_t = std::remove_cvref_t<decltype(get_completion_scheduler<set_value_t>(s.s_))>;
+					return execution::connect(std::move(s.s_),
+											  parallel_bulk_receiver<sch_t, Shape, F, R>{get_completion_scheduler<set_value_t>(s.s_), s.shape, std::move(s.f_), std::forward<R>(out_r)});
+				}
+				else
+				{
+					return execution::connect(std::move(s.s_),
+											  bulk_receiver<Shape, F, R>{s.shape, std::move(s.f_), std::forward<R>(out_r)});
+				}
+			}
+
+			// Values are sent from a chunk, which runs on the predecessor's scheduler.
+			friend decltype(auto) tag_invoke(get_completion_scheduler_t<set_value_t> t, const bulk_sender& s) noexcept
+				requires(requires(const S& p) { get_completion_scheduler<set_value_t>(p); })
+			{
+				return t(s.s_);
 			}
 		private:
 			S s_;
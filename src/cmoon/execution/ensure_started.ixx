@@ -7,11 +7,15 @@ import <concepts>;
 import <type_traits>;
 import <optional>;
 import <tuple>;
+import <memory>;
+import <cstddef>;
 
 import cmoon.meta;
 import cmoon.functional;
+import cmoon.memory;
 
 import cmoon.execution.get_completion_scheduler;
+import cmoon.execution.get_allocator;
 import cmoon.execution.set_value;
 import cmoon.execution.set_error;
 import cmoon.execution.set_done;
@@ -23,14 +27,14 @@ import cmoon.execution.sender_adapter;
 
 namespace cmoon::execution
 {
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct state;
 
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct ensure_started_receiver
 	{
 		public:
-			ensure_started_receiver(state<S>* s)
+			ensure_started_receiver(state<S, Alloc>* s)
 				: s{s} {}
 
 			template<class... Args>
@@ -54,34 +58,43 @@ namespace cmoon::execution
 				r.s->operation_done.test_and_set();
 				r.s->operation_done.notify_one();
 			}
+
+			friend Alloc tag_invoke(get_allocator_t, const ensure_started_receiver& r) noexcept
+			{
+				return r.s->alloc;
+			}
 		private:
-			state<S>* s;
+			state<S, Alloc>* s;
 	};
 
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct state
 	{
-		state(S&& s)
-			: op_state{execution::connect(std::forward<S>(s), ensure_started_receiver<S>{this})}
+		state(S&& s, const Alloc& alloc)
+			: alloc{alloc},
+			  op_state{execution::connect(std::forward<S>(s), ensure_started_receiver<S, Alloc>{this})}
 		{
 			execution::start(op_state);
 		}
 
-		connect_result_t<S, ensure_started_receiver<S>> op_state;
+		Alloc alloc;
+		connect_result_t<S, ensure_started_receiver<S, Alloc>> op_state;
 		std::optional<value_types_of_t<S>> args;
 		std::optional<error_types_of_t<S>> err;
 		std::atomic_flag operation_done;
 	};
 
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct ensure_started_sender
 	{
+		using state_ptr = cmoon::allocate_unique_t<state<S, Alloc>, Alloc>;
+
 		template<receiver R>
 		struct op
 		{
 			public:
 				op(R&& r,
-				   std::unique_ptr<state<S>> s)
+				   state_ptr s)
 					: out_r{std::forward<R>(r)},
 					  s{std::move(s)} {}
 
@@ -113,12 +126,12 @@ namespace cmoon::execution
 				}
 			private:
 				R out_r;
-				std::unique_ptr<state<S>> s;
+				state_ptr s;
 		};
 
 		public:
-			ensure_started_sender(S&& s)
-				: s{std::make_unique<state<S>>(std::forward<S>(s))} {}
+			ensure_started_sender(S&& s, const Alloc& alloc = Alloc{})
+				: s{cmoon::allocate_unique<state<S, Alloc>>(Alloc{alloc}, std::forward<S>(s), alloc)} {}
 
 			template<template<class...> class Tuple, template<class...> class Variant>
 			using value_types = value_types_of_t<S, Tuple, Variant>;
@@ -134,7 +147,7 @@ namespace cmoon::execution
 				return op<R>{std::forward<R>(out_r), std::move(s.s)};
 			}
 		private:
-			std::unique_ptr<state<S>> s;
+			state_ptr s;
 	};
 
 	export
@@ -180,10 +193,17 @@ namespace cmoon::execution
 				}
 				else if constexpr (choice.strategy == state::other)
 				{
-					return ensure_started_sender{std::forward<S>(s)};
+					return ensure_started_sender<std::remove_cvref_t<S>, cmoon::recycling_allocator<std::byte>>{std::forward<S>(s)};
 				}
 			}
 
+			// Keeps the state of the started operation in memory from alloc.
+			template<typed_sender S, cmoon::allocator Alloc>
+			[[nodiscard]] ensure_started_sender<std::remove_cvref_t<S>, Alloc> operator()(S&& s, const Alloc& alloc) const
+			{
+				return ensure_started_sender<std::remove_cvref_t<S>, Alloc>{std::forward<S>(s), alloc};
+			}
+
 			constexpr auto operator()() const noexcept
 			{
 				return sender_adapter<ensure_started_t>{};
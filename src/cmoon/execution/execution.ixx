@@ -16,7 +16,12 @@ export import cmoon.execution.sender_adapter;
 export import cmoon.execution.connect;
 export import cmoon.execution.schedule;
 export import cmoon.execution.scheduler;
+export import cmoon.execution.now;
+export import cmoon.execution.schedule_at;
+export import cmoon.execution.schedule_after;
+export import cmoon.execution.time_scheduler;
 export import cmoon.execution.get_forward_progress_guarantee;
+export import cmoon.execution.get_numa_node;
 export import cmoon.execution.get_completion_scheduler;
 export import cmoon.execution.start_detached;
 export import cmoon.execution.sender_to;
@@ -45,4 +50,7 @@ export import cmoon.execution.done_as_error;
 export import cmoon.execution.ensure_started;
 export import cmoon.execution.sync_wait;
 export import cmoon.execution.execute;
-export import cmoon.execution.async;
\ No newline at end of file
+export import cmoon.execution.async;
+export import cmoon.execution.task;
+export import cmoon.execution.tracer;
+export import cmoon.execution.traced;
\ No newline at end of file
@@ -1,8 +1,10 @@
 export module cmoon.execution.get_allocator;
 
 import <utility>;
+import <cstddef>;
 
 import cmoon.functional;
+import cmoon.memory;
 
 import cmoon.execution.receiver;
 
@@ -23,4 +25,20 @@ namespace cmoon::execution
 
 	export
 	inline constexpr get_allocator_t get_allocator{};
+
+	// The allocator that R asks algorithms to use for the state they keep
+	// while connected to it, or a recycling_allocator if it does not say.
+	export
+	template<class R>
+	[[nodiscard]] constexpr auto allocator_of(const R& r) noexcept
+	{
+		if constexpr (requires { execution::get_allocator(r); })
+		{
+			return execution::get_allocator(r);
+		}
+		else
+		{
+			return cmoon::recycling_allocator<std::byte>{};
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+export module cmoon.execution.get_numa_node;
+
+import <cstddef>;
+import <utility>;
+import <concepts>;
+
+import cmoon.functional;
+
+import cmoon.execution.scheduler;
+
+namespace cmoon::execution
+{
+	// Asks a scheduler which NUMA node the work it schedules from the calling
+	// thread will run on.
+	export
+	struct get_numa_node_t
+	{
+		template<scheduler Sch>
+			requires(requires(get_numa_node_t t, Sch&& sch) {
+				{ tag_invoke(t, std::forward<Sch>(sch)) } noexcept -> std::same_as<std::size_t>;
+			})
+		constexpr std::size_t operator()(Sch&& sch) const noexcept
+		{
+			return tag_invoke(*this, std::forward<Sch>(sch));
+		}
+	};
+
+	export
+	inline constexpr get_numa_node_t get_numa_node{};
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+export module cmoon.execution.now;
+
+import <utility>;
+import <type_traits>;
+
+import cmoon.functional;
+
+namespace cmoon::execution
+{
+	export
+	struct now_t
+	{
+		template<class S>
+			requires(requires(now_t t, const S& s) {
+				tag_invoke(t, s);
+			})
+		constexpr decltype(auto) operator()(const S& s) const noexcept(cmoon::nothrow_tag_invocable<now_t, const S&>)
+		{
+			return tag_invoke(*this, s);
+		}
+	};
+
+	export
+	inline constexpr now_t now{};
+}
\ No newline at end of file
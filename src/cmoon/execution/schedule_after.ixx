@@ -0,0 +1,27 @@
+export module cmoon.execution.schedule_after;
+
+import <utility>;
+import <type_traits>;
+
+import cmoon.functional;
+
+import cmoon.execution.sender;
+
+namespace cmoon::execution
+{
+	export
+	struct schedule_after_t
+	{
+		template<class S, class Duration>
+			requires(requires(schedule_after_t t, S&& s, Duration&& d) {
+				{ tag_invoke(t, s, std::forward<Duration>(d)) } -> sender;
+			})
+		constexpr decltype(auto) operator()(S&& s, Duration&& d) const noexcept(cmoon::nothrow_tag_invocable<schedule_after_t, S, Duration>)
+		{
+			return tag_invoke(*this, s, std::forward<Duration>(d));
+		}
+	};
+
+	export
+	inline constexpr schedule_after_t schedule_after{};
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+export module cmoon.execution.schedule_at;
+
+import <utility>;
+import <type_traits>;
+
+import cmoon.functional;
+
+import cmoon.execution.sender;
+
+namespace cmoon::execution
+{
+	export
+	struct schedule_at_t
+	{
+		template<class S, class TimePoint>
+			requires(requires(schedule_at_t t, S&& s, TimePoint&& tp) {
+				{ tag_invoke(t, s, std::forward<TimePoint>(tp)) } -> sender;
+			})
+		constexpr decltype(auto) operator()(S&& s, TimePoint&& tp) const noexcept(cmoon::nothrow_tag_invocable<schedule_at_t, S, TimePoint>)
+		{
+			return tag_invoke(*this, s, std::forward<TimePoint>(tp));
+		}
+	};
+
+	export
+	inline constexpr schedule_at_t schedule_at{};
+}
\ No newline at end of file
@@ -1,17 +1,16 @@
 export module cmoon.execution.split;
 
+import <cstddef>;
 import <utility>;
 import <tuple>;
 import <functional>;
 import <memory>;
 import <mutex>;
-import <thread>;
 import <optional>;
-import <stop_token>;
 
 import cmoon.meta;
 import cmoon.functional;
-import cmoon.scope;
+import cmoon.memory;
 
 import cmoon.execution.set_value;
 import cmoon.execution.set_error;
@@ -20,126 +19,150 @@ import cmoon.execution.sender;
 import cmoon.execution.typed_sender;
 import cmoon.execution.receiver;
 import cmoon.execution.get_completion_scheduler;
+import cmoon.execution.get_allocator;
 import cmoon.execution.sender_traits;
 import cmoon.execution.connect;
 import cmoon.execution.start;
 
 namespace cmoon::execution
 {
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct shared_state;
 
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct split_receiver
 	{
 		template<class... Args>
 		friend void tag_invoke(set_value_t, split_receiver&& r, Args&&... args) noexcept
 		{
 			r.sh_state->args = std::make_tuple(std::forward<Args>(args)...);
-			r.sh_state->received.test_and_set();
-			r.sh_state->received.notify_all();
+			r.sh_state->notify();
 		}
 
 		template<class E>
 		friend void tag_invoke(set_error_t, split_receiver&& r, E&& e) noexcept
 		{
 			r.sh_state->e = std::forward<E>(e);
-			r.sh_state->received.test_and_set();
-			r.sh_state->received.notify_all();
+			r.sh_state->notify();
 		}
 
 		friend void tag_invoke(set_done_t, split_receiver&& r) noexcept
 		{
-			r.sh_state->received.test_and_set();
-			r.sh_state->received.notify_all();
+			r.sh_state->notify();
 		}
 
-		shared_state<S>* sh_state;
+		friend Alloc tag_invoke(get_allocator_t, const split_receiver& r) noexcept
+		{
+			return r.sh_state->alloc;
+		}
+
+		shared_state<S, Alloc>* sh_state;
 	};
 
-	template<typed_sender S>
-	struct shared_state
+	// A started operation waiting on the shared result.
+	struct split_waiter
 	{
-		shared_state(S&& s)
-			: op_state2{execution::connect(std::forward<S>(s), split_receiver<S>{this})} {}
+		split_waiter* next {nullptr};
+		void (*complete)(split_waiter&) noexcept;
+	};
 
-		connect_result_t<S, split_receiver<S>> op_state2;
+	template<typed_sender S, class Alloc>
+	struct shared_state : public std::enable_shared_from_this<shared_state<S, Alloc>>
+	{
+		shared_state(S&& s, const Alloc& alloc)
+			: alloc{alloc},
+			  op_state2{execution::connect(std::forward<S>(s), split_receiver<S, Alloc>{this})} {}
+
+		Alloc alloc;
+		connect_result_t<S, split_receiver<S, Alloc>> op_state2;
 		value_types_of_t<S, std::tuple, std::optional> args;
 		error_types_of_t<S, std::optional> e;
-		std::atomic_flag received;
-		std::once_flag start_once_flag;
-
-		void start() noexcept
+		std::mutex mut;
+		split_waiter* waiters {nullptr};
+		bool started {false};
+		bool completed {false};
+
+		// Completes w once the sender has completed, starting the sender if
+		// w is the first to wait on it.
+		void add(split_waiter& w) noexcept
 		{
-			std::call_once(start_once_flag, [this] {
+			std::unique_lock l {mut};
+			if (completed)
+			{
+				l.unlock();
+				w.complete(w);
+				return;
+			}
+
+			w.next = std::exchange(waiters, &w);
+			if (!std::exchange(started, true))
+			{
+				l.unlock();
 				execution::start(op_state2);
-			});
+			}
+		}
+
+		void notify() noexcept
+		{
+			// A waiter's receiver may drop the last reference to this.
+			const auto keep_alive {this->shared_from_this()};
+
+			split_waiter* w;
+			{
+				std::scoped_lock l {mut};
+				completed = true;
+				w = std::exchange(waiters, nullptr);
+			}
+
+			while (w != nullptr)
+			{
+				const auto next {w->next};
+				w->complete(*w);
+				w = next;
+			}
 		}
 	};
 
-	template<typed_sender S>
+	template<typed_sender S, class Alloc>
 	struct split_sender
 	{
 		private:
 			template<receiver R>
-			struct op
+			struct op : private split_waiter
 			{
 				public:
-					op(std::shared_ptr<shared_state<S>> s, R&& r)
-						: sh_state{std::move(s)}, t{&op::wait_on_receiver, std::ref(*this), stop_source.get_token(), sh_state, std::forward<R>(r)} {}
+					op(std::shared_ptr<shared_state<S, Alloc>> s, R&& r)
+						: split_waiter{nullptr, &op::complete},
+						  sh_state{std::move(s)},
+						  out_r{std::forward<R>(r)} {}
 
 					friend void tag_invoke(start_t, op& o) noexcept
 					{
-						o.sh_state->start();
-						o.started.test_and_set();
-						o.started.notify_one();
-					}
-
-					~op() noexcept
-					{
-						if (!started.test())
-						{
-							stop_source.request_stop();
-							started.test_and_set();
-							started.notify_one();
-							t.join();
-						}
-						else
-						{
-							t.detach();
-						}
+						o.sh_state->add(o);
 					}
 				private:
-					std::atomic_flag started;
-					std::stop_source stop_source;
-					std::shared_ptr<shared_state<S>> sh_state;
-					std::thread t;
+					std::shared_ptr<shared_state<S, Alloc>> sh_state;
+					std::remove_cvref_t<R> out_r;
 
-					static void wait_on_receiver(op& o, std::stop_token token, std::shared_ptr<shared_state<S>> sh_state, R&& r)
+					static void complete(split_waiter& w) noexcept
 					{
-						o.started.wait(false);
-						if (token.stop_requested())
-						{
-							return;
-						}
-
-						sh_state->received.wait(false);
-
-						if (sh_state->args)
+						auto& o {static_cast<op&>(w)};
+						auto& sh_state {*o.sh_state};
+						if (sh_state.args)
 						{
 							std::apply(
-								[&r] (auto&&... args) {
-									execution::set_value(std::forward<R>(r), std::forward<decltype(args)>(args)...);
+								[&o] (auto&... args) {
+									execution::set_value(std::move(o.out_r), args...);
 								},
-							sh_state->args.value());
+							sh_state.args.value());
 						}
-						else if (sh_state->e)
+						else if (sh_state.e)
 						{
-							execution::set_error(std::forward<R>(r), sh_state->e.value());
+							execution::set_error(std::move(o.out_r), sh_state.e.value());
 						}
 						else
 						{
-							execution::set_done(std::forward<R>(r));
+							execution::set_done(std::move(o.out_r));
 						}
 					}
 			};
@@ -152,8 +175,8 @@ namespace cmoon::execution
 
 			static constexpr bool sends_done {S::sends_done};
 
-			split_sender(S&& s)
-				: sh_state{std::make_shared<shared_state<S>>(std::forward<S>(s))} {}
+			split_sender(S&& s, const Alloc& alloc = Alloc{})
+				: sh_state{std::allocate_shared<shared_state<S, Alloc>>(alloc, std::forward<S>(s), alloc)} {}
 
 			template<receiver R>
 			friend auto tag_invoke(connect_t, split_sender& s, R&& out_r)
@@ -167,7 +190,7 @@ namespace cmoon::execution
 				return op<R>{std::move(s.sh_state), std::forward<R>(out_r)};
 			}
 		private:
-			std::shared_ptr<shared_state<S>> sh_state;
+			std::shared_ptr<shared_state<S, Alloc>> sh_state;
 	};
 
 	export
@@ -194,7 +217,7 @@ namespace cmoon::execution
 				}
 				else
 				{
-					return {state::other, std::is_nothrow_constructible_v<split_sender<S>, S>};
+					return {state::other, std::is_nothrow_constructible_v<split_sender<S, cmoon::recycling_allocator<std::byte>>, S>};
 				}
 			}
 		public:
@@ -213,9 +236,17 @@ namespace cmoon::execution
 				}
 				else if constexpr (choice.strategy == state::other)
 				{
-					return split_sender<S>{std::forward<S>(s)};
+					return split_sender<S, cmoon::recycling_allocator<std::byte>>{std::forward<S>(s)};
 				}
 			}
+
+			// Keeps the shared state, and that of the operations the sender
+			// is connected to, in memory from alloc.
+			template<typed_sender S, cmoon::allocator Alloc>
+			[[nodiscard]] split_sender<S, Alloc> operator()(S&& s, const Alloc& alloc) const
+			{
+				return split_sender<S, Alloc>{std::forward<S>(s), alloc};
+			}
 	};
 
 	export
@@ -5,11 +5,15 @@ import <functional>;
 import <atomic>;
 import <concepts>;
 import <type_traits>;
+import <memory>;
+import <cstddef>;
 
 import cmoon.meta;
 import cmoon.functional;
+import cmoon.memory;
 
 import cmoon.execution.get_completion_scheduler;
+import cmoon.execution.get_allocator;
 import cmoon.execution.set_value;
 import cmoon.execution.set_error;
 import cmoon.execution.set_done;
@@ -20,7 +24,7 @@ import cmoon.execution.start;
 
 namespace cmoon::execution
 {
-	template<sender S>
+	template<sender S, class Alloc>
 	struct start_detached_impl
 	{
 		struct wrap_r
@@ -28,7 +32,7 @@ namespace cmoon::execution
 			template<class... Args>
 			constexpr friend void tag_invoke(set_value_t, start_detached_impl::wrap_r&& r, Args&&...) noexcept
 			{
-				delete r.impl;
+				r.impl->destroy();
 			}
 
 			template<class E>
@@ -39,16 +43,37 @@ namespace cmoon::execution
 
 			constexpr friend void tag_invoke(set_done_t, start_detached_impl::wrap_r&& r) noexcept
 			{
-				delete r.impl;
+				r.impl->destroy();
+			}
+
+			friend Alloc tag_invoke(get_allocator_t, const start_detached_impl::wrap_r& r) noexcept
+			{
+				return r.impl->alloc;
 			}
 
 			start_detached_impl* impl;
 		};
 
+		Alloc alloc;
 		connect_result_t<S, wrap_r> state;
 
-		start_detached_impl(S&& s) noexcept(cmoon::nothrow_tag_invocable<connect_t, S, wrap_r>)
-			: state{execution::connect(std::forward<S>(s), wrap_r{this})} {}
+		start_detached_impl(S&& s, const Alloc& alloc) noexcept(cmoon::nothrow_tag_invocable<connect_t, S, wrap_r>)
+			: alloc{alloc},
+			  state{execution::connect(std::forward<S>(s), wrap_r{this})} {}
+
+		static void start_new(S&& s, const Alloc& alloc)
+		{
+			auto impl {cmoon::allocate_unique<start_detached_impl>(Alloc{alloc}, std::forward<S>(s), alloc)};
+			execution::start(impl.release()->state);
+		}
+
+		void destroy() noexcept
+		{
+			using traits = typename std::allocator_traits<Alloc>::template rebind_traits<start_detached_impl>;
+			typename traits::allocator_type a {alloc};
+			traits::destroy(a, this);
+			traits::deallocate(a, this, 1);
+		}
 	};
 
 	export
@@ -94,10 +119,17 @@ namespace cmoon::execution
 				}
 				else if constexpr (choice.strategy == state::other)
 				{
-					auto impl {new start_detached_impl<std::decay_t<S>>{std::forward<S>(s)}};
-					execution::start(impl->state);
+					start_detached_impl<std::decay_t<S>, cmoon::recycling_allocator<std::byte>>::start_new(std::forward<S>(s), {});
 				}
 			}
+
+			// Keeps the operation state in memory from alloc, which is also
+			// what the operation gets when it asks its receiver for one.
+			template<sender S, cmoon::allocator Alloc>
+			void operator()(S&& s, const Alloc& alloc) const
+			{
+				start_detached_impl<std::decay_t<S>, Alloc>::start_new(std::forward<S>(s), alloc);
+			}
 	};
 
 	export
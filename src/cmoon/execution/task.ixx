@@ -0,0 +1,601 @@
+export module cmoon.execution.task;
+
+import <cstddef>;
+import <coroutine>;
+import <exception>;
+import <memory>;
+import <new>;
+import <optional>;
+import <type_traits>;
+import <utility>;
+import <variant>;
+import <atomic>;
+import <concepts>;
+
+import cmoon.memory;
+import cmoon.thread;
+
+import cmoon.execution.set_value;
+import cmoon.execution.set_error;
+import cmoon.execution.set_done;
+import cmoon.execution.receiver;
+import cmoon.execution.sender;
+import cmoon.execution.typed_sender;
+import cmoon.execution.connect;
+import cmoon.execution.start;
+import cmoon.execution.get_stop_token;
+
+namespace cmoon::execution
+{
+	// A coroutine frame is allocated with the function that frees it, and
+	// the allocator it is freed with, stored after it.
+	struct task_frame
+	{
+		using deallocate_fn = void (*)(void*, std::size_t) noexcept;
+
+		struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) unit
+		{
+			std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+		};
+
+		[[nodiscard]] static constexpr std::size_t align_up(std::size_t n, std::size_t alignment) noexcept
+		{
+			return (n + alignment - 1) / alignment * alignment;
+		}
+
+		template<class Alloc>
+		struct layout
+		{
+			using traits = typename std::allocator_traits<Alloc>::template rebind_traits<unit>;
+			using allocator_type = typename traits::allocator_type;
+
+			std::size_t fn_offset;
+			std::size_t alloc_offset;
+			std::size_t units;
+
+			constexpr explicit layout(std::size_t size) noexcept
+				: fn_offset{align_up(size, alignof(deallocate_fn))},
+				  alloc_offset{align_up(fn_offset + sizeof(deallocate_fn), alignof(allocator_type))},
+				  units{align_up(alloc_offset + sizeof(allocator_type), sizeof(unit)) / sizeof(unit)} {}
+		};
+
+		template<class Alloc>
+		[[nodiscard]] static void* allocate(std::size_t size, const Alloc& alloc)
+		{
+			using layout_t = layout<Alloc>;
+			const layout_t l {size};
+			typename layout_t::allocator_type a {alloc};
+			const auto p {reinterpret_cast<std::byte*>(std::to_address(layout_t::traits::allocate(a, l.units)))};
+			::new (p + l.fn_offset) deallocate_fn{&deallocate<Alloc>};
+			::new (p + l.alloc_offset) typename layout_t::allocator_type{std::move(a)};
+			return p;
+		}
+
+		template<class Alloc>
+		static void deallocate(void* p, std::size_t size) noexcept
+		{
+			using layout_t = layout<Alloc>;
+			const layout_t l {size};
+			const auto stored {std::launder(reinterpret_cast<typename layout_t::allocator_type*>(static_cast<std::byte*>(p) + l.alloc_offset))};
+			auto a {std::move(*stored)};
+			std::destroy_at(stored);
+			layout_t::traits::deallocate(a, static_cast<unit*>(p), l.units);
+		}
+
+		static void free(void* p, std::size_t size) noexcept
+		{
+			const auto fn {*std::launder(reinterpret_cast<deallocate_fn*>(static_cast<std::byte*>(p) + align_up(size, alignof(deallocate_fn))))};
+			fn(p, size);
+		}
+	};
+
+	struct task_promise_base
+	{
+		// Called when the coroutine has finished. Returns the coroutine to
+		// resume next.
+		std::coroutine_handle<> (*finish)(task_promise_base&) noexcept {nullptr};
+
+		// Called instead when an awaited sender completes with set_done.
+		std::coroutine_handle<> (*stopped)(task_promise_base&) noexcept {nullptr};
+
+		// The task awaiting this one, if any.
+		std::coroutine_handle<> continuation {};
+		task_promise_base* parent {nullptr};
+
+		// The operation state, if this task was connected to a receiver.
+		void* operation {nullptr};
+
+		cmoon::in_place_stop_token stop_token {};
+
+		struct final_awaiter
+		{
+			[[nodiscard]] bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template<class P>
+			[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+			{
+				auto& p {h.promise()};
+				return p.finish(p);
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		[[nodiscard]] std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		[[nodiscard]] final_awaiter final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		template<class S>
+		decltype(auto) await_transform(S&& s);
+
+		// Frames come from a recycling_allocator, unless the coroutine's first
+		// parameters, after the object for a member function, are
+		// std::allocator_arg and an allocator.
+		[[nodiscard]] static void* operator new(std::size_t size)
+		{
+			return task_frame::allocate(size, cmoon::recycling_allocator<std::byte>{});
+		}
+
+		template<class Alloc, class... Args>
+		[[nodiscard]] static void* operator new(std::size_t size, std::allocator_arg_t, const Alloc& alloc, const Args&...)
+		{
+			return task_frame::allocate(size, alloc);
+		}
+
+		template<class Class, class Alloc, class... Args>
+		[[nodiscard]] static void* operator new(std::size_t size, const Class&, std::allocator_arg_t, const Alloc& alloc, const Args&...)
+		{
+			return task_frame::allocate(size, alloc);
+		}
+
+		static void operator delete(void* p, std::size_t size) noexcept
+		{
+			task_frame::free(p, size);
+		}
+
+		[[nodiscard]] static std::coroutine_handle<> resume_parent(task_promise_base& p) noexcept
+		{
+			return p.continuation;
+		}
+
+		[[nodiscard]] static std::coroutine_handle<> stop_parent(task_promise_base& p) noexcept
+		{
+			return p.parent->stopped(*p.parent);
+		}
+	};
+
+	template<class T>
+	using task_result_t = std::variant<std::monostate, std::conditional_t<std::is_void_v<T>, std::monostate, T>, std::exception_ptr>;
+
+	export
+	template<class T = void>
+	class task;
+
+	template<class T>
+	struct task_promise : public task_promise_base
+	{
+		task_result_t<T> result;
+
+		task<T> get_return_object() noexcept;
+
+		template<class U = T>
+			requires(std::convertible_to<U, T>)
+		void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>)
+		{
+			result.template emplace<1>(std::forward<U>(value));
+		}
+
+		void unhandled_exception() noexcept
+		{
+			result.template emplace<2>(std::current_exception());
+		}
+	};
+
+	template<>
+	struct task_promise<void> : public task_promise_base
+	{
+		task_result_t<void> result;
+
+		task<void> get_return_object() noexcept;
+
+		void return_void() noexcept
+		{
+			result.template emplace<1>();
+		}
+
+		void unhandled_exception() noexcept
+		{
+			result.template emplace<2>(std::current_exception());
+		}
+	};
+
+	template<class T, template<class...> class Tuple, template<class...> class Variant>
+	struct task_value_types : std::type_identity<Variant<Tuple<T>>> {};
+
+	template<template<class...> class Tuple, template<class...> class Variant>
+	struct task_value_types<void, Tuple, Variant> : std::type_identity<Variant<Tuple<>>> {};
+
+	struct task_stop_callback
+	{
+		cmoon::in_place_stop_source& stop_src_;
+
+		void operator()() noexcept
+		{
+			stop_src_.request_stop();
+		}
+	};
+
+	template<class T, class R>
+	class task_operation
+	{
+		public:
+			task_operation(std::coroutine_handle<task_promise<T>> coro, R&& r)
+				: coro_{coro}, out_r{std::forward<R>(r)} {}
+
+			task_operation(task_operation&&) = delete;
+
+			~task_operation() noexcept
+			{
+				if (coro_)
+				{
+					coro_.destroy();
+				}
+			}
+
+			friend void tag_invoke(start_t, task_operation& o) noexcept
+			{
+				o.callback_.emplace(execution::get_stop_token(o.out_r), task_stop_callback{o.stop_source_});
+
+				auto& p {o.coro_.promise()};
+				p.operation = &o;
+				p.finish = &task_operation::finish;
+				p.stopped = &task_operation::stopped;
+				p.stop_token = o.stop_source_.get_token();
+				o.coro_.resume();
+			}
+		private:
+			std::coroutine_handle<task_promise<T>> coro_;
+			std::remove_cvref_t<R> out_r;
+			cmoon::in_place_stop_source stop_source_;
+			std::optional<typename stop_token_of_t<std::remove_cvref_t<R>&>::template callback_type<task_stop_callback>> callback_;
+
+			[[nodiscard]] static std::coroutine_handle<> finish(task_promise_base& p) noexcept
+			{
+				auto& o {*static_cast<task_operation*>(p.operation)};
+				o.callback_.reset();
+
+				auto& result {o.coro_.promise().result};
+				if (result.index() == 2)
+				{
+					execution::set_error(std::move(o.out_r), std::move(std::get<2>(result)));
+				}
+				else
+				{
+					try
+					{
+						if constexpr (std::is_void_v<T>)
+						{
+							execution::set_value(std::move(o.out_r));
+						}
+						else
+						{
+							execution::set_value(std::move(o.out_r), std::move(std::get<1>(result)));
+						}
+					}
+					catch (...)
+					{
+						execution::set_error(std::move(o.out_r), std::current_exception());
+					}
+				}
+
+				return std::noop_coroutine();
+			}
+
+			[[nodiscard]] static std::coroutine_handle<> stopped(task_promise_base& p) noexcept
+			{
+				auto& o {*static_cast<task_operation*>(p.operation)};
+				o.callback_.reset();
+				execution::set_done(std::move(o.out_r));
+				return std::noop_coroutine();
+			}
+	};
+
+	// A lazily started coroutine that is also a typed sender. Inside it,
+	// co_await works on any typed sender that sends at most one value; an
+	// error is rethrown as an exception, and set_done stops the task, which
+	// then completes with set_done itself. The coroutine continues on
+	// whichever thread the awaited sender completes on, so awaiting
+	// schedule(sch) or transfer(s, sch) moves the rest of the task onto sch.
+	// Awaiting another task, or a sender that completes inline, resumes by
+	// symmetric transfer, so neither grows the stack.
+	export
+	template<class T>
+	class task
+	{
+		public:
+			using promise_type = task_promise<T>;
+
+			struct awaiter
+			{
+				std::coroutine_handle<promise_type> coro;
+
+				[[nodiscard]] bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				template<std::derived_from<task_promise_base> P>
+				[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept
+				{
+					auto& p {coro.promise()};
+					p.continuation = parent;
+					p.parent = &parent.promise();
+					p.finish = &task_promise_base::resume_parent;
+					p.stopped = &task_promise_base::stop_parent;
+					p.stop_token = parent.promise().stop_token;
+					return coro;
+				}
+
+				T await_resume()
+				{
+					auto& result {coro.promise().result};
+					if (result.index() == 2)
+					{
+						std::rethrow_exception(std::get<2>(result));
+					}
+
+					if constexpr (!std::is_void_v<T>)
+					{
+						return std::move(std::get<1>(result));
+					}
+				}
+			};
+
+			template<template<class...> class Tuple, template<class...> class Variant>
+			using value_types = typename task_value_types<T, Tuple, Variant>::type;
+
+			template<template<class...> class Variant>
+			using error_types = Variant<std::exception_ptr>;
+
+			static constexpr bool sends_done {true};
+
+			task(task&& other) noexcept
+				: coro_{std::exchange(other.coro_, {})} {}
+
+			task& operator=(task&& other) noexcept
+			{
+				if (this != &other)
+				{
+					if (coro_)
+					{
+						coro_.destroy();
+					}
+
+					coro_ = std::exchange(other.coro_, {});
+				}
+
+				return *this;
+			}
+
+			~task() noexcept
+			{
+				if (coro_)
+				{
+					coro_.destroy();
+				}
+			}
+
+			[[nodiscard]] awaiter operator co_await() && noexcept
+			{
+				return awaiter{coro_};
+			}
+
+			template<receiver R>
+			friend task_operation<T, R> tag_invoke(connect_t, task&& t, R&& r)
+			{
+				return {std::exchange(t.coro_, {}), std::forward<R>(r)};
+			}
+		private:
+			std::coroutine_handle<promise_type> coro_;
+
+			explicit task(std::coroutine_handle<promise_type> coro) noexcept
+				: coro_{coro} {}
+
+			friend promise_type;
+	};
+
+	template<class T>
+	task<T> task_promise<T>::get_return_object() noexcept
+	{
+		return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+	}
+
+	inline task<void> task_promise<void>::get_return_object() noexcept
+	{
+		return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+	}
+
+	template<class T>
+	inline constexpr bool is_task {false};
+
+	template<class T>
+	inline constexpr bool is_task<task<T>> {true};
+
+	template<class... Ts>
+	struct single_value;
+
+	template<>
+	struct single_value<> : std::type_identity<void> {};
+
+	template<class T>
+	struct single_value<T> : std::type_identity<T> {};
+
+	template<class... Ts>
+	using single_value_t = typename single_value<Ts...>::type;
+
+	// The type co_await gives for a sender: its single value, or void if it
+	// sends none.
+	template<typed_sender S>
+	using sender_await_result_t = value_types_of_t<S, single_value_t, single_value_t>;
+
+	template<typed_sender S>
+	class sender_awaiter
+	{
+		using value_type = std::decay_t<sender_await_result_t<S>>;
+
+		struct awaiter_receiver
+		{
+			public:
+				sender_awaiter* a;
+
+				template<class... Args>
+				friend void tag_invoke(set_value_t, awaiter_receiver&& r, Args&&... args) noexcept
+				{
+					r.set_value_helper(std::forward<Args>(args)...);
+				}
+
+				template<class E>
+				friend void tag_invoke(set_error_t, awaiter_receiver&& r, E&& e) noexcept
+				{
+					if constexpr (std::same_as<std::remove_cvref_t<E>, std::exception_ptr>)
+					{
+						r.set_error_helper(std::forward<E>(e));
+					}
+					else
+					{
+						r.set_error_helper(std::make_exception_ptr(std::forward<E>(e)));
+					}
+				}
+
+				friend void tag_invoke(set_done_t, awaiter_receiver&& r) noexcept
+				{
+					r.set_done_helper();
+				}
+
+				friend cmoon::in_place_stop_token tag_invoke(get_stop_token_t, const awaiter_receiver& r) noexcept
+				{
+					return r.get_stop_token_helper();
+				}
+			private:
+				template<class... Args>
+				void set_value_helper(Args&&... args) noexcept
+				{
+					try
+					{
+						a->result_.template emplace<1>(std::forward<Args>(args)...);
+					}
+					catch (...)
+					{
+						a->result_.template emplace<2>(std::current_exception());
+					}
+
+					a->complete();
+				}
+
+				void set_error_helper(std::exception_ptr e) noexcept
+				{
+					a->result_.template emplace<2>(std::move(e));
+					a->complete();
+				}
+
+				void set_done_helper() noexcept
+				{
+					a->done_ = true;
+					a->complete();
+				}
+
+				[[nodiscard]] cmoon::in_place_stop_token get_stop_token_helper() const noexcept
+				{
+					return a->promise_->stop_token;
+				}
+		};
+
+		public:
+			sender_awaiter(S&& s, task_promise_base& p)
+				: promise_{&p},
+				  op_{execution::connect(std::forward<S>(s), awaiter_receiver{this})} {}
+
+			sender_awaiter(sender_awaiter&&) = delete;
+
+			[[nodiscard]] bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			// If the sender completes before start returns, the coroutine
+			// carries on from here instead of being resumed inside start.
+			[[nodiscard]] bool await_suspend(std::coroutine_handle<> h) noexcept
+			{
+				continuation_ = h;
+				execution::start(op_);
+				if (ready_.exchange(true, std::memory_order_acq_rel))
+				{
+					if (!done_)
+					{
+						return false;
+					}
+
+					promise_->stopped(*promise_).resume();
+				}
+
+				return true;
+			}
+
+			value_type await_resume()
+			{
+				if (result_.index() == 2)
+				{
+					std::rethrow_exception(std::get<2>(result_));
+				}
+
+				if constexpr (!std::is_void_v<value_type>)
+				{
+					return std::move(std::get<1>(result_));
+				}
+			}
+		private:
+			task_promise_base* promise_;
+			std::coroutine_handle<> continuation_ {};
+			task_result_t<value_type> result_ {};
+			bool done_ {false};
+			std::atomic<bool> ready_ {false};
+			connect_result_t<S, awaiter_receiver> op_;
+
+			void complete() noexcept
+			{
+				if (ready_.exchange(true, std::memory_order_acq_rel))
+				{
+					if (done_)
+					{
+						promise_->stopped(*promise_).resume();
+					}
+					else
+					{
+						continuation_.resume();
+					}
+				}
+			}
+	};
+
+	template<class S>
+	decltype(auto) task_promise_base::await_transform(S&& s)
+	{
+		if constexpr (typed_sender<S> && !is_task<std::remove_cvref_t<S>>)
+		{
+			return sender_awaiter<S>{std::forward<S>(s), *this};
+		}
+		else
+		{
+			return std::forward<S>(s);
+		}
+	}
+}
\ No newline at end of file
@@ -170,6 +170,13 @@ namespace cmoon::execution
 			{
 				return execution::connect(std::move(s.s_), then_receiver<R, F>{std::forward<R>(out_r), std::move(s.f_)});
 			}
+
+			// f runs where the predecessor sends its values, and so does this.
+			friend decltype(auto) tag_invoke(get_completion_scheduler_t<set_value_t> t, const then_sender& s) noexcept
+				requires(requires(const S& p) { get_completion_scheduler<set_value_t>(p); })
+			{
+				return t(s.s_);
+			}
 		private:
 			S s_;
 			F f_;
@@ -0,0 +1,24 @@
+export module cmoon.execution.time_scheduler;
+
+import <concepts>;
+import <type_traits>;
+
+import cmoon.execution.scheduler;
+import cmoon.execution.now;
+import cmoon.execution.schedule_at;
+import cmoon.execution.schedule_after;
+
+namespace cmoon::execution
+{
+	// A scheduler that can also start work at, or after, a point in time
+	// on its own clock.
+	export
+	template<class S>
+	concept time_scheduler = scheduler<S> &&
+		requires(S&& s)
+	{
+		execution::now(s);
+		execution::schedule_at(std::forward<S>(s), execution::now(s));
+		execution::schedule_after(std::forward<S>(s), execution::now(s) - execution::now(s));
+	};
+}
\ No newline at end of file
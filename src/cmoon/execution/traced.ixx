@@ -0,0 +1,160 @@
+export module cmoon.execution.traced;
+
+import <utility>;
+import <type_traits>;
+import <functional>;
+import <chrono>;
+
+import cmoon.meta;
+import cmoon.functional;
+
+import cmoon.execution.receiver;
+import cmoon.execution.set_value;
+import cmoon.execution.set_error;
+import cmoon.execution.set_done;
+import cmoon.execution.sender;
+import cmoon.execution.typed_sender;
+import cmoon.execution.sender_traits;
+import cmoon.execution.connect;
+import cmoon.execution.start;
+import cmoon.execution.get_stop_token;
+import cmoon.execution.sender_adapter;
+import cmoon.execution.tracer;
+
+namespace cmoon::execution
+{
+	template<class S, class R>
+	class traced_operation
+	{
+		struct traced_receiver
+		{
+			public:
+				traced_operation* op;
+
+				template<class... Args>
+				friend void tag_invoke(set_value_t, traced_receiver&& r, Args&&... args) noexcept(cmoon::nothrow_tag_invocable<set_value_t, R, Args...>)
+				{
+					execution::set_value(r.complete_helper(), std::forward<Args>(args)...);
+				}
+
+				template<class E>
+				friend void tag_invoke(set_error_t, traced_receiver&& r, E&& e) noexcept
+				{
+					execution::set_error(r.complete_helper(), std::forward<E>(e));
+				}
+
+				friend void tag_invoke(set_done_t, traced_receiver&& r) noexcept
+				{
+					execution::set_done(r.complete_helper());
+				}
+
+				friend auto tag_invoke(get_stop_token_t, const traced_receiver& r) noexcept
+				{
+					return r.get_stop_token_helper();
+				}
+			private:
+				[[nodiscard]] std::remove_cvref_t<R>&& complete_helper() const noexcept
+				{
+					op->tracer_.get().record(op->name_, op->started_, op->started_, tracer::clock::now());
+					return std::move(op->out_r);
+				}
+
+				[[nodiscard]] auto get_stop_token_helper() const noexcept
+				{
+					return execution::get_stop_token(op->out_r);
+				}
+		};
+
+		public:
+			traced_operation(S&& s, R&& r, tracer& t, const char* name)
+				: out_r{std::forward<R>(r)}, tracer_{t}, name_{name},
+				  op_{execution::connect(std::forward<S>(s), traced_receiver{this})} {}
+
+			traced_operation(traced_operation&&) = delete;
+
+			friend void tag_invoke(start_t, traced_operation& o) noexcept
+			{
+				o.started_ = tracer::clock::now();
+				execution::start(o.op_);
+			}
+		private:
+			std::remove_cvref_t<R> out_r;
+			std::reference_wrapper<tracer> tracer_;
+			const char* name_;
+			tracer::clock::time_point started_ {};
+			connect_result_t<S, traced_receiver> op_;
+	};
+
+	template<typed_sender S>
+	struct traced_sender
+	{
+		public:
+			template<template<class...> class Tuple, template<class...> class Variant>
+			using value_types = value_types_of_t<S, Tuple, Variant>;
+
+			template<template<class...> class Variant>
+			using error_types = error_types_of_t<S, Variant>;
+
+			static constexpr bool sends_done {sender_traits<std::remove_cvref_t<S>>::sends_done};
+
+			constexpr traced_sender(S&& s, tracer& t, const char* name)
+				: s_{std::forward<S>(s)}, tracer_{t}, name_{name} {}
+
+			template<receiver R>
+			friend traced_operation<S, R> tag_invoke(connect_t, traced_sender&& s, R&& out_r)
+			{
+				return {std::move(s.s_), std::forward<R>(out_r), s.tracer_.get(), s.name_};
+			}
+		private:
+			S s_;
+			std::reference_wrapper<tracer> tracer_;
+			const char* name_;
+	};
+
+	// Records, under name, how long each operation of s takes from being
+	// started to completing on any channel.
+	export
+	struct traced_t
+	{
+		private:
+			enum class state { tag_invoke_fn, other };
+
+			template<class S>
+			[[nodiscard]] static consteval cmoon::meta::choice_t<state> choose() noexcept
+			{
+				if constexpr (requires(traced_t t, S&& s, tracer& tr, const char* name) {
+					{ tag_invoke(t, std::forward<S>(s), tr, name) } -> sender;
+				})
+				{
+					return {state::tag_invoke_fn, cmoon::nothrow_tag_invocable<traced_t, S, tracer&, const char*>};
+				}
+				else
+				{
+					return {state::other, std::is_nothrow_constructible_v<traced_sender<S>, S, tracer&, const char*>};
+				}
+			}
+		public:
+			template<typed_sender S>
+			constexpr decltype(auto) operator()(S&& s, tracer& t, const char* name) const noexcept(choose<S>().no_throw)
+			{
+				constexpr auto choice {choose<S>()};
+
+				if constexpr (choice.strategy == state::tag_invoke_fn)
+				{
+					return tag_invoke(*this, std::forward<S>(s), t, name);
+				}
+				else if constexpr (choice.strategy == state::other)
+				{
+					return traced_sender<S>{std::forward<S>(s), t, name};
+				}
+			}
+
+			constexpr auto operator()(tracer& t, const char* name) const
+			{
+				return sender_adapter<traced_t, std::reference_wrapper<tracer>, const char*>{std::ref(t), std::move(name)};
+			}
+	};
+
+	export
+	inline constexpr traced_t traced{};
+}
\ No newline at end of file
@@ -0,0 +1,392 @@
+export module cmoon.execution.tracer;
+
+import <atomic>;
+import <chrono>;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <mutex>;
+import <vector>;
+import <thread>;
+import <ostream>;
+import <string>;
+import <string_view>;
+import <map>;
+import <algorithm>;
+import <array>;
+import <bit>;
+import <format>;
+
+import cmoon.json;
+
+namespace cmoon::execution
+{
+	export
+	struct trace_record
+	{
+		const char* name {""};
+
+		// Numbered in the order threads first recorded to the tracer.
+		std::size_t thread {0};
+
+		std::chrono::steady_clock::time_point enqueued {};
+		std::chrono::steady_clock::time_point started {};
+		std::chrono::steady_clock::time_point completed {};
+
+		[[nodiscard]] std::chrono::nanoseconds queue_time() const noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(started - enqueued);
+		}
+
+		[[nodiscard]] std::chrono::nanoseconds run_time() const noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(completed - started);
+		}
+	};
+
+	// Counts durations in power of two buckets of nanoseconds. Bucket 0 holds
+	// 0ns and bucket i holds [2^(i-1), 2^i) ns.
+	export
+	class latency_histogram
+	{
+		public:
+			static constexpr std::size_t bucket_count {65};
+
+			void add(std::chrono::nanoseconds d) noexcept
+			{
+				const auto ns {static_cast<std::uint64_t>(std::max(d.count(), std::chrono::nanoseconds::rep{0}))};
+				++buckets_[std::bit_width(ns)];
+				if (count_ == 0 || ns < min_)
+				{
+					min_ = ns;
+				}
+
+				max_ = std::max(max_, ns);
+				total_ += ns;
+				++count_;
+			}
+
+			[[nodiscard]] std::size_t count() const noexcept
+			{
+				return count_;
+			}
+
+			[[nodiscard]] std::size_t bucket(std::size_t i) const noexcept
+			{
+				return buckets_[i];
+			}
+
+			[[nodiscard]] static constexpr std::chrono::nanoseconds bucket_lower(std::size_t i) noexcept
+			{
+				return std::chrono::nanoseconds{i == 0 ? 0 : static_cast<std::chrono::nanoseconds::rep>(std::uint64_t{1} << (i - 1))};
+			}
+
+			[[nodiscard]] std::chrono::nanoseconds min() const noexcept
+			{
+				return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(min_)};
+			}
+
+			[[nodiscard]] std::chrono::nanoseconds max() const noexcept
+			{
+				return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(max_)};
+			}
+
+			[[nodiscard]] std::chrono::nanoseconds mean() const noexcept
+			{
+				return std::chrono::nanoseconds{count_ == 0 ? 0 : static_cast<std::chrono::nanoseconds::rep>(total_ / count_)};
+			}
+
+			// The upper bound of the bucket holding the given fraction of the
+			// durations, so within a factor of two of the exact value.
+			[[nodiscard]] std::chrono::nanoseconds percentile(double p) const noexcept
+			{
+				if (count_ == 0)
+				{
+					return std::chrono::nanoseconds{0};
+				}
+
+				const auto rank {static_cast<std::size_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count_ - 1)) + 1};
+				std::size_t seen {0};
+				for (std::size_t i {0}; i < bucket_count; ++i)
+				{
+					seen += buckets_[i];
+					if (seen >= rank)
+					{
+						const auto upper {i == 0 ? std::uint64_t{0} : i == 64 ? max_ : (std::uint64_t{1} << i) - 1};
+						return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(std::clamp(upper, min_, max_))};
+					}
+				}
+
+				return max();
+			}
+		private:
+			std::array<std::size_t, bucket_count> buckets_ {};
+			std::size_t count_ {0};
+			std::uint64_t min_ {0};
+			std::uint64_t max_ {0};
+			std::uint64_t total_ {0};
+	};
+
+	export
+	struct trace_summary
+	{
+		std::string name;
+		latency_histogram queue_time;
+		latency_histogram run_time;
+	};
+
+	// Collects trace_records from any number of threads. Each thread records
+	// into a ring buffer of its own without taking a lock, and once it has
+	// filled it the thread's oldest records are overwritten. Reading the
+	// records while threads are still recording is safe; a record caught
+	// half written is skipped.
+	//
+	// Nothing is traced unless a tracer is handed to a thread pool, or to
+	// traced, and nothing is timed when none is.
+	export
+	class tracer
+	{
+		public:
+			using clock = std::chrono::steady_clock;
+
+			explicit tracer(std::size_t capacity = 16384)
+				: capacity_{std::max(capacity, std::size_t{1})} {}
+
+			tracer(const tracer&) = delete;
+			tracer& operator=(const tracer&) = delete;
+
+			// name must outlive the tracer.
+			void record(const char* name, clock::time_point enqueued, clock::time_point started, clock::time_point completed) noexcept
+			{
+				ring* r;
+				try
+				{
+					r = local_ring();
+				}
+				catch (...)
+				{
+					lost_.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				const auto i {r->head.load(std::memory_order_relaxed)};
+				auto& s {r->slots[i % capacity_]};
+				s.sequence.store(2 * i + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				s.name.store(name, std::memory_order_relaxed);
+				s.enqueued.store(enqueued.time_since_epoch().count(), std::memory_order_relaxed);
+				s.started.store(started.time_since_epoch().count(), std::memory_order_relaxed);
+				s.completed.store(completed.time_since_epoch().count(), std::memory_order_relaxed);
+				s.sequence.store(2 * i + 2, std::memory_order_release);
+				r->head.store(i + 1, std::memory_order_release);
+			}
+
+			// Every record still held, ordered by when it started.
+			[[nodiscard]] std::vector<trace_record> records() const
+			{
+				std::vector<trace_record> out;
+				std::lock_guard l {rings_mut_};
+				for (const auto& r : rings_)
+				{
+					const auto head {r->head.load(std::memory_order_acquire)};
+					for (auto i {head > capacity_ ? head - capacity_ : 0}; i < head; ++i)
+					{
+						const auto& s {r->slots[i % capacity_]};
+						const auto before {s.sequence.load(std::memory_order_acquire)};
+						if (before != 2 * i + 2)
+						{
+							continue;
+						}
+
+						trace_record rec {
+							s.name.load(std::memory_order_relaxed),
+							r->index,
+							clock::time_point{clock::duration{s.enqueued.load(std::memory_order_relaxed)}},
+							clock::time_point{clock::duration{s.started.load(std::memory_order_relaxed)}},
+							clock::time_point{clock::duration{s.completed.load(std::memory_order_relaxed)}}
+						};
+
+						std::atomic_thread_fence(std::memory_order_acquire);
+						if (s.sequence.load(std::memory_order_relaxed) == before)
+						{
+							out.push_back(rec);
+						}
+					}
+				}
+
+				std::ranges::sort(out, {}, &trace_record::started);
+				return out;
+			}
+
+			// Records overwritten before they were read, or never stored
+			// because a ring could not be allocated.
+			[[nodiscard]] std::uint64_t dropped() const noexcept
+			{
+				std::uint64_t total {lost_.load(std::memory_order_relaxed)};
+				std::lock_guard l {rings_mut_};
+				for (const auto& r : rings_)
+				{
+					const auto head {r->head.load(std::memory_order_relaxed)};
+					total += head > capacity_ ? head - capacity_ : 0;
+				}
+
+				return total;
+			}
+
+			// One summary per distinct name, in name order.
+			[[nodiscard]] std::vector<trace_summary> summarize() const
+			{
+				std::map<std::string_view, trace_summary> by_name;
+				for (const auto& rec : records())
+				{
+					auto& s {by_name[rec.name]};
+					s.queue_time.add(rec.queue_time());
+					s.run_time.add(rec.run_time());
+				}
+
+				std::vector<trace_summary> out;
+				out.reserve(std::size(by_name));
+				for (auto& [name, s] : by_name)
+				{
+					s.name = name;
+					out.push_back(std::move(s));
+				}
+
+				return out;
+			}
+
+			// Writes the records in the Chrome trace event format, which
+			// chrome://tracing and Perfetto open. Each record is a complete
+			// event on the thread that ran it, and time spent queued is an
+			// async event of its own.
+			void write_chrome_trace(std::ostream& os) const
+			{
+				const auto recs {records()};
+				cmoon::json::json_outputter<> out {os};
+				const auto micros = [this](clock::time_point t) {
+					return std::chrono::duration<double, std::micro>{t - epoch_}.count();
+				};
+
+				os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+				for (std::size_t i {0}; i < std::size(recs); ++i)
+				{
+					const auto& rec {recs[i]};
+					const std::string name {rec.name};
+
+					os << (i == 0 ? "\n" : ",\n") << "{\"name\": ";
+					out(name);
+					os << std::format(", \"cat\": \"run\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+									  rec.thread, micros(rec.started), std::chrono::duration<double, std::micro>{rec.run_time()}.count());
+
+					if (rec.enqueued < rec.started)
+					{
+						for (const auto [phase, t] : {std::pair{'b', rec.enqueued}, std::pair{'e', rec.started}})
+						{
+							os << ",\n{\"name\": ";
+							out(name);
+							os << std::format(", \"cat\": \"queue\", \"ph\": \"{}\", \"id\": {}, \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}}}",
+											  phase, i, rec.thread, micros(t));
+						}
+					}
+				}
+
+				os << "\n]}\n";
+			}
+
+			// A table of percentiles per name, followed by the histograms
+			// they were taken from. Times are in microseconds.
+			void write_summary(std::ostream& os) const
+			{
+				const auto summaries {summarize()};
+				const auto micros = [](std::chrono::nanoseconds d) {
+					return std::chrono::duration<double, std::micro>{d}.count();
+				};
+
+				os << std::format("{:<32} {:>10} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}\n",
+								  "name", "count", "queue p50", "queue p99", "queue max", "run p50", "run p99", "run max");
+				for (const auto& s : summaries)
+				{
+					os << std::format("{:<32} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n",
+									  s.name, s.run_time.count(),
+									  micros(s.queue_time.percentile(0.5)), micros(s.queue_time.percentile(0.99)), micros(s.queue_time.max()),
+									  micros(s.run_time.percentile(0.5)), micros(s.run_time.percentile(0.99)), micros(s.run_time.max()));
+				}
+
+				for (const auto& s : summaries)
+				{
+					for (const auto [label, h] : {std::pair{"queue", &s.queue_time}, std::pair{"run", &s.run_time}})
+					{
+						os << std::format("\n{} {}\n", s.name, label);
+						for (std::size_t i {0}; i < latency_histogram::bucket_count; ++i)
+						{
+							if (h->bucket(i) != 0)
+							{
+								os << std::format("  >= {:>14.3f} {:>10}\n", micros(latency_histogram::bucket_lower(i)), h->bucket(i));
+							}
+						}
+					}
+				}
+
+				if (const auto d {dropped()}; d != 0)
+				{
+					os << std::format("\n{} records dropped\n", d);
+				}
+			}
+		private:
+			struct slot
+			{
+				std::atomic<std::uint64_t> sequence {0};
+				std::atomic<const char*> name {""};
+				std::atomic<clock::rep> enqueued {0};
+				std::atomic<clock::rep> started {0};
+				std::atomic<clock::rep> completed {0};
+			};
+
+			struct ring
+			{
+				std::thread::id owner;
+				std::size_t index;
+				std::unique_ptr<slot[]> slots;
+				std::atomic<std::uint64_t> head {0};
+			};
+
+			// The ring the calling thread last recorded into, and the tracer
+			// it belongs to.
+			struct cached_ring
+			{
+				std::uint64_t owner;
+				ring* r;
+			};
+
+			static inline std::atomic<std::uint64_t> next_id_ {1};
+			static thread_local inline cached_ring cache_ {};
+
+			std::size_t capacity_;
+			std::uint64_t id_ {next_id_.fetch_add(1, std::memory_order_relaxed)};
+			clock::time_point epoch_ {clock::now()};
+			std::atomic<std::uint64_t> lost_ {0};
+			mutable std::mutex rings_mut_;
+			std::vector<std::unique_ptr<ring>> rings_;
+
+			[[nodiscard]] ring* local_ring()
+			{
+				if (cache_.owner == id_)
+				{
+					return cache_.r;
+				}
+
+				const auto self {std::this_thread::get_id()};
+				std::lock_guard l {rings_mut_};
+				auto it {std::ranges::find(rings_, self, [](const auto& r) { return r->owner; })};
+				if (it == std::end(rings_))
+				{
+					auto r {std::make_unique<ring>(self, std::size(rings_), std::make_unique<slot[]>(capacity_))};
+					rings_.push_back(std::move(r));
+					it = std::prev(std::end(rings_));
+				}
+
+				cache_ = {id_, it->get()};
+				return cache_.r;
+			}
+	};
+}
\ No newline at end of file
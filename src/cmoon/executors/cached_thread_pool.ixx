@@ -1,5 +1,6 @@
 export module cmoon.executors.cached_thread_pool;
 
+import <cstddef>;
 import <atomic>;
 import <vector>;
 import <type_traits>;
@@ -9,10 +10,16 @@ import <mutex>;
 import <condition_variable>;
 import <chrono>;
 import <algorithm>;
-import <latch>;
+import <limits>;
+import <memory>;
+import <functional>;
+import <exception>;
+import <optional>;
 
 import cmoon.execution;
-import cmoon.intrusive_queue;
+
+import cmoon.executors.queue_full;
+import cmoon.executors.task_lanes;
 
 namespace cmoon::executors
 {
@@ -26,8 +33,61 @@ namespace cmoon::executors
 	{
 		task_base* next;
 		void (*execute)(task_base*) noexcept;
+		cmoon::executors::lane_hook<task_base> hook;
+		const char* name;
+
+		// Only set when the pool is traced.
+		std::chrono::steady_clock::time_point enqueued {};
+	};
+
+	// What starting work on a cached_thread_pool does when its queue is
+	// already holding max_queued tasks.
+	export
+	enum class overflow_policy
+	{
+		// Wait for a thread to take a task off the queue.
+		block,
+
+		// Complete the operation with set_error(queue_full).
+		reject,
+
+		// Run the task on the thread that started it.
+		run_inline
+	};
+
+	export
+	struct cached_thread_pool_options
+	{
+		// Started up front and kept however long they sit idle.
+		std::size_t min_threads {0};
+
+		std::size_t max_threads {std::numeric_limits<std::size_t>::max()};
+
+		// A new thread is only started once this many queued tasks are left
+		// over after every idle thread has taken one, so a short burst is
+		// absorbed by the threads there are rather than each task starting
+		// a thread of its own.
+		std::size_t spawn_backlog {1};
+
+		std::size_t max_queued {std::numeric_limits<std::size_t>::max()};
+		overflow_policy overflow {overflow_policy::block};
+
+		// Threads above min_threads exit after idling this long.
+		std::chrono::nanoseconds idle_timeout {std::chrono::seconds{60}};
+
+		// How long the oldest task of a lane may wait before it is served
+		// ahead of the lanes that would otherwise come first.
+		std::chrono::steady_clock::duration starvation_limit {std::chrono::milliseconds{100}};
+
+		// Records when each task is queued, started and finished. Left null,
+		// the pool reads no clocks.
+		cmoon::execution::tracer* tracer {nullptr};
 	};
 
+	// Starts threads as work arrives and lets them go again once they have
+	// been idle for a while. The thread counts are atomics kept alongside
+	// the queue under its one lock, so running a task takes no lock of its
+	// own and the counts can be read without one.
 	export
 	class cached_thread_pool
 	{
@@ -38,6 +98,7 @@ namespace cmoon::executors
 				struct bulk_sender_t
 				{
 					cached_thread_pool& pool_;
+					task_lane lane_;
 					Shape shape_;
 					F f_;
 
@@ -52,19 +113,20 @@ namespace cmoon::executors
 					template<cmoon::execution::receiver R>
 					friend bulk_operation<std::decay_t<R>, Shape, std::decay_t<F>> tag_invoke(cmoon::execution::connect_t, cached_thread_pool::scheduler_t::bulk_sender_t<Shape, F>&& s, R&& r)
 					{
-						return {s.pool_, std::forward<R>(r), s.shape_, std::move(s.f_)};
+						return {s.pool_, s.lane_, std::forward<R>(r), s.shape_, std::move(s.f_)};
 					}
 
 					template<class CPO>
 					friend cached_thread_pool::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, cached_thread_pool::scheduler_t::bulk_sender_t<Shape, F>& s) noexcept
 					{
-						return {std::addressof(s.pool_)};
+						return {std::addressof(s.pool_), s.lane_};
 					}
 				};
 
 				struct sender_t
 				{
 					cached_thread_pool& pool_;
+					task_lane lane_;
 
 					template<template<class...> class Tuple, template<class...> class Variant>
 					using value_types = Variant<Tuple<>>;
@@ -77,27 +139,52 @@ namespace cmoon::executors
 					template<cmoon::execution::receiver R>
 					friend operation<std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, cached_thread_pool::scheduler_t::sender_t s, R&& r) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<R>, R>)
 					{
-						return {s.pool_, std::forward<R>(r)};
+						return {s.pool_, s.lane_, std::forward<R>(r)};
 					}
 
 					template<std::integral Shape, class F>
 					friend cached_thread_pool::scheduler_t::bulk_sender_t<Shape, std::decay_t<F>> tag_invoke(cmoon::execution::bulk_t, cached_thread_pool::scheduler_t::sender_t s, Shape shape, F&& f) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F>)
 					{
-						return {s.pool_, shape, std::forward<F>(f)};
+						return {s.pool_, s.lane_, shape, std::forward<F>(f)};
 					}
 
 					template<class CPO>
 					friend cached_thread_pool::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, cached_thread_pool::scheduler_t::sender_t s) noexcept
 					{
-						return {std::addressof(s.pool_)};
+						return {std::addressof(s.pool_), s.lane_};
 					}
 				};
 
 				cached_thread_pool* pool_;
+				task_lane lane_ {};
+
+				[[nodiscard]] scheduler_t require(priority_t p) const noexcept
+				{
+					auto s {*this};
+					s.lane_.priority = p.value;
+					return s;
+				}
+
+				[[nodiscard]] scheduler_t require(deadline_t d) const noexcept
+				{
+					auto s {*this};
+					s.lane_.deadline = d.value;
+					return s;
+				}
+
+				[[nodiscard]] task_priority query(priority_t) const noexcept
+				{
+					return lane_.priority;
+				}
+
+				[[nodiscard]] std::optional<std::chrono::steady_clock::duration> query(deadline_t) const noexcept
+				{
+					return lane_.deadline;
+				}
 
 				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_t, cached_thread_pool::scheduler_t t) noexcept
 				{
-					return {*t.pool_};
+					return {*t.pool_, t.lane_};
 				}
 
 				[[nodiscard]] friend cmoon::execution::forward_progress_guarantee tag_invoke(cmoon::execution::get_forward_progress_guarantee_t, cached_thread_pool::scheduler_t) noexcept
@@ -110,7 +197,34 @@ namespace cmoon::executors
 			};
 
 			cached_thread_pool(const std::chrono::nanoseconds& timeout = std::chrono::seconds{60}) noexcept
-				: timeout_{timeout} {}
+				: cached_thread_pool{cached_thread_pool_options{.idle_timeout = timeout}} {}
+
+			explicit cached_thread_pool(const cached_thread_pool_options& options)
+				: timeout_{options.idle_timeout},
+				  max_threads_{std::max(options.max_threads, std::size_t{1})},
+				  min_threads_{std::min(options.min_threads, max_threads_)},
+				  spawn_backlog_{std::max(options.spawn_backlog, std::size_t{1})},
+				  max_queued_{options.max_queued},
+				  overflow_{options.overflow},
+				  queue_{options.starvation_limit},
+				  tracer_{options.tracer}
+			{
+				try
+				{
+					for (std::size_t i {0}; i < min_threads_; ++i)
+					{
+						num_threads_.fetch_add(1, std::memory_order_relaxed);
+						spawn();
+					}
+				}
+				catch (...)
+				{
+					num_threads_.fetch_sub(1, std::memory_order_relaxed);
+					request_stop();
+					join();
+					throw;
+				}
+			}
 
 			cached_thread_pool(const cached_thread_pool&) = delete;
 			cached_thread_pool(cached_thread_pool&&) = default;
@@ -129,16 +243,13 @@ namespace cmoon::executors
 				std::lock_guard s {jobs_mut_};
 				stop_requested_ = true;
 				jobs_cv_.notify_all();
+				space_cv_.notify_all();
 			}
 
 			void join() noexcept
 			{
-				auto n {num_threads.load(std::memory_order_relaxed)};
-				while (n != 0)
-				{
-					num_threads.wait(n);
-					n = num_threads.load(std::memory_order_relaxed);
-				}
+				std::unique_lock l {exit_mut_};
+				exit_cv_.wait(l, [this] { return running_ == 0; });
 			}
 
 			[[nodiscard]] scheduler_t get_scheduler() noexcept
@@ -155,15 +266,76 @@ namespace cmoon::executors
 			{
 				timeout_.store(t, std::memory_order_relaxed);
 			}
+
+			[[nodiscard]] std::size_t thread_count() const noexcept
+			{
+				return num_threads_.load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] std::size_t idle_thread_count() const noexcept
+			{
+				return idle_threads_.load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] std::size_t busy_thread_count() const noexcept
+			{
+				const auto threads {thread_count()};
+				return threads - std::min(idle_thread_count(), threads);
+			}
+
+			[[nodiscard]] std::size_t queued() const noexcept
+			{
+				return queued_.load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] std::size_t max_threads() const noexcept
+			{
+				return max_threads_;
+			}
+
+			[[nodiscard]] std::size_t max_queued() const noexcept
+			{
+				return max_queued_;
+			}
+
+			[[nodiscard]] lane_stats stats(task_priority p)
+			{
+				std::lock_guard l {jobs_mut_};
+				return queue_.stats(p);
+			}
+
+			[[nodiscard]] lane_stats deadline_stats()
+			{
+				std::lock_guard l {jobs_mut_};
+				return queue_.deadline_stats();
+			}
 		private:
 			std::atomic<std::chrono::nanoseconds> timeout_;
+			std::size_t max_threads_;
+			std::size_t min_threads_;
+			std::size_t spawn_backlog_;
+			std::size_t max_queued_;
+			overflow_policy overflow_;
 			std::mutex jobs_mut_;
-			std::mutex threads_mut_;
 			std::condition_variable jobs_cv_;
-			cmoon::intrusive_queue<&task_base::next> queue_;
-			std::atomic<std::size_t> num_threads{0};
-			std::size_t busy_threads{0};
-			bool stop_requested_{false};
+			std::condition_variable space_cv_;
+			task_lanes<task_base> queue_;
+			cmoon::execution::tracer* tracer_;
+
+			// Only written with jobs_mut_ held.
+			std::atomic<std::size_t> num_threads_ {0};
+			std::atomic<std::size_t> idle_threads_ {0};
+			std::atomic<std::size_t> queued_ {0};
+
+			// Threads that have yet to return, which join waits on. A thread
+			// leaves num_threads_ while it still holds jobs_mut_, and leaves
+			// this, and notifies, while holding exit_mut_, so join cannot
+			// return and let the pool be destroyed until the thread is done
+			// with both.
+			std::mutex exit_mut_;
+			std::condition_variable exit_cv_;
+			std::size_t running_ {0};
+			bool stop_requested_ {false};
 
 			template<cmoon::execution::receiver R>
 			friend struct operation;
@@ -171,72 +343,174 @@ namespace cmoon::executors
 			template<cmoon::execution::receiver R, std::integral Shape, class F>
 			friend struct bulk_operation;
 
-			[[nodiscard]] std::size_t available_threads() const noexcept
+			// The caller has already counted the thread in num_threads_.
+			void spawn()
 			{
-				return num_threads - busy_threads;
+				{
+					std::lock_guard l {exit_mut_};
+					++running_;
+				}
+
+				try
+				{
+					std::thread{&cached_thread_pool::thread_loop, this}.detach();
+				}
+				catch (...)
+				{
+					std::lock_guard l {exit_mut_};
+					--running_;
+					throw;
+				}
 			}
 
-			void enqueue(task_base* task) noexcept
+			// Returns false if the task was rejected, in which case it has
+			// not run and never will.
+			[[nodiscard]] bool enqueue(task_base* task) noexcept
 			{
+				if (tracer_ != nullptr)
+				{
+					task->enqueued = cmoon::execution::tracer::clock::now();
+				}
+
+				std::unique_lock l {jobs_mut_};
+				while (queued_.load(std::memory_order_relaxed) >= max_queued_)
 				{
-					std::unique_lock l {threads_mut_};
-					if (available_threads() == 0)
+					switch (overflow_)
 					{
-						++num_threads;
-						++busy_threads;
-						std::thread{&cached_thread_pool::thread_loop, this, task}.detach();
-						return;
+						case overflow_policy::reject:
+							return false;
+						case overflow_policy::run_inline:
+							l.unlock();
+							run(task);
+							return true;
+						case overflow_policy::block:
+							space_cv_.wait(l);
+							break;
 					}
 				}
 
-				std::lock_guard l{jobs_mut_};
-				const auto was_empty {queue_.empty()};
 				queue_.push_back(task);
-				if (was_empty)
+				const auto queued {queued_.load(std::memory_order_relaxed) + 1};
+				queued_.store(queued, std::memory_order_relaxed);
+
+				const auto idle {idle_threads_.load(std::memory_order_relaxed)};
+				if (idle != 0)
 				{
 					jobs_cv_.notify_one();
 				}
+
+				const auto threads {num_threads_.load(std::memory_order_relaxed)};
+				const auto backlog {queued - std::min(queued, idle)};
+				if (threads >= max_threads_ || (threads != 0 && backlog < spawn_backlog_))
+				{
+					return true;
+				}
+
+				num_threads_.store(threads + 1, std::memory_order_relaxed);
+				l.unlock();
+
+				try
+				{
+					spawn();
+				}
+				catch (...)
+				{
+					l.lock();
+					num_threads_.fetch_sub(1, std::memory_order_relaxed);
+					if (num_threads_.load(std::memory_order_relaxed) == 0)
+					{
+						// Nothing is left to take the queue, so whoever
+						// queued last runs it.
+						l.unlock();
+						while ((task = try_dequeue()) != nullptr)
+						{
+							run(task);
+						}
+					}
+				}
+
+				return true;
 			}
 
-			task_base* dequeue()
+			task_base* pop() noexcept
 			{
-				std::unique_lock l{jobs_mut_};
-				while (queue_.empty())
+				const auto task {queue_.pop_front()};
+				queued_.store(queued_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+				if (max_queued_ != std::numeric_limits<std::size_t>::max())
 				{
-					if (stop_requested_)
+					space_cv_.notify_one();
+				}
+
+				return task;
+			}
+
+			task_base* try_dequeue() noexcept
+			{
+				std::lock_guard l {jobs_mut_};
+				return queue_.empty() ? nullptr : pop();
+			}
+
+			// Returns nullptr once the thread should exit, having already
+			// taken it out of num_threads_.
+			task_base* dequeue() noexcept
+			{
+				std::unique_lock l {jobs_mut_};
+				if (queue_.empty())
+				{
+					idle_threads_.fetch_add(1, std::memory_order_relaxed);
+					while (queue_.empty() && !stop_requested_)
 					{
-						return nullptr;
+						if (num_threads_.load(std::memory_order_relaxed) <= min_threads_)
+						{
+							jobs_cv_.wait(l);
+						}
+						else if (jobs_cv_.wait_for(l, timeout_.load(std::memory_order_relaxed)) == std::cv_status::timeout &&
+								 num_threads_.load(std::memory_order_relaxed) > min_threads_)
+						{
+							break;
+						}
 					}
 
-					if (jobs_cv_.wait_for(l, timeout_.load(std::memory_order_relaxed)) == std::cv_status::timeout)
+					idle_threads_.fetch_sub(1, std::memory_order_relaxed);
+					if (queue_.empty())
 					{
+						num_threads_.fetch_sub(1, std::memory_order_relaxed);
 						return nullptr;
 					}
 				}
 
-				return queue_.pop_front();
+				return pop();
 			}
 
-			inline void thread_loop(task_base* task)
+			// The task may be gone once it has run, so whatever the trace
+			// needs from it is read first.
+			void run(task_base* task) noexcept
 			{
+				if (tracer_ == nullptr)
+				{
+					task->execute(task);
+					return;
+				}
+
+				const auto name {task->name};
+				const auto enqueued {task->enqueued};
+				const auto started {cmoon::execution::tracer::clock::now()};
 				task->execute(task);
-				std::unique_lock l {threads_mut_};
-				--busy_threads;
-				l.unlock();
+				tracer_->record(name, enqueued, started, cmoon::execution::tracer::clock::now());
+			}
 
+			void thread_loop() noexcept
+			{
+				task_base* task;
 				while ((task = dequeue()) != nullptr)
 				{
-					l.lock();
-					++busy_threads;
-					l.unlock();
-					task->execute(task);
-					l.lock();
-					--busy_threads;
+					run(task);
 				}
 
-				if (--num_threads == 0)
+				std::lock_guard l {exit_mut_};
+				if (--running_ == 0)
 				{
-					num_threads.notify_all();
+					exit_cv_.notify_all();
 				}
 			}
 	};
@@ -245,9 +519,11 @@ namespace cmoon::executors
 	struct operation : public task_base
 	{
 		public:
-			operation(cached_thread_pool& pool, R&& r)
+			operation(cached_thread_pool& pool, task_lane lane, R&& r)
 				: pool_{pool}, r_{std::forward<R>(r)}
 			{
+				this->hook.lane = lane;
+				this->name = "cached_thread_pool::schedule";
 				this->execute = [](task_base* t) noexcept
 				{
 					auto& op = *static_cast<operation*>(t);
@@ -272,10 +548,15 @@ namespace cmoon::executors
 
 			void start_helper(task_base* task) noexcept
 			{
-				pool_.enqueue(task);
+				if (!pool_.enqueue(task))
+				{
+					cmoon::execution::set_error(std::move(r_), std::make_exception_ptr(queue_full{}));
+				}
 			}
 	};
 
+	// Every index is a task of its own, and whichever finishes last
+	// completes the receiver, so no thread is held waiting on the others.
 	template<cmoon::execution::receiver R, std::integral Shape, class F>
 	struct bulk_operation : public task_base
 	{
@@ -286,14 +567,12 @@ namespace cmoon::executors
 					bulk_operation_helper(bulk_operation* owner, Shape shape)
 						: owner_{owner}, shape_{shape}
 					{
+						this->hook.lane = owner->hook.lane;
+						this->name = owner->name;
 						this->execute = [](task_base* t) noexcept
 						{
 							auto& op = *static_cast<bulk_operation_helper*>(t);
-							if (!cmoon::execution::get_stop_token(op.owner_->r_).stop_requested())
-							{
-								std::invoke(std::move(op.owner_->f_), op.shape_);
-								op.owner_->l.count_down();
-							}
+							op.owner_->run(op.shape_);
 						};
 					}
 
@@ -307,39 +586,36 @@ namespace cmoon::executors
 
 					void start_helper(task_base* task) noexcept
 					{
-						owner_->pool_.enqueue(task);
+						owner_->submit(task);
 					}
 			};
 
 			friend struct bulk_operation_helper;
 
-			bulk_operation(cached_thread_pool& pool, R&& r, Shape shape, F&& f)
-				: pool_{pool}, r_{std::forward<R>(r)}, f_{std::forward<F>(f)}, shape_{shape}, l{shape_}
+			bulk_operation(cached_thread_pool& pool, task_lane lane, R&& r, Shape shape, F&& f)
+				: pool_{pool}, r_{std::forward<R>(r)}, f_{std::forward<F>(f)}, shape_{shape}, remaining_{shape}
 			{
+				this->hook.lane = lane;
+				this->name = "cached_thread_pool::bulk";
 				this->execute = [](task_base* t) noexcept
 				{
 					auto& op = *static_cast<bulk_operation*>(t);
-					if (cmoon::execution::get_stop_token(op.r_).stop_requested())
-					{
-						cmoon::execution::set_done(std::move(op.r_));
-					}
-					else
-					{
-						std::invoke(op.f_, op.shape_ - 1);
-						op.l.arrive_and_wait();
-						cmoon::execution::set_value(std::move(op.r_));
-					}
+					op.run(op.shape_ - 1);
 				};
 
-				for (Shape i {0}; i < shape - 1; ++i)
+				for (Shape i {1}; i < shape; ++i)
 				{
-					helpers.emplace_back(this, i);
+					helpers.emplace_back(this, i - 1);
 				}
 			}
 
 			friend void tag_invoke(cmoon::execution::start_t, bulk_operation& o) noexcept
 			{
-				if (o.shape_ != 0)
+				if (o.shape_ == 0)
+				{
+					cmoon::execution::set_value(std::move(o.r_));
+				}
+				else
 				{
 					o.start_helper(std::addressof(o));
 				}
@@ -349,15 +625,77 @@ namespace cmoon::executors
 			R r_;
 			F f_;
 			Shape shape_;
-			std::latch l;
+			std::atomic<Shape> remaining_;
+			std::atomic<bool> rejected_ {false};
+			std::atomic_flag errored_;
+			std::exception_ptr error_;
 			std::vector<bulk_operation_helper> helpers;
 
+			// The last task to finish may destroy this operation, so nothing
+			// here is read after the final submit.
 			void start_helper(task_base* task) noexcept
 			{
-				pool_.enqueue(task);
-				for (auto& op : helpers)
+				const auto first {helpers.data()};
+				const auto count {helpers.size()};
+
+				submit(task);
+				for (std::size_t i {0}; i < count; ++i)
+				{
+					cmoon::execution::start(first[i]);
+				}
+			}
+
+			void submit(task_base* task) noexcept
+			{
+				if (rejected_.load(std::memory_order_relaxed) || !pool_.enqueue(task))
+				{
+					rejected_.store(true, std::memory_order_relaxed);
+					finish();
+				}
+			}
+
+			void run(Shape i) noexcept
+			{
+				if (!rejected_.load(std::memory_order_relaxed) && !cmoon::execution::get_stop_token(r_).stop_requested())
+				{
+					try
+					{
+						std::invoke(f_, i);
+					}
+					catch (...)
+					{
+						if (!errored_.test_and_set())
+						{
+							error_ = std::current_exception();
+						}
+					}
+				}
+
+				finish();
+			}
+
+			void finish() noexcept
+			{
+				if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					return;
+				}
+
+				if (errored_.test())
+				{
+					cmoon::execution::set_error(std::move(r_), std::move(error_));
+				}
+				else if (rejected_.load(std::memory_order_relaxed))
+				{
+					cmoon::execution::set_error(std::move(r_), std::make_exception_ptr(queue_full{}));
+				}
+				else if (cmoon::execution::get_stop_token(r_).stop_requested())
+				{
+					cmoon::execution::set_done(std::move(r_));
+				}
+				else
 				{
-					cmoon::execution::start(op);
+					cmoon::execution::set_value(std::move(r_));
 				}
 			}
 	};
@@ -1,7 +1,10 @@
 export module cmoon.executors;
 export import cmoon.executors.context_stopped;
+export import cmoon.executors.queue_full;
+export import cmoon.executors.task_lanes;
 export import cmoon.executors.inline_scheduler;
 export import cmoon.executors.static_thread_pool;
 export import cmoon.executors.cached_thread_pool;
 export import cmoon.executors.single_thread_context;
-//export import cmoon.executors.strand;
\ No newline at end of file
+export import cmoon.executors.strand;
+export import cmoon.executors.timer_context;
\ No newline at end of file
@@ -0,0 +1,18 @@
+export module cmoon.executors.queue_full;
+
+import <exception>;
+
+namespace cmoon::executors
+{
+	export
+	class queue_full : public std::exception
+	{
+		public:
+			constexpr queue_full() = default;
+
+			constexpr const char* what() const noexcept final
+			{
+				return "execution queue is full";
+			}
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 export module cmoon.executors.static_thread_pool;
 
 import <vector>;
+import <algorithm>;
 import <functional>;
 import <memory>;
 import <type_traits>;
@@ -9,11 +10,18 @@ import <thread>;
 import <mutex>;
 import <concepts>;
 import <condition_variable>;
-import <latch>;
+import <atomic>;
+import <exception>;
+import <optional>;
+import <cstddef>;
+import <limits>;
+import <chrono>;
 
 import cmoon.execution;
 import cmoon.functional;
-import cmoon.intrusive_queue;
+import cmoon.thread;
+
+import cmoon.executors.task_lanes;
 
 namespace cmoon::executors
 {
@@ -27,6 +35,38 @@ namespace cmoon::executors
 	{
 		task_base* next;
 		void (*execute)(task_base*) noexcept;
+		cmoon::executors::lane_hook<task_base> hook;
+		const char* name;
+
+		// Only set when the pool is traced.
+		std::chrono::steady_clock::time_point enqueued {};
+	};
+
+	export
+	enum class thread_placement
+	{
+		none,
+		cores,
+		nodes
+	};
+
+	export
+	struct static_thread_pool_options
+	{
+		// Number of worker threads.
+		std::size_t threads {std::thread::hardware_concurrency()};
+		// none leaves workers to the OS. cores pins each worker to a single cpu
+		// and nodes pins each worker to every cpu of one NUMA node. Workers are
+		// spread over the nodes round-robin either way.
+		thread_placement placement {thread_placement::none};
+		// Machine layout to place workers on. Detected from the system when empty.
+		std::optional<cmoon::cpu_topology> topology {};
+		// How long the oldest task of a lane may wait before it is served
+		// ahead of the lanes that would otherwise come first.
+		std::chrono::steady_clock::duration starvation_limit {std::chrono::milliseconds{100}};
+		// Records when each task is queued, started and finished. Left null,
+		// the pool reads no clocks.
+		cmoon::execution::tracer* tracer {nullptr};
 	};
 
 	export
@@ -45,6 +85,8 @@ namespace cmoon::executors
 				struct bulk_sender_t
 				{
 					static_thread_pool& pool_;
+					std::size_t node_;
+					task_lane lane_;
 					Shape shape_;
 					F f_;
 
@@ -59,19 +101,21 @@ namespace cmoon::executors
 					template<cmoon::execution::receiver R>
 					friend bulk_operation<std::decay_t<R>, Shape, std::decay_t<F>> tag_invoke(cmoon::execution::connect_t, static_thread_pool::scheduler_t::bulk_sender_t<Shape, F>&& s, R&& r)
 					{
-						return {s.pool_, std::forward<R>(r), s.shape_, std::move(s.f_)};
+						return {s.pool_, s.node_, s.lane_, std::forward<R>(r), s.shape_, std::move(s.f_)};
 					}
 
 					template<class CPO>
 					friend static_thread_pool::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, static_thread_pool::scheduler_t::bulk_sender_t<Shape, F>& s) noexcept
 					{
-						return {std::addressof(s.pool_)};
+						return {std::addressof(s.pool_), s.node_, s.lane_};
 					}
 				};
 
 				struct sender_t
 				{
 					static_thread_pool& pool_;
+					std::size_t node_;
+					task_lane lane_;
 
 					template<template<class...> class Tuple, template<class...> class Variant>
 					using value_types = Variant<Tuple<>>;
@@ -84,27 +128,63 @@ namespace cmoon::executors
 					template<cmoon::execution::receiver R>
 					friend operation<std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, static_thread_pool::scheduler_t::sender_t s, R&& r) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<R>, R>)
 					{
-						return {s.pool_, std::forward<R>(r)};
+						return {s.pool_, s.node_, s.lane_, std::forward<R>(r)};
 					}
 
 					template<std::integral Shape, class F>
 					friend static_thread_pool::scheduler_t::bulk_sender_t<Shape, std::decay_t<F>> tag_invoke(cmoon::execution::bulk_t, static_thread_pool::scheduler_t::sender_t s, Shape shape, F&& f) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F>)
 					{
-						return {s.pool_, shape, std::forward<F>(f)};
+						return {s.pool_, s.node_, s.lane_, shape, std::forward<F>(f)};
 					}
 
 					template<class CPO>
 					friend static_thread_pool::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, static_thread_pool::scheduler_t::sender_t s) noexcept
 					{
-						return {std::addressof(s.pool_)};
+						return {std::addressof(s.pool_), s.node_, s.lane_};
 					}
 				};
 
 				static_thread_pool* pool_;
+				std::size_t node_ {any_node};
+				task_lane lane_ {};
 
 				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_t, static_thread_pool::scheduler_t t) noexcept
 				{
-					return {*t.pool_};
+					return {*t.pool_, t.node_, t.lane_};
+				}
+
+				[[nodiscard]] scheduler_t require(priority_t p) const noexcept
+				{
+					auto s {*this};
+					s.lane_.priority = p.value;
+					return s;
+				}
+
+				[[nodiscard]] scheduler_t require(deadline_t d) const noexcept
+				{
+					auto s {*this};
+					s.lane_.deadline = d.value;
+					return s;
+				}
+
+				[[nodiscard]] task_priority query(priority_t) const noexcept
+				{
+					return lane_.priority;
+				}
+
+				[[nodiscard]] std::optional<std::chrono::steady_clock::duration> query(deadline_t) const noexcept
+				{
+					return lane_.deadline;
+				}
+
+				[[nodiscard]] std::size_t numa_node() const noexcept
+				{
+					return pool_->target_node(node_);
+				}
+
+				[[nodiscard]] friend std::size_t tag_invoke(cmoon::execution::get_numa_node_t, static_thread_pool::scheduler_t t) noexcept
+				{
+					return t.numa_node();
 				}
 
 				[[nodiscard]] friend cmoon::execution::forward_progress_guarantee tag_invoke(cmoon::execution::get_forward_progress_guarantee_t, static_thread_pool::scheduler_t) noexcept
@@ -116,15 +196,45 @@ namespace cmoon::executors
 				[[nodiscard]] friend bool operator!=(const scheduler_t&, const scheduler_t&) noexcept = default;
 			};
 
+			// Schedulers that are not bound to a node queue work on the node of
+			// the thread that starts it.
+			static constexpr std::size_t any_node {std::numeric_limits<std::size_t>::max()};
+
 			static_thread_pool(std::size_t num_threads)
+				: static_thread_pool{static_thread_pool_options{num_threads}} {}
+
+			static_thread_pool(static_thread_pool_options options)
+				: topology_{options.placement == thread_placement::none
+								? cmoon::cpu_topology{}
+								: options.topology ? std::move(*options.topology) : cmoon::cpu_topology::detect()},
+				  node_count_{std::max<std::size_t>(std::min(topology_.node_count(), options.threads), 1)},
+				  queues_{std::make_unique<node_queue[]>(node_count_)},
+				  tracer_{options.tracer}
 			{
-				threads.reserve(num_threads);
+				for (std::size_t i {0}; i < node_count_; ++i)
+				{
+					queues_[i].jobs = task_lanes<task_base>{options.starvation_limit};
+				}
+
+				threads.reserve(options.threads);
 
 				try
 				{
-					for (std::size_t i {0}; i < num_threads; ++i)
+					for (std::size_t i {0}; i < options.threads; ++i)
 					{
-						threads.emplace_back(&static_thread_pool::thread_loop, this);
+						const auto node {i % node_count_};
+						auto& t {threads.emplace_back(&static_thread_pool::thread_loop, this, node)};
+
+						if (options.placement == thread_placement::cores)
+						{
+							const auto cpus {topology_.cpus(node)};
+							const auto cpu {cpus[(i / node_count_) % std::size(cpus)]};
+							cmoon::pin_thread(t, {&cpu, 1});
+						}
+						else if (options.placement == thread_placement::nodes)
+						{
+							cmoon::pin_thread(t, topology_.cpus(node));
+						}
 					}
 				}
 				catch (...)
@@ -136,10 +246,10 @@ namespace cmoon::executors
 			}
 
 			static_thread_pool(const static_thread_pool&) = delete;
-			static_thread_pool(static_thread_pool&&) = default;
+			static_thread_pool(static_thread_pool&&) = delete;
 
 			static_thread_pool& operator=(const static_thread_pool&) = delete;
-			static_thread_pool& operator=(static_thread_pool&&) = default;
+			static_thread_pool& operator=(static_thread_pool&&) = delete;
 
 			~static_thread_pool() noexcept
 			{
@@ -149,9 +259,12 @@ namespace cmoon::executors
 
 			void request_stop() noexcept
 			{
-				std::lock_guard l{jobs_mut_};
-				stop_requested_ = true;
-				jobs_cv_.notify_all();
+				stop_requested_.store(true);
+				for (std::size_t i {0}; i < node_count_; ++i)
+				{
+					std::lock_guard l{queues_[i].mut};
+					queues_[i].cv.notify_all();
+				}
 			}
 
 			void join() noexcept
@@ -168,56 +281,237 @@ namespace cmoon::executors
 			{
 				return {this};
 			}
+
+			// A scheduler whose work always queues on the given node, so its
+			// workers pick it up before any other node steals it.
+			[[nodiscard]] scheduler_t get_scheduler(std::size_t node) noexcept
+			{
+				return {this, node % node_count_};
+			}
+
+			// The number of nodes that have their own queue. This is 1 unless
+			// workers are placed.
+			[[nodiscard]] std::size_t node_count() const noexcept
+			{
+				return node_count_;
+			}
+
+			// Counters for one lane, summed over every node.
+			[[nodiscard]] lane_stats stats(task_priority p) const
+			{
+				return sum_stats([p](const task_lanes<task_base>& l) { return l.stats(p); });
+			}
+
+			[[nodiscard]] lane_stats deadline_stats() const
+			{
+				return sum_stats([](const task_lanes<task_base>& l) { return l.deadline_stats(); });
+			}
 		private:
+			struct node_queue
+			{
+				std::mutex mut;
+				std::condition_variable cv;
+				task_lanes<task_base> jobs;
+				std::atomic<std::size_t> queued {0};
+				std::atomic<std::size_t> idle {0};
+			};
+
+			static thread_local const static_thread_pool* current_pool_;
+			static thread_local std::size_t current_node_;
+
+			cmoon::cpu_topology topology_;
+			std::size_t node_count_;
+			std::unique_ptr<node_queue[]> queues_;
 			std::vector<std::thread> threads;
-			std::mutex jobs_mut_;
-			std::condition_variable jobs_cv_;
-			cmoon::intrusive_queue<&task_base::next> jobs_queue_;
-			bool stop_requested_{false};
+			std::atomic<bool> stop_requested_{false};
+			cmoon::execution::tracer* tracer_;
 
-			void enqueue(task_base* task) noexcept
+			template<class F>
+			[[nodiscard]] lane_stats sum_stats(F f) const
 			{
-				std::lock_guard l {jobs_mut_};
-				const auto was_empty {jobs_queue_.empty()};
-				jobs_queue_.push_back(task);
-				if (was_empty)
+				lane_stats total;
+				for (std::size_t i {0}; i < node_count_; ++i)
 				{
-					jobs_cv_.notify_one();
+					std::lock_guard l {queues_[i].mut};
+					total += f(queues_[i].jobs);
 				}
+
+				return total;
 			}
 
-			void thread_loop()
+			[[nodiscard]] std::size_t target_node(std::size_t node) const noexcept
 			{
-				while (true)
+				if (node != any_node)
+				{
+					return node;
+				}
+
+				if (current_pool_ == this)
 				{
-					task_base* task;
+					return current_node_;
+				}
+
+				if (node_count_ > 1)
+				{
+					if (const auto cpu {cmoon::current_cpu()})
 					{
-						std::unique_lock l{jobs_mut_};
-						while (jobs_queue_.empty())
+						if (const auto n {topology_.node_of(*cpu)})
 						{
-							if (stop_requested_)
-							{
-								return;
-							}
+							return *n % node_count_;
+						}
+					}
+				}
+
+				return 0;
+			}
+
+			void enqueue(task_base* task, std::size_t node) noexcept
+			{
+				if (tracer_ != nullptr)
+				{
+					task->enqueued = cmoon::execution::tracer::clock::now();
+				}
+
+				node = target_node(node);
+				auto& q {queues_[node]};
+				bool woken;
+				{
+					std::lock_guard l {q.mut};
+					q.jobs.push_back(task);
+					q.queued.fetch_add(1);
+					woken = q.idle.load() != 0;
+					if (woken)
+					{
+						q.cv.notify_one();
+					}
+				}
 
-							jobs_cv_.wait(l);
+				// Every worker of the node is busy, so let an idle worker of
+				// another node steal it rather than wait.
+				if (!woken)
+				{
+					for (std::size_t i {1}; i < node_count_; ++i)
+					{
+						auto& other {queues_[(node + i) % node_count_]};
+						if (other.idle.load() != 0)
+						{
+							std::lock_guard l {other.mut};
+							other.cv.notify_one();
+							break;
 						}
+					}
+				}
+			}
+
+			[[nodiscard]] task_base* try_pop(node_queue& q) noexcept
+			{
+				if (q.queued.load(std::memory_order_relaxed) == 0)
+				{
+					return nullptr;
+				}
+
+				std::lock_guard l {q.mut};
+				if (q.jobs.empty())
+				{
+					return nullptr;
+				}
+
+				q.queued.fetch_sub(1, std::memory_order_relaxed);
+				return q.jobs.pop_front();
+			}
+
+			[[nodiscard]] task_base* try_steal(std::size_t node) noexcept
+			{
+				for (std::size_t i {1}; i < node_count_; ++i)
+				{
+					if (auto task {try_pop(queues_[(node + i) % node_count_])})
+					{
+						return task;
+					}
+				}
+
+				return nullptr;
+			}
 
-						task = jobs_queue_.pop_front();
+			[[nodiscard]] bool has_foreign_work(std::size_t node) const noexcept
+			{
+				for (std::size_t i {1}; i < node_count_; ++i)
+				{
+					if (queues_[(node + i) % node_count_].queued.load() != 0)
+					{
+						return true;
 					}
+				}
+
+				return false;
+			}
 
+			// The task may be gone once it has run, so whatever the trace
+			// needs from it is read first.
+			void run(task_base* task) noexcept
+			{
+				if (tracer_ == nullptr)
+				{
 					task->execute(task);
+					return;
+				}
+
+				const auto name {task->name};
+				const auto enqueued {task->enqueued};
+				const auto started {cmoon::execution::tracer::clock::now()};
+				task->execute(task);
+				tracer_->record(name, enqueued, started, cmoon::execution::tracer::clock::now());
+			}
+
+			void thread_loop(std::size_t node)
+			{
+				current_pool_ = this;
+				current_node_ = node;
+				auto& q {queues_[node]};
+
+				while (true)
+				{
+					auto task {try_pop(q)};
+					if (!task)
+					{
+						task = try_steal(node);
+					}
+
+					if (task)
+					{
+						run(task);
+						continue;
+					}
+
+					std::unique_lock l{q.mut};
+					q.idle.fetch_add(1);
+					while (q.jobs.empty() && !has_foreign_work(node))
+					{
+						if (stop_requested_.load())
+						{
+							q.idle.fetch_sub(1);
+							return;
+						}
+
+						q.cv.wait(l);
+					}
+					q.idle.fetch_sub(1);
 				}
 			}
 	};
 
+	thread_local const static_thread_pool* static_thread_pool::current_pool_ {nullptr};
+	thread_local std::size_t static_thread_pool::current_node_ {0};
+
 	template<cmoon::execution::receiver R>
 	struct operation : public task_base
 	{
 		public:
-			operation(static_thread_pool& pool, R&& r)
-				: pool_{pool}, r_{std::forward<R>(r)}
+			operation(static_thread_pool& pool, std::size_t node, task_lane lane, R&& r)
+				: pool_{pool}, node_{node}, r_{std::forward<R>(r)}
 			{
+				this->hook.lane = lane;
+				this->name = "static_thread_pool::schedule";
 				this->execute = [](task_base* t) noexcept
 				{
 					auto& op = *static_cast<operation*>(t);
@@ -238,11 +532,12 @@ namespace cmoon::executors
 			}
 		private:
 			static_thread_pool& pool_;
+			std::size_t node_;
 			R r_;
 
 			void start_helper(task_base* task) noexcept
 			{
-				pool_.enqueue(task);
+				pool_.enqueue(task, node_);
 			}
 	};
 
@@ -256,14 +551,12 @@ namespace cmoon::executors
 					bulk_operation_helper(bulk_operation* owner, Shape shape)
 						: owner_{owner}, shape_{shape}
 					{
+						this->hook.lane = owner->hook.lane;
+						this->name = owner->name;
 						this->execute = [](task_base* t) noexcept
 						{
 							auto& op = *static_cast<bulk_operation_helper*>(t);
-							if (!cmoon::execution::get_stop_token(op.owner_->r_).stop_requested())
-							{
-								std::invoke(std::move(op.owner_->f_), op.shape_);
-								op.owner_->l.count_down();
-							}
+							op.owner_->run(op.shape_);
 						};
 					}
 
@@ -277,33 +570,26 @@ namespace cmoon::executors
 
 					void start_helper(task_base* task) noexcept
 					{
-						owner_->pool_.enqueue(task);
+						owner_->pool_.enqueue(task, owner_->node_);
 					}
 			};
 
 			friend struct bulk_operation_helper;
 
-			bulk_operation(static_thread_pool& pool, R&& r, Shape shape, F&& f)
-				: pool_{pool}, r_{std::forward<R>(r)}, f_{std::forward<F>(f)}, shape_{shape}, l{shape_}
+			bulk_operation(static_thread_pool& pool, std::size_t node, task_lane lane, R&& r, Shape shape, F&& f)
+				: pool_{pool}, node_{node}, r_{std::forward<R>(r)}, f_{std::forward<F>(f)}, shape_{shape}, remaining_{shape_}
 			{
+				this->hook.lane = lane;
+				this->name = "static_thread_pool::bulk";
 				this->execute = [](task_base* t) noexcept
 				{
 					auto& op = *static_cast<bulk_operation*>(t);
-					if (cmoon::execution::get_stop_token(op.r_).stop_requested())
-					{
-						cmoon::execution::set_done(std::move(op.r_));
-					}
-					else
-					{
-						std::invoke(op.f_, op.shape_ - 1);
-						op.l.arrive_and_wait();
-						cmoon::execution::set_value(std::move(op.r_));
-					}
+					op.run(op.shape_ - 1);
 				};
 
-				for (Shape i {0}; i < shape - 1; ++i)
+				for (Shape i {1}; i < shape; ++i)
 				{
-					helpers.emplace_back(this, i);
+					helpers.emplace_back(this, i - 1);
 				}
 			}
 
@@ -313,22 +599,66 @@ namespace cmoon::executors
 				{
 					o.start_helper(std::addressof(o));
 				}
+				else
+				{
+					cmoon::execution::set_value(std::move(o.r_));
+				}
 			}
 		private:
 			static_thread_pool& pool_;
+			std::size_t node_;
 			R r_;
 			F f_;
 			Shape shape_;
-			std::latch l;
+			std::atomic<Shape> remaining_;
+			std::atomic_flag errored_;
+			std::exception_ptr error_;
 			std::vector<bulk_operation_helper> helpers;
 
 			void start_helper(task_base* task) noexcept
 			{
-				pool_.enqueue(task);
+				pool_.enqueue(task, node_);
 				for (auto& op : helpers)
 				{
 					cmoon::execution::start(op);
 				}
 			}
+
+			// Every index runs on whichever worker picks it up, and the last one
+			// to finish completes the receiver, so no worker is left blocked
+			// waiting on the others.
+			void run(Shape i) noexcept
+			{
+				if (!cmoon::execution::get_stop_token(r_).stop_requested())
+				{
+					try
+					{
+						std::invoke(f_, i);
+					}
+					catch (...)
+					{
+						if (!errored_.test_and_set())
+						{
+							error_ = std::current_exception();
+						}
+					}
+				}
+
+				if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					if (errored_.test())
+					{
+						cmoon::execution::set_error(std::move(r_), std::move(error_));
+					}
+					else if (cmoon::execution::get_stop_token(r_).stop_requested())
+					{
+						cmoon::execution::set_done(std::move(r_));
+					}
+					else
+					{
+						cmoon::execution::set_value(std::move(r_));
+					}
+				}
+			}
 	};
 }
\ No newline at end of file
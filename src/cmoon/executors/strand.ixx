@@ -1,162 +1,145 @@
 export module cmoon.executors.strand;
 
+import <cstddef>;
+import <algorithm>;
 import <concepts>;
+import <new>;
 import <type_traits>;
 import <utility>;
 import <thread>;
-import <mutex>;
-import <condition_variable>;
-import <deque>;
+import <atomic>;
 import <memory>;
 import <exception>;
 
 import cmoon.execution;
-import cmoon.memory;
 
 namespace cmoon::executors
 {
-	struct job
-	{
-		virtual void execute() noexcept = 0;
-		virtual ~job() noexcept = default;
-	};
+	template<cmoon::execution::scheduler Sch, cmoon::execution::receiver R>
+	struct strand_operation;
 
-	template<cmoon::execution::operation_state OP>
-	struct scheduler_job : public job
+	// Operation states submitted to a strand embed this, so queueing a job
+	// never allocates.
+	struct strand_task
 	{
-		scheduler_job(OP&& op)
-			: op_{std::forward<OP>(op)} {}
-
-		[[no_unique_address]] OP op_;
-
-		void execute() noexcept final
-		{
-			cmoon::execution::start(op_);
-		}
+		std::atomic<strand_task*> next {nullptr};
+		void (*execute)(strand_task*, bool) noexcept;
+		void (*drive)(strand_task*) noexcept;
 	};
 
-	export
-	template<cmoon::execution::scheduler Sch, class InAlloc = std::allocator<void>>
-	class strand
+	// An intrusive multi-producer/single-consumer queue (Vyukov). Producers
+	// only ever exchange the head, and the single consumer owns the tail,
+	// so neither side takes a lock.
+	class strand_queue
 	{
 		public:
-			using allocator_type = typename std::allocator_traits<InAlloc>::template rebind_alloc<job>;
-		private:
-			struct state_t
-			{
-				using deque_value_t = typename std::allocator_traits<allocator_type>::template rebind_alloc<cmoon::allocate_unique_t<job, allocator_type>>;
+			strand_queue() noexcept
+				: head_{&stub_}, tail_{&stub_} {}
 
-				state_t(const allocator_type& a)
-					: alloc{a}, jobs{a} {}
+			strand_queue(const strand_queue&) = delete;
+			strand_queue& operator=(const strand_queue&) = delete;
 
-				allocator_type alloc;
-				std::deque<cmoon::allocate_unique_t<job, allocator_type>, deque_value_t> jobs;
-				bool can_execute {true};
-				std::mutex jobs_m;
-				std::condition_variable jobs_cv;
-			};
-		public:
-			template<cmoon::execution::receiver R>
-			struct receiver_t
+			void push(strand_task* task) noexcept
 			{
-				state_t* state;
-				R r_;
+				task->next.store(nullptr, std::memory_order_relaxed);
+				const auto previous {head_.exchange(task, std::memory_order_acq_rel)};
+				previous->next.store(task, std::memory_order_release);
+			}
 
-				template<class... Args>
-				friend void tag_invoke(cmoon::execution::set_value_t, strand::receiver_t<R>&& r, Args&&... args) noexcept
+			// Returns nullptr when the queue is empty, or when a producer has
+			// claimed the head but not yet linked its task in.
+			[[nodiscard]] strand_task* try_pop() noexcept
+			{
+				auto tail {tail_};
+				auto next {tail->next.load(std::memory_order_acquire)};
+
+				if (tail == &stub_)
 				{
-					try
+					if (next == nullptr)
 					{
-						cmoon::execution::set_value(std::move(r.r_), std::forward<Args>(args)...);
-					}
-					catch (...)
-					{
-						cmoon::execution::set_error(std::move(r.r_), std::current_exception());
+						return nullptr;
 					}
 
-					std::scoped_lock l{state->jobs_m};
-					state->can_execute = true;
-					state->jobs_cv.notify_one();
+					tail_ = next;
+					tail = next;
+					next = next->next.load(std::memory_order_acquire);
 				}
 
-				template<class E>
-				friend void tag_invoke(cmoon::execution::set_error_t, strand::receiver_t<R>&& r, E&& e) noexcept
+				if (next != nullptr)
 				{
-					cmoon::execution::set_error(std::move(r.r_), std::current_exception());
-					std::scoped_lock l{state->jobs_m};
-					state->can_execute = true;
-					state->jobs_cv.notify_one();
+					tail_ = next;
+					return tail;
 				}
 
-				friend void tag_invoke(cmoon::execution::set_done_t, strand::receiver_t<R>&& r) noexcept
+				if (tail != head_.load(std::memory_order_acquire))
 				{
-					cmoon::execution::set_done(std::move(r.r_), std::current_exception());
-					std::scoped_lock l{state->jobs_m};
-					state->can_execute = true;
-					state->jobs_cv.notify_one();
+					return nullptr;
 				}
-			};
+
+				push(&stub_);
+				next = tail->next.load(std::memory_order_acquire);
+				if (next != nullptr)
+				{
+					tail_ = next;
+					return tail;
+				}
+
+				return nullptr;
+			}
+		private:
+			alignas(std::hardware_destructive_interference_size) std::atomic<strand_task*> head_;
+			alignas(std::hardware_destructive_interference_size) strand_task* tail_;
+			strand_task stub_;
+	};
+
+	// Runs work submitted through its scheduler one job at a time, in the
+	// order it was submitted, on the underlying scheduler. While the strand
+	// has work, exactly one job is scheduled on the underlying scheduler;
+	// when it runs, it executes up to batch_size queued jobs inline and then
+	// hands the rest to a fresh turn so other work on the scheduler is not
+	// starved. The strand must outlive the work submitted to it.
+	export
+	template<cmoon::execution::scheduler Sch>
+	class strand
+	{
+		template<cmoon::execution::scheduler Sch2, cmoon::execution::receiver R>
+		friend struct strand_operation;
+
+		public:
+			static constexpr std::size_t default_batch_size {64};
 
 			struct scheduler_t
 			{
-				struct sender_t : public cmoon::execution::sender_base
+				struct sender_t
 				{
-					strand* owner;
+					strand& strand_;
 
-					template<cmoon::execution::operation_state OP2>
-					struct op
-					{
-						public:
-							op(state_t* state, OP2&& op2)
-								: state{state},
-								  op2_{std::forward<OP2>(op2)} {}
-
-							state_t* state;
-							OP2 op2_;
-
-							friend void tag_invoke(cmoon::execution::start_t, op& o) noexcept
-							{
-								o.start_helper();
-							}
-						private:
-							void start_helper() noexcept
-							{
-								std::scoped_lock l {state->job_m};
-								state->jobs.push_back(cmoon::allocate_unique<scheduler_job>(
-									state->alloc,
-									std::move(op2_)
-								));
-
-								if (state->can_execute)
-								{
-									state->jobs_cv.notify_one();
-								}
-							}
-					};
+					template<template<class...> class Tuple, template<class...> class Variant>
+					using value_types = Variant<Tuple<>>;
+
+					template<template<class...> class Variant>
+					using error_types = Variant<std::exception_ptr>;
+
+					static constexpr bool sends_done {true};
 
 					template<cmoon::execution::receiver R>
-					friend strand::scheduler_t::sender_t::op<R> tag_invoke(cmoon::execution::connect_t, strand::scheduler_t::sender_t s, R&& r) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<R>, R>)
+					friend strand_operation<Sch, std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, strand::scheduler_t::sender_t s, R&& r)
 					{
-						return s.connect_helper(std::forward<R>(r));
+						return {s.strand_, std::forward<R>(r)};
 					}
 
-					private:
-						template<cmoon::execution::receiver R>
-						strand::scheduler_t::sender_t::op<R> connect_helper(R&& r)
-						{
-							return {owner->state.get(),
-									cmoon::execution::connect(
-										cmoon::execution::schedule(owner->sch),
-										strand::receiver_t<R>{owner->state.get(), std::forward<R>(r)}
-									)};
-						}
+					template<class CPO>
+					friend strand::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, strand::scheduler_t::sender_t s) noexcept
+					{
+						return {std::addressof(s.strand_)};
+					}
 				};
 
-				strand* owner;
+				strand* strand_;
 
 				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_t, strand::scheduler_t t) noexcept
 				{
-					return {t.owner};
+					return {*t.strand_};
 				}
 
 				[[nodiscard]] friend cmoon::execution::forward_progress_guarantee tag_invoke(cmoon::execution::get_forward_progress_guarantee_t, strand::scheduler_t) noexcept
@@ -164,111 +147,181 @@ namespace cmoon::executors
 					return cmoon::execution::forward_progress_guarantee::weakly_parallel;
 				}
 
-				[[nodiscard]] friend bool operator==(const strand::scheduler_t&, const strand::scheduler_t&) noexcept = default;
-				[[nodiscard]] friend bool operator!=(const strand::scheduler_t&, const strand::scheduler_t&) noexcept = default;
+				[[nodiscard]] friend bool operator==(const scheduler_t&, const scheduler_t&) noexcept = default;
+				[[nodiscard]] friend bool operator!=(const scheduler_t&, const scheduler_t&) noexcept = default;
 			};
 
-			strand(const InAlloc& alloc = {}) requires(std::default_initializable<Sch>)
-				: state{create_state(alloc)}
-			{
-				std::thread{&strand::thread_loop, state}.detach();
-			}
+			strand(std::size_t batch_size = default_batch_size) requires(std::default_initializable<Sch>)
+				: batch_size_{std::max(batch_size, std::size_t{1})} {}
 
-			explicit strand(Sch&& sch, const InAlloc& alloc = {})
-				: sch{std::forward<Sch>(sch)},state{create_state(alloc)}
+			explicit strand(Sch sch, std::size_t batch_size = default_batch_size)
+				: sch_{std::move(sch)}, batch_size_{std::max(batch_size, std::size_t{1})} {}
+
+			strand(const strand&) = delete;
+			strand& operator=(const strand&) = delete;
+
+			[[nodiscard]] scheduler_t get_scheduler() noexcept
 			{
-				std::thread{&strand::thread_loop, state}.detach();
+				return {this};
 			}
 
-			strand(const strand& other) noexcept
-				: sch{other.sch}
+			[[nodiscard]] std::size_t batch_size() const noexcept
 			{
-				std::scoped_lock l{other.state->jobs_m};
-				state = other.state;
+				return batch_size_;
 			}
-
-			strand(strand&& other) noexcept
-				: sch{other.sch}
+		private:
+			Sch sch_;
+			std::size_t batch_size_;
+			strand_queue queue_;
+			alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> pending_ {0};
+
+			// The job that takes the pending count off zero becomes the driver
+			// and is scheduled directly instead of being queued. Every other
+			// job is counted before it is queued, so the driver may briefly see
+			// a count for a job that is not linked in yet.
+			void post(strand_task* task) noexcept
 			{
-				std::scoped_lock l{other.state->jobs_m};
-				state = std::move(other.state);
+				if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+				{
+					task->drive(task);
+				}
+				else
+				{
+					queue_.push(task);
+				}
 			}
 
-			strand& operator=(const strand& other) noexcept
+			[[nodiscard]] strand_task* pop_counted() noexcept
 			{
-				if (this != std::addressof(other))
+				auto task {queue_.try_pop()};
+				while (task == nullptr)
 				{
-					std::scoped_lock l{other.state->jobs_m};
-					state = other.state;
+					std::this_thread::yield();
+					task = queue_.try_pop();
 				}
 
-				return *this;
+				return task;
 			}
 
-			strand& operator=(strand&& other) noexcept
+			// Runs on the underlying scheduler, starting with the driver. A
+			// job may be destroyed as soon as it completes, so nothing is read
+			// from it afterwards.
+			void drain(strand_task* driver, bool stopped) noexcept
 			{
-				if (this != std::addressof(other))
+				auto task {driver};
+				std::size_t unsettled {0};
+				for (std::size_t ran {0}; ; )
 				{
-					std::scoped_lock l{other.state->jobs_m};
-					state = std::move(other.state);
+					task->execute(task, stopped);
+					++unsettled;
+
+					if (++ran == batch_size_)
+					{
+						break;
+					}
+
+					task = queue_.try_pop();
+					if (task == nullptr)
+					{
+						if (pending_.fetch_sub(unsettled, std::memory_order_acq_rel) == unsettled)
+						{
+							return;
+						}
+
+						unsettled = 0;
+						task = pop_counted();
+					}
+				}
+
+				if (pending_.fetch_sub(unsettled, std::memory_order_acq_rel) == unsettled)
+				{
+					return;
 				}
 
-				return *this;
+				const auto next {pop_counted()};
+				next->drive(next);
 			}
+	};
 
-			~strand() noexcept
+	template<cmoon::execution::scheduler Sch, cmoon::execution::receiver R>
+	struct strand_operation : public strand_task
+	{
+		public:
+			struct drive_receiver
 			{
-				std::scoped_lock l{state->jobs_m};
-				state->jobs_cv.notify_one();
-				state.reset();
-			}
+				strand_operation* op_;
 
-			[[nodiscard]] strand::scheduler_t get_scheduler() noexcept
+				friend void tag_invoke(cmoon::execution::set_value_t, drive_receiver&& r) noexcept
+				{
+					r.run(false);
+				}
+
+				template<class E>
+				friend void tag_invoke(cmoon::execution::set_error_t, drive_receiver&& r, E&&) noexcept
+				{
+					r.run(true);
+				}
+
+				friend void tag_invoke(cmoon::execution::set_done_t, drive_receiver&& r) noexcept
+				{
+					r.run(true);
+				}
+				private:
+					void run(bool stopped) noexcept
+					{
+						op_->run_turn(stopped);
+					}
+			};
+
+			strand_operation(strand<Sch>& s, R&& r)
+				: strand_{s},
+				  r_{std::forward<R>(r)},
+				  scheduled_op_{cmoon::execution::connect(cmoon::execution::schedule(s.sch_), drive_receiver{this})}
 			{
-				return {this};
+				// If the underlying scheduler could not run the turn, the jobs
+				// in it complete with set_done.
+				this->execute = [](strand_task* t, bool stopped) noexcept
+				{
+					auto& op = *static_cast<strand_operation*>(t);
+					if (stopped || cmoon::execution::get_stop_token(op.r_).stop_requested())
+					{
+						cmoon::execution::set_done(std::move(op.r_));
+						return;
+					}
+
+					try
+					{
+						cmoon::execution::set_value(std::move(op.r_));
+					}
+					catch (...)
+					{
+						cmoon::execution::set_error(std::move(op.r_), std::current_exception());
+					}
+				};
+
+				this->drive = [](strand_task* t) noexcept
+				{
+					cmoon::execution::start(static_cast<strand_operation*>(t)->scheduled_op_);
+				};
 			}
 
-			[[nodiscard]] friend bool operator==(const strand& lhs, const strand& rhs) noexcept
+			friend void tag_invoke(cmoon::execution::start_t, strand_operation& o) noexcept
 			{
-				return lhs.state == rhs.state;
+				o.submit();
 			}
-
-			[[nodiscard]] friend bool operator!=(const strand&, const strand&) noexcept = default;
 		private:
-			Sch sch;
-			std::shared_ptr<state_t> state;
+			strand<Sch>& strand_;
+			R r_;
+			cmoon::execution::connect_result_t<cmoon::execution::schedule_result_t<Sch&>, drive_receiver> scheduled_op_;
 
-			friend struct sender_t;
-
-			static std::shared_ptr<state_t> create_state(const allocator_type& a)
+			void submit() noexcept
 			{
-				return std::allocate_shared<state_t>(a, a);
+				strand_.post(this);
 			}
 
-			static void thread_loop(std::shared_ptr<state_t> state)
+			void run_turn(bool stopped) noexcept
 			{
-				while (true)
-				{
-					cmoon::allocate_unique_t<job, allocator_type> j{nullptr, state->alloc};
-					{
-						std::unique_lock l{state->jobs_m};
-						state->jobs_cv.wait(l, [&state] {
-							return (state->can_execute && !state->jobs.empty()) ||
-								   (state.use_count() == 1 && state->jobs.empty());
-						});
-
-						if (state.use_count() == 1 && state->jobs.empty())
-						{
-							return;
-						}
-
-						j = std::move(state->jobs.front());
-						state->jobs.pop_front();
-						state->can_execute = false;
-					}
-
-					j->execute();
-				}
+				strand_.drain(this, stopped);
 			}
 	};
-}
\ No newline at end of file
+}
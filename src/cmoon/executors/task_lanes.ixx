@@ -0,0 +1,323 @@
+export module cmoon.executors.task_lanes;
+
+import <cstddef>;
+import <array>;
+import <chrono>;
+import <optional>;
+import <algorithm>;
+import <utility>;
+
+import cmoon.execution;
+import cmoon.intrusive_queue;
+
+namespace cmoon::executors
+{
+	export
+	enum class task_priority
+	{
+		high,
+		normal,
+		low
+	};
+
+	// Which lane a scheduler's work is queued on. Work with a deadline is
+	// queued earliest-deadline-first ahead of the normal and low lanes, and
+	// the deadline is counted from when the work is queued.
+	export
+	struct task_lane
+	{
+		task_priority priority {task_priority::normal};
+		std::optional<std::chrono::steady_clock::duration> deadline {};
+
+		[[nodiscard]] friend bool operator==(const task_lane&, const task_lane&) noexcept = default;
+	};
+
+	// Property for schedulers that support task_lane, for use with
+	// cmoon::require, cmoon::prefer and cmoon::query.
+	export
+	struct priority_t
+	{
+		static constexpr bool is_requirable {true};
+		static constexpr bool is_preferable {true};
+
+		template<class T>
+		static constexpr bool is_applicable_property_v {cmoon::execution::scheduler<T>};
+
+		task_priority value {task_priority::normal};
+
+		[[nodiscard]] constexpr priority_t operator()(task_priority p) const noexcept
+		{
+			return {p};
+		}
+	};
+
+	export
+	inline constexpr priority_t priority {};
+
+	export
+	struct deadline_t
+	{
+		static constexpr bool is_requirable {true};
+		static constexpr bool is_preferable {true};
+
+		template<class T>
+		static constexpr bool is_applicable_property_v {cmoon::execution::scheduler<T>};
+
+		std::optional<std::chrono::steady_clock::duration> value {};
+
+		[[nodiscard]] constexpr deadline_t operator()(std::chrono::steady_clock::duration d) const noexcept
+		{
+			return {d};
+		}
+	};
+
+	// Without an argument, removes the deadline.
+	export
+	inline constexpr deadline_t deadline {};
+
+	export
+	struct lane_stats
+	{
+		// Tasks waiting right now.
+		std::size_t depth {0};
+		std::size_t max_depth {0};
+
+		// Tasks that have been taken off the lane to run.
+		std::size_t started {0};
+
+		// Time from being queued to being taken off the lane.
+		std::chrono::steady_clock::duration total_wait {};
+		std::chrono::steady_clock::duration max_wait {};
+
+		// Tasks taken off the lane after their deadline had passed.
+		std::size_t missed_deadlines {0};
+
+		lane_stats& operator+=(const lane_stats& other) noexcept
+		{
+			depth += other.depth;
+			max_depth = std::max(max_depth, other.max_depth);
+			started += other.started;
+			total_wait += other.total_wait;
+			max_wait = std::max(max_wait, other.max_wait);
+			missed_deadlines += other.missed_deadlines;
+			return *this;
+		}
+	};
+
+	// The part of a queued task that task_lanes uses.
+	export
+	template<class Task>
+	struct lane_hook
+	{
+		Task* child {nullptr};
+		task_lane lane {};
+		std::chrono::steady_clock::time_point queued_at {};
+		std::chrono::steady_clock::time_point due {};
+	};
+
+	// The high, normal and low lanes are FIFO queues, and the deadline lane
+	// is an intrusive pairing heap ordered by due time. Lanes are served in
+	// the order high, deadline, normal, low, except that once the oldest task
+	// of a lane has waited starvation_limit it is served first. Task needs a
+	// Task* next and a lane_hook<Task> hook. Not thread safe; the pools call
+	// it under their queue lock.
+	export
+	template<class Task>
+	class task_lanes
+	{
+		using clock = std::chrono::steady_clock;
+
+		enum lane_index : std::size_t { high_lane, deadline_lane, normal_lane, low_lane, lane_count };
+
+		public:
+			explicit task_lanes(clock::duration starvation_limit = std::chrono::milliseconds{100}) noexcept
+				: starvation_limit_{starvation_limit} {}
+
+			[[nodiscard]] bool empty() const noexcept
+			{
+				return size_ == 0;
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return size_;
+			}
+
+			void push_back(Task* task) noexcept
+			{
+				auto& hook {task->hook};
+				hook.queued_at = clock::now();
+
+				lane_index i;
+				if (hook.lane.deadline)
+				{
+					i = deadline_lane;
+					hook.due = hook.queued_at + *hook.lane.deadline;
+					hook.child = nullptr;
+					task->next = nullptr;
+					heap_ = meld(heap_, task);
+				}
+				else
+				{
+					i = index_of(hook.lane.priority);
+					fifos_[i].push_back(task);
+				}
+
+				auto& s {stats_[i]};
+				++s.depth;
+				s.max_depth = std::max(s.max_depth, s.depth);
+				++size_;
+			}
+
+			[[nodiscard]] Task* pop_front() noexcept
+			{
+				const auto now {clock::now()};
+				const auto i {next_lane(now)};
+
+				Task* task;
+				if (i == deadline_lane)
+				{
+					task = heap_;
+					heap_ = merge_pairs(std::exchange(task->hook.child, nullptr));
+				}
+				else
+				{
+					task = fifos_[i].pop_front();
+				}
+
+				const auto wait {now - task->hook.queued_at};
+				auto& s {stats_[i]};
+				--s.depth;
+				++s.started;
+				s.total_wait += wait;
+				s.max_wait = std::max(s.max_wait, wait);
+				if (i == deadline_lane && now > task->hook.due)
+				{
+					++s.missed_deadlines;
+				}
+
+				--size_;
+				return task;
+			}
+
+			[[nodiscard]] const lane_stats& stats(task_priority p) const noexcept
+			{
+				return stats_[index_of(p)];
+			}
+
+			[[nodiscard]] const lane_stats& deadline_stats() const noexcept
+			{
+				return stats_[deadline_lane];
+			}
+		private:
+			std::array<cmoon::intrusive_queue<&Task::next>, lane_count> fifos_;
+			Task* heap_ {nullptr};
+			std::size_t size_ {0};
+			clock::duration starvation_limit_;
+			std::array<lane_stats, lane_count> stats_ {};
+
+			[[nodiscard]] static constexpr lane_index index_of(task_priority p) noexcept
+			{
+				switch (p)
+				{
+					case task_priority::high:
+						return high_lane;
+					case task_priority::low:
+						return low_lane;
+					default:
+						return normal_lane;
+				}
+			}
+
+			[[nodiscard]] Task* head(lane_index i) const noexcept
+			{
+				return i == deadline_lane ? heap_ : fifos_[i].front();
+			}
+
+			[[nodiscard]] lane_index next_lane(clock::time_point now) const noexcept
+			{
+				auto first {lane_count};
+				auto starved {lane_count};
+				auto oldest {clock::time_point::max()};
+				for (std::size_t i {high_lane}; i < lane_count; ++i)
+				{
+					const auto t {head(static_cast<lane_index>(i))};
+					if (t == nullptr)
+					{
+						continue;
+					}
+
+					if (first == lane_count)
+					{
+						first = static_cast<lane_index>(i);
+					}
+					else if (now - t->hook.queued_at >= starvation_limit_ && t->hook.queued_at < oldest)
+					{
+						starved = static_cast<lane_index>(i);
+						oldest = t->hook.queued_at;
+					}
+				}
+
+				return starved != lane_count ? starved : first;
+			}
+
+			[[nodiscard]] static Task* meld(Task* a, Task* b) noexcept
+			{
+				if (a == nullptr)
+				{
+					return b;
+				}
+
+				if (b == nullptr)
+				{
+					return a;
+				}
+
+				if (b->hook.due < a->hook.due)
+				{
+					std::swap(a, b);
+				}
+
+				b->next = a->hook.child;
+				a->hook.child = b;
+				return a;
+			}
+
+			// The two pass merge of a pairing heap, done without recursion. The
+			// first pass melds siblings in pairs onto a reversed list, and the
+			// second melds that list into one heap.
+			[[nodiscard]] static Task* merge_pairs(Task* first) noexcept
+			{
+				Task* pairs {nullptr};
+				while (first != nullptr)
+				{
+					const auto a {first};
+					const auto b {a->next};
+					if (b == nullptr)
+					{
+						a->next = pairs;
+						pairs = a;
+						break;
+					}
+
+					first = b->next;
+					a->next = nullptr;
+					b->next = nullptr;
+
+					const auto m {meld(a, b)};
+					m->next = pairs;
+					pairs = m;
+				}
+
+				Task* result {nullptr};
+				while (pairs != nullptr)
+				{
+					const auto t {std::exchange(pairs, pairs->next)};
+					t->next = nullptr;
+					result = meld(result, t);
+				}
+
+				return result;
+			}
+	};
+}
\ No newline at end of file
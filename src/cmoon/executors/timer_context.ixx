@@ -0,0 +1,625 @@
+export module cmoon.executors.timer_context;
+
+import <cstddef>;
+import <cstdint>;
+import <algorithm>;
+import <array>;
+import <bit>;
+import <chrono>;
+import <condition_variable>;
+import <exception>;
+import <limits>;
+import <memory>;
+import <mutex>;
+import <optional>;
+import <thread>;
+import <type_traits>;
+import <utility>;
+
+import cmoon.execution;
+import cmoon.thread;
+
+namespace cmoon::executors
+{
+	template<cmoon::execution::receiver R>
+	struct timer_operation;
+
+	enum class timer_state : std::uint8_t
+	{
+		idle,
+		pending,
+		firing,
+		cancelled
+	};
+
+	// Embedded in every timer operation state, so a timer is linked into
+	// the wheel without allocating.
+	struct timer_base
+	{
+		timer_base* next {nullptr};
+		timer_base* prev {nullptr};
+		std::uint64_t tick {0};
+		std::size_t list {0};
+		timer_state state {timer_state::idle};
+		void (*complete)(timer_base*, bool stopped) noexcept {nullptr};
+	};
+
+	class timer_list
+	{
+		public:
+			[[nodiscard]] bool empty() const noexcept
+			{
+				return head_ == nullptr;
+			}
+
+			[[nodiscard]] timer_base* front() const noexcept
+			{
+				return head_;
+			}
+
+			void push_back(timer_base* t) noexcept
+			{
+				t->next = nullptr;
+				t->prev = tail_;
+				if (tail_ != nullptr)
+				{
+					tail_->next = t;
+				}
+				else
+				{
+					head_ = t;
+				}
+
+				tail_ = t;
+			}
+
+			void remove(timer_base* t) noexcept
+			{
+				(t->prev != nullptr ? t->prev->next : head_) = t->next;
+				(t->next != nullptr ? t->next->prev : tail_) = t->prev;
+				t->next = nullptr;
+				t->prev = nullptr;
+			}
+
+			void splice(timer_list& other) noexcept
+			{
+				if (other.empty())
+				{
+					return;
+				}
+
+				if (tail_ != nullptr)
+				{
+					tail_->next = other.head_;
+					other.head_->prev = tail_;
+				}
+				else
+				{
+					head_ = other.head_;
+				}
+
+				tail_ = other.tail_;
+				other.head_ = nullptr;
+				other.tail_ = nullptr;
+			}
+		private:
+			timer_base* head_ {nullptr};
+			timer_base* tail_ {nullptr};
+	};
+
+	// A hierarchical timing wheel over 64-bit ticks. A timer sits in the
+	// level of the highest group of slot_bits bits in which its tick
+	// differs from now(), in the slot that group names, and is moved down
+	// a level each time now() reaches the start of that slot. Inserting
+	// and removing a timer are both O(1), and finding the next tick with
+	// anything to do only scans one occupancy word per level.
+	class timer_wheel
+	{
+		public:
+			static constexpr std::size_t slot_bits {6};
+			static constexpr std::size_t slots {std::size_t{1} << slot_bits};
+			static constexpr std::size_t levels {(64 + slot_bits - 1) / slot_bits};
+
+			[[nodiscard]] std::uint64_t now() const noexcept
+			{
+				return now_;
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return size_;
+			}
+
+			// Timers due at or before now() are due straight away.
+			void insert(timer_base* t) noexcept
+			{
+				++size_;
+				link(t);
+			}
+
+			void remove(timer_base* t) noexcept
+			{
+				--size_;
+				unlink(t);
+			}
+
+			// The earliest tick at which advance has anything to do.
+			[[nodiscard]] std::optional<std::uint64_t> next_tick() const noexcept
+			{
+				if (!due_.empty())
+				{
+					return now_;
+				}
+
+				for (std::size_t level {0}; level < levels; ++level)
+				{
+					const auto shift {level * slot_bits};
+					const auto group {(now_ >> shift) & (slots - 1)};
+					const auto later {occupied_[level] & ~((std::uint64_t{2} << group) - 1)};
+					if (later != 0)
+					{
+						const auto above {shift + slot_bits};
+						const auto base {above >= 64 ? 0 : (now_ >> above) << above};
+						return base | (static_cast<std::uint64_t>(std::countr_zero(later)) << shift);
+					}
+				}
+
+				return std::nullopt;
+			}
+
+			// Moves now() forward to tick and every timer that has come due
+			// on the way into expired, in order of tick.
+			void advance(std::uint64_t tick, timer_list& expired) noexcept
+			{
+				while (true)
+				{
+					take_due(expired);
+
+					const auto next {next_tick()};
+					if (!next || *next > tick)
+					{
+						now_ = std::max(now_, tick);
+						return;
+					}
+
+					now_ = *next;
+					for (auto level {levels - 1}; level > 0; --level)
+					{
+						const auto shift {level * slot_bits};
+						if ((now_ & ((std::uint64_t{1} << shift) - 1)) == 0)
+						{
+							cascade(level * slots + ((now_ >> shift) & (slots - 1)));
+						}
+					}
+
+					cascade(now_ & (slots - 1));
+				}
+			}
+
+			// Takes every timer, due or not.
+			void clear(timer_list& expired) noexcept
+			{
+				for (auto& list : lists_)
+				{
+					due_.splice(list);
+				}
+
+				occupied_ = {};
+				take_due(expired);
+			}
+		private:
+			static constexpr std::size_t due_list {levels * slots};
+
+			std::array<timer_list, levels * slots> lists_ {};
+			std::array<std::uint64_t, levels> occupied_ {};
+			timer_list due_;
+			std::uint64_t now_ {0};
+			std::size_t size_ {0};
+
+			void link(timer_base* t) noexcept
+			{
+				if (t->tick <= now_)
+				{
+					t->list = due_list;
+					due_.push_back(t);
+					return;
+				}
+
+				const auto level {static_cast<std::size_t>(std::bit_width(t->tick ^ now_) - 1) / slot_bits};
+				const auto slot {(t->tick >> (level * slot_bits)) & (slots - 1)};
+				t->list = level * slots + slot;
+				lists_[t->list].push_back(t);
+				occupied_[level] |= std::uint64_t{1} << slot;
+			}
+
+			void unlink(timer_base* t) noexcept
+			{
+				if (t->list == due_list)
+				{
+					due_.remove(t);
+					return;
+				}
+
+				auto& list {lists_[t->list]};
+				list.remove(t);
+				if (list.empty())
+				{
+					occupied_[t->list / slots] &= ~(std::uint64_t{1} << (t->list % slots));
+				}
+			}
+
+			// Relinks every timer in a slot against the current now().
+			void cascade(std::size_t list) noexcept
+			{
+				auto& slot {lists_[list]};
+				if (slot.empty())
+				{
+					return;
+				}
+
+				occupied_[list / slots] &= ~(std::uint64_t{1} << (list % slots));
+				timer_list moving;
+				moving.splice(slot);
+				while (!moving.empty())
+				{
+					const auto t {moving.front()};
+					moving.remove(t);
+					link(t);
+				}
+			}
+
+			void take_due(timer_list& expired) noexcept
+			{
+				for (auto t {due_.front()}; t != nullptr; t = t->next)
+				{
+					--size_;
+				}
+
+				expired.splice(due_);
+			}
+	};
+
+	// Runs timers on a thread of its own, which sleeps until the next one
+	// is due. Deadlines are rounded up to the next tick of resolution, so
+	// nothing completes early; each one costs O(1) to schedule or cancel
+	// however many are pending. Completions run on the timer thread and
+	// should be short, or move on with transfer.
+	export
+	class timer_context
+	{
+		template<cmoon::execution::receiver R>
+		friend struct timer_operation;
+
+		public:
+			using clock = std::chrono::steady_clock;
+			using duration = clock::duration;
+			using time_point = clock::time_point;
+
+			struct scheduler_t
+			{
+				struct sender_t
+				{
+					timer_context& ctx_;
+					time_point deadline_;
+					bool relative_;
+
+					template<template<class...> class Tuple, template<class...> class Variant>
+					using value_types = Variant<Tuple<>>;
+
+					template<template<class...> class Variant>
+					using error_types = Variant<std::exception_ptr>;
+
+					static constexpr bool sends_done {true};
+
+					template<cmoon::execution::receiver R>
+					friend timer_operation<std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, timer_context::scheduler_t::sender_t s, R&& r) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<R>, R>)
+					{
+						return {s.ctx_, std::forward<R>(r), s.deadline_, s.relative_};
+					}
+
+					template<class CPO>
+					friend timer_context::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, timer_context::scheduler_t::sender_t s) noexcept
+					{
+						return {std::addressof(s.ctx_)};
+					}
+				};
+
+				timer_context* ctx_;
+
+				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_t, timer_context::scheduler_t t) noexcept
+				{
+					return {*t.ctx_, time_point::min(), false};
+				}
+
+				template<class Duration>
+				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_at_t, timer_context::scheduler_t t, const std::chrono::time_point<clock, Duration>& tp) noexcept
+				{
+					return {*t.ctx_, std::chrono::ceil<duration>(tp), false};
+				}
+
+				// The delay is measured from when the operation is started.
+				template<class Rep, class Period>
+				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_after_t, timer_context::scheduler_t t, const std::chrono::duration<Rep, Period>& d) noexcept
+				{
+					return {*t.ctx_, time_point{std::chrono::ceil<duration>(d)}, true};
+				}
+
+				[[nodiscard]] friend time_point tag_invoke(cmoon::execution::now_t, const timer_context::scheduler_t&) noexcept
+				{
+					return clock::now();
+				}
+
+				[[nodiscard]] friend cmoon::execution::forward_progress_guarantee tag_invoke(cmoon::execution::get_forward_progress_guarantee_t, timer_context::scheduler_t) noexcept
+				{
+					return cmoon::execution::forward_progress_guarantee::parallel;
+				}
+
+				[[nodiscard]] friend bool operator==(const scheduler_t& lhs, const scheduler_t& rhs) noexcept = default;
+				[[nodiscard]] friend bool operator!=(const scheduler_t&, const scheduler_t&) noexcept = default;
+			};
+
+			explicit timer_context(duration resolution = std::chrono::milliseconds{1})
+				: resolution_{std::max(resolution, duration{1})},
+				  epoch_{clock::now()},
+				  thread_{&timer_context::run, this} {}
+
+			timer_context(const timer_context&) = delete;
+			timer_context& operator=(const timer_context&) = delete;
+
+			~timer_context() noexcept
+			{
+				request_stop();
+				join();
+			}
+
+			// Timers still pending complete with set_done, and any started
+			// afterwards complete with set_done straight away.
+			void request_stop() noexcept
+			{
+				std::lock_guard l {mut_};
+				stop_requested_ = true;
+				cv_.notify_one();
+			}
+
+			void join() noexcept
+			{
+				if (thread_.joinable())
+				{
+					thread_.join();
+				}
+			}
+
+			[[nodiscard]] scheduler_t get_scheduler() noexcept
+			{
+				return {this};
+			}
+
+			[[nodiscard]] duration resolution() const noexcept
+			{
+				return resolution_;
+			}
+
+			[[nodiscard]] std::size_t pending() const noexcept
+			{
+				std::lock_guard l {mut_};
+				return wheel_.size();
+			}
+		private:
+			static constexpr std::uint64_t awake {0};
+			static constexpr std::uint64_t asleep {std::numeric_limits<std::uint64_t>::max()};
+
+			duration resolution_;
+			time_point epoch_;
+			mutable std::mutex mut_;
+			std::condition_variable cv_;
+			timer_wheel wheel_;
+
+			// The tick the timer thread is sleeping until; a timer due
+			// earlier has to wake it.
+			std::uint64_t wake_tick_ {awake};
+			bool stop_requested_ {false};
+			std::thread thread_;
+
+			// Rounded up, so that a timer never fires before its deadline.
+			[[nodiscard]] std::uint64_t tick_at(time_point tp) const noexcept
+			{
+				if (tp <= epoch_)
+				{
+					return 0;
+				}
+
+				const auto d {tp - epoch_};
+				return static_cast<std::uint64_t>(d / resolution_) + (d % resolution_ != duration::zero());
+			}
+
+			[[nodiscard]] std::uint64_t ticks_elapsed() const noexcept
+			{
+				return static_cast<std::uint64_t>((clock::now() - epoch_) / resolution_);
+			}
+
+			[[nodiscard]] time_point time_of(std::uint64_t tick) const noexcept
+			{
+				const auto limit {static_cast<std::uint64_t>((time_point::max() - epoch_) / resolution_)};
+				return tick >= limit ? time_point::max() : epoch_ + resolution_ * static_cast<duration::rep>(tick);
+			}
+
+			// Returns false if the timer was cancelled before it could be
+			// added, or the context is stopping; the caller completes it.
+			[[nodiscard]] bool submit(timer_base* t, time_point deadline) noexcept
+			{
+				std::lock_guard l {mut_};
+				if (stop_requested_ || t->state == timer_state::cancelled)
+				{
+					return false;
+				}
+
+				t->tick = tick_at(deadline);
+				t->state = timer_state::pending;
+				wheel_.insert(t);
+				if (t->tick < wake_tick_)
+				{
+					cv_.notify_one();
+				}
+
+				return true;
+			}
+
+			// Returns true if the timer was taken out of the wheel before it
+			// came due, in which case the caller completes it.
+			[[nodiscard]] bool cancel(timer_base* t) noexcept
+			{
+				std::lock_guard l {mut_};
+				switch (t->state)
+				{
+					case timer_state::pending:
+						wheel_.remove(t);
+						t->state = timer_state::cancelled;
+						return true;
+					case timer_state::idle:
+						t->state = timer_state::cancelled;
+						return false;
+					default:
+						return false;
+				}
+			}
+
+			void run() noexcept
+			{
+				std::unique_lock l {mut_};
+				while (true)
+				{
+					timer_list expired;
+					wheel_.advance(ticks_elapsed(), expired);
+
+					const auto stopping {stop_requested_};
+					if (stopping)
+					{
+						wheel_.clear(expired);
+					}
+
+					if (!expired.empty())
+					{
+						for (auto t {expired.front()}; t != nullptr; t = t->next)
+						{
+							t->state = timer_state::firing;
+						}
+
+						l.unlock();
+						for (auto t {expired.front()}; t != nullptr;)
+						{
+							// Completing may end the operation the timer is part of.
+							const auto next {t->next};
+							t->complete(t, stopping);
+							t = next;
+						}
+
+						l.lock();
+						continue;
+					}
+
+					if (stopping)
+					{
+						return;
+					}
+
+					if (const auto next {wheel_.next_tick()}; next)
+					{
+						wake_tick_ = *next;
+						cv_.wait_until(l, std::min(time_of(*next), clock::now() + std::chrono::hours{1}));
+					}
+					else
+					{
+						wake_tick_ = asleep;
+						cv_.wait(l);
+					}
+
+					wake_tick_ = awake;
+				}
+			}
+	};
+
+	template<cmoon::execution::receiver R>
+	struct timer_operation : public timer_base
+	{
+		public:
+			using clock = timer_context::clock;
+			using time_point = timer_context::time_point;
+
+			timer_operation(timer_context& ctx, R&& r, time_point deadline, bool relative)
+				: ctx_{ctx}, r_{std::forward<R>(r)}, deadline_{deadline}, relative_{relative}
+			{
+				this->complete = [](timer_base* t, bool stopped) noexcept
+				{
+					auto& op = *static_cast<timer_operation*>(t);
+					op.callback_.reset();
+					if (stopped || cmoon::execution::get_stop_token(op.r_).stop_requested())
+					{
+						cmoon::execution::set_done(std::move(op.r_));
+					}
+					else
+					{
+						cmoon::execution::set_value(std::move(op.r_));
+					}
+				};
+			}
+
+			timer_operation(const timer_operation&) = delete;
+			timer_operation& operator=(const timer_operation&) = delete;
+
+			friend void tag_invoke(cmoon::execution::start_t, timer_operation& o) noexcept
+			{
+				o.start_helper();
+			}
+		private:
+			struct cancel_fn
+			{
+				timer_operation* op_;
+
+				void operator()() noexcept
+				{
+					op_->cancel();
+				}
+			};
+
+			using stop_token_type = cmoon::execution::stop_token_of_t<R&>;
+
+			timer_context& ctx_;
+			R r_;
+			time_point deadline_;
+			bool relative_;
+			std::optional<typename stop_token_type::template callback_type<cancel_fn>> callback_;
+
+			void start_helper() noexcept
+			{
+				if (relative_)
+				{
+					// deadline_ holds the delay until now.
+					const auto now {clock::now()};
+					const auto delay {deadline_.time_since_epoch()};
+					deadline_ = delay >= time_point::max() - now ? time_point::max() : now + delay;
+				}
+
+				if constexpr (!cmoon::unstoppable_token<stop_token_type>)
+				{
+					// May cancel straight away, in which case submit reports
+					// it.
+					callback_.emplace(cmoon::execution::get_stop_token(r_), cancel_fn{this});
+				}
+
+				if (!ctx_.submit(this, deadline_))
+				{
+					callback_.reset();
+					cmoon::execution::set_done(std::move(r_));
+				}
+			}
+
+			void cancel() noexcept
+			{
+				if (ctx_.cancel(this))
+				{
+					callback_.reset();
+					cmoon::execution::set_done(std::move(r_));
+				}
+			}
+	};
+}
\ No newline at end of file
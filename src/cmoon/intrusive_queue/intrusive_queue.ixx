@@ -36,6 +36,11 @@ namespace cmoon
 				return head_ == nullptr;
 			}
 
+			[[nodiscard]] constexpr Item* front() const noexcept
+			{
+				return head_;
+			}
+
 			[[nodiscard]] constexpr Item* pop_front() noexcept
 			{
 				auto item {std::exchange(head_, head_->*Next)};
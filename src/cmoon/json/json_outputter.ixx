@@ -3,6 +3,7 @@ export module cmoon.json.json_outputter;
 import <iostream>;
 import <functional>;
 import <variant>;
+import <iterator>;
 
 import cmoon.json.json_value;
 
@@ -102,7 +103,7 @@ namespace cmoon::json
 				for(auto it = std::cbegin(list); it != std::cend(list); ++it)
 				{
 					operator()(*it);
-					if ((it + 1) != std::cend(list))
+					if (std::next(it) != std::cend(list))
 					{
 						os.get() << ", ";
 					}
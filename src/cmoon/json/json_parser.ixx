@@ -4,9 +4,11 @@ import <iostream>;
 import <string_view>;
 import <stack>;
 import <utility>;
+import <cctype>;
 
 import cmoon.string;
 import cmoon.json.json_value;
+import cmoon.json.invalid_json;
 
 namespace cmoon::json
 {
@@ -119,7 +121,7 @@ namespace cmoon::json
 							break;
 						case token_type::integer:
 							{
-								const auto integer = collin::from_string<json_int_type>(token);
+								const auto integer = cmoon::from_string<json_int_type>(std::basic_string_view<json_char_type>{token});
 								if (state_stack.empty())
 								{
 									state_stack.emplace(integer);
@@ -133,7 +135,7 @@ namespace cmoon::json
 							break;
 						case token_type::floating:
 							{
-								const auto floating = collin::from_string<json_float_type>(token);
+								const auto floating = cmoon::from_string<json_float_type>(std::basic_string_view<json_char_type>{token});
 								if (state_stack.empty())
 								{
 									state_stack.emplace(floating);
@@ -222,7 +224,7 @@ namespace cmoon::json
 
 			static token_type get_token(std::basic_istream<json_char_type>& is, const parse_state state, json_string_type& out)
 			{
-				std::basic_istream<json_char_type>::sentry se(is);
+				typename std::basic_istream<json_char_type>::sentry se(is);
 				auto sb = is.rdbuf();
 
 				while(true)
@@ -289,7 +291,7 @@ namespace cmoon::json
 								auto i {0};
 								while (((ch = sb->sbumpc()) != eof) && i++ < 4)
 								{
-									const auto hex_value = collin::hex_to_base10(ch);
+									const auto hex_value = cmoon::hex_to_base10(ch);
 									if (hex_value < 0 || hex_value > 15)
 									{
 										is.setstate(std::ios::failbit);
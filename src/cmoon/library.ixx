@@ -46,6 +46,7 @@ namespace cmoon
 		stats,
 		stemmer,
 		string,
+		test,
 		thread,
 		type_traits,
 		utility,
@@ -7,9 +7,12 @@ import <algorithm>;
 import <numeric>;
 import <span>;
 import <functional>;
+import <stdexcept>;
 
 import cmoon.utility;
 
+import cmoon.linear.matrix_expression;
+
 namespace cmoon::linear
 {
 	export
@@ -154,9 +157,25 @@ namespace cmoon::linear
 			using iterator = column_iterator<element_type, RowSize>;
 			using reverse_iterator = std::reverse_iterator<iterator>;
 
+			static constexpr std::size_t num_rows {Extent};
+			static constexpr std::size_t num_columns {1};
+
 			constexpr column(pointer first, size_type size, size_type row_size) noexcept
 				: storage_{first, size, row_size} {}
 
+			template<matrix_expression_type E>
+				requires(!std::is_const_v<element_type>)
+			constexpr column& operator=(const E& e)
+			{
+				if (rows() != e.rows() || cols() != e.cols())
+				{
+					throw std::invalid_argument{"cannot assign matrices of different dimension sizes"};
+				}
+
+				assign_elementwise(*this, e);
+				return *this;
+			}
+
 			[[nodiscard]] constexpr iterator begin() const noexcept
 			{
 				return {data(), row_size()};
@@ -207,6 +226,16 @@ namespace cmoon::linear
 				return storage_.row_size();
 			}
 
+			[[nodiscard]] constexpr size_type rows() const noexcept
+			{
+				return size();
+			}
+
+			[[nodiscard]] constexpr size_type cols() const noexcept
+			{
+				return 1;
+			}
+
 			[[nodiscard]] constexpr bool empty() const noexcept
 			{
 				return size() == 0;
@@ -258,6 +287,30 @@ namespace cmoon::linear
 				return *this;
 			}
 
+			template<matrix_expression_type E>
+			constexpr column& operator+=(const E& other)
+			{
+				if (rows() != other.rows() || cols() != other.cols())
+				{
+					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
+				}
+
+				apply_elementwise(*this, other, std::plus<>{});
+				return *this;
+			}
+
+			template<matrix_expression_type E>
+			constexpr column& operator-=(const E& other)
+			{
+				if (rows() != other.rows() || cols() != other.cols())
+				{
+					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
+				}
+
+				apply_elementwise(*this, other, std::minus<>{});
+				return *this;
+			}
+
 			constexpr column& operator*=(const_reference other) noexcept
 			{
 				std::transform(begin(), end(), begin(), std::bind(std::multiplies{}, std::placeholders::_1, other));
@@ -296,6 +349,39 @@ namespace cmoon::linear
 				return {data(), size(), row_size()};
 			}
 
+			template<class T2, std::size_t Extent2, std::size_t RowSize2>
+			[[nodiscard]] friend constexpr auto operator+(const column& lhs, const column<T2, Extent2, RowSize2>& rhs)
+			{
+				return make_elementwise<std::plus<>>(lhs, rhs, "cannot add columns of different sizes");
+			}
+
+			template<class T2, std::size_t Extent2, std::size_t RowSize2>
+			[[nodiscard]] friend constexpr auto operator-(const column& lhs, const column<T2, Extent2, RowSize2>& rhs)
+			{
+				return make_elementwise<std::minus<>>(lhs, rhs, "cannot subtract columns of different sizes");
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v * rep; })
+			[[nodiscard]] friend constexpr auto operator*(const column& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::multiplies<>, column, Rep>{lhs, rhs};
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v / rep; })
+			[[nodiscard]] friend constexpr auto operator/(const column& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::divides<>, column, Rep>{lhs, rhs};
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v % rep; })
+			[[nodiscard]] friend constexpr auto operator%(const column& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::modulus<>, column, Rep>{lhs, rhs};
+			}
+
 			template<std::size_t Extent2, std::size_t RowSize2>
 			[[nodiscard]] friend constexpr bool operator==(const column& lhs, const column<T, Extent2, RowSize2>& rhs) noexcept
 			{
@@ -360,6 +446,10 @@ namespace cmoon::linear
 				storage_type<cmoon::extent_type<Extent>, cmoon::extent_type<RowSize>>,
 				storage_type2<cmoon::extent_type<Extent>, cmoon::extent_type<RowSize>>> storage_;
 	};
+
+	export
+	template<class T, std::size_t Extent, std::size_t RowSize>
+	constexpr bool enable_matrix_view<column<T, Extent, RowSize>> = true;
 }
 
 namespace std
@@ -0,0 +1,787 @@
+module;
+
+#include "cmoon/linear/matrix_definitions.hpp"
+
+export module cmoon.linear.decomposition;
+
+import <cstddef>;
+import <cmath>;
+import <algorithm>;
+import <concepts>;
+import <memory>;
+import <span>;
+import <stdexcept>;
+import <type_traits>;
+import <vector>;
+
+import cmoon.linear.is_matrix;
+import cmoon.linear.gemm;
+import cmoon.linear.matrix_expression;
+import cmoon.linear.matrix;
+import cmoon.linear.static_matrix;
+
+namespace cmoon::linear
+{
+	// Columns factored together before the trailing matrix is updated
+	// through the GEMM kernel.
+	inline constexpr std::size_t decomposition_block_size {64};
+
+	// Integral matrices are factored in long double so that results such as
+	// determinants can be rounded back exactly.
+	export
+	template<class T>
+	using decomposition_value_t = std::conditional_t<std::floating_point<T>, T, long double>;
+
+	template<class M, class T, std::size_t Rows = std::dynamic_extent, std::size_t Cols = std::dynamic_extent>
+	struct rebind_matrix;
+
+	template<class Rep, class Allocator, class T, std::size_t Rows, std::size_t Cols>
+	struct rebind_matrix<matrix<Rep, Allocator>, T, Rows, Cols>
+	{
+		using type = matrix<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+	};
+
+	template<class Rep, std::size_t R, std::size_t C, class T, std::size_t Rows, std::size_t Cols>
+	struct rebind_matrix<static_matrix<Rep, R, C>, T, Rows, Cols>
+	{
+		using type = static_matrix<T, Rows == std::dynamic_extent ? R : Rows, Cols == std::dynamic_extent ? C : Cols>;
+	};
+
+	template<class M, class T, std::size_t Rows = std::dynamic_extent, std::size_t Cols = std::dynamic_extent>
+	using rebind_matrix_t = typename rebind_matrix<M, T, Rows, Cols>::type;
+
+	template<class M>
+	constexpr std::size_t static_columns {std::dynamic_extent};
+
+	template<class Rep, std::size_t Rows, std::size_t Cols>
+	constexpr std::size_t static_columns<static_matrix<Rep, Rows, Cols>> {Cols};
+
+	template<matrix_type M>
+	[[nodiscard]] M make_matrix(std::size_t rows, std::size_t cols)
+	{
+		if constexpr (static_matrix_type<M>)
+		{
+			return M{};
+		}
+		else
+		{
+			return M(rows, cols);
+		}
+	}
+
+	template<matrix_type M, matrix_type Source>
+	[[nodiscard]] M converted_copy(const Source& source)
+	{
+		auto m = make_matrix<M>(source.rows(), source.cols());
+		assign_elementwise(m.data(), source);
+		return m;
+	}
+
+	template<matrix_type M>
+	[[nodiscard]] M make_identity(std::size_t size)
+	{
+		auto m = make_matrix<M>(size, size);
+		for (std::size_t i {0}; i < size; ++i)
+		{
+			m(i, i) = typename M::value_type{1};
+		}
+
+		return m;
+	}
+
+	// C -= A * B, where A is m x k, B is k x n and C is m x n.
+	template<class T>
+	void subtract_product(std::size_t m, std::size_t n, std::size_t k,
+						  const T* a, std::size_t lda,
+						  const T* b, std::size_t ldb,
+						  T* c, std::size_t ldc)
+	{
+		std::vector<T> negated(m * k);
+		for (std::size_t i {0}; i < m; ++i)
+		{
+			for (std::size_t p {0}; p < k; ++p)
+			{
+				negated[i * k + p] = -a[i * lda + p];
+			}
+		}
+
+		gemm(m, n, k, negated.data(), k, b, ldb, c, ldc);
+	}
+
+	// Computes P * A = L * U with partial pivoting, where L is unit lower
+	// triangular and U is upper triangular. Both are stored in one matrix.
+	// The factorization is blocked: each panel of columns is factored on its
+	// own, and the rest of the matrix is then updated through the GEMM
+	// kernel.
+	export
+	template<matrix_type M>
+	class lu_decomposition
+	{
+		public:
+			using factor_type = M;
+			using value_type = typename M::value_type;
+
+			template<matrix_type Source>
+			explicit lu_decomposition(const Source& m)
+			{
+				if (m.rows() != m.cols())
+				{
+					throw std::invalid_argument{"can only find the LU decomposition of a square matrix"};
+				}
+
+				lu_ = converted_copy<M>(m);
+				pivots_.resize(m.rows());
+				factor();
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return lu_.rows();
+			}
+
+			[[nodiscard]] bool singular() const noexcept
+			{
+				return singular_;
+			}
+
+			// The row swapped with row i while factoring column i, in order.
+			[[nodiscard]] const std::vector<std::size_t>& pivots() const noexcept
+			{
+				return pivots_;
+			}
+
+			[[nodiscard]] M lower() const
+			{
+				const auto n = size();
+				auto l = make_identity<M>(n);
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					std::copy_n(lu_.data() + i * n, i, l.data() + i * n);
+				}
+
+				return l;
+			}
+
+			[[nodiscard]] M upper() const
+			{
+				const auto n = size();
+				auto u = make_matrix<M>(n, n);
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					std::copy(lu_.data() + i * n + i, lu_.data() + (i + 1) * n, u.data() + i * n + i);
+				}
+
+				return u;
+			}
+
+			[[nodiscard]] value_type determinant() const noexcept
+			{
+				if (singular_)
+				{
+					return value_type{0};
+				}
+
+				value_type det {static_cast<value_type>(sign_)};
+				for (std::size_t i {0}; i < size(); ++i)
+				{
+					det *= lu_(i, i);
+				}
+
+				return det;
+			}
+
+			// Solves A * X = B for every column of B.
+			template<matrix_type B>
+			[[nodiscard]] rebind_matrix_t<B, value_type> solve(const B& b) const
+			{
+				if (b.rows() != size())
+				{
+					throw std::invalid_argument{"right-hand side does not match the decomposition"};
+				}
+
+				auto x = converted_copy<rebind_matrix_t<B, value_type>>(b);
+				solve_in_place(x.data(), x.cols());
+				return x;
+			}
+
+			[[nodiscard]] M inverse() const
+			{
+				auto x = make_identity<M>(size());
+				solve_in_place(x.data(), size());
+				return x;
+			}
+		private:
+			M lu_;
+			std::vector<std::size_t> pivots_;
+			int sign_ {1};
+			bool singular_ {false};
+
+			void factor()
+			{
+				const auto n = size();
+				const auto a = lu_.data();
+
+				for (std::size_t k {0}; k < n; k += decomposition_block_size)
+				{
+					const auto panel_end = std::min(k + decomposition_block_size, n);
+
+					// Rows are swapped across the whole matrix, so the columns
+					// right of the panel pick up the same permutation.
+					for (std::size_t j {k}; j < panel_end; ++j)
+					{
+						auto p = j;
+						for (std::size_t i {j + 1}; i < n; ++i)
+						{
+							if (std::abs(a[i * n + j]) > std::abs(a[p * n + j]))
+							{
+								p = i;
+							}
+						}
+
+						pivots_[j] = p;
+						if (a[p * n + j] == value_type{0})
+						{
+							singular_ = true;
+							continue;
+						}
+
+						if (p != j)
+						{
+							std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+							sign_ = -sign_;
+						}
+
+						const auto pivot_row = a + j * n;
+						for (std::size_t i {j + 1}; i < n; ++i)
+						{
+							const auto row = a + i * n;
+							const auto l = row[j] /= pivot_row[j];
+							for (std::size_t c {j + 1}; c < panel_end; ++c)
+							{
+								row[c] -= l * pivot_row[c];
+							}
+						}
+					}
+
+					if (panel_end == n)
+					{
+						break;
+					}
+
+					const auto trailing = n - panel_end;
+
+					// U12 = inverse(L11) * A12
+					for (std::size_t j {k + 1}; j < panel_end; ++j)
+					{
+						const auto row = a + j * n + panel_end;
+						for (std::size_t i {k}; i < j; ++i)
+						{
+							const auto l = a[j * n + i];
+							const auto upper_row = a + i * n + panel_end;
+							for (std::size_t c {0}; c < trailing; ++c)
+							{
+								row[c] -= l * upper_row[c];
+							}
+						}
+					}
+
+					// A22 -= L21 * U12
+					subtract_product(trailing, trailing, panel_end - k,
+									 a + panel_end * n + k, n,
+									 a + k * n + panel_end, n,
+									 a + panel_end * n + panel_end, n);
+				}
+			}
+
+			void solve_in_place(value_type* x, std::size_t k) const
+			{
+				if (singular_)
+				{
+					throw std::invalid_argument{"cannot solve a singular system"};
+				}
+
+				const auto n = size();
+				const auto a = lu_.data();
+
+				for (std::size_t j {0}; j < n; ++j)
+				{
+					if (pivots_[j] != j)
+					{
+						std::swap_ranges(x + j * k, x + (j + 1) * k, x + pivots_[j] * k);
+					}
+				}
+
+				for (std::size_t i {1}; i < n; ++i)
+				{
+					const auto row = x + i * k;
+					for (std::size_t j {0}; j < i; ++j)
+					{
+						const auto l = a[i * n + j];
+						const auto solved = x + j * k;
+						for (std::size_t c {0}; c < k; ++c)
+						{
+							row[c] -= l * solved[c];
+						}
+					}
+				}
+
+				for (std::size_t i {n}; i-- > 0;)
+				{
+					const auto row = x + i * k;
+					for (std::size_t j {i + 1}; j < n; ++j)
+					{
+						const auto u = a[i * n + j];
+						const auto solved = x + j * k;
+						for (std::size_t c {0}; c < k; ++c)
+						{
+							row[c] -= u * solved[c];
+						}
+					}
+
+					const auto d = a[i * n + i];
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						row[c] /= d;
+					}
+				}
+			}
+	};
+
+	template<matrix_type Source>
+	lu_decomposition(const Source&) -> lu_decomposition<rebind_matrix_t<Source, decomposition_value_t<typename Source::value_type>>>;
+
+	// Computes A = L * transpose(L) for a symmetric positive definite A, where
+	// L is lower triangular. Only the lower triangle of A is read. Like the LU
+	// decomposition, it is blocked over panels of columns.
+	export
+	template<matrix_type M>
+	class cholesky_decomposition
+	{
+		public:
+			using factor_type = M;
+			using value_type = typename M::value_type;
+
+			template<matrix_type Source>
+			explicit cholesky_decomposition(const Source& m)
+			{
+				if (m.rows() != m.cols())
+				{
+					throw std::invalid_argument{"can only find the Cholesky decomposition of a square matrix"};
+				}
+
+				l_ = converted_copy<M>(m);
+				factor();
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return l_.rows();
+			}
+
+			[[nodiscard]] const M& lower() const noexcept
+			{
+				return l_;
+			}
+
+			[[nodiscard]] value_type determinant() const noexcept
+			{
+				value_type det {1};
+				for (std::size_t i {0}; i < size(); ++i)
+				{
+					det *= l_(i, i);
+				}
+
+				return det * det;
+			}
+
+			template<matrix_type B>
+			[[nodiscard]] rebind_matrix_t<B, value_type> solve(const B& b) const
+			{
+				if (b.rows() != size())
+				{
+					throw std::invalid_argument{"right-hand side does not match the decomposition"};
+				}
+
+				auto x = converted_copy<rebind_matrix_t<B, value_type>>(b);
+				solve_in_place(x.data(), x.cols());
+				return x;
+			}
+
+			[[nodiscard]] M inverse() const
+			{
+				auto x = make_identity<M>(size());
+				solve_in_place(x.data(), size());
+				return x;
+			}
+		private:
+			M l_;
+
+			void factor()
+			{
+				const auto n = size();
+				const auto a = l_.data();
+
+				for (std::size_t k {0}; k < n; k += decomposition_block_size)
+				{
+					const auto panel_end = std::min(k + decomposition_block_size, n);
+
+					for (std::size_t j {k}; j < panel_end; ++j)
+					{
+						const auto row_j = a + j * n;
+						auto d = row_j[j];
+						for (std::size_t p {k}; p < j; ++p)
+						{
+							d -= row_j[p] * row_j[p];
+						}
+
+						if (!(d > value_type{0}))
+						{
+							throw std::invalid_argument{"matrix is not positive definite"};
+						}
+
+						const auto diagonal = std::sqrt(d);
+						row_j[j] = diagonal;
+
+						for (std::size_t i {j + 1}; i < n; ++i)
+						{
+							const auto row_i = a + i * n;
+							auto s = row_i[j];
+							for (std::size_t p {k}; p < j; ++p)
+							{
+								s -= row_i[p] * row_j[p];
+							}
+
+							row_i[j] = s / diagonal;
+						}
+					}
+
+					if (panel_end == n)
+					{
+						break;
+					}
+
+					// A22 -= L21 * transpose(L21). The whole block is updated,
+					// but only its lower triangle is read from here on.
+					const auto trailing = n - panel_end;
+					const auto width = panel_end - k;
+
+					std::vector<value_type> transposed(width * trailing);
+					for (std::size_t i {0}; i < trailing; ++i)
+					{
+						for (std::size_t p {0}; p < width; ++p)
+						{
+							transposed[p * trailing + i] = a[(panel_end + i) * n + k + p];
+						}
+					}
+
+					subtract_product(trailing, trailing, width,
+									 a + panel_end * n + k, n,
+									 transposed.data(), trailing,
+									 a + panel_end * n + panel_end, n);
+				}
+
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					std::fill(a + i * n + i + 1, a + (i + 1) * n, value_type{0});
+				}
+			}
+
+			void solve_in_place(value_type* x, std::size_t k) const
+			{
+				const auto n = size();
+				const auto a = l_.data();
+
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					const auto row = x + i * k;
+					for (std::size_t j {0}; j < i; ++j)
+					{
+						const auto l = a[i * n + j];
+						const auto solved = x + j * k;
+						for (std::size_t c {0}; c < k; ++c)
+						{
+							row[c] -= l * solved[c];
+						}
+					}
+
+					const auto d = a[i * n + i];
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						row[c] /= d;
+					}
+				}
+
+				for (std::size_t i {n}; i-- > 0;)
+				{
+					const auto row = x + i * k;
+					for (std::size_t j {i + 1}; j < n; ++j)
+					{
+						const auto l = a[j * n + i];
+						const auto solved = x + j * k;
+						for (std::size_t c {0}; c < k; ++c)
+						{
+							row[c] -= l * solved[c];
+						}
+					}
+
+					const auto d = a[i * n + i];
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						row[c] /= d;
+					}
+				}
+			}
+	};
+
+	template<matrix_type Source>
+	cholesky_decomposition(const Source&) -> cholesky_decomposition<rebind_matrix_t<Source, decomposition_value_t<typename Source::value_type>>>;
+
+	// Computes A = Q * R for an m x n matrix with m >= n using Householder
+	// reflections. R is stored in the upper triangle and the reflectors
+	// below it. Reflectors are applied a row at a time so that every update
+	// walks contiguous memory.
+	export
+	template<matrix_type M>
+	class qr_decomposition
+	{
+		public:
+			using factor_type = M;
+			using value_type = typename M::value_type;
+
+			template<matrix_type Source>
+			explicit qr_decomposition(const Source& m)
+			{
+				if (m.rows() < m.cols())
+				{
+					throw std::invalid_argument{"can only find the QR decomposition of a matrix with at least as many rows as columns"};
+				}
+
+				qr_ = converted_copy<M>(m);
+				tau_.resize(m.cols());
+				factor();
+			}
+
+			[[nodiscard]] std::size_t rows() const noexcept
+			{
+				return qr_.rows();
+			}
+
+			[[nodiscard]] std::size_t cols() const noexcept
+			{
+				return qr_.cols();
+			}
+
+			// The thin m x n factor with orthonormal columns.
+			[[nodiscard]] M q() const
+			{
+				const auto m = rows();
+				const auto n = cols();
+
+				auto out = make_matrix<M>(m, n);
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					out(i, i) = value_type{1};
+				}
+
+				for (std::size_t j {n}; j-- > 0;)
+				{
+					apply_reflector(j, out.data(), n);
+				}
+
+				return out;
+			}
+
+			// The n x n upper triangular factor.
+			[[nodiscard]] rebind_matrix_t<M, value_type, static_columns<M>, static_columns<M>> r() const
+			{
+				const auto n = cols();
+				auto out = make_matrix<rebind_matrix_t<M, value_type, static_columns<M>, static_columns<M>>>(n, n);
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					std::copy(qr_.data() + i * n + i, qr_.data() + (i + 1) * n, out.data() + i * n + i);
+				}
+
+				return out;
+			}
+
+			// Finds the X that minimizes the norm of A * X - B for every
+			// column of B. For a square A this is the exact solution.
+			template<matrix_type B>
+			[[nodiscard]] auto solve(const B& b) const
+			{
+				using result_type = std::conditional_t<static_matrix_type<M> && static_matrix_type<B>,
+													   rebind_matrix_t<B, value_type, static_columns<M>>,
+													   matrix<value_type>>;
+
+				if (b.rows() != rows())
+				{
+					throw std::invalid_argument{"right-hand side does not match the decomposition"};
+				}
+
+				const auto n = cols();
+				const auto k = b.cols();
+
+				auto y = converted_copy<matrix<value_type>>(b);
+				for (std::size_t j {0}; j < n; ++j)
+				{
+					apply_reflector(j, y.data(), k);
+				}
+
+				auto x = make_matrix<result_type>(n, k);
+				std::copy_n(y.data(), n * k, x.data());
+
+				const auto a = qr_.data();
+				for (std::size_t i {n}; i-- > 0;)
+				{
+					const auto row = x.data() + i * k;
+					for (std::size_t j {i + 1}; j < n; ++j)
+					{
+						const auto r = a[i * n + j];
+						const auto solved = x.data() + j * k;
+						for (std::size_t c {0}; c < k; ++c)
+						{
+							row[c] -= r * solved[c];
+						}
+					}
+
+					const auto d = a[i * n + i];
+					if (d == value_type{0})
+					{
+						throw std::invalid_argument{"cannot solve a rank deficient system"};
+					}
+
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						row[c] /= d;
+					}
+				}
+
+				return x;
+			}
+		private:
+			M qr_;
+			std::vector<value_type> tau_;
+
+			void factor()
+			{
+				const auto m = rows();
+				const auto n = cols();
+				const auto a = qr_.data();
+
+				std::vector<value_type> w(n);
+
+				for (std::size_t j {0}; j < n; ++j)
+				{
+					value_type norm {0};
+					for (std::size_t i {j}; i < m; ++i)
+					{
+						norm += a[i * n + j] * a[i * n + j];
+					}
+
+					norm = std::sqrt(norm);
+					if (norm == value_type{0})
+					{
+						tau_[j] = value_type{0};
+						continue;
+					}
+
+					const auto diagonal = a[j * n + j];
+					const auto beta = diagonal >= value_type{0} ? -norm : norm;
+					tau_[j] = (beta - diagonal) / beta;
+
+					const auto scale = value_type{1} / (diagonal - beta);
+					for (std::size_t i {j + 1}; i < m; ++i)
+					{
+						a[i * n + j] *= scale;
+					}
+
+					a[j * n + j] = beta;
+
+					// Applies the reflector to the columns right of j, with the
+					// implicit leading 1 of the reflector on row j.
+					const auto trailing = n - j - 1;
+					const auto first = a + j * n + j + 1;
+					std::copy_n(first, trailing, w.data());
+					for (std::size_t i {j + 1}; i < m; ++i)
+					{
+						const auto v = a[i * n + j];
+						const auto row = a + i * n + j + 1;
+						for (std::size_t c {0}; c < trailing; ++c)
+						{
+							w[c] += v * row[c];
+						}
+					}
+
+					for (std::size_t c {0}; c < trailing; ++c)
+					{
+						first[c] -= tau_[j] * w[c];
+					}
+
+					for (std::size_t i {j + 1}; i < m; ++i)
+					{
+						const auto v = tau_[j] * a[i * n + j];
+						const auto row = a + i * n + j + 1;
+						for (std::size_t c {0}; c < trailing; ++c)
+						{
+							row[c] -= v * w[c];
+						}
+					}
+				}
+			}
+
+			// Applies reflector j to an m x k row-major matrix from the left.
+			void apply_reflector(std::size_t j, value_type* x, std::size_t k) const
+			{
+				const auto tau = tau_[j];
+				if (tau == value_type{0})
+				{
+					return;
+				}
+
+				const auto m = rows();
+				const auto n = cols();
+				const auto a = qr_.data();
+
+				std::vector<value_type> w(x + j * k, x + (j + 1) * k);
+				for (std::size_t i {j + 1}; i < m; ++i)
+				{
+					const auto v = a[i * n + j];
+					const auto row = x + i * k;
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						w[c] += v * row[c];
+					}
+				}
+
+				const auto first = x + j * k;
+				for (std::size_t c {0}; c < k; ++c)
+				{
+					first[c] -= tau * w[c];
+				}
+
+				for (std::size_t i {j + 1}; i < m; ++i)
+				{
+					const auto v = tau * a[i * n + j];
+					const auto row = x + i * k;
+					for (std::size_t c {0}; c < k; ++c)
+					{
+						row[c] -= v * w[c];
+					}
+				}
+			}
+	};
+
+	template<matrix_type Source>
+	qr_decomposition(const Source&) -> qr_decomposition<rebind_matrix_t<Source, decomposition_value_t<typename Source::value_type>>>;
+
+	// Solves A * X = B through an LU decomposition of A. When several
+	// right-hand sides share the same A, keep the lu_decomposition and call
+	// solve on it instead.
+	export
+	template<matrix_type A, matrix_type B>
+	[[nodiscard]] auto solve(const A& a, const B& b)
+	{
+		const lu_decomposition lu {a};
+		return lu.solve(b);
+	}
+}
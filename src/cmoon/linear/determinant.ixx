@@ -2,15 +2,30 @@ export module cmoon.linear.determinant;
 
 import <stdexcept>;
 import <algorithm>;
-import <memory>;
+import <cmath>;
 import <concepts>;
 
 import cmoon.linear.matrix;
 import cmoon.linear.static_matrix;
-import cmoon.linear.pivot_elimination;
+import cmoon.linear.square_matrix;
+import cmoon.linear.decomposition;
 
 namespace cmoon::linear
 {
+	template<class T, class M>
+	[[nodiscard]] T lu_determinant(const M& m)
+	{
+		const auto det = lu_decomposition{m}.determinant();
+		if constexpr (std::integral<T>)
+		{
+			return static_cast<T>(std::round(det));
+		}
+		else
+		{
+			return static_cast<T>(det);
+		}
+	}
+
 	export
 	template<class T, class Allocator>
 	[[nodiscard]] T determinant(const matrix<T, Allocator>& m)
@@ -50,19 +65,8 @@ namespace cmoon::linear
 					(b*d*i) -
 					(c*e*g);
 		}
-			
-		matrix<long double, typename std::allocator_traits<Allocator>::template rebind_alloc<long double>> elim {size, size};
-		std::copy(std::begin(m), std::end(m), std::begin(elim));
-		const auto operations = pivot_elimination(elim);
-		const auto p = main_diagonal(elim).product();
-		if constexpr (std::integral<T>)
-		{
-			return static_cast<T>(std::round(p * operations));
-		}
-		else
-		{
-			return static_cast<T>(p * operations);
-		}
+
+		return lu_determinant<T>(m);
 	}
 
 	export
@@ -99,31 +103,18 @@ namespace cmoon::linear
 		}
 		else if (std::is_constant_evaluated())
 		{
-			int sign {1};
 			Rep result {0};
 
 			for(std::size_t f {0}; f < S; ++f)
 			{
-				result += sign * m(0, f) * cofactor(m, 0, f);
-				sign = -sign;
+				result += m(0, f) * cofactor(m, 0, f);
 			}
 
 			return result;
 		}
 		else
 		{
-			square_matrix<long double, S> elim;
-			std::copy(std::begin(m), std::end(m), std::begin(elim));
-			const auto operations = pivot_elimination(elim);
-			const auto p = main_diagonal(elim).product();
-			if constexpr (std::integral<Rep>)
-			{
-				return static_cast<Rep>(std::round(p * operations));
-			}
-			else
-			{
-				return static_cast<Rep>(p * operations);
-			}
+			return lu_determinant<Rep>(m);
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,292 @@
+export module cmoon.linear.gemm;
+
+import <cstddef>;
+import <cstdint>;
+import <algorithm>;
+import <concepts>;
+import <memory>;
+import <new>;
+import <type_traits>;
+import <vector>;
+
+import cmoon.simd.simd;
+import cmoon.simd.tag;
+
+namespace cmoon::linear
+{
+	export
+	inline constexpr std::size_t l1_cache_size {32 * 1024};
+
+	export
+	inline constexpr std::size_t l2_cache_size {256 * 1024};
+
+	export
+	inline constexpr std::size_t l3_cache_size {8 * 1024 * 1024};
+
+	inline constexpr std::size_t gemm_alignment {64};
+
+	template<class T>
+	concept gemm_vectorizable = std::same_as<T, float> ||
+								std::same_as<T, double> ||
+								std::same_as<T, std::int32_t>;
+
+	template<class T>
+	struct gemm_vector_width : std::integral_constant<std::size_t, 1> {};
+
+	template<gemm_vectorizable T>
+	struct gemm_vector_width<T> : std::integral_constant<std::size_t, cmoon::native_simd<T>::size()> {};
+
+	[[nodiscard]] constexpr std::size_t round_down(std::size_t value, std::size_t multiple) noexcept
+	{
+		return std::max(value / multiple, std::size_t{1}) * multiple;
+	}
+
+	[[nodiscard]] constexpr std::size_t round_up(std::size_t value, std::size_t multiple) noexcept
+	{
+		return ((value + multiple - 1) / multiple) * multiple;
+	}
+
+	// Blocking parameters of the packed GEMM. The micro-tile (mr x nr) is
+	// held entirely in registers, a kc x nr micro-panel of B is sized to stay
+	// in L1, an mc x kc block of A stays in L2, and a kc x nc panel of B
+	// stays in L3.
+	export
+	template<class T>
+	struct gemm_blocking
+	{
+		static constexpr std::size_t vector_width {gemm_vector_width<T>::value};
+		static constexpr std::size_t mr {4};
+		static constexpr std::size_t nr {vector_width == 1 ? 4 : 2 * vector_width};
+		static constexpr std::size_t kc {round_down(l1_cache_size / 2 / (nr * sizeof(T)), 8)};
+		static constexpr std::size_t mc {round_down(l2_cache_size / 2 / (kc * sizeof(T)), mr)};
+		static constexpr std::size_t nc {round_down(l3_cache_size / 2 / (kc * sizeof(T)), nr)};
+	};
+
+	template<class T>
+	class gemm_allocator
+	{
+		public:
+			using value_type = T;
+
+			gemm_allocator() noexcept = default;
+
+			template<class U>
+			gemm_allocator(const gemm_allocator<U>&) noexcept {}
+
+			[[nodiscard]] T* allocate(std::size_t n)
+			{
+				return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{gemm_alignment}));
+			}
+
+			void deallocate(T* p, std::size_t) noexcept
+			{
+				::operator delete(p, std::align_val_t{gemm_alignment});
+			}
+
+			[[nodiscard]] friend bool operator==(const gemm_allocator&, const gemm_allocator&) noexcept = default;
+	};
+
+	template<class T>
+	using gemm_buffer = std::vector<T, gemm_allocator<T>>;
+
+	// Packs an mb x kb block of A into row panels of height mr, each stored
+	// column by column so the micro-kernel reads it sequentially. Rows past
+	// the end of the block are padded with zeros.
+	template<class T, class A>
+	void pack_a(std::size_t mb, std::size_t kb, const A* a, std::size_t lda, T* out) noexcept
+	{
+		constexpr auto mr = gemm_blocking<T>::mr;
+
+		for (std::size_t ir {0}; ir < mb; ir += mr)
+		{
+			const auto rows = std::min(mr, mb - ir);
+			for (std::size_t p {0}; p < kb; ++p)
+			{
+				std::size_t i {0};
+				for (; i < rows; ++i)
+				{
+					out[i] = static_cast<T>(a[(ir + i) * lda + p]);
+				}
+
+				for (; i < mr; ++i)
+				{
+					out[i] = T{0};
+				}
+
+				out += mr;
+			}
+		}
+	}
+
+	// Packs a kb x nb block of B into column panels of width nr, each stored
+	// row by row. Columns past the end of the block are padded with zeros.
+	template<class T, class B>
+	void pack_b(std::size_t kb, std::size_t nb, const B* b, std::size_t ldb, T* out) noexcept
+	{
+		constexpr auto nr = gemm_blocking<T>::nr;
+
+		for (std::size_t jr {0}; jr < nb; jr += nr)
+		{
+			const auto cols = std::min(nr, nb - jr);
+			for (std::size_t p {0}; p < kb; ++p)
+			{
+				const auto row = b + p * ldb + jr;
+				std::size_t j {0};
+				for (; j < cols; ++j)
+				{
+					out[j] = static_cast<T>(row[j]);
+				}
+
+				for (; j < nr; ++j)
+				{
+					out[j] = T{0};
+				}
+
+				out += nr;
+			}
+		}
+	}
+
+	// Computes an mr x nr tile of C += A * B from packed panels. Only the
+	// leading m x n portion of the tile is written back, which handles the
+	// edges of the matrix.
+	template<class T>
+	void micro_kernel(std::size_t kb, const T* a, const T* b, T* c, std::size_t ldc, std::size_t m, std::size_t n) noexcept
+	{
+		using blocking = gemm_blocking<T>;
+		constexpr auto mr = blocking::mr;
+		constexpr auto nr = blocking::nr;
+
+		alignas(gemm_alignment) T tile[mr * nr];
+
+		if constexpr (gemm_vectorizable<T>)
+		{
+			using vector_t = cmoon::native_simd<T>;
+			constexpr auto w = vector_t::size();
+			constexpr auto nv = nr / w;
+
+			vector_t acc[mr][nv];
+			for (std::size_t i {0}; i < mr; ++i)
+			{
+				for (std::size_t j {0}; j < nv; ++j)
+				{
+					acc[i][j] = vector_t{T{0}};
+				}
+			}
+
+			for (std::size_t p {0}; p < kb; ++p)
+			{
+				vector_t bv[nv];
+				for (std::size_t j {0}; j < nv; ++j)
+				{
+					bv[j] = vector_t{b + j * w, cmoon::vector_aligned};
+				}
+
+				for (std::size_t i {0}; i < mr; ++i)
+				{
+					const vector_t av {a[i]};
+					for (std::size_t j {0}; j < nv; ++j)
+					{
+						acc[i][j] = fma(av, bv[j], acc[i][j]);
+					}
+				}
+
+				a += mr;
+				b += nr;
+			}
+
+			for (std::size_t i {0}; i < mr; ++i)
+			{
+				for (std::size_t j {0}; j < nv; ++j)
+				{
+					acc[i][j].copy_to(tile + i * nr + j * w, cmoon::vector_aligned);
+				}
+			}
+		}
+		else
+		{
+			std::fill(tile, tile + mr * nr, T{0});
+
+			for (std::size_t p {0}; p < kb; ++p)
+			{
+				for (std::size_t i {0}; i < mr; ++i)
+				{
+					for (std::size_t j {0}; j < nr; ++j)
+					{
+						tile[i * nr + j] += a[i] * b[j];
+					}
+				}
+
+				a += mr;
+				b += nr;
+			}
+		}
+
+		for (std::size_t i {0}; i < m; ++i)
+		{
+			for (std::size_t j {0}; j < n; ++j)
+			{
+				c[i * ldc + j] += tile[i * nr + j];
+			}
+		}
+	}
+
+	template<class T>
+	void macro_kernel(std::size_t mb, std::size_t nb, std::size_t kb, const T* a_pack, const T* b_pack, T* c, std::size_t ldc) noexcept
+	{
+		using blocking = gemm_blocking<T>;
+
+		for (std::size_t jr {0}; jr < nb; jr += blocking::nr)
+		{
+			for (std::size_t ir {0}; ir < mb; ir += blocking::mr)
+			{
+				micro_kernel(kb,
+							 a_pack + ir * kb,
+							 b_pack + jr * kb,
+							 c + ir * ldc + jr,
+							 ldc,
+							 std::min(blocking::mr, mb - ir),
+							 std::min(blocking::nr, nb - jr));
+			}
+		}
+	}
+
+	// Computes C += A * B, where A is m x k, B is k x n and C is m x n, all
+	// stored row-major with the given leading dimensions. A and B are
+	// converted to T while being packed.
+	export
+	template<class T, class A, class B>
+	void gemm(std::size_t m, std::size_t n, std::size_t k,
+			  const A* a, std::size_t lda,
+			  const B* b, std::size_t ldb,
+			  T* c, std::size_t ldc)
+	{
+		using blocking = gemm_blocking<T>;
+
+		if (m == 0 || n == 0 || k == 0)
+		{
+			return;
+		}
+
+		gemm_buffer<T> a_pack(std::min(blocking::mc, round_up(m, blocking::mr)) * std::min(blocking::kc, k));
+		gemm_buffer<T> b_pack(std::min(blocking::nc, round_up(n, blocking::nr)) * std::min(blocking::kc, k));
+
+		for (std::size_t jc {0}; jc < n; jc += blocking::nc)
+		{
+			const auto nb = std::min(blocking::nc, n - jc);
+			for (std::size_t pc {0}; pc < k; pc += blocking::kc)
+			{
+				const auto kb = std::min(blocking::kc, k - pc);
+				pack_b(kb, nb, b + pc * ldb + jc, ldb, b_pack.data());
+
+				for (std::size_t ic {0}; ic < m; ic += blocking::mc)
+				{
+					const auto mb = std::min(blocking::mc, m - ic);
+					pack_a(mb, kb, a + ic * lda + pc, lda, a_pack.data());
+
+					macro_kernel(mb, nb, kb, a_pack.data(), b_pack.data(), c + ic * ldc + jc, ldc);
+				}
+			}
+		}
+	}
+}
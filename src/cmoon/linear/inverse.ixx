@@ -5,24 +5,30 @@ import <type_traits>;
 import <stdexcept>;
 import <algorithm>;
 
-import cmoon.linear.is_matrix;
 import cmoon.linear.matrix;
 import cmoon.linear.static_matrix;
 import cmoon.linear.square_matrix;
 import cmoon.linear.gaussian_elimination;
 import cmoon.linear.determinant;
+import cmoon.linear.adjugate;
 
 namespace cmoon::linear
 {
+	export
 	template<class T, class Allocator>
-	[[nodiscard]] matrix<T, Allocator> inverse_impl(matrix<T, Allocator>& m)
+	[[nodiscard]] matrix<T, Allocator> inverse(const matrix<T, Allocator>& m)
 	{
-		auto identity = identity_matrix<T, Allocator>(m.rows());
-		return gaussian_elimination(m, identity);
+		if (!is_square_matrix(m))
+		{
+			throw std::invalid_argument{"can only find the inverse of a square matrix"};
+		}
+
+		return gaussian_elimination(m, identity_matrix<T, Allocator>(m.rows()));
 	}
 
+	export
 	template<class T, std::size_t S>
-	[[nodiscard]] square_matrix<T, S> inverse(square_matrix<T, S>& m)
+	[[nodiscard]] constexpr square_matrix<T, S> inverse(const square_matrix<T, S>& m)
 	{
 		if (std::is_constant_evaluated())
 		{
@@ -44,23 +50,7 @@ namespace cmoon::linear
 		}
 		else
 		{
-			auto identity = identity_matrix<T, S>();
-			return gaussian_elimination(m, identity);
+			return gaussian_elimination(m, identity_matrix<T, S>());
 		}
 	}
-	
-	export
-	template<matrix_type M>
-	[[nodiscard]] auto inverse(M m)
-	{
-		return inverse_impl(m);
-	}
-
-	export
-	template<matrix_type M>
-		requires(!std::is_lvalue_reference_v<M>)
-	[[nodiscard]] auto inverse(M&& m)
-	{
-		return inverse_impl(m);
-	}
 }
\ No newline at end of file
@@ -1,19 +1,24 @@
 export module cmoon.linear;
 export import cmoon.linear.is_matrix;
+export import cmoon.linear.matrix_expression;
 export import cmoon.linear.square_matrix;
 export import cmoon.linear.row;
 export import cmoon.linear.column;
 export import cmoon.linear.diagonal;
 export import cmoon.linear.rows_slice;
 export import cmoon.linear.columns_slice;
+export import cmoon.linear.gemm;
+export import cmoon.linear.matrix_multiplication;
 export import cmoon.linear.matrix;
 export import cmoon.linear.static_matrix;
+export import cmoon.linear.sparse_matrix;
 export import cmoon.linear.transpose;
 export import cmoon.linear.sub_matrix;
 export import cmoon.linear.trace;
 export import cmoon.linear.pivot_elimination;
+export import cmoon.linear.decomposition;
 export import cmoon.linear.back_substitution;
-export import cmoon.linear.gaussian_elimniation;
+export import cmoon.linear.gaussian_elimination;
 export import cmoon.linear.determinant;
 export import cmoon.linear.cofactor;
 export import cmoon.linear.adjugate;
@@ -9,6 +9,9 @@ import <initializer_list>;
 import <span>;
 import <stdexcept>;
 import <algorithm>;
+import <concepts>;
+import <type_traits>;
+import <utility>;
 
 import cmoon.multidimensional;
 
@@ -17,6 +20,8 @@ import cmoon.linear.column;
 import cmoon.linear.diagonal;
 import cmoon.linear.rows_slice;
 import cmoon.linear.columns_slice;
+import cmoon.linear.is_matrix;
+import cmoon.linear.matrix_expression;
 import cmoon.linear.matrix_multiplication;
 
 namespace cmoon::linear
@@ -56,6 +61,13 @@ namespace cmoon::linear
 			matrix(const static_matrix<Rep, R, C>& other, const Allocator& alloc = Allocator{})
 				: data_{other.data_, alloc} {}
 
+			template<matrix_expression_type E>
+			matrix(const E& e, const Allocator& alloc = Allocator{})
+				: data_{{e.rows(), e.cols()}, alloc}
+			{
+				assign_elementwise(data(), e);
+			}
+
 			matrix(matrix&&) noexcept = default;
 
 			matrix& operator=(const matrix&) = default;
@@ -74,6 +86,20 @@ namespace cmoon::linear
 				return *this;
 			}
 
+			template<matrix_expression_type E>
+			matrix& operator=(const E& e)
+			{
+				if (rows() != e.rows() || cols() != e.cols())
+				{
+					// The expression may refer to this matrix, so it cannot be
+					// resized in place.
+					return *this = matrix{e, get_allocator()};
+				}
+
+				assign_elementwise(data(), e);
+				return *this;
+			}
+
 			void resize(std::size_t rows, std::size_t cols)
 			{
 				data_.dimensions(rows, cols);
@@ -253,116 +279,62 @@ namespace cmoon::linear
 				return data_.size();
 			}
 
-			template<class Rep2>
-			[[nodiscard]] friend auto operator+(const matrix& lhs, const matrix<Rep2, Allocator>& rhs)
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, matrix> && matrix_type<std::remove_cvref_t<M2>>)
+			[[nodiscard]] friend auto operator+(M&& lhs, M2&& rhs)
 			{
-				if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
-				{
-					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
-				}
-
-				matrix<std::decay_t<decltype(std::declval<Rep>() + std::declval<Rep2>())>, Allocator> m {lhs.rows(), lhs.cols(), lhs.get_allocator()};
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::plus<>{});
-				return m;
+				return make_elementwise<std::plus<>>(std::forward<M>(lhs), std::forward<M2>(rhs), "cannot add matrices of different dimension sizes");
 			}
 
-			template<class Rep2, std::size_t Rows, std::size_t Cols>
-			[[nodiscard]] friend auto operator+(const matrix& lhs, const static_matrix<Rep2, Rows, Cols>& rhs)
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, matrix> && matrix_type<std::remove_cvref_t<M2>>)
+			[[nodiscard]] friend auto operator-(M&& lhs, M2&& rhs)
 			{
-				if (lhs.rows() != Rows || rhs.cols() != Cols)
-				{
-					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
-				}
-
-				matrix<std::decay_t<decltype(std::declval<Rep>() + std::declval<Rep2>())>, Allocator> m {lhs.rows(), lhs.cols()};
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::plus<>{});
-				return m;
+				return make_elementwise<std::minus<>>(std::forward<M>(lhs), std::forward<M2>(rhs), "cannot subtract matrices of different dimension sizes");
 			}
 
-			template<class Rep2>
-			[[nodiscard]] friend auto operator-(const matrix& lhs, const matrix<Rep2, Allocator>& rhs)
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, matrix> && !elementwise_operand<Rep2> && requires(value_type rep, Rep2 rep2) { rep * rep2; })
+			[[nodiscard]] friend auto operator*(M&& lhs, const Rep2& rhs)
 			{
-				if (lhs.rows() != rhs.rows() || rhs.cols() != rhs.cols())
-				{
-					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
-				}
-
-				matrix<std::decay_t<decltype(std::declval<Rep>() - std::declval<Rep2>())>, Allocator> m {lhs.rows(), lhs.cols(), lhs.get_allocator()};
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::minus<>{});
-				return m;
+				return make_scalar_expression<std::multiplies<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Rep2, std::size_t Rows, std::size_t Cols>
-			[[nodiscard]] friend auto operator-(const matrix& lhs, const static_matrix<Rep2, Rows, Cols>& rhs)
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, matrix> && !elementwise_operand<Rep2> && requires(value_type rep, Rep2 rep2) { rep / rep2; })
+			[[nodiscard]] friend auto operator/(M&& lhs, const Rep2& rhs)
 			{
-				if (lhs.rows() != Rows || rhs.cols() != Cols)
-				{
-					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
-				}
-
-				matrix<std::decay_t<decltype(std::declval<Rep>() - std::declval<Rep2>())>, Allocator> m{lhs.rows(), lhs.cols()};
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::minus<>{});
-				return m;
+				return make_scalar_expression<std::divides<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Rep2>
-				requires(requires(value_type rep, Rep2 rep2) { rep * rep2; })
-			[[nodiscard]] friend auto operator*(const matrix& lhs, const Rep2& rhs) noexcept
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, matrix> && !elementwise_operand<Rep2> && requires(value_type rep, Rep2 rep2) { rep % rep2; })
+			[[nodiscard]] friend auto operator%(M&& lhs, const Rep2& rhs)
 			{
-				matrix<std::decay_t<decltype(std::declval<Rep>() * std::declval<Rep2>())>, Allocator> m {lhs.rows(), lhs.cols(), lhs.get_allocator()};
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::multiplies{}, std::placeholders::_1, rhs));
-				return m;
+				return make_scalar_expression<std::modulus<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Rep2>
-				requires(requires(value_type rep, Rep2 rep2) { rep / rep2; })
-			[[nodiscard]] friend auto operator/(const matrix& lhs, const Rep2& rhs) noexcept
-			{
-				matrix<std::decay_t<decltype(std::declval<Rep>() / std::declval<Rep2>())>, Allocator> m{lhs.rows(), lhs.cols(), lhs.get_allocator()};
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::divides{}, std::placeholders::_1, rhs));
-				return m;
-			}
-
-			template<class Rep2>
-				requires(requires(value_type rep, Rep2 rep2) { rep % rep2; })
-			[[nodiscard]] friend auto operator%(const matrix& lhs, const Rep2& rhs) noexcept
-			{
-				matrix<std::decay_t<decltype(std::declval<Rep>() % std::declval<Rep2>())>, Allocator> m{lhs.rows(), lhs.cols(), lhs.get_allocator()};
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::modulus{}, std::placeholders::_1, rhs));
-				return m;
-			}
-				
-			matrix& operator+=(const matrix& other)
+			template<elementwise_operand E>
+			matrix& operator+=(const E& other)
 			{
 				if (rows() != other.rows() || cols() != other.cols())
 				{
 					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
 				}
 
-				std::transform(begin(), end(), other.begin(), begin(), std::plus<>{});
+				apply_elementwise(data(), other, std::plus<>{});
 				return *this;
 			}
 
-			matrix& operator-=(const matrix& other)
+			template<elementwise_operand E>
+			matrix& operator-=(const E& other)
 			{
 				if (rows() != other.rows() || cols() != other.cols())
 				{
 					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
 				}
 
-				std::transform(begin(), end(), other.begin(), begin(), std::minus<>{});
-				return *this;
-			}
-				
-			template<std::size_t Rows, std::size_t Cols>
-			matrix& operator-=(const static_matrix<Rep, Rows, Cols>& other)
-			{
-				if (rows() != Rows || cols() != Cols)
-				{
-					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
-				}
-
-				std::transform(begin(), end(), other.begin(), begin(), std::minus<>{});
+				apply_elementwise(data(), other, std::minus<>{});
 				return *this;
 			}
 
@@ -427,15 +399,25 @@ namespace cmoon::linear
 			throw std::invalid_argument {"cannot multiplies matrices that do not share columns with rows"};
 		}
 
-		if (is_square_matrix(lhs) && 
-			is_square_matrix(rhs) &&
-			cmoon::is_power_of_2(lhs.cols()))
+		return blocked_mult(lhs, rhs);
+	}
+
+	// Element-wise expressions are materialized once before being handed to
+	// the GEMM kernel.
+	export
+	template<class M1, class M2>
+		requires((matrix_type<M1> || matrix_expression_type<M1>) &&
+				 (matrix_type<M2> || matrix_expression_type<M2>) &&
+				 (matrix_expression_type<M1> || matrix_expression_type<M2>))
+	[[nodiscard]] auto operator*(const M1& lhs, const M2& rhs)
+	{
+		if constexpr (matrix_expression_type<M1>)
 		{
-			return details::strassen_mult_par(lhs, rhs);
+			return evaluate(lhs) * rhs;
 		}
 		else
 		{
-			return details::standard_mult(lhs, rhs);
+			return lhs * evaluate(rhs);
 		}
 	}
 
@@ -0,0 +1,349 @@
+module;
+
+#include "cmoon/linear/matrix_definitions.hpp"
+
+export module cmoon.linear.matrix_expression;
+
+import <cstddef>;
+import <concepts>;
+import <functional>;
+import <memory>;
+import <span>;
+import <stdexcept>;
+import <type_traits>;
+import <utility>;
+
+namespace cmoon::linear
+{
+	// Anything with a rows() x cols() shape and row-major flat indexing can
+	// be an operand of an element-wise expression. Rows are treated as
+	// 1 x n and columns as n x 1.
+	export
+	template<class T>
+	concept elementwise_operand = requires(const T& t, std::size_t i)
+	{
+		{ t.rows() } -> std::convertible_to<std::size_t>;
+		{ t.cols() } -> std::convertible_to<std::size_t>;
+		{ t.size() } -> std::convertible_to<std::size_t>;
+		t[i];
+	};
+
+	export
+	template<class Derived>
+	class matrix_expression;
+
+	export
+	template<class T>
+	constexpr bool is_matrix_expression_v = std::is_class_v<T> && std::derived_from<T, matrix_expression<T>>;
+
+	export
+	template<class T>
+	concept matrix_expression_type = is_matrix_expression_v<T>;
+
+	// Views such as row and column are cheap to copy and are often
+	// temporaries, so expressions hold them by value. Any other operand is
+	// held by reference when it is an lvalue and moved in when it is an
+	// rvalue, so that an expression kept past the end of the full
+	// expression that made it never refers to a destroyed temporary.
+	export
+	template<class T>
+	constexpr bool enable_matrix_view = false;
+
+	export
+	template<class T>
+	using operand_t = std::conditional_t<matrix_expression_type<std::remove_cvref_t<T>> || enable_matrix_view<std::remove_cvref_t<T>> || !std::is_lvalue_reference_v<T>,
+										 std::remove_cvref_t<T>,
+										 const std::remove_cvref_t<T>&>;
+
+	template<class T>
+	using operand_value_t = std::remove_cvref_t<decltype(std::declval<const T&>()[std::size_t{}])>;
+
+	template<class T>
+	struct operand_extents
+	{
+		static constexpr std::size_t rows {std::dynamic_extent};
+		static constexpr std::size_t cols {std::dynamic_extent};
+	};
+
+	template<class T>
+		requires(requires { T::num_rows; T::num_columns; })
+	struct operand_extents<T>
+	{
+		static constexpr std::size_t rows {T::num_rows};
+		static constexpr std::size_t cols {T::num_columns};
+	};
+
+	template<class T>
+	struct operand_allocator
+	{
+		using type = void;
+	};
+
+	template<class T>
+		requires(requires { typename T::allocator_type; })
+	struct operand_allocator<T>
+	{
+		using type = typename T::allocator_type;
+	};
+
+	[[nodiscard]] constexpr std::size_t common_extent(std::size_t lhs, std::size_t rhs) noexcept
+	{
+		return lhs != std::dynamic_extent ? lhs : rhs;
+	}
+
+	// An expression evaluates to a matrix using the allocator of its first
+	// dynamically sized operand. Without one, it evaluates to a static_matrix
+	// when the shape is known at compile time.
+	template<class Rep, class Allocator, std::size_t Rows, std::size_t Cols>
+	struct expression_result
+	{
+		using type = matrix<Rep, std::allocator<Rep>>;
+	};
+
+	template<class Rep, class Allocator, std::size_t Rows, std::size_t Cols>
+		requires(!std::is_void_v<Allocator>)
+	struct expression_result<Rep, Allocator, Rows, Cols>
+	{
+		using type = matrix<Rep, typename std::allocator_traits<Allocator>::template rebind_alloc<Rep>>;
+	};
+
+	template<class Rep, std::size_t Rows, std::size_t Cols>
+		requires(Rows != std::dynamic_extent && Cols != std::dynamic_extent)
+	struct expression_result<Rep, void, Rows, Cols>
+	{
+		using type = static_matrix<Rep, Rows, Cols>;
+	};
+
+	// Writes every element of e into out. Each element only reads the same
+	// index of its operands, so out may alias any of them.
+	export
+	template<class Out, elementwise_operand E>
+	constexpr void assign_elementwise(Out&& out, const E& e)
+	{
+		using value_type = std::remove_cvref_t<decltype(out[std::size_t{}])>;
+
+		const std::size_t n {e.size()};
+		for (std::size_t i {0}; i < n; ++i)
+		{
+			out[i] = static_cast<value_type>(e[i]);
+		}
+	}
+
+	export
+	template<class Out, elementwise_operand E, class Op>
+	constexpr void apply_elementwise(Out&& out, const E& e, Op op)
+	{
+		using value_type = std::remove_cvref_t<decltype(out[std::size_t{}])>;
+
+		const std::size_t n {e.size()};
+		for (std::size_t i {0}; i < n; ++i)
+		{
+			out[i] = static_cast<value_type>(std::invoke(op, out[i], e[i]));
+		}
+	}
+
+	export
+	template<class Op, elementwise_operand L, elementwise_operand R>
+	class elementwise_expression;
+
+	export
+	template<class Op, elementwise_operand E, class Scalar>
+	class scalar_expression;
+
+	export
+	template<class Op, class L, class R>
+	[[nodiscard]] constexpr elementwise_expression<Op, operand_t<L>, operand_t<R>> make_elementwise(L&& lhs, R&& rhs, const char* message)
+	{
+		if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+		{
+			throw std::invalid_argument{message};
+		}
+
+		return {std::forward<L>(lhs), std::forward<R>(rhs)};
+	}
+
+	export
+	template<class Op, class E, class Scalar>
+	[[nodiscard]] constexpr scalar_expression<Op, operand_t<E>, Scalar> make_scalar_expression(E&& e, const Scalar& scalar)
+	{
+		return {std::forward<E>(e), scalar};
+	}
+
+	export
+	template<class Derived>
+	class matrix_expression
+	{
+		public:
+			[[nodiscard]] constexpr std::size_t size() const
+			{
+				return derived().rows() * derived().cols();
+			}
+
+			[[nodiscard]] constexpr auto operator()(std::size_t r, std::size_t c) const
+			{
+				return derived()[r * derived().cols() + c];
+			}
+
+			template<class E, class R>
+				requires(std::same_as<std::remove_cvref_t<E>, Derived> && elementwise_operand<std::remove_cvref_t<R>>)
+			[[nodiscard]] friend constexpr auto operator+(E&& lhs, R&& rhs)
+			{
+				return make_elementwise<std::plus<>>(std::forward<E>(lhs), std::forward<R>(rhs), "cannot add matrices of different dimension sizes");
+			}
+
+			template<class L, class E>
+				requires(elementwise_operand<std::remove_cvref_t<L>> && !matrix_expression_type<std::remove_cvref_t<L>> && std::same_as<std::remove_cvref_t<E>, Derived>)
+			[[nodiscard]] friend constexpr auto operator+(L&& lhs, E&& rhs)
+			{
+				return make_elementwise<std::plus<>>(std::forward<L>(lhs), std::forward<E>(rhs), "cannot add matrices of different dimension sizes");
+			}
+
+			template<class E, class R>
+				requires(std::same_as<std::remove_cvref_t<E>, Derived> && elementwise_operand<std::remove_cvref_t<R>>)
+			[[nodiscard]] friend constexpr auto operator-(E&& lhs, R&& rhs)
+			{
+				return make_elementwise<std::minus<>>(std::forward<E>(lhs), std::forward<R>(rhs), "cannot subtract matrices of different dimension sizes");
+			}
+
+			template<class L, class E>
+				requires(elementwise_operand<std::remove_cvref_t<L>> && !matrix_expression_type<std::remove_cvref_t<L>> && std::same_as<std::remove_cvref_t<E>, Derived>)
+			[[nodiscard]] friend constexpr auto operator-(L&& lhs, E&& rhs)
+			{
+				return make_elementwise<std::minus<>>(std::forward<L>(lhs), std::forward<E>(rhs), "cannot subtract matrices of different dimension sizes");
+			}
+
+			template<class E, class Scalar>
+				requires(std::same_as<std::remove_cvref_t<E>, Derived> && !elementwise_operand<Scalar> && requires(typename Derived::value_type rep, Scalar s) { rep * s; })
+			[[nodiscard]] friend constexpr auto operator*(E&& lhs, const Scalar& rhs)
+			{
+				return make_scalar_expression<std::multiplies<>>(std::forward<E>(lhs), rhs);
+			}
+
+			template<class E, class Scalar>
+				requires(std::same_as<std::remove_cvref_t<E>, Derived> && !elementwise_operand<Scalar> && requires(typename Derived::value_type rep, Scalar s) { rep / s; })
+			[[nodiscard]] friend constexpr auto operator/(E&& lhs, const Scalar& rhs)
+			{
+				return make_scalar_expression<std::divides<>>(std::forward<E>(lhs), rhs);
+			}
+
+			template<class E, class Scalar>
+				requires(std::same_as<std::remove_cvref_t<E>, Derived> && !elementwise_operand<Scalar> && requires(typename Derived::value_type rep, Scalar s) { rep % s; })
+			[[nodiscard]] friend constexpr auto operator%(E&& lhs, const Scalar& rhs)
+			{
+				return make_scalar_expression<std::modulus<>>(std::forward<E>(lhs), rhs);
+			}
+
+			template<elementwise_operand R>
+			[[nodiscard]] friend constexpr bool operator==(const Derived& lhs, const R& rhs)
+			{
+				if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+				{
+					return false;
+				}
+
+				const auto n = lhs.size();
+				for (std::size_t i {0}; i < n; ++i)
+				{
+					if (!(lhs[i] == rhs[i]))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		private:
+			[[nodiscard]] constexpr const Derived& derived() const noexcept
+			{
+				return static_cast<const Derived&>(*this);
+			}
+	};
+
+	// A lazily evaluated element-wise combination of two operands of the same
+	// shape. Nothing is computed until the expression is indexed, assigned
+	// into a matrix or evaluated. L and R are what operand_t gives, so a
+	// reference type is held by reference and anything else by value.
+	export
+	template<class Op, elementwise_operand L, elementwise_operand R>
+	class elementwise_expression : public matrix_expression<elementwise_expression<Op, L, R>>
+	{
+		public:
+			using value_type = std::remove_cvref_t<std::invoke_result_t<const Op&, operand_value_t<L>, operand_value_t<R>>>;
+			using allocator_type = std::conditional_t<std::is_void_v<typename operand_allocator<std::remove_cvref_t<L>>::type>,
+													  typename operand_allocator<std::remove_cvref_t<R>>::type,
+													  typename operand_allocator<std::remove_cvref_t<L>>::type>;
+
+			static constexpr std::size_t num_rows {common_extent(operand_extents<std::remove_cvref_t<L>>::rows, operand_extents<std::remove_cvref_t<R>>::rows)};
+			static constexpr std::size_t num_columns {common_extent(operand_extents<std::remove_cvref_t<L>>::cols, operand_extents<std::remove_cvref_t<R>>::cols)};
+
+			using result_type = typename expression_result<value_type, allocator_type, num_rows, num_columns>::type;
+
+			constexpr elementwise_expression(L lhs, R rhs, Op op = {})
+				: lhs_{std::forward<L>(lhs)}, rhs_{std::forward<R>(rhs)}, op_{op} {}
+
+			[[nodiscard]] constexpr std::size_t rows() const
+			{
+				return lhs_.rows();
+			}
+
+			[[nodiscard]] constexpr std::size_t cols() const
+			{
+				return lhs_.cols();
+			}
+
+			[[nodiscard]] constexpr value_type operator[](std::size_t i) const
+			{
+				return std::invoke(op_, lhs_[i], rhs_[i]);
+			}
+		private:
+			L lhs_;
+			R rhs_;
+			Op op_;
+	};
+
+	// A lazily evaluated element-wise combination of an operand with a scalar
+	// on the right-hand side. E is held as in elementwise_expression.
+	export
+	template<class Op, elementwise_operand E, class Scalar>
+	class scalar_expression : public matrix_expression<scalar_expression<Op, E, Scalar>>
+	{
+		public:
+			using value_type = std::remove_cvref_t<std::invoke_result_t<const Op&, operand_value_t<E>, const Scalar&>>;
+			using allocator_type = typename operand_allocator<std::remove_cvref_t<E>>::type;
+
+			static constexpr std::size_t num_rows {operand_extents<std::remove_cvref_t<E>>::rows};
+			static constexpr std::size_t num_columns {operand_extents<std::remove_cvref_t<E>>::cols};
+
+			using result_type = typename expression_result<value_type, allocator_type, num_rows, num_columns>::type;
+
+			constexpr scalar_expression(E e, const Scalar& scalar, Op op = {})
+				: e_{std::forward<E>(e)}, scalar_{scalar}, op_{op} {}
+
+			[[nodiscard]] constexpr std::size_t rows() const
+			{
+				return e_.rows();
+			}
+
+			[[nodiscard]] constexpr std::size_t cols() const
+			{
+				return e_.cols();
+			}
+
+			[[nodiscard]] constexpr value_type operator[](std::size_t i) const
+			{
+				return std::invoke(op_, e_[i], scalar_);
+			}
+		private:
+			E e_;
+			Scalar scalar_;
+			Op op_;
+	};
+
+	// Materializes an expression in a single pass with a single allocation.
+	export
+	template<matrix_expression_type E>
+	[[nodiscard]] constexpr typename E::result_type evaluate(const E& e)
+	{
+		return typename E::result_type(e);
+	}
+}
@@ -6,11 +6,16 @@ export module cmoon.linear.matrix_multiplication;
 
 import <type_traits>;
 import <numeric>;
-import <future>;
+import <algorithm>;
+import <stdexcept>;
+import <thread>;
+
+import cmoon.execution;
 
 import cmoon.linear.is_matrix;
 import cmoon.linear.square_matrix;
-
+import cmoon.linear.gemm;
+import cmoon.linear.matrix_expression;
 
 namespace cmoon::linear
 {
@@ -22,9 +27,6 @@ namespace cmoon::linear
 	{
 		using common_rep = std::common_type_t<T, T2>;
 		using type = matrix<common_rep, Allocator>;
-		using half_type_first = matrix<T, Allocator>;
-		using half_type_second = matrix<T2, Allocator>;
-		using half_type_common = type;
 		static constexpr auto is_fixed {false};
 	};
 
@@ -41,14 +43,10 @@ namespace cmoon::linear
 	{
 		using common_rep = std::common_type_t<T, T2>;
 		using type = static_matrix<common_rep, Rows, Cols2>;
-		using half_type_first = static_matrix<T, Rows / 2, Cols / 2>;
-		using half_type_second = static_matrix<T2, Cols / 2, Cols2 / 2>;
-		using half_type_common = static_matrix<common_rep, Rows / 2, Cols2 / 2>;
 		static constexpr auto is_fixed {true};
 	};
 
 	constexpr std::size_t strassen_dim_cutoff {300};
-	constexpr std::size_t strassen_dim_cutoff2 {1000};
 
 	template<class T, class Allocator>
 	[[nodiscard]] matrix<T, Allocator> get_part(std::size_t pi, std::size_t pj, const matrix<T, Allocator>& m) noexcept
@@ -60,10 +58,7 @@ namespace cmoon::linear
 
 		for (std::size_t i {0}; i < new_dim; ++i)
 		{
-			for (std::size_t j {0}; j < new_dim; ++j)
-			{
-				p(i, j) = m(i + pi, j + pj);
-			}
+			std::copy_n(std::addressof(m(i + pi, pj)), new_dim, std::addressof(p(i, 0)));
 		}
 
 		return p;
@@ -142,6 +137,26 @@ namespace cmoon::linear
 		return m;
 	}
 
+	export
+	template<matrix_type M1, matrix_type M2>
+	[[nodiscard]] typename common_matrix_type<M1, M2>::type blocked_mult(const M1& lhs, const M2& rhs)
+	{
+		using matrix_specs = common_matrix_type<M1, M2>;
+
+		typename matrix_specs::type m;
+		if constexpr (!matrix_specs::is_fixed)
+		{
+			m.resize(lhs.rows(), rhs.cols());
+		}
+
+		gemm(lhs.rows(), rhs.cols(), lhs.cols(),
+			 lhs.data(), lhs.cols(),
+			 rhs.data(), rhs.cols(),
+			 m.data(), m.cols());
+
+		return m;
+	}
+
 	export
 	template<matrix_type M1, matrix_type M2>
 	[[nodiscard]] typename common_matrix_type<M1, M2>::type strassen_mult(const M1& a, const M2& b) noexcept
@@ -198,14 +213,16 @@ namespace cmoon::linear
 			}
 		}
 
-		const auto p1 = strassen_mult(a11, b12 - b22);
-		const auto p2 = strassen_mult(a11 + a12, b22);
-		const auto p3 = strassen_mult(a21 + a22, b11);
-		const auto p4 = strassen_mult(a22, b21 - b11);
-		const auto p5 = strassen_mult(a11 + a22, b11 + b22);
-		const auto p6 = strassen_mult(a12 - a22, b21 + b22);
-		const auto p7 = strassen_mult(a11 - a21, b11 + b12);
+		const auto p1 = strassen_mult(a11, evaluate(b12 - b22));
+		const auto p2 = strassen_mult(evaluate(a11 + a12), b22);
+		const auto p3 = strassen_mult(evaluate(a21 + a22), b11);
+		const auto p4 = strassen_mult(a22, evaluate(b21 - b11));
+		const auto p5 = strassen_mult(evaluate(a11 + a22), evaluate(b11 + b22));
+		const auto p6 = strassen_mult(evaluate(a12 - a22), evaluate(b21 + b22));
+		const auto p7 = strassen_mult(evaluate(a11 - a21), evaluate(b11 + b12));
 
+		// The quadrants of the result stay lazy and are written straight
+		// into it, so no intermediate matrix is allocated for them.
 		const auto c11 = ((p5 + p4) + p6) - p2;
 		const auto c12 = p1 + p2;
 		const auto c21 = p3 + p4;
@@ -225,134 +242,64 @@ namespace cmoon::linear
 		return result;
 	}
 
-	template<matrix_type M1, matrix_type M2>
-	[[nodiscard]] inline typename common_matrix_type<M1, M2>::type strassen_mult_par(const M1& a, const M2& b);
-
 	export
-	template<matrix_type M1, matrix_type M2>
-	[[nodiscard]] typename common_matrix_type<M1, M2>::type strassen_mult_par_impl(const M1& a, const M2& b)
+	template<cmoon::execution::scheduler Scheduler, matrix_type M1, matrix_type M2>
+	[[nodiscard]] typename common_matrix_type<M1, M2>::type parallel_mult(Scheduler&& sch, const M1& lhs, const M2& rhs, std::size_t max_tasks = std::thread::hardware_concurrency())
 	{
 		using matrix_specs = common_matrix_type<M1, M2>;
-		using result_t = typename matrix_specs::type;
-
-		using get_part_a_t = typename matrix_specs::half_type_first(*)(std::size_t, std::size_t, const M1&);
-		using get_part_b_t = typename matrix_specs::half_type_second(*)(std::size_t, std::size_t, const M2&);
-		using f_t = typename matrix_specs::half_type_common(*)(const typename matrix_specs::half_type_first&, const typename matrix_specs::half_type_second&);
-		using set_part_f_t = void(*)(std::size_t, std::size_t, typename matrix_specs::type&, const typename matrix_specs::half_type_common&);
-
-		auto b12_future = std::async(std::launch::async, static_cast<get_part_b_t>(get_part), 0, 1, std::cref(b));
-		auto a11_future = std::async(std::launch::async, static_cast<get_part_a_t>(get_part), 0, 0, std::cref(a));
-		auto a12_future = std::async(std::launch::async, static_cast<get_part_a_t>(get_part), 0, 1, std::cref(a));
-		auto a21_future = std::async(std::launch::async, static_cast<get_part_a_t>(get_part), 1, 0, std::cref(a));
-		auto a22_future = std::async(std::launch::async, static_cast<get_part_a_t>(get_part), 1, 1, std::cref(a));
-
-		auto b11_future = std::async(std::launch::async, static_cast<get_part_b_t>(get_part), 0, 0, std::cref(b));
-		auto b21_future = std::async(std::launch::async, static_cast<get_part_b_t>(get_part), 1, 0, std::cref(b));
-		auto b22_future = std::async(std::launch::async, static_cast<get_part_b_t>(get_part), 1, 1, std::cref(b));
-
-		const auto b12 = b12_future.get();
-		const auto b22 = b22_future.get();
-		const auto b12_22 = b12 - b22;
-		const auto a11 = a11_future.get();
-		auto p1_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a11), std::cref(b12_22));
-
-		const auto a12 = a12_future.get();
-		const auto a1112 = a11 + a12;
-		auto p2_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a1112), std::cref(b22));
-
-		const auto a21 = a21_future.get();
-		const auto a22 = a22_future.get();
-		const auto a2122 = a21 + a22;
-		const auto b11 = b11_future.get();
-		auto p3_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a2122), std::cref(b11));
-
-		const auto b21 = b21_future.get();
-		const auto b21_11 = b21 - b11;
-		auto p4_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a22), std::cref(b21_11));
-
-		const auto a1122 = a11 + a22;
-		const auto b1122 = b11 + b22;
-		auto p5_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a1122), std::cref(b1122));
-				
-		const auto a12_a22 = a12 - a22;
-		const auto b2122 = b21 + b22;
-		auto p6_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a12_a22), std::cref(b2122));
-
-		const auto a21_11 = a21 - a11;
-		const auto b1112 = b11 + b12;
-		auto p7_future = std::async(std::launch::async, static_cast<f_t>(strassen_mult_par), std::cref(a21_11), std::cref(b1112));
-
-		result_t c;
-		if constexpr (!matrix_specs::is_fixed)
+		using blocking = gemm_blocking<typename matrix_specs::common_rep>;
+
+		if (lhs.cols() != rhs.rows())
 		{
-			c.resize(a.rows(), a.cols());
+			throw std::invalid_argument {"cannot multiplies matrices that do not share columns with rows"};
 		}
 
-		const auto p1 = p1_future.get();
-		const auto p2 = p2_future.get();
-		const auto c12 = p1 + p2;
-
-		const auto p3 = p3_future.get();
-		const auto p4 = p4_future.get();
-		const auto c21 = p3 + p4;
-
-		const auto p5 = p5_future.get();
-		const auto p6 = p6_future.get();
-		const auto c11 = ((p5 + p4) + p6) - p2;
-
-		const auto p7 = p7_future.get();
-		const auto c22 = ((p5 + p1) - p3) - p7;
-
-		const auto k = a.rows() / 2;
+		const auto rows = lhs.rows();
+		const auto columns = rhs.cols();
+		const auto inner = lhs.cols();
 
-		for (std::size_t i{0}; i < k; ++i)
+		typename matrix_specs::type m;
+		if constexpr (!matrix_specs::is_fixed)
 		{
-			for (std::size_t j{0}; j < k; ++j)
-			{
-				c(i, j) = c11(i, j);
-				c(i, j + k) = c12(i, j);
-				c(k + i, j) = c21(i, j);
-				c(k + i, k + j) = c22(i, j);
-			}
+			m.resize(rows, columns);
 		}
 
-		return c;
-	}
+		// Each tile of the output is an mc x nc block, so a task works on the
+		// same block sizes the serial kernel is tuned for.
+		const auto row_tiles = (rows + blocking::mc - 1) / blocking::mc;
+		const auto column_tiles = (columns + blocking::nc - 1) / blocking::nc;
+		const auto tiles = row_tiles * column_tiles;
 
-	export
-	template<matrix_type M1, matrix_type M2>
-	[[nodiscard]] inline typename common_matrix_type<M1, M2>::type strassen_mult_par(const M1& a, const M2& b)
-	{
-		using matrix_specs = common_matrix_type<M1, M2>;
-		if constexpr (matrix_specs::is_fixed)
+		if (tiles == 0 || inner == 0)
 		{
-			if constexpr (M1::num_rows < strassen_dim_cutoff)
-			{
-				return standard_mult(a, b);
-			}
-			else if constexpr (M1::num_rows < strassen_dim_cutoff2)
-			{
-				return strassen_mult(a, b);
-			}
-			else
+			return m;
+		}
+
+		const auto tasks = std::clamp(max_tasks, std::size_t{1}, tiles);
+		auto multiply_tiles = [&](std::size_t task) {
+			for (auto tile {task}; tile < tiles; tile += tasks)
 			{
-				return strassen_mult_par_impl(a, b);
+				const auto r = (tile / column_tiles) * blocking::mc;
+				const auto c = (tile % column_tiles) * blocking::nc;
+
+				gemm(std::min(blocking::mc, rows - r), std::min(blocking::nc, columns - c), inner,
+					 lhs.data() + r * inner, inner,
+					 rhs.data() + c, columns,
+					 m.data() + r * columns + c, columns);
 			}
+		};
+
+		if (tasks == 1)
+		{
+			multiply_tiles(0);
 		}
 		else
 		{
-			if (a.rows() < strassen_dim_cutoff)
-			{
-				return standard_mult(a, b);
-			}
-			else if (a.rows() < strassen_dim_cutoff2)
-			{
-				return strassen_mult(a, b);
-			}
-			else
-			{
-				return strassen_mult_par_impl(a, b);
-			}
+			cmoon::execution::sync_wait(
+				cmoon::execution::bulk(cmoon::execution::schedule(sch), tasks, multiply_tiles)
+			);
 		}
+
+		return m;
 	}
 }
\ No newline at end of file
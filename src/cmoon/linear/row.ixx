@@ -4,6 +4,10 @@ import <span>;
 import <algorithm>;
 import <functional>;
 import <numeric>;
+import <stdexcept>;
+import <type_traits>;
+
+import cmoon.linear.matrix_expression;
 
 namespace cmoon::linear
 {
@@ -25,9 +29,27 @@ namespace cmoon::linear
 			using iterator = typename base::iterator;
 			using reverse_iterator = typename base::reverse_iterator;
 
+			static constexpr std::size_t num_rows {1};
+			static constexpr std::size_t num_columns {Extent};
+
 			constexpr row(pointer first, std::size_t size)
 				: base{first, size} {}
 
+			// Assigning an expression writes through to the viewed elements,
+			// while assigning another row still rebinds the view.
+			template<matrix_expression_type E>
+				requires(!std::is_const_v<element_type>)
+			constexpr row& operator=(const E& e)
+			{
+				if (rows() != e.rows() || cols() != e.cols())
+				{
+					throw std::invalid_argument{"cannot assign matrices of different dimension sizes"};
+				}
+
+				assign_elementwise(*this, e);
+				return *this;
+			}
+
 			[[nodiscard]] constexpr iterator begin() const noexcept
 			{
 				return base::begin();
@@ -73,6 +95,16 @@ namespace cmoon::linear
 				return base::size();
 			}
 
+			[[nodiscard]] constexpr size_type rows() const noexcept
+			{
+				return 1;
+			}
+
+			[[nodiscard]] constexpr size_type cols() const noexcept
+			{
+				return size();
+			}
+
 			[[nodiscard]] constexpr bool empty() const noexcept
 			{
 				return base::empty();
@@ -124,6 +156,30 @@ namespace cmoon::linear
 				return *this;
 			}
 
+			template<matrix_expression_type E>
+			constexpr row& operator+=(const E& other)
+			{
+				if (rows() != other.rows() || cols() != other.cols())
+				{
+					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
+				}
+
+				apply_elementwise(*this, other, std::plus<>{});
+				return *this;
+			}
+
+			template<matrix_expression_type E>
+			constexpr row& operator-=(const E& other)
+			{
+				if (rows() != other.rows() || cols() != other.cols())
+				{
+					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
+				}
+
+				apply_elementwise(*this, other, std::minus<>{});
+				return *this;
+			}
+
 			constexpr row& operator*=(const_reference other) noexcept
 			{
 				std::transform(begin(), end(), begin(), std::bind(std::multiplies{}, std::placeholders::_1, other));
@@ -162,6 +218,39 @@ namespace cmoon::linear
 				return {data(), size()};
 			}
 
+			template<class T2, std::size_t Extent2>
+			[[nodiscard]] friend constexpr auto operator+(const row& lhs, const row<T2, Extent2>& rhs)
+			{
+				return make_elementwise<std::plus<>>(lhs, rhs, "cannot add rows of different sizes");
+			}
+
+			template<class T2, std::size_t Extent2>
+			[[nodiscard]] friend constexpr auto operator-(const row& lhs, const row<T2, Extent2>& rhs)
+			{
+				return make_elementwise<std::minus<>>(lhs, rhs, "cannot subtract rows of different sizes");
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v * rep; })
+			[[nodiscard]] friend constexpr auto operator*(const row& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::multiplies<>, row, Rep>{lhs, rhs};
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v / rep; })
+			[[nodiscard]] friend constexpr auto operator/(const row& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::divides<>, row, Rep>{lhs, rhs};
+			}
+
+			template<class Rep>
+				requires(!elementwise_operand<Rep> && requires(value_type v, Rep rep) { v % rep; })
+			[[nodiscard]] friend constexpr auto operator%(const row& lhs, const Rep& rhs) noexcept
+			{
+				return scalar_expression<std::modulus<>, row, Rep>{lhs, rhs};
+			}
+
 			template<std::size_t Extent2>
 			[[nodiscard]] friend constexpr bool operator==(const row& lhs, const row<T, Extent2>& rhs) noexcept
 			{
@@ -175,6 +264,10 @@ namespace cmoon::linear
 				return !(lhs == rhs);
 			}
 	};
+
+	export
+	template<class T, std::size_t Extent>
+	constexpr bool enable_matrix_view<row<T, Extent>> = true;
 }
 
 namespace std
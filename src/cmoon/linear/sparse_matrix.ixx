@@ -0,0 +1,502 @@
+module;
+
+#include "cmoon/linear/matrix_definitions.hpp"
+
+export module cmoon.linear.sparse_matrix;
+
+import <cstddef>;
+import <algorithm>;
+import <memory>;
+import <numeric>;
+import <span>;
+import <stdexcept>;
+import <thread>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+import cmoon.execution;
+
+import cmoon.linear.is_matrix;
+import cmoon.linear.matrix;
+import cmoon.linear.static_matrix;
+
+namespace cmoon::linear
+{
+	export
+	enum class sparse_layout
+	{
+		row_major,
+		column_major
+	};
+
+	// A coordinate (COO) entry. Entries passed to a sparse matrix may come in
+	// any order, and entries sharing a position are summed.
+	export
+	template<class Rep>
+	struct triplet
+	{
+		std::size_t row;
+		std::size_t col;
+		Rep value;
+	};
+
+	export
+	template<class Rep, sparse_layout Layout, class Allocator = std::allocator<Rep>>
+	class compressed_matrix;
+
+	// Compressed sparse row: the non-zeros of each row are stored together,
+	// ordered by column.
+	export
+	template<class Rep, class Allocator = std::allocator<Rep>>
+	using csr_matrix = compressed_matrix<Rep, sparse_layout::row_major, Allocator>;
+
+	// Compressed sparse column: the non-zeros of each column are stored
+	// together, ordered by row.
+	export
+	template<class Rep, class Allocator = std::allocator<Rep>>
+	using csc_matrix = compressed_matrix<Rep, sparse_layout::column_major, Allocator>;
+
+	// Below this many non-zeros a product is not worth splitting into tasks.
+	inline constexpr std::size_t sparse_parallel_cutoff {1 << 14};
+
+	export
+	template<class Rep, sparse_layout Layout, class Allocator>
+	class compressed_matrix
+	{
+		using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+
+		template<class Rep2, sparse_layout Layout2, class Allocator2>
+		friend class compressed_matrix;
+
+		template<class Rep2, sparse_layout Layout2, class Allocator2>
+		friend auto transpose(const compressed_matrix<Rep2, Layout2, Allocator2>& m);
+
+		public:
+			using value_type = Rep;
+			using allocator_type = Allocator;
+			using size_type = std::size_t;
+
+			static constexpr sparse_layout layout {Layout};
+
+			using transposed_type = compressed_matrix<Rep, Layout == sparse_layout::row_major ? sparse_layout::column_major : sparse_layout::row_major, Allocator>;
+
+			compressed_matrix(const Allocator& alloc = Allocator{})
+				: values_{alloc}, indices_{index_allocator{alloc}}, offsets_(1, 0, index_allocator{alloc}) {}
+
+			compressed_matrix(std::size_t rows, std::size_t cols, const Allocator& alloc = Allocator{})
+				: rows_{rows}, cols_{cols}, values_{alloc}, indices_{index_allocator{alloc}}, offsets_(major_size() + 1, 0, index_allocator{alloc}) {}
+
+			compressed_matrix(std::size_t rows, std::size_t cols, std::span<const triplet<Rep>> entries, const Allocator& alloc = Allocator{})
+				: compressed_matrix{rows, cols, alloc}
+			{
+				for (const auto& entry : entries)
+				{
+					if (entry.row >= rows_ || entry.col >= cols_)
+					{
+						throw std::out_of_range{"triplet lies outside of the matrix"};
+					}
+
+					++offsets_[major_of(entry) + 1];
+				}
+
+				std::partial_sum(std::begin(offsets_), std::end(offsets_), std::begin(offsets_));
+
+				// Bucket the entries by their major index, then order and merge
+				// each bucket by its minor index. Merging only shrinks a bucket,
+				// so the result is compacted in place.
+				std::vector<std::size_t, index_allocator> next(std::begin(offsets_), std::prev(std::end(offsets_)), index_allocator{alloc});
+				indices_.resize(entries.size());
+				values_.resize(entries.size());
+				for (const auto& entry : entries)
+				{
+					const auto position = next[major_of(entry)]++;
+					indices_[position] = minor_of(entry);
+					values_[position] = entry.value;
+				}
+
+				std::vector<std::pair<std::size_t, Rep>> bucket;
+				std::size_t written {0};
+				for (std::size_t major {0}; major < major_size(); ++major)
+				{
+					bucket.clear();
+					for (auto i = offsets_[major]; i < offsets_[major + 1]; ++i)
+					{
+						bucket.emplace_back(indices_[i], values_[i]);
+					}
+
+					std::ranges::stable_sort(bucket, {}, &std::pair<std::size_t, Rep>::first);
+
+					offsets_[major] = written;
+					for (const auto& [index, value] : bucket)
+					{
+						if (written != offsets_[major] && indices_[written - 1] == index)
+						{
+							values_[written - 1] += value;
+						}
+						else
+						{
+							indices_[written] = index;
+							values_[written] = value;
+							++written;
+						}
+					}
+				}
+
+				offsets_[major_size()] = written;
+				indices_.resize(written);
+				values_.resize(written);
+			}
+
+			template<matrix_type M>
+			explicit compressed_matrix(const M& m, const Allocator& alloc = Allocator{})
+				: compressed_matrix{m.rows(), m.cols(), alloc}
+			{
+				for (std::size_t major {0}; major < major_size(); ++major)
+				{
+					for (std::size_t minor {0}; minor < minor_size(); ++minor)
+					{
+						const auto& v = Layout == sparse_layout::row_major ? m(major, minor) : m(minor, major);
+						if (v != Rep{0})
+						{
+							indices_.push_back(minor);
+							values_.push_back(static_cast<Rep>(v));
+						}
+					}
+
+					offsets_[major + 1] = values_.size();
+				}
+			}
+
+			// Converting between CSR and CSC is a transpose of the compressed
+			// arrays, done with one counting pass.
+			template<sparse_layout Layout2>
+				requires(Layout2 != Layout)
+			explicit compressed_matrix(const compressed_matrix<Rep, Layout2, Allocator>& other)
+				: compressed_matrix{other.rows(), other.cols(), other.get_allocator()}
+			{
+				for (const auto index : other.indices_)
+				{
+					++offsets_[index + 1];
+				}
+
+				std::partial_sum(std::begin(offsets_), std::end(offsets_), std::begin(offsets_));
+
+				std::vector<std::size_t, index_allocator> next(std::begin(offsets_), std::prev(std::end(offsets_)), index_allocator{get_allocator()});
+				indices_.resize(other.non_zeros());
+				values_.resize(other.non_zeros());
+				for (std::size_t major {0}; major < other.major_size(); ++major)
+				{
+					for (auto i = other.offsets_[major]; i < other.offsets_[major + 1]; ++i)
+					{
+						const auto position = next[other.indices_[i]]++;
+						indices_[position] = major;
+						values_[position] = other.values_[i];
+					}
+				}
+			}
+
+			[[nodiscard]] Allocator get_allocator() const noexcept
+			{
+				return values_.get_allocator();
+			}
+
+			[[nodiscard]] std::size_t rows() const noexcept
+			{
+				return rows_;
+			}
+
+			[[nodiscard]] std::size_t cols() const noexcept
+			{
+				return cols_;
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return rows_ * cols_;
+			}
+
+			[[nodiscard]] std::size_t non_zeros() const noexcept
+			{
+				return values_.size();
+			}
+
+			// Rows for CSR, columns for CSC. Entry i of offsets() is where
+			// that row (or column) begins in indices() and values().
+			[[nodiscard]] std::span<const std::size_t> offsets() const noexcept
+			{
+				return offsets_;
+			}
+
+			[[nodiscard]] std::span<const std::size_t> indices() const noexcept
+			{
+				return indices_;
+			}
+
+			[[nodiscard]] std::span<const Rep> values() const noexcept
+			{
+				return values_;
+			}
+
+			[[nodiscard]] std::span<Rep> values() noexcept
+			{
+				return values_;
+			}
+
+			[[nodiscard]] Rep operator()(std::size_t r, std::size_t c) const
+			{
+				const auto major = Layout == sparse_layout::row_major ? r : c;
+				const auto minor = Layout == sparse_layout::row_major ? c : r;
+
+				const auto first = std::begin(indices_) + offsets_[major];
+				const auto last = std::begin(indices_) + offsets_[major + 1];
+				const auto it = std::lower_bound(first, last, minor);
+				if (it == last || *it != minor)
+				{
+					return Rep{0};
+				}
+
+				return values_[it - std::begin(indices_)];
+			}
+
+			[[nodiscard]] matrix<Rep, Allocator> to_dense() const
+			{
+				matrix<Rep, Allocator> m{rows_, cols_, get_allocator()};
+				scatter_to(m);
+				return m;
+			}
+
+			template<class Rep2, std::size_t Rows, std::size_t Cols>
+			explicit operator static_matrix<Rep2, Rows, Cols>() const
+			{
+				if (rows_ != Rows || cols_ != Cols)
+				{
+					throw std::invalid_argument{"cannot convert to a static matrix of different dimension sizes"};
+				}
+
+				static_matrix<Rep2, Rows, Cols> m;
+				scatter_to(m);
+				return m;
+			}
+
+			template<class Rep2, class Allocator2>
+			explicit operator matrix<Rep2, Allocator2>() const
+			{
+				matrix<Rep2, Allocator2> m{rows_, cols_};
+				scatter_to(m);
+				return m;
+			}
+
+			template<matrix_type M>
+			[[nodiscard]] friend auto operator*(const compressed_matrix& lhs, const M& rhs)
+			{
+				using common_rep = std::common_type_t<Rep, typename M::value_type>;
+
+				if (lhs.cols() != rhs.rows())
+				{
+					throw std::invalid_argument {"cannot multiplies matrices that do not share columns with rows"};
+				}
+
+				matrix<common_rep, typename std::allocator_traits<Allocator>::template rebind_alloc<common_rep>> m{lhs.rows(), rhs.cols()};
+				lhs.multiply_major_range(0, lhs.major_size(), rhs.data(), rhs.cols(), m.data());
+				return m;
+			}
+
+			[[nodiscard]] friend bool operator==(const compressed_matrix& lhs, const compressed_matrix& rhs) noexcept
+			{
+				return lhs.rows_ == rhs.rows_ &&
+					   lhs.cols_ == rhs.cols_ &&
+					   std::ranges::equal(lhs.offsets_, rhs.offsets_) &&
+					   std::ranges::equal(lhs.indices_, rhs.indices_) &&
+					   std::ranges::equal(lhs.values_, rhs.values_);
+			}
+
+			// Computes out += this * b for the rows (CSR) or columns (CSC)
+			// [first, last), where b is cols() x n and out is rows() x n, both
+			// dense and row-major. Each non-zero scales a contiguous row of b,
+			// so the inner loop streams through memory.
+			template<class B, class T>
+			void multiply_major_range(std::size_t first, std::size_t last, const B* b, std::size_t n, T* out) const noexcept
+			{
+				for (auto major {first}; major < last; ++major)
+				{
+					for (auto i = offsets_[major]; i < offsets_[major + 1]; ++i)
+					{
+						const auto v = static_cast<T>(values_[i]);
+						const auto minor = indices_[i];
+						const auto b_row = b + (Layout == sparse_layout::row_major ? minor : major) * n;
+						const auto out_row = out + (Layout == sparse_layout::row_major ? major : minor) * n;
+
+						for (std::size_t j {0}; j < n; ++j)
+						{
+							out_row[j] += v * static_cast<T>(b_row[j]);
+						}
+					}
+				}
+			}
+		private:
+			std::size_t rows_ {0};
+			std::size_t cols_ {0};
+			std::vector<Rep, Allocator> values_;
+			std::vector<std::size_t, index_allocator> indices_;
+			std::vector<std::size_t, index_allocator> offsets_;
+
+			[[nodiscard]] std::size_t major_size() const noexcept
+			{
+				return Layout == sparse_layout::row_major ? rows_ : cols_;
+			}
+
+			[[nodiscard]] std::size_t minor_size() const noexcept
+			{
+				return Layout == sparse_layout::row_major ? cols_ : rows_;
+			}
+
+			[[nodiscard]] static std::size_t major_of(const triplet<Rep>& entry) noexcept
+			{
+				return Layout == sparse_layout::row_major ? entry.row : entry.col;
+			}
+
+			[[nodiscard]] static std::size_t minor_of(const triplet<Rep>& entry) noexcept
+			{
+				return Layout == sparse_layout::row_major ? entry.col : entry.row;
+			}
+
+			template<class M>
+			void scatter_to(M& m) const
+			{
+				for (std::size_t major {0}; major < major_size(); ++major)
+				{
+					for (auto i = offsets_[major]; i < offsets_[major + 1]; ++i)
+					{
+						if constexpr (Layout == sparse_layout::row_major)
+						{
+							m(major, indices_[i]) = static_cast<typename M::value_type>(values_[i]);
+						}
+						else
+						{
+							m(indices_[i], major) = static_cast<typename M::value_type>(values_[i]);
+						}
+					}
+				}
+			}
+	};
+
+	// The arrays of a CSR matrix are exactly those of the CSC form of its
+	// transpose, and the other way around, so nothing is reordered.
+	export
+	template<class Rep, sparse_layout Layout, class Allocator>
+	[[nodiscard]] auto transpose(const compressed_matrix<Rep, Layout, Allocator>& m)
+	{
+		typename compressed_matrix<Rep, Layout, Allocator>::transposed_type t{m.get_allocator()};
+		t.rows_ = m.cols_;
+		t.cols_ = m.rows_;
+		t.values_ = m.values_;
+		t.indices_ = m.indices_;
+		t.offsets_ = m.offsets_;
+		return t;
+	}
+
+	// Computes y = a * x.
+	export
+	template<class Rep, sparse_layout Layout, class Allocator, class T, class U>
+	void multiply(const compressed_matrix<Rep, Layout, Allocator>& a, std::span<const T> x, std::span<U> y)
+	{
+		if (x.size() != a.cols() || y.size() != a.rows())
+		{
+			throw std::invalid_argument {"vector sizes do not match the matrix"};
+		}
+
+		if constexpr (Layout == sparse_layout::row_major)
+		{
+			const auto offsets = a.offsets();
+			const auto indices = a.indices();
+			const auto values = a.values();
+
+			for (std::size_t r {0}; r < a.rows(); ++r)
+			{
+				U sum {0};
+				for (auto i = offsets[r]; i < offsets[r + 1]; ++i)
+				{
+					sum += static_cast<U>(values[i]) * static_cast<U>(x[indices[i]]);
+				}
+
+				y[r] = sum;
+			}
+		}
+		else
+		{
+			std::ranges::fill(y, U{0});
+			a.multiply_major_range(0, a.cols(), x.data(), 1, y.data());
+		}
+	}
+
+	// Splits the rows of a into at most `tasks` contiguous blocks holding
+	// about the same number of non-zeros, and returns where block `task`
+	// begins.
+	[[nodiscard]] inline std::size_t row_block_begin(std::span<const std::size_t> offsets, std::size_t task, std::size_t tasks) noexcept
+	{
+		const auto rows = offsets.size() - 1;
+		if (task >= tasks)
+		{
+			return rows;
+		}
+
+		const auto target = offsets.back() / tasks * task + offsets.back() % tasks * task / tasks;
+		const auto it = std::lower_bound(std::begin(offsets), std::end(offsets), target);
+		return std::min(static_cast<std::size_t>(it - std::begin(offsets)), rows);
+	}
+
+	template<cmoon::execution::scheduler Scheduler, class Rep, class Allocator, class F>
+	void for_each_row_block(Scheduler&& sch, const csr_matrix<Rep, Allocator>& a, std::size_t max_tasks, F f)
+	{
+		const auto tasks = std::clamp(max_tasks, std::size_t{1}, std::max(a.rows(), std::size_t{1}));
+
+		if (tasks == 1 || a.non_zeros() < sparse_parallel_cutoff)
+		{
+			f(std::size_t{0}, a.rows());
+			return;
+		}
+
+		cmoon::execution::sync_wait(
+			cmoon::execution::bulk(cmoon::execution::schedule(sch), tasks, [&](std::size_t task) {
+				f(row_block_begin(a.offsets(), task, tasks), row_block_begin(a.offsets(), task + 1, tasks));
+			})
+		);
+	}
+
+	// Computes y = a * x with the rows of a split across tasks on sch. Each
+	// task writes a disjoint range of y.
+	export
+	template<cmoon::execution::scheduler Scheduler, class Rep, class Allocator, class T, class U>
+	void parallel_multiply(Scheduler&& sch, const csr_matrix<Rep, Allocator>& a, std::span<const T> x, std::span<U> y, std::size_t max_tasks = std::thread::hardware_concurrency())
+	{
+		if (x.size() != a.cols() || y.size() != a.rows())
+		{
+			throw std::invalid_argument {"vector sizes do not match the matrix"};
+		}
+
+		std::ranges::fill(y, U{0});
+		for_each_row_block(sch, a, max_tasks, [&](std::size_t first, std::size_t last) {
+			a.multiply_major_range(first, last, x.data(), 1, y.data());
+		});
+	}
+
+	export
+	template<cmoon::execution::scheduler Scheduler, class Rep, class Allocator, matrix_type M>
+	[[nodiscard]] auto parallel_mult(Scheduler&& sch, const csr_matrix<Rep, Allocator>& lhs, const M& rhs, std::size_t max_tasks = std::thread::hardware_concurrency())
+	{
+		using common_rep = std::common_type_t<Rep, typename M::value_type>;
+
+		if (lhs.cols() != rhs.rows())
+		{
+			throw std::invalid_argument {"cannot multiplies matrices that do not share columns with rows"};
+		}
+
+		matrix<common_rep, typename std::allocator_traits<Allocator>::template rebind_alloc<common_rep>> m{lhs.rows(), rhs.cols()};
+		for_each_row_block(sch, lhs, max_tasks, [&](std::size_t first, std::size_t last) {
+			lhs.multiply_major_range(first, last, rhs.data(), rhs.cols(), m.data());
+		});
+
+		return m;
+	}
+}
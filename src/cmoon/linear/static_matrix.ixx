@@ -10,6 +10,7 @@ import <numeric>;
 import <concepts>;
 import <stdexcept>;
 import <type_traits>;
+import <utility>;
 
 import cmoon.math;
 import cmoon.multidimensional;
@@ -19,6 +20,8 @@ import cmoon.linear.column;
 import cmoon.linear.diagonal;
 import cmoon.linear.rows_slice;
 import cmoon.linear.columns_slice;
+import cmoon.linear.is_matrix;
+import cmoon.linear.matrix_expression;
 import cmoon.linear.matrix_multiplication;
 import cmoon.linear.square_matrix;
 
@@ -53,6 +56,29 @@ namespace cmoon::linear
 			constexpr static_matrix(Elements&&... elements) noexcept(std::is_nothrow_constructible_v<storage_t, Elements...>)
 				: data_{std::forward<Elements>(elements)...} {}
 
+			template<matrix_expression_type E>
+			constexpr static_matrix(const E& e)
+			{
+				if (Rows != e.rows() || Cols != e.cols())
+				{
+					throw std::invalid_argument{"cannot assign matrices of different dimension sizes"};
+				}
+
+				assign_elementwise(data(), e);
+			}
+
+			template<matrix_expression_type E>
+			constexpr static_matrix& operator=(const E& e)
+			{
+				if (Rows != e.rows() || Cols != e.cols())
+				{
+					throw std::invalid_argument{"cannot assign matrices of different dimension sizes"};
+				}
+
+				assign_elementwise(data(), e);
+				return *this;
+			}
+
 			[[nodiscard]] constexpr std::size_t rows() const noexcept
 			{
 				return Rows;
@@ -222,108 +248,76 @@ namespace cmoon::linear
 				return {get_column(start), count == std::dynamic_extent ? rows() : count};
 			}
 
-			template<class Rep2, class Allocator>
-			[[nodiscard]] friend auto operator+(const static_matrix& lhs, const matrix<Rep2, Allocator>& rhs)
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && regular_matrix_type<std::remove_cvref_t<M2>>)
+			[[nodiscard]] friend auto operator+(M&& lhs, M2&& rhs)
 			{
-				if (Rows != rhs.rows() || Cols != rhs.cols())
-				{
-					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
-				}
-
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() + std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::plus<>{});
-				return m;
+				return make_elementwise<std::plus<>>(std::forward<M>(lhs), std::forward<M2>(rhs), "cannot add matrices of different dimension sizes");
 			}
 
-			template<class Rep2, class Allocator>
-			[[nodiscard]] friend auto operator-(const static_matrix& lhs, const matrix<Rep2, Allocator>& rhs)
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && regular_matrix_type<std::remove_cvref_t<M2>>)
+			[[nodiscard]] friend auto operator-(M&& lhs, M2&& rhs)
 			{
-				if (Rows != rhs.rows() || Cols != rhs.cols())
-				{
-					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
-				}
-
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() - std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::minus<>{});
-				return m;
+				return make_elementwise<std::minus<>>(std::forward<M>(lhs), std::forward<M2>(rhs), "cannot subtract matrices of different dimension sizes");
 			}
 
-			template<class Rep2>
-			[[nodiscard]] friend constexpr auto operator+(const static_matrix& lhs, const static_matrix<Rep2, Rows, Cols>& rhs) noexcept
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && static_matrix_type<std::remove_cvref_t<M2>> && std::remove_cvref_t<M2>::num_rows == Rows && std::remove_cvref_t<M2>::num_columns == Cols)
+			[[nodiscard]] friend constexpr auto operator+(M&& lhs, M2&& rhs)
 			{
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() + std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::plus<>{});
-				return m;
+				return elementwise_expression<std::plus<>, operand_t<M>, operand_t<M2>>{std::forward<M>(lhs), std::forward<M2>(rhs)};
 			}
 
-			template<class Rep2>
-			[[nodiscard]] friend constexpr auto operator-(const static_matrix& lhs, const static_matrix<Rep2, Rows, Cols>& rhs) noexcept
+			template<class M, class M2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && static_matrix_type<std::remove_cvref_t<M2>> && std::remove_cvref_t<M2>::num_rows == Rows && std::remove_cvref_t<M2>::num_columns == Cols)
+			[[nodiscard]] friend constexpr auto operator-(M&& lhs, M2&& rhs)
 			{
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() - std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), rhs.begin(), m.begin(), std::minus<>{});
-				return m;
+				return elementwise_expression<std::minus<>, operand_t<M>, operand_t<M2>>{std::forward<M>(lhs), std::forward<M2>(rhs)};
 			}
 
-			template<class Rep2>
-				requires(requires(Rep rep, Rep2 rep2) { rep * rep2; })
-			[[nodiscard]] friend constexpr static_matrix operator*(const static_matrix& lhs, const Rep2& rhs) noexcept
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && !elementwise_operand<Rep2> && requires(Rep rep, Rep2 rep2) { rep * rep2; })
+			[[nodiscard]] friend constexpr auto operator*(M&& lhs, const Rep2& rhs)
 			{
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() * std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
-				return m;
+				return make_scalar_expression<std::multiplies<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Rep2>
-				requires(requires(Rep rep, Rep2 rep2) { rep / rep2; })
-			[[nodiscard]] friend constexpr auto operator/(const static_matrix& lhs, const Rep2& rhs) noexcept
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && !elementwise_operand<Rep2> && requires(Rep rep, Rep2 rep2) { rep / rep2; })
+			[[nodiscard]] friend constexpr auto operator/(M&& lhs, const Rep2& rhs)
 			{
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() / std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::divides<>{}, std::placeholders::_1, rhs));
-				return m;
+				return make_scalar_expression<std::divides<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Rep2>
-				requires(requires(Rep rep, Rep2 rep2) { rep % rep2; })
-			[[nodiscard]] friend constexpr auto operator%(const static_matrix& lhs, const Rep2& rhs) noexcept
+			template<class M, class Rep2>
+				requires(std::same_as<std::remove_cvref_t<M>, static_matrix> && !elementwise_operand<Rep2> && requires(Rep rep, Rep2 rep2) { rep % rep2; })
+			[[nodiscard]] friend constexpr auto operator%(M&& lhs, const Rep2& rhs)
 			{
-				static_matrix<std::decay_t<decltype(std::declval<Rep>() % std::declval<Rep2>())>, Rows, Cols> m;
-				std::transform(lhs.begin(), lhs.end(), m.begin(), std::bind(std::modulus<>{}, std::placeholders::_1, rhs));
-				return m;
+				return make_scalar_expression<std::modulus<>>(std::forward<M>(lhs), rhs);
 			}
 
-			template<class Allocator>
-			static_matrix& operator+=(const matrix<Rep, Allocator>& other)
+			template<elementwise_operand E>
+			constexpr static_matrix& operator+=(const E& other)
 			{
 				if (Rows != other.rows() || Cols != other.cols())
 				{
 					throw std::invalid_argument{"cannot add matrices of different dimension sizes"};
 				}
 
-				std::transform(begin(), end(), other.begin(), begin(), std::plus<>{});
+				apply_elementwise(data(), other, std::plus<>{});
 				return *this;
 			}
 
-			template<class Allocator>
-			static_matrix& operator-=(const matrix<Rep, Allocator>& other)
+			template<elementwise_operand E>
+			constexpr static_matrix& operator-=(const E& other)
 			{
 				if (Rows != other.rows() || Cols != other.cols())
 				{
 					throw std::invalid_argument{"cannot subtract matrices of different dimension sizes"};
 				}
 
-				std::transform(begin(), end(), other.begin(), begin(), std::minus<>{});
-				return *this;
-			}
-
-			constexpr static_matrix& operator+=(const static_matrix& other) noexcept
-			{
-				std::transform(begin(), end(), other.begin(), begin(), std::plus<>{});
-				return *this;
-			}
-
-			constexpr static_matrix& operator-=(const static_matrix& other) noexcept
-			{
-				std::transform(begin(), end(), other.begin(), begin(), std::minus<>{});
+				apply_elementwise(data(), other, std::minus<>{});
 				return *this;
 			}
 
@@ -387,16 +381,15 @@ namespace cmoon::linear
 
 	export
 	template<class T, class T2, std::size_t Rows, std::size_t Cols, std::size_t Cols2>
-	[[nodiscard]] constexpr auto operator*(const static_matrix<T, Rows, Cols>& lhs, const static_matrix<T2, Cols, Cols2>& rhs) noexcept
+	[[nodiscard]] constexpr auto operator*(const static_matrix<T, Rows, Cols>& lhs, const static_matrix<T2, Cols, Cols2>& rhs)
 	{
-		if constexpr (Rows == Cols && Cols == Cols2 &&
-						cmoon::is_power_of_2(Cols))
+		if (std::is_constant_evaluated())
 		{
-			return strassen_mult_par(lhs, rhs);
+			return standard_mult(lhs, rhs);
 		}
 		else
 		{
-			return standard_mult(lhs, rhs);
+			return blocked_mult(lhs, rhs);
 		}
 	}
 
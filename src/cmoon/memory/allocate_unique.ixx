@@ -48,10 +48,10 @@ namespace cmoon
 
 	export
 	template<class T, class Alloc, class... Args>
-	[[nodiscard]] constexpr std::unique_ptr<T, allocator_delete<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>>
+	[[nodiscard]] constexpr std::unique_ptr<T, allocator_delete<T, typename std::allocator_traits<std::remove_cvref_t<Alloc>>::template rebind_alloc<T>>>
 	allocate_unique(Alloc&& alloc, Args&&... args)
 	{
-		using traits = typename std::allocator_traits<Alloc>::template rebind_traits<T>;
+		using traits = typename std::allocator_traits<std::remove_cvref_t<Alloc>>::template rebind_traits<T>;
 		typename traits::allocator_type my_alloc {alloc};
 		auto hold_deleter = [&my_alloc](auto p) {
 			traits::deallocate(my_alloc, p, 1);
@@ -60,7 +60,7 @@ namespace cmoon
 		using hold_t = std::unique_ptr<T, decltype(hold_deleter)>;
 		hold_t hold{traits::allocate(my_alloc, 1), hold_deleter};
 		traits::construct(my_alloc, hold.get(), std::forward<Args>(args)...);
-		auto deleter = allocator_delete<T>{my_alloc};
+		auto deleter = allocator_delete<T, typename traits::allocator_type>{my_alloc};
 		return std::unique_ptr<T, decltype(deleter)>{hold.release(), std::move(deleter)};
 	}
 
@@ -78,7 +78,7 @@ namespace cmoon
 		using hold_t = std::unique_ptr<T, decltype(hold_deleter)>;
 		hold_t hold{traits::allocate(my_alloc, 1), hold_deleter};
 		traits::construct(my_alloc, hold.get(), std::forward<Args>(args)...);
-		auto deleter = allocator_delete<T>{my_alloc};
+		auto deleter = allocator_delete<T, Alloc&>{alloc.get()};
 		return std::unique_ptr<T, decltype(deleter)>{hold.release(), std::move(deleter)};
 	}
 
@@ -1,3 +1,4 @@
 export module cmoon.memory;
 export import cmoon.memory.concepts;
-export import cmoon.memory.allocate_unique;
\ No newline at end of file
+export import cmoon.memory.allocate_unique;
+export import cmoon.memory.recycling_allocator;
\ No newline at end of file
@@ -0,0 +1,196 @@
+export module cmoon.memory.recycling_allocator;
+
+import <cstddef>;
+import <new>;
+import <array>;
+import <bit>;
+import <limits>;
+
+namespace cmoon
+{
+	export
+	struct recycling_pool_stats
+	{
+		// Blocks this thread had to get from operator new.
+		std::size_t upstream_allocations {0};
+
+		// Allocations this thread served from its free lists.
+		std::size_t recycled_allocations {0};
+	};
+
+	// Size classes are powers of two from min_block to max_block bytes. Each
+	// thread keeps a free list per class, and a freed block goes on the list
+	// of the thread that frees it, up to max_cached blocks a class. Larger or
+	// over aligned requests go straight to operator new.
+	export
+	class recycling_pool
+	{
+		public:
+			static constexpr std::size_t min_block {16};
+			static constexpr std::size_t max_block {4096};
+			static constexpr std::size_t max_cached {64};
+
+			[[nodiscard]] static void* allocate(std::size_t bytes, std::size_t alignment)
+			{
+				if (bytes > max_block || alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				{
+					return ::operator new(bytes, std::align_val_t{alignment});
+				}
+
+				const auto c {class_of(bytes)};
+				if (const auto l {local()}; l != nullptr)
+				{
+					if (const auto b {l->heads[c]}; b != nullptr)
+					{
+						l->heads[c] = b->next;
+						--l->counts[c];
+						++l->stats.recycled_allocations;
+						return b;
+					}
+
+					++l->stats.upstream_allocations;
+				}
+
+				return ::operator new(block_size(c));
+			}
+
+			static void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+			{
+				if (bytes > max_block || alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				{
+					::operator delete(p, bytes, std::align_val_t{alignment});
+					return;
+				}
+
+				const auto c {class_of(bytes)};
+				if (const auto l {local()}; l != nullptr && l->counts[c] < max_cached)
+				{
+					l->heads[c] = ::new (p) block{l->heads[c]};
+					++l->counts[c];
+					return;
+				}
+
+				::operator delete(p, block_size(c));
+			}
+
+			// The counters of the calling thread.
+			[[nodiscard]] static recycling_pool_stats stats() noexcept
+			{
+				if (const auto l {local()}; l != nullptr)
+				{
+					return l->stats;
+				}
+
+				return {};
+			}
+
+			// Gives the blocks cached by the calling thread back to operator delete.
+			static void release() noexcept
+			{
+				if (const auto l {local()}; l != nullptr)
+				{
+					l->release();
+				}
+			}
+		private:
+			static constexpr std::size_t class_count {std::countr_zero(max_block) - std::countr_zero(min_block) + 1};
+
+			struct block
+			{
+				block* next;
+			};
+
+			struct free_lists
+			{
+				std::array<block*, class_count> heads {};
+				std::array<std::size_t, class_count> counts {};
+				recycling_pool_stats stats {};
+
+				free_lists() = default;
+				free_lists(const free_lists&) = delete;
+				free_lists& operator=(const free_lists&) = delete;
+
+				~free_lists() noexcept
+				{
+					release();
+					destroyed_ = true;
+				}
+
+				void release() noexcept
+				{
+					for (std::size_t c {0}; c < class_count; ++c)
+					{
+						while (heads[c] != nullptr)
+						{
+							const auto b {heads[c]};
+							heads[c] = b->next;
+							::operator delete(b, block_size(c));
+						}
+
+						counts[c] = 0;
+					}
+				}
+			};
+
+			// Set once the thread's free lists are gone, so that blocks freed
+			// later in thread exit go back to operator delete.
+			static thread_local inline bool destroyed_ {false};
+
+			[[nodiscard]] static free_lists* local() noexcept
+			{
+				if (destroyed_)
+				{
+					return nullptr;
+				}
+
+				thread_local free_lists lists;
+				return &lists;
+			}
+
+			[[nodiscard]] static constexpr std::size_t class_of(std::size_t bytes) noexcept
+			{
+				return static_cast<std::size_t>(std::countr_zero(std::bit_ceil(bytes < min_block ? min_block : bytes)) - std::countr_zero(min_block));
+			}
+
+			[[nodiscard]] static constexpr std::size_t block_size(std::size_t c) noexcept
+			{
+				return min_block << c;
+			}
+	};
+
+	// A stateless allocator over recycling_pool. Any instance can free memory
+	// from any other, on any thread.
+	export
+	template<class T>
+	class recycling_allocator
+	{
+		public:
+			using value_type = T;
+
+			constexpr recycling_allocator() noexcept = default;
+
+			template<class U>
+			constexpr recycling_allocator(const recycling_allocator<U>&) noexcept {}
+
+			[[nodiscard]] T* allocate(std::size_t n)
+			{
+				if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+				{
+					throw std::bad_array_new_length{};
+				}
+
+				return static_cast<T*>(recycling_pool::allocate(n * sizeof(T), alignof(T)));
+			}
+
+			void deallocate(T* p, std::size_t n) noexcept
+			{
+				recycling_pool::deallocate(p, n * sizeof(T), alignof(T));
+			}
+
+			template<class U>
+			[[nodiscard]] friend constexpr bool operator==(const recycling_allocator&, const recycling_allocator<U>&) noexcept
+			{
+				return true;
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+export module cmoon.net.buffers.buffer_pool;
+
+import <cstddef>;
+import <algorithm>;
+import <atomic>;
+import <memory>;
+import <mutex>;
+import <new>;
+import <thread>;
+import <vector>;
+
+namespace cmoon::net
+{
+	export
+	struct buffer_pool_statistics
+	{
+		std::size_t slab_size {0};
+		std::size_t in_use {0};
+		std::size_t high_water {0};
+		std::size_t cached {0};
+		std::size_t system_allocations {0};
+	};
+
+	// Hands out fixed-size slabs. Freed slabs go onto the free list of the
+	// thread that frees them and are reused by that thread first; a list
+	// holding more than cached_per_thread slabs returns the excess to the
+	// system, so memory is given back once the load drops.
+	export
+	class buffer_pool
+	{
+		struct alignas(std::hardware_destructive_interference_size) free_list
+		{
+			std::mutex m;
+			std::vector<void*> slabs;
+		};
+
+		public:
+			static constexpr std::size_t default_slab_size {4096};
+			static constexpr std::size_t default_cached_per_thread {256};
+			static constexpr std::size_t slab_alignment {64};
+
+			explicit buffer_pool(std::size_t slab_size = default_slab_size, std::size_t cached_per_thread = default_cached_per_thread)
+				: slab_size_{slab_size},
+				  cached_per_thread_{cached_per_thread},
+				  lists_count_{std::max(std::thread::hardware_concurrency(), 1u)},
+				  lists_{std::make_unique<free_list[]>(lists_count_)}
+			{
+				// Reserved up front so that deallocate never allocates.
+				for (std::size_t i {0}; i < lists_count_; ++i)
+				{
+					lists_[i].slabs.reserve(cached_per_thread_);
+				}
+			}
+
+			buffer_pool(const buffer_pool&) = delete;
+			buffer_pool& operator=(const buffer_pool&) = delete;
+
+			// Every slab must have been deallocated.
+			~buffer_pool() noexcept
+			{
+				for (std::size_t i {0}; i < lists_count_; ++i)
+				{
+					for (const auto slab : lists_[i].slabs)
+					{
+						release(slab);
+					}
+				}
+			}
+
+			[[nodiscard]] void* allocate()
+			{
+				void* slab {nullptr};
+				{
+					auto& list {local_list()};
+					std::scoped_lock l {list.m};
+					if (!list.slabs.empty())
+					{
+						slab = list.slabs.back();
+						list.slabs.pop_back();
+						cached_.fetch_sub(1, std::memory_order_relaxed);
+					}
+				}
+
+				if (!slab)
+				{
+					slab = ::operator new(slab_size_, std::align_val_t{slab_alignment});
+					system_allocations_.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				const auto in_use {in_use_.fetch_add(1, std::memory_order_relaxed) + 1};
+				auto high_water {high_water_.load(std::memory_order_relaxed)};
+				while (high_water < in_use && !high_water_.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {}
+
+				return slab;
+			}
+
+			void deallocate(void* slab) noexcept
+			{
+				in_use_.fetch_sub(1, std::memory_order_relaxed);
+				{
+					auto& list {local_list()};
+					std::scoped_lock l {list.m};
+					if (list.slabs.size() < cached_per_thread_)
+					{
+						list.slabs.push_back(slab);
+						cached_.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+				}
+
+				release(slab);
+			}
+
+			[[nodiscard]] std::size_t slab_size() const noexcept
+			{
+				return slab_size_;
+			}
+
+			[[nodiscard]] buffer_pool_statistics statistics() const noexcept
+			{
+				return {
+					.slab_size = slab_size_,
+					.in_use = in_use_.load(std::memory_order_relaxed),
+					.high_water = high_water_.load(std::memory_order_relaxed),
+					.cached = cached_.load(std::memory_order_relaxed),
+					.system_allocations = system_allocations_.load(std::memory_order_relaxed)
+				};
+			}
+		private:
+			std::size_t slab_size_;
+			std::size_t cached_per_thread_;
+			std::size_t lists_count_;
+			std::unique_ptr<free_list[]> lists_;
+			std::atomic<std::size_t> in_use_ {0};
+			std::atomic<std::size_t> high_water_ {0};
+			std::atomic<std::size_t> cached_ {0};
+			std::atomic<std::size_t> system_allocations_ {0};
+
+			static inline std::atomic<std::size_t> next_thread_ {0};
+
+			// Threads are numbered as they first touch any pool, so up to
+			// hardware_concurrency threads each own a list outright.
+			[[nodiscard]] free_list& local_list() noexcept
+			{
+				static thread_local const std::size_t thread_index {next_thread_.fetch_add(1, std::memory_order_relaxed)};
+				return lists_[thread_index % lists_count_];
+			}
+
+			void release(void* slab) noexcept
+			{
+				::operator delete(slab, slab_size_, std::align_val_t{slab_alignment});
+			}
+	};
+}
@@ -4,6 +4,7 @@ namespace cmoon::net
 {
 	export
 	template<class C>
+		requires(requires(C& c) { c.begin(); })
 	inline constexpr auto buffer_sequence_begin(C& c) noexcept
 	{
 		return c.begin();
@@ -11,6 +12,7 @@ namespace cmoon::net
 
 	export
 	template<class C>
+		requires(requires(const C& c) { c.begin(); })
 	inline constexpr auto buffer_sequence_begin(const C& c) noexcept
 	{
 		return c.begin();
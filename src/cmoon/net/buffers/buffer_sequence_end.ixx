@@ -4,6 +4,7 @@ namespace cmoon::net
 {
 	export
 	template<class C>
+		requires(requires(C& c) { c.end(); })
 	inline constexpr auto buffer_sequence_end(C& c) noexcept
 	{
 		return c.end();
@@ -11,6 +12,7 @@ namespace cmoon::net
 
 	export
 	template<class C>
+		requires(requires(const C& c) { c.end(); })
 	inline constexpr auto buffer_sequence_end(const C& c) noexcept
 	{
 		return c.end();
@@ -7,12 +7,25 @@ import <iterator>;
 
 import cmoon.net.buffers.mutable_buffer;
 import cmoon.net.buffers.const_buffer;
+import cmoon.net.buffers.buffer_sequence_begin;
+import cmoon.net.buffers.buffer_sequence_end;
 
 namespace cmoon::net
 {
+	template<class T>
+	concept is_iterator_reference_conv_mutable_buffer = std::convertible_to<typename std::iterator_traits<T>::reference, mutable_buffer> &&
+														std::bidirectional_iterator<T>;
+
 	template<class T>
 	concept is_mutable_buffer_sequence_concept = std::destructible<T> &&
-												 std::copy_constructible<T>;
+												 std::copy_constructible<T> &&
+		requires(T x, const T x1)
+	{
+		{ buffer_sequence_begin(x) } -> is_iterator_reference_conv_mutable_buffer<>;
+		{ buffer_sequence_begin(x1) } -> is_iterator_reference_conv_mutable_buffer<>;
+		{ buffer_sequence_end(x) } -> is_iterator_reference_conv_mutable_buffer<>;
+		{ buffer_sequence_end(x1) } -> is_iterator_reference_conv_mutable_buffer<>;
+	};
 
 	template<class T>
 	concept is_iterator_reference_conv_const_buffer = std::convertible_to<typename std::iterator_traits<T>::reference, const_buffer> &&
@@ -1,17 +1,20 @@
 export module cmoon.net.buffers;
-export module cmoon.net.buffers.stream_errc;
-export module cmoon.net.buffers.mutable_buffer;
-export module cmoon.net.buffers.const_buffer;
-export module cmoon.net.buffers.buffer_traits;
-export module cmoon.net.buffers.buffer_sequence_begin;
-export module cmoon.net.buffers.buffer_sequence_end;
-export module cmoon.net.buffers.buffer_size;
-export module cmoon.net.buffers.buffer_copy;
-export module cmoon.net.buffers.buffer;
-export module cmoon.net.buffers.dynamic_vector_buffer;
-export module cmoon.net.buffers.dynamic_string_buffer;
-export module cmoon.net.buffers.transfer_all;
-export module cmoon.net.buffers.transfer_at_least;
-export module cmoon.net.buffers.transfer_exactly;
-export module cmoon.net.buffers.read;
-export module cmoon.net.buffers.write;
\ No newline at end of file
+export import cmoon.net.buffers.stream_errc;
+export import cmoon.net.buffers.mutable_buffer;
+export import cmoon.net.buffers.const_buffer;
+export import cmoon.net.buffers.buffer_traits;
+export import cmoon.net.buffers.buffer_sequence_begin;
+export import cmoon.net.buffers.buffer_sequence_end;
+export import cmoon.net.buffers.buffer_size;
+export import cmoon.net.buffers.buffer_copy;
+export import cmoon.net.buffers.buffer;
+export import cmoon.net.buffers.dynamic_vector_buffer;
+export import cmoon.net.buffers.dynamic_string_buffer;
+export import cmoon.net.buffers.buffer_pool;
+export import cmoon.net.buffers.dynamic_slab_buffer;
+export import cmoon.net.buffers.consuming_buffers;
+export import cmoon.net.buffers.transfer_all;
+export import cmoon.net.buffers.transfer_at_least;
+export import cmoon.net.buffers.transfer_exactly;
+export import cmoon.net.buffers.read;
+export import cmoon.net.buffers.write;
\ No newline at end of file
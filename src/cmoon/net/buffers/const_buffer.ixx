@@ -4,6 +4,8 @@ import <cstddef>;
 import <algorithm>;
 import <memory>;
 
+import cmoon.net.buffers.mutable_buffer;
+
 namespace cmoon::net
 {
 	export
@@ -58,7 +60,7 @@ namespace cmoon::net
 	constexpr const_buffer operator+(const const_buffer& b, std::size_t n) noexcept
 	{
 		const auto min = std::min(n, b.size());
-		return const_buffer{static_cast<char*>(b.data()) + min, b.size() - min};
+		return const_buffer{static_cast<const char*>(b.data()) + min, b.size() - min};
 	}
 
 	export
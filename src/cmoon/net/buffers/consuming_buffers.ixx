@@ -0,0 +1,149 @@
+export module cmoon.net.buffers.consuming_buffers;
+
+import <cstddef>;
+import <array>;
+import <algorithm>;
+import <utility>;
+
+import cmoon.net.buffers.mutable_buffer;
+import cmoon.net.buffers.const_buffer;
+import cmoon.net.buffers.buffer_sequence_begin;
+import cmoon.net.buffers.buffer_sequence_end;
+
+namespace cmoon::net
+{
+	// The most buffers handed to a single scatter/gather system call.
+	export
+	inline constexpr std::size_t max_buffers {64};
+
+	// A fixed-capacity buffer sequence, filled by consuming_buffers::prepare.
+	export
+	template<class Buffer, std::size_t N = max_buffers>
+	class prepared_buffers
+	{
+		public:
+			using value_type = Buffer;
+			using const_iterator = const Buffer*;
+
+			constexpr prepared_buffers() noexcept = default;
+
+			constexpr void push_back(const Buffer& b) noexcept
+			{
+				buffers_[count_++] = b;
+			}
+
+			[[nodiscard]] constexpr const_iterator begin() const noexcept
+			{
+				return buffers_.data();
+			}
+
+			[[nodiscard]] constexpr const_iterator end() const noexcept
+			{
+				return buffers_.data() + count_;
+			}
+
+			[[nodiscard]] constexpr std::size_t count() const noexcept
+			{
+				return count_;
+			}
+
+			[[nodiscard]] constexpr bool full() const noexcept
+			{
+				return count_ == N;
+			}
+		private:
+			std::array<Buffer, N> buffers_ {};
+			std::size_t count_ {0};
+	};
+
+	// Walks a buffer sequence across several partial reads or writes without
+	// copying or modifying the sequence itself.
+	export
+	template<class Buffer, class BufferSequence>
+	class consuming_buffers
+	{
+		public:
+			explicit consuming_buffers(const BufferSequence& buffers)
+				: current_{buffer_sequence_begin(buffers)}, end_{buffer_sequence_end(buffers)} {}
+
+			[[nodiscard]] bool empty() const noexcept
+			{
+				auto i {current_};
+				if (i == end_)
+				{
+					return true;
+				}
+
+				if (Buffer{*i}.size() > offset_)
+				{
+					return false;
+				}
+
+				for (++i; i != end_; ++i)
+				{
+					if (Buffer{*i}.size() > 0)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// The next max_size bytes, or fewer, as at most N buffers.
+			template<std::size_t N = max_buffers>
+			[[nodiscard]] prepared_buffers<Buffer, N> prepare(std::size_t max_size) const noexcept
+			{
+				prepared_buffers<Buffer, N> result;
+				auto offset {offset_};
+				for (auto i {current_}; i != end_ && max_size > 0 && !result.full(); ++i, offset = 0)
+				{
+					const auto b {Buffer{*i} + offset};
+					if (b.size() == 0)
+					{
+						continue;
+					}
+
+					const auto n {std::min(b.size(), max_size)};
+					result.push_back(Buffer{b.data(), n});
+					max_size -= n;
+				}
+
+				return result;
+			}
+
+			void consume(std::size_t n) noexcept
+			{
+				total_consumed_ += n;
+				while (current_ != end_)
+				{
+					const auto remaining {Buffer{*current_}.size() - offset_};
+					if (n < remaining)
+					{
+						offset_ += n;
+						return;
+					}
+
+					n -= remaining;
+					offset_ = 0;
+					++current_;
+					if (n == 0)
+					{
+						return;
+					}
+				}
+			}
+
+			[[nodiscard]] std::size_t total_consumed() const noexcept
+			{
+				return total_consumed_;
+			}
+		private:
+			using iterator = decltype(buffer_sequence_begin(std::declval<const BufferSequence&>()));
+
+			iterator current_;
+			iterator end_;
+			std::size_t offset_ {0};
+			std::size_t total_consumed_ {0};
+	};
+}
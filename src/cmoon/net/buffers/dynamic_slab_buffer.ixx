@@ -0,0 +1,333 @@
+export module cmoon.net.buffers.dynamic_slab_buffer;
+
+import <cstddef>;
+import <algorithm>;
+import <iterator>;
+import <limits>;
+import <stdexcept>;
+import <utility>;
+import <vector>;
+
+import cmoon.net.buffers.const_buffer;
+import cmoon.net.buffers.mutable_buffer;
+import cmoon.net.buffers.buffer_pool;
+
+namespace cmoon::net
+{
+	// A byte range spread over consecutive slabs, one buffer per slab.
+	// Invalidated by anything that adds or removes slabs.
+	export
+	template<class Buffer>
+	class slab_buffers
+	{
+		public:
+			class iterator
+			{
+				public:
+					using iterator_concept = std::bidirectional_iterator_tag;
+					using iterator_category = std::input_iterator_tag;
+					using value_type = Buffer;
+					using difference_type = std::ptrdiff_t;
+					using reference = Buffer;
+
+					iterator() noexcept = default;
+
+					[[nodiscard]] Buffer operator*() const noexcept
+					{
+						const auto slab_begin {index_ * slab_size_};
+						const auto first {std::max(begin_, slab_begin)};
+						const auto last {std::min(end_, slab_begin + slab_size_)};
+						return Buffer{slabs_[index_] + (first - slab_begin), last - first};
+					}
+
+					iterator& operator++() noexcept
+					{
+						++index_;
+						return *this;
+					}
+
+					iterator operator++(int) noexcept
+					{
+						auto old {*this};
+						++index_;
+						return old;
+					}
+
+					iterator& operator--() noexcept
+					{
+						--index_;
+						return *this;
+					}
+
+					iterator operator--(int) noexcept
+					{
+						auto old {*this};
+						--index_;
+						return old;
+					}
+
+					[[nodiscard]] friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept
+					{
+						return lhs.index_ == rhs.index_;
+					}
+				private:
+					std::byte* const* slabs_ {nullptr};
+					std::size_t slab_size_ {0};
+					std::size_t begin_ {0};
+					std::size_t end_ {0};
+					std::size_t index_ {0};
+
+					iterator(std::byte* const* slabs, std::size_t slab_size, std::size_t begin, std::size_t end, std::size_t index) noexcept
+						: slabs_{slabs}, slab_size_{slab_size}, begin_{begin}, end_{end}, index_{index} {}
+
+					friend slab_buffers;
+			};
+
+			using value_type = Buffer;
+			using const_iterator = iterator;
+
+			slab_buffers() noexcept = default;
+
+			slab_buffers(std::byte* const* slabs, std::size_t slab_size, std::size_t begin, std::size_t end) noexcept
+				: slabs_{slabs}, slab_size_{slab_size}, begin_{begin}, end_{end} {}
+
+			[[nodiscard]] iterator begin() const noexcept
+			{
+				return {slabs_, slab_size_, begin_, end_, slab_size_ == 0 ? 0 : begin_ / slab_size_};
+			}
+
+			[[nodiscard]] iterator end() const noexcept
+			{
+				return {slabs_, slab_size_, begin_, end_, begin_ == end_ ? begin().index_ : (end_ - 1) / slab_size_ + 1};
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return end_ - begin_;
+			}
+		private:
+			std::byte* const* slabs_ {nullptr};
+			std::size_t slab_size_ {0};
+			std::size_t begin_ {0};
+			std::size_t end_ {0};
+	};
+
+	// Bytes held in slabs from a buffer_pool. Growing adds slabs rather than
+	// reallocating and moving what is already there, and slabs are returned
+	// to the pool as soon as they are consumed, so an idle chain holds no
+	// memory at all.
+	export
+	class slab_chain
+	{
+		public:
+			explicit slab_chain(buffer_pool& pool, std::size_t maximum_size = std::numeric_limits<std::size_t>::max()) noexcept
+				: pool_{&pool}, max_size_{maximum_size} {}
+
+			slab_chain(slab_chain&& other) noexcept
+				: pool_{other.pool_},
+				  slabs_{std::move(other.slabs_)},
+				  begin_{std::exchange(other.begin_, 0)},
+				  size_{std::exchange(other.size_, 0)},
+				  max_size_{other.max_size_}
+			{
+				other.slabs_.clear();
+			}
+
+			slab_chain& operator=(slab_chain&& other) noexcept
+			{
+				if (this != &other)
+				{
+					clear();
+					pool_ = other.pool_;
+					slabs_ = std::move(other.slabs_);
+					other.slabs_.clear();
+					begin_ = std::exchange(other.begin_, 0);
+					size_ = std::exchange(other.size_, 0);
+					max_size_ = other.max_size_;
+				}
+
+				return *this;
+			}
+
+			~slab_chain() noexcept
+			{
+				clear();
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return size_;
+			}
+
+			[[nodiscard]] std::size_t max_size() const noexcept
+			{
+				return max_size_;
+			}
+
+			[[nodiscard]] std::size_t capacity() const noexcept
+			{
+				return std::min(slabs_.size() * pool_->slab_size() - begin_, max_size_);
+			}
+
+			[[nodiscard]] std::size_t slab_count() const noexcept
+			{
+				return slabs_.size();
+			}
+
+			[[nodiscard]] buffer_pool& pool() const noexcept
+			{
+				return *pool_;
+			}
+
+			[[nodiscard]] slab_buffers<const_buffer> data(std::size_t pos, std::size_t n) const noexcept
+			{
+				const auto [first, last] {range(pos, n)};
+				return {slabs_.data(), pool_->slab_size(), first, last};
+			}
+
+			[[nodiscard]] slab_buffers<mutable_buffer> data(std::size_t pos, std::size_t n) noexcept
+			{
+				const auto [first, last] {range(pos, n)};
+				return {slabs_.data(), pool_->slab_size(), first, last};
+			}
+
+			void grow(std::size_t n)
+			{
+				if (max_size_ - size_ < n)
+				{
+					throw std::length_error{"slab_chain too long"};
+				}
+
+				const auto needed {begin_ + size_ + n};
+				while (slabs_.size() * pool_->slab_size() < needed)
+				{
+					slabs_.push_back(static_cast<std::byte*>(pool_->allocate()));
+				}
+
+				size_ += n;
+			}
+
+			void shrink(std::size_t n) noexcept
+			{
+				size_ -= std::min(n, size_);
+				if (size_ == 0)
+				{
+					clear();
+					return;
+				}
+
+				const auto slab_size {pool_->slab_size()};
+				const auto used {(begin_ + size_ - 1) / slab_size + 1};
+				while (slabs_.size() > used)
+				{
+					pool_->deallocate(slabs_.back());
+					slabs_.pop_back();
+				}
+			}
+
+			void consume(std::size_t n) noexcept
+			{
+				n = std::min(n, size_);
+				size_ -= n;
+				if (size_ == 0)
+				{
+					clear();
+					return;
+				}
+
+				begin_ += n;
+				const auto slab_size {pool_->slab_size()};
+				const auto spent {begin_ / slab_size};
+				for (std::size_t i {0}; i < spent; ++i)
+				{
+					pool_->deallocate(slabs_[i]);
+				}
+
+				slabs_.erase(slabs_.begin(), slabs_.begin() + spent);
+				begin_ -= spent * slab_size;
+			}
+
+			void clear() noexcept
+			{
+				for (const auto slab : slabs_)
+				{
+					pool_->deallocate(slab);
+				}
+
+				slabs_.clear();
+				begin_ = 0;
+				size_ = 0;
+			}
+		private:
+			buffer_pool* pool_;
+			std::vector<std::byte*> slabs_;
+			std::size_t begin_ {0};
+			std::size_t size_ {0};
+			std::size_t max_size_;
+
+			[[nodiscard]] std::pair<std::size_t, std::size_t> range(std::size_t pos, std::size_t n) const noexcept
+			{
+				pos = std::min(pos, size_);
+				return {begin_ + pos, begin_ + pos + std::min(n, size_ - pos)};
+			}
+	};
+
+	export
+	class dynamic_slab_buffer
+	{
+		public:
+			using const_buffers_type = slab_buffers<const_buffer>;
+			using mutable_buffers_type = slab_buffers<mutable_buffer>;
+
+			explicit dynamic_slab_buffer(slab_chain& chain) noexcept
+				: chain_{chain} {}
+
+			[[nodiscard]] std::size_t size() const noexcept
+			{
+				return chain_.size();
+			}
+
+			[[nodiscard]] std::size_t max_size() const noexcept
+			{
+				return chain_.max_size();
+			}
+
+			[[nodiscard]] std::size_t capacity() const noexcept
+			{
+				return chain_.capacity();
+			}
+
+			[[nodiscard]] const_buffers_type data(std::size_t pos, std::size_t n) const noexcept
+			{
+				return std::as_const(chain_).data(pos, n);
+			}
+
+			[[nodiscard]] mutable_buffers_type data(std::size_t pos, std::size_t n) noexcept
+			{
+				return chain_.data(pos, n);
+			}
+
+			void grow(std::size_t n)
+			{
+				chain_.grow(n);
+			}
+
+			void shrink(std::size_t n)
+			{
+				chain_.shrink(n);
+			}
+
+			void consume(std::size_t n)
+			{
+				chain_.consume(n);
+			}
+		private:
+			slab_chain& chain_;
+	};
+
+	export
+	[[nodiscard]] dynamic_slab_buffer dynamic_buffer(slab_chain& chain) noexcept
+	{
+		return dynamic_slab_buffer{chain};
+	}
+}
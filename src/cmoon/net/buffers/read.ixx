@@ -1,43 +1,49 @@
 export module cmoon.net.buffers.read;
 
 import <cstddef>;
+import <algorithm>;
 import <system_error>;
 
-import cmoon.net.buffers.buffer_sequence_begin;
-import cmoon.net.buffers.buffer_sequence_end;
+import cmoon.net.buffers.mutable_buffer;
+import cmoon.net.buffers.consuming_buffers;
 import cmoon.net.buffers.transfer_all;
 import cmoon.net.buffers.buffer_traits;
 
 namespace cmoon::net
 {
+	// How far a dynamic buffer is grown for a read when it has no spare
+	// capacity.
+	inline constexpr std::size_t dynamic_read_size {512};
+
+	// Each read_some is handed as much of the remaining sequence as the
+	// completion condition allows, so a stream that supports scatter reads
+	// fills several buffers with one system call.
 	export
 	template<class SyncReadStream, class MutableBufferSequence, class CompletionCondition>
 		requires(is_mutable_buffer_sequence_v<MutableBufferSequence>)
 	std::size_t read(SyncReadStream& stream, const MutableBufferSequence& buffers, CompletionCondition completion_condition, std::error_code& ec)
 	{
-		std::size_t total_bytes_read {0};
 		ec.clear();
-		auto i {buffer_sequence_begin(buffers)};
-		const auto end {buffer_sequence_end(buffers)};
+		consuming_buffers<mutable_buffer, MutableBufferSequence> remaining {buffers};
 
-		while (i != end)
+		while (!remaining.empty())
 		{
-			const auto bytes_read = stream.read_some(buffer(*i, completion_condition(ec, i->size())), ec);
-			if (bytes_read == 0)
+			const auto n {completion_condition(ec, remaining.total_consumed())};
+			if (n == 0)
 			{
 				break;
 			}
 
-			*i += bytes_read;
-			total_bytes_read += bytes_read;
-			
-			if (i->size() == 0)
+			const auto bytes_read {stream.read_some(remaining.prepare(n), ec)};
+			if (bytes_read == 0)
 			{
-				++i;
+				break;
 			}
+
+			remaining.consume(bytes_read);
 		}
 
-		return total_bytes_read;
+		return remaining.total_consumed();
 	}
 
 	export
@@ -51,7 +57,7 @@ namespace cmoon::net
 
 	export
 	template<class SyncReadStream, class MutableBufferSequence>
-		requires(is_mutable_buffer_sequence)_<MutableBufferSequence>)
+		requires(is_mutable_buffer_sequence_v<MutableBufferSequence>)
 	std::size_t read(SyncReadStream& stream, const MutableBufferSequence& buffers)
 	{
 		std::error_code ec;
@@ -76,16 +82,17 @@ namespace cmoon::net
 
 		while (true)
 		{
-			const auto orig_size = b.size();
-			const auto N = completion_condition(ec, b.capacity() - orig_size);
-			if (N == 0)
+			const auto orig_size {b.size()};
+			const auto N {std::min(completion_condition(ec, total_bytes_read), std::max(b.capacity() - orig_size, dynamic_read_size))};
+			if (N == 0 || orig_size == b.max_size())
 			{
 				break;
 			}
 
-			b.grow(N);
-			auto x = b.data(orig_size, N);
-			const auto bytes_read = stream.read_some(x, ec);
+			const auto n {std::min(N, b.max_size() - orig_size)};
+			b.grow(n);
+			const auto bytes_read {stream.read_some(b.data(orig_size, n), ec)};
+			b.shrink(n - bytes_read);
 
 			if (bytes_read == 0)
 			{
@@ -1,5 +1,6 @@
 export module cmoon.net.buffers.stream_errc;
 
+import <string>;
 import <system_error>;
 
 namespace cmoon::net
@@ -11,6 +12,19 @@ namespace cmoon::net
 			{
 				return "stream";
 			}
+
+			std::string message(int ev) const override
+			{
+				switch (ev)
+				{
+					case 1:
+						return "end of file";
+					case 2:
+						return "not found";
+					default:
+						return "unknown stream error";
+				}
+			}
 	};
 
 	export
@@ -37,7 +51,7 @@ namespace std
 	}
 
 	export
-	std::error_condition make_error_condition(collin::net::stream_errc e) noexcept
+	std::error_condition make_error_condition(cmoon::net::stream_errc e) noexcept
 	{
 		return std::error_condition{static_cast<int>(e), cmoon::net::stream_category()};
 	}
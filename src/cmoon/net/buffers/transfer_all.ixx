@@ -2,21 +2,25 @@ export module cmoon.net.buffers.transfer_all;
 
 import <system_error>;
 import <cstddef>;
+import <limits>;
 
 namespace cmoon::net
 {
+	// Completion conditions receive the bytes transferred so far and return
+	// the most the next operation may transfer, or 0 to stop. Leaving that
+	// unbounded lets a whole buffer sequence go to a single readv/writev.
 	export
 	class transfer_all
 	{
 		public:
-			std::size_t operator()(const error_code& ec, std::size_t n) const
+			std::size_t operator()(const std::error_code& ec, std::size_t) const noexcept
 			{
 				if (!ec)
 				{
-					return n;
+					return std::numeric_limits<std::size_t>::max();
 				}
 
 				return 0;
 			}
 	};
-}
\ No newline at end of file
+}
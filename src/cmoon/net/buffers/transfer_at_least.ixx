@@ -2,6 +2,7 @@ export module cmoon.net.buffers.transfer_at_least;
 
 import <system_error>;
 import <cstddef>;
+import <limits>;
 
 namespace cmoon::net
 {
@@ -12,11 +13,11 @@ namespace cmoon::net
 			explicit transfer_at_least(std::size_t m)
 				: minimum_{m} {}
 
-			std::size_t operator()(const std::error_code& ec, std::size_t n) const
+			std::size_t operator()(const std::error_code& ec, std::size_t n) const noexcept
 			{
 				if (!ec && n < minimum_)
 				{
-					return n;
+					return std::numeric_limits<std::size_t>::max();
 				}
 
 				return 0;
@@ -24,4 +25,4 @@ namespace cmoon::net
 		private:
 			std::size_t minimum_;
 	};
-}
\ No newline at end of file
+}
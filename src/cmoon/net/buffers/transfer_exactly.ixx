@@ -2,7 +2,6 @@ export module cmoon.net.buffers.transfer_exactly;
 
 import <system_error>;
 import <cstddef>;
-import <algorithm>;
 
 namespace cmoon::net
 {
@@ -13,11 +12,11 @@ namespace cmoon::net
 			explicit transfer_exactly(std::size_t e)
 				: exact_{e} {}
 
-			std::size_t operator()(const std::error_code& ec, std::size_t n) const
+			std::size_t operator()(const std::error_code& ec, std::size_t n) const noexcept
 			{
 				if (!ec && n < exact_)
 				{
-					return std::min(exact_ - n, n);
+					return exact_ - n;
 				}
 
 				return 0;
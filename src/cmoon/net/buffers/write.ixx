@@ -1,61 +1,67 @@
 export module cmoon.net.buffers.write;
 
 import <cstddef>;
+import <algorithm>;
 import <system_error>;
 
-import cmoon.net.buffers.buffer_sequence_begin;
-import cmoon.net.buffers.buffer_sequence_end;
+import cmoon.net.buffers.const_buffer;
+import cmoon.net.buffers.consuming_buffers;
 import cmoon.net.buffers.transfer_all;
 import cmoon.net.buffers.buffer_traits;
 
 namespace cmoon::net
 {
+	// Each write_some is handed as much of the remaining sequence as the
+	// completion condition allows, so framing such as a header and body
+	// goes out in one gathered system call.
 	export
 	template<class SyncWriteStream, class ConstBufferSequence, class CompletionCondition>
+		requires(is_const_buffer_sequence_v<ConstBufferSequence>)
 	std::size_t write(SyncWriteStream& stream, const ConstBufferSequence& buffers, CompletionCondition completion_condition, std::error_code& ec)
 	{
-		std::size_t total_bytes_written {0};
 		ec.clear();
-		auto i {buffer_sequence_begin(buffers)};
-		const auto end {buffer_sequence_end(buffers)};
+		consuming_buffers<const_buffer, ConstBufferSequence> remaining {buffers};
 
-		while (i != end)
+		while (!remaining.empty())
 		{
-			const auto bytes_written = stream.write_some(buffer(*i, completion_condition(ec, i->size())), ec);
-			if (bytes_written == 0)
+			const auto n {completion_condition(ec, remaining.total_consumed())};
+			if (n == 0)
 			{
 				break;
 			}
 
-			*i += bytes_written;
-			total_bytes_written += bytes_written;
-
-			if (i->size() == 0)
+			const auto bytes_written {stream.write_some(remaining.prepare(n), ec)};
+			if (bytes_written == 0)
 			{
-				++i;
+				break;
 			}
+
+			remaining.consume(bytes_written);
 		}
 
-		return total_bytes_written;
+		return remaining.total_consumed();
 	}
 
 	export
 	template<class SyncWriteStream, class ConstBufferSequence>
+		requires(is_const_buffer_sequence_v<ConstBufferSequence>)
 	std::size_t write(SyncWriteStream& stream, const ConstBufferSequence& buffers)
 	{
 		std::error_code ec;
-		return write(stream, buffers, std::transfer_all{}, ec);
+		return write(stream, buffers, transfer_all{}, ec);
 	}
 
 	export
 	template<class SyncWriteStream, class ConstBufferSequence>
+		requires(is_const_buffer_sequence_v<ConstBufferSequence>)
 	std::size_t write(SyncWriteStream& stream, const ConstBufferSequence& buffers, std::error_code& ec)
 	{
-		return write(stream, buffers, std::transfer_all{}, ec);
+		return write(stream, buffers, transfer_all{}, ec);
 	}
 
 	export
 	template<class SyncWriteStream, class ConstBufferSequence, class CompletionCondition>
+		requires(is_const_buffer_sequence_v<ConstBufferSequence>)
 	std::size_t write(SyncWriteStream& stream, const ConstBufferSequence& buffers, CompletionCondition completion_condition)
 	{
 		std::error_code ec;
@@ -72,7 +78,13 @@ namespace cmoon::net
 
 		while (b.size() > 0)
 		{
-			const auto bytes_written = stream.write_some(b.data(0, completion_condition(b.size(), ec)));
+			const auto n {completion_condition(ec, total_bytes_written)};
+			if (n == 0)
+			{
+				break;
+			}
+
+			const auto bytes_written {stream.write_some(b.data(0, std::min(n, b.size())), ec)};
 			if (bytes_written == 0)
 			{
 				break;
@@ -1,4 +1,5 @@
 export module cmoon.net.execution;
 //export import cmoon.net.execution.fork_event;
 export import cmoon.net.execution.service_context;
+export import cmoon.net.execution.io_context;
 //export import cmoon.net.execution.system_context;
\ No newline at end of file
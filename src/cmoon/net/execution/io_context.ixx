@@ -0,0 +1,1648 @@
+module;
+
+#if defined(__linux__)
+	#include <linux/io_uring.h>
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+	#include <sys/socket.h>
+	#include <sys/uio.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <errno.h>
+#endif
+
+export module cmoon.net.execution.io_context;
+
+import <cstddef>;
+import <cstdint>;
+import <cstring>;
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <concepts>;
+import <deque>;
+import <limits>;
+import <memory>;
+import <mutex>;
+import <optional>;
+import <span>;
+import <system_error>;
+import <exception>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+import cmoon.execution;
+import cmoon.intrusive_queue;
+import cmoon.net.execution.io_ring;
+import cmoon.net.buffers.mutable_buffer;
+import cmoon.net.buffers.const_buffer;
+import cmoon.net.buffers.stream_errc;
+import cmoon.net.buffers.buffer_traits;
+import cmoon.net.buffers.consuming_buffers;
+
+#if defined(__linux__)
+namespace cmoon::net
+{
+	export
+	class io_context;
+
+	template<cmoon::execution::receiver R>
+	struct io_schedule_operation;
+
+	template<class Action, cmoon::execution::receiver R>
+	struct io_operation;
+
+	enum class io_direction : std::size_t
+	{
+		read,
+		write
+	};
+
+	// epoll waits for readiness and then makes the system call itself;
+	// io_uring hands the whole operation to the kernel, batching the
+	// submissions made while a thread is inside run().
+	export
+	enum class io_backend
+	{
+		epoll,
+		io_uring
+	};
+
+	// Whether an io_context can use io_backend::io_uring here: the kernel
+	// must allow io_uring at all and implement every opcode it submits.
+	export
+	[[nodiscard]] bool io_uring_supported() noexcept
+	{
+		try
+		{
+			const io_ring ring {1};
+			return ring.supports({IORING_OP_ASYNC_CANCEL,
+								  IORING_OP_ACCEPT,
+								  IORING_OP_CONNECT,
+								  IORING_OP_READ_FIXED,
+								  IORING_OP_WRITE_FIXED,
+								  IORING_OP_RECV,
+								  IORING_OP_SEND,
+								  IORING_OP_RECVMSG,
+								  IORING_OP_SENDMSG,
+								  IORING_OP_POLL_ADD});
+		}
+		catch (const std::system_error&)
+		{
+			return false;
+		}
+	}
+
+	// Operation states for the reactor embed this, so starting an operation
+	// never allocates. perform is null for posted work; otherwise it makes
+	// one non-blocking attempt and returns true once the operation has
+	// finished, leaving any failure in ec. With io_uring, prepare fills in
+	// the submission instead and finish records the kernel's result.
+	struct reactor_operation
+	{
+		reactor_operation* next {nullptr};
+		bool (*perform)(reactor_operation*) noexcept {nullptr};
+		void (*prepare)(reactor_operation*, ::io_uring_sqe&, int, std::span<const mutable_buffer>) noexcept {nullptr};
+		void (*finish)(reactor_operation*, int) noexcept {nullptr};
+		void (*complete)(reactor_operation*) noexcept {nullptr};
+		std::error_code ec;
+	};
+
+	using reactor_queue = cmoon::intrusive_queue<&reactor_operation::next>;
+
+	// A descriptor registered with an io_context. It is added to epoll once,
+	// edge-triggered for both directions, and each direction keeps the
+	// operations waiting for the descriptor to become ready again.
+	// Descriptors are recycled rather than freed, so an event that was
+	// already dequeued for a descriptor that has since been deregistered
+	// only causes a harmless retry.
+	export
+	class io_descriptor
+	{
+		friend class io_context;
+
+		public:
+			io_descriptor() noexcept = default;
+
+			io_descriptor(const io_descriptor&) = delete;
+			io_descriptor& operator=(const io_descriptor&) = delete;
+
+			[[nodiscard]] int native_handle() const noexcept
+			{
+				return fd_;
+			}
+
+			[[nodiscard]] io_context& context() const noexcept
+			{
+				return *ctx_;
+			}
+		private:
+			std::mutex m_;
+			io_context* ctx_ {nullptr};
+			int fd_ {-1};
+			std::array<reactor_queue, 2> ops_;
+			io_descriptor* next_free_ {nullptr};
+
+			// Only used by io_uring, which keeps one multishot accept armed
+			// per listening descriptor. Connections it delivers before anyone
+			// asks for them wait here.
+			std::deque<int> accepted_;
+			bool accept_armed_ {false};
+			bool retiring_ {false};
+
+			[[nodiscard]] reactor_queue& queue(io_direction d) noexcept
+			{
+				return ops_[static_cast<std::size_t>(d)];
+			}
+	};
+
+	// An event loop for socket operations. Any number of threads may call
+	// run(), and every operation completes on one of them. run() returns
+	// once the context is stopped or no operations are outstanding. Threads
+	// always wait in epoll; with the io_uring backend the ring itself is one
+	// of the descriptors waited on.
+	export
+	class io_context
+	{
+		template<cmoon::execution::receiver R>
+		friend struct io_schedule_operation;
+
+		template<class Action, cmoon::execution::receiver R>
+		friend struct io_operation;
+
+		public:
+			struct scheduler_t
+			{
+				struct sender_t
+				{
+					io_context& ctx_;
+
+					template<template<class...> class Tuple, template<class...> class Variant>
+					using value_types = Variant<Tuple<>>;
+
+					template<template<class...> class Variant>
+					using error_types = Variant<std::exception_ptr>;
+
+					static constexpr bool sends_done {true};
+
+					template<cmoon::execution::receiver R>
+					friend io_schedule_operation<std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, io_context::scheduler_t::sender_t s, R&& r) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<R>, R>)
+					{
+						return {s.ctx_, std::forward<R>(r)};
+					}
+
+					template<class CPO>
+					friend io_context::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, io_context::scheduler_t::sender_t s) noexcept
+					{
+						return {std::addressof(s.ctx_)};
+					}
+				};
+
+				io_context* ctx_;
+
+				[[nodiscard]] friend sender_t tag_invoke(cmoon::execution::schedule_t, io_context::scheduler_t t) noexcept
+				{
+					return {*t.ctx_};
+				}
+
+				[[nodiscard]] friend cmoon::execution::forward_progress_guarantee tag_invoke(cmoon::execution::get_forward_progress_guarantee_t, io_context::scheduler_t) noexcept
+				{
+					return cmoon::execution::forward_progress_guarantee::weakly_parallel;
+				}
+
+				[[nodiscard]] friend bool operator==(const scheduler_t&, const scheduler_t&) noexcept = default;
+				[[nodiscard]] friend bool operator!=(const scheduler_t&, const scheduler_t&) noexcept = default;
+			};
+
+			// Counts as outstanding work until reset or destroyed, so threads
+			// can sit in run() waiting for operations that start later.
+			class work_guard
+			{
+				public:
+					explicit work_guard(io_context& ctx) noexcept
+						: ctx_{std::addressof(ctx)}
+					{
+						ctx_->work_started();
+					}
+
+					work_guard(const work_guard&) = delete;
+					work_guard& operator=(const work_guard&) = delete;
+
+					~work_guard() noexcept
+					{
+						reset();
+					}
+
+					void reset() noexcept
+					{
+						if (ctx_ != nullptr)
+						{
+							std::exchange(ctx_, nullptr)->work_finished();
+						}
+					}
+				private:
+					io_context* ctx_;
+			};
+
+			static constexpr unsigned ring_entries {4096};
+
+			explicit io_context(io_backend backend = io_backend::epoll)
+				: backend_{backend}, epoll_fd_{::epoll_create1(EPOLL_CLOEXEC)}
+			{
+				if (epoll_fd_ == -1)
+				{
+					throw std::system_error{errno, std::generic_category(), "io_context"};
+				}
+
+				wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+				if (wakeup_fd_ == -1)
+				{
+					const auto error {errno};
+					::close(epoll_fd_);
+					throw std::system_error{error, std::generic_category(), "io_context"};
+				}
+
+				// The wakeup descriptor is the only one registered with a null
+				// pointer. Being edge-triggered, every write wakes one thread.
+				::epoll_event event {};
+				event.events = EPOLLIN | EPOLLET;
+				event.data.ptr = nullptr;
+				if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event) == -1)
+				{
+					const auto error {errno};
+					::close(wakeup_fd_);
+					::close(epoll_fd_);
+					throw std::system_error{error, std::generic_category(), "io_context"};
+				}
+
+				if (backend_ == io_backend::io_uring)
+				{
+					try
+					{
+						ring_.emplace(ring_entries);
+					}
+					catch (...)
+					{
+						::close(wakeup_fd_);
+						::close(epoll_fd_);
+						throw;
+					}
+
+					event.events = EPOLLIN | EPOLLET;
+					event.data.ptr = this;
+					if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, ring_->native_handle(), &event) == -1)
+					{
+						const auto error {errno};
+						ring_.reset();
+						::close(wakeup_fd_);
+						::close(epoll_fd_);
+						throw std::system_error{error, std::generic_category(), "io_context"};
+					}
+				}
+			}
+
+			io_context(const io_context&) = delete;
+			io_context& operator=(const io_context&) = delete;
+
+			~io_context() noexcept
+			{
+				::close(wakeup_fd_);
+				::close(epoll_fd_);
+			}
+
+			std::size_t run()
+			{
+				std::size_t handled {0};
+				std::array<::epoll_event, 128> events;
+				const auto previous {std::exchange(running_, this)};
+
+				while (!stopped())
+				{
+					if (outstanding_.load(std::memory_order_acquire) == 0)
+					{
+						break;
+					}
+
+					if (auto op {pop_ready()})
+					{
+						op->complete(op);
+						work_finished();
+						++handled;
+						continue;
+					}
+
+					flush_submissions();
+					const auto count {::epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), -1)};
+					for (int i {0}; i < count; ++i)
+					{
+						if (events[i].data.ptr == nullptr)
+						{
+							std::uint64_t ignored;
+							(void) ::read(wakeup_fd_, &ignored, sizeof(ignored));
+						}
+						else if (events[i].data.ptr == this)
+						{
+							handled += reap();
+						}
+						else
+						{
+							handled += react(*static_cast<io_descriptor*>(events[i].data.ptr), events[i].events);
+						}
+					}
+				}
+
+				flush_submissions();
+				running_ = previous;
+
+				// Pass the wakeup on so every other run() thread notices too.
+				wake();
+				return handled;
+			}
+
+			void stop() noexcept
+			{
+				stopped_.store(true, std::memory_order_release);
+				wake();
+			}
+
+			[[nodiscard]] bool stopped() const noexcept
+			{
+				return stopped_.load(std::memory_order_acquire);
+			}
+
+			void restart() noexcept
+			{
+				stopped_.store(false, std::memory_order_release);
+			}
+
+			[[nodiscard]] scheduler_t get_scheduler() noexcept
+			{
+				return {this};
+			}
+
+			[[nodiscard]] io_backend backend() const noexcept
+			{
+				return backend_;
+			}
+
+			// With io_uring, reads and writes whose buffer lies entirely in
+			// one of these use the fixed-buffer opcodes, so the kernel does
+			// not map the pages for every operation. Call this before
+			// starting operations; the buffers must outlive the context. It
+			// has no effect with epoll.
+			void register_buffers(std::span<const mutable_buffer> buffers)
+			{
+				if (backend_ != io_backend::io_uring)
+				{
+					return;
+				}
+
+				std::vector<::iovec> iovecs;
+				iovecs.reserve(buffers.size());
+				for (const auto& b : buffers)
+				{
+					iovecs.push_back(::iovec{b.data(), b.size()});
+				}
+
+				std::lock_guard l {submit_m_};
+				ring_->register_buffers(iovecs);
+				registered_.assign(buffers.begin(), buffers.end());
+			}
+
+			// Adds fd to the context, making it non-blocking for epoll. The
+			// descriptor stays owned by the caller and must be deregistered
+			// before it is closed.
+			[[nodiscard]] io_descriptor* register_descriptor(int fd, std::error_code& ec) noexcept
+			{
+				if (backend_ == io_backend::epoll)
+				{
+					const auto flags {::fcntl(fd, F_GETFL, 0)};
+					if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+					{
+						ec.assign(errno, std::generic_category());
+						return nullptr;
+					}
+				}
+
+				io_descriptor* d;
+				{
+					std::lock_guard l {registry_m_};
+					if (free_ != nullptr)
+					{
+						d = std::exchange(free_, free_->next_free_);
+					}
+					else
+					{
+						try
+						{
+							d = descriptors_.emplace_back(std::make_unique<io_descriptor>()).get();
+						}
+						catch (...)
+						{
+							ec = std::make_error_code(std::errc::not_enough_memory);
+							return nullptr;
+						}
+					}
+				}
+
+				{
+					std::lock_guard l {d->m_};
+					d->ctx_ = this;
+					d->fd_ = fd;
+				}
+
+				if (backend_ == io_backend::io_uring)
+				{
+					ec.clear();
+					return d;
+				}
+
+				::epoll_event event {};
+				event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+				event.data.ptr = d;
+				if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1)
+				{
+					ec.assign(errno, std::generic_category());
+					recycle(*d);
+					return nullptr;
+				}
+
+				ec.clear();
+				return d;
+			}
+
+			[[nodiscard]] io_descriptor& register_descriptor(int fd)
+			{
+				std::error_code ec;
+				const auto d {register_descriptor(fd, ec)};
+				if (ec)
+				{
+					throw std::system_error{ec, "io_context::register_descriptor"};
+				}
+
+				return *d;
+			}
+
+			// Completes every pending operation on d with set_done.
+			void cancel(io_descriptor& d) noexcept
+			{
+				reactor_queue canceled;
+				int fd;
+				{
+					std::lock_guard l {d.m_};
+					fd = d.fd_;
+					canceled.append(std::move(d.queue(io_direction::read)));
+					canceled.append(std::move(d.queue(io_direction::write)));
+				}
+
+				cancel_all(std::move(canceled));
+				if (backend_ == io_backend::io_uring && fd != -1)
+				{
+					submit_cancel(fd);
+				}
+			}
+
+			void deregister_descriptor(io_descriptor& d) noexcept
+			{
+				reactor_queue canceled;
+				int fd;
+				bool retiring;
+				{
+					std::lock_guard l {d.m_};
+					fd = std::exchange(d.fd_, -1);
+					if (fd != -1 && backend_ == io_backend::epoll)
+					{
+						(void) ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+					}
+
+					canceled.append(std::move(d.queue(io_direction::read)));
+					canceled.append(std::move(d.queue(io_direction::write)));
+
+					for (const auto connection : d.accepted_)
+					{
+						::close(connection);
+					}
+
+					d.accepted_.clear();
+
+					// An armed multishot accept still refers to d, so d is
+					// recycled once its final completion arrives.
+					retiring = d.accept_armed_;
+					d.retiring_ = retiring;
+				}
+
+				cancel_all(std::move(canceled));
+				if (backend_ == io_backend::io_uring && fd != -1)
+				{
+					submit_cancel(fd);
+				}
+
+				if (!retiring)
+				{
+					recycle(d);
+				}
+			}
+		private:
+			static constexpr std::uint64_t accept_tag {1};
+			static inline thread_local io_context* running_ {nullptr};
+
+			io_backend backend_;
+			int epoll_fd_;
+			int wakeup_fd_ {-1};
+			std::atomic<bool> stopped_ {false};
+			std::atomic<std::size_t> outstanding_ {0};
+
+			std::mutex ready_m_;
+			reactor_queue ready_;
+
+			std::mutex registry_m_;
+			std::vector<std::unique_ptr<io_descriptor>> descriptors_;
+			io_descriptor* free_ {nullptr};
+
+			// Lock order: complete_m_, then a descriptor, then submit_m_.
+			std::optional<io_ring> ring_;
+			std::mutex submit_m_;
+			std::mutex complete_m_;
+			std::vector<mutable_buffer> registered_;
+			std::atomic<bool> multishot_accept_ {true};
+
+			void wake() noexcept
+			{
+				const std::uint64_t one {1};
+				(void) ::write(wakeup_fd_, &one, sizeof(one));
+			}
+
+			void work_started() noexcept
+			{
+				outstanding_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void work_finished() noexcept
+			{
+				if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					wake();
+				}
+			}
+
+			[[nodiscard]] reactor_operation* pop_ready() noexcept
+			{
+				std::lock_guard l {ready_m_};
+				return ready_.empty() ? nullptr : ready_.pop_front();
+			}
+
+			void enqueue_ready(reactor_operation* op) noexcept
+			{
+				bool was_empty;
+				{
+					std::lock_guard l {ready_m_};
+					was_empty = ready_.empty();
+					ready_.push_back(op);
+				}
+
+				if (was_empty)
+				{
+					wake();
+				}
+			}
+
+			void cancel_all(reactor_queue&& canceled) noexcept
+			{
+				while (!canceled.empty())
+				{
+					auto op {canceled.pop_front()};
+					op->ec = std::make_error_code(std::errc::operation_canceled);
+					enqueue_ready(op);
+				}
+			}
+
+			void recycle(io_descriptor& d) noexcept
+			{
+				std::lock_guard l {registry_m_};
+				d.next_free_ = free_;
+				free_ = std::addressof(d);
+			}
+
+			void post(reactor_operation* op) noexcept
+			{
+				work_started();
+				enqueue_ready(op);
+			}
+
+			// An operation that finishes straight away is still completed from
+			// run(), never inside start, so chains of operations cannot grow
+			// the stack.
+			void start_operation(io_descriptor& d, io_direction direction, reactor_operation* op) noexcept
+			{
+				if (backend_ == io_backend::io_uring)
+				{
+					submit_operation(d, op);
+					return;
+				}
+
+				work_started();
+				{
+					std::lock_guard l {d.m_};
+					if (d.fd_ == -1)
+					{
+						op->ec = std::make_error_code(std::errc::bad_file_descriptor);
+					}
+					else if (!d.queue(direction).empty() || !op->perform(op))
+					{
+						d.queue(direction).push_back(op);
+						return;
+					}
+				}
+
+				enqueue_ready(op);
+			}
+
+			// Retries queued operations under the descriptor's lock, then
+			// completes the ones that finished outside of it.
+			std::size_t react(io_descriptor& d, std::uint32_t events) noexcept
+			{
+				reactor_queue finished;
+				{
+					std::lock_guard l {d.m_};
+					if (events & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP))
+					{
+						perform_queued(d.queue(io_direction::read), finished);
+					}
+
+					if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+					{
+						perform_queued(d.queue(io_direction::write), finished);
+					}
+				}
+
+				std::size_t handled {0};
+				while (!finished.empty())
+				{
+					auto op {finished.pop_front()};
+					op->complete(op);
+					work_finished();
+					++handled;
+				}
+
+				return handled;
+			}
+
+			static void perform_queued(reactor_queue& queue, reactor_queue& finished) noexcept
+			{
+				while (!queue.empty())
+				{
+					auto op {queue.pop_front()};
+					if (!op->perform(op))
+					{
+						queue.push_front(op);
+						return;
+					}
+
+					finished.push_back(op);
+				}
+			}
+
+			// Callers hold submit_m_. A full ring is flushed to make room.
+			[[nodiscard]] ::io_uring_sqe& next_sqe() noexcept
+			{
+				auto sqe {ring_->get_sqe()};
+				while (sqe == nullptr)
+				{
+					(void) ring_->submit();
+					sqe = ring_->get_sqe();
+				}
+
+				return *sqe;
+			}
+
+			// Submissions made on a run() thread wait for it to flush them
+			// in one system call before it next waits; anyone else submits
+			// straight away.
+			void submitted() noexcept
+			{
+				if (running_ != this)
+				{
+					(void) ring_->submit();
+				}
+			}
+
+			void flush_submissions() noexcept
+			{
+				if (backend_ == io_backend::io_uring)
+				{
+					std::lock_guard l {submit_m_};
+					if (ring_->has_pending())
+					{
+						(void) ring_->submit();
+					}
+				}
+			}
+
+			void submit_operation(io_descriptor& d, reactor_operation* op) noexcept
+			{
+				work_started();
+				int fd;
+				{
+					std::lock_guard l {d.m_};
+					fd = d.fd_;
+				}
+
+				if (fd == -1)
+				{
+					op->ec = std::make_error_code(std::errc::bad_file_descriptor);
+					enqueue_ready(op);
+					return;
+				}
+
+				std::lock_guard l {submit_m_};
+				auto& sqe {next_sqe()};
+				op->prepare(op, sqe, fd, registered_);
+				sqe.user_data = reinterpret_cast<std::uint64_t>(op);
+				submitted();
+			}
+
+			void submit_cancel(int fd) noexcept
+			{
+				std::lock_guard l {submit_m_};
+				auto& sqe {next_sqe()};
+				sqe.opcode = IORING_OP_ASYNC_CANCEL;
+				sqe.fd = fd;
+				sqe.cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+				sqe.user_data = 0;
+				(void) ring_->submit();
+			}
+
+			// Accepts wait on the descriptor while a single multishot accept
+			// feeds them, falling back to one accept per connection on
+			// kernels without multishot support.
+			void start_accept(io_descriptor& d, reactor_operation* op) noexcept
+			{
+				work_started();
+				std::unique_lock l {d.m_};
+				if (d.fd_ == -1)
+				{
+					l.unlock();
+					op->ec = std::make_error_code(std::errc::bad_file_descriptor);
+					enqueue_ready(op);
+				}
+				else if (!d.accepted_.empty())
+				{
+					op->finish(op, d.accepted_.front());
+					d.accepted_.pop_front();
+					l.unlock();
+					enqueue_ready(op);
+				}
+				else
+				{
+					d.queue(io_direction::read).push_back(op);
+					arm_accept(d);
+				}
+			}
+
+			// Callers hold d's lock.
+			void arm_accept(io_descriptor& d) noexcept
+			{
+				if (d.accept_armed_)
+				{
+					return;
+				}
+
+				d.accept_armed_ = true;
+				std::lock_guard l {submit_m_};
+				auto& sqe {next_sqe()};
+				sqe.opcode = IORING_OP_ACCEPT;
+				sqe.fd = d.fd_;
+				sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+				if (multishot_accept_.load(std::memory_order_relaxed))
+				{
+					sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+				}
+
+				sqe.user_data = reinterpret_cast<std::uint64_t>(std::addressof(d)) | accept_tag;
+				submitted();
+			}
+
+			void accepted(io_descriptor& d, int result, std::uint32_t flags, reactor_queue& finished) noexcept
+			{
+				std::lock_guard l {d.m_};
+				const bool more {(flags & IORING_CQE_F_MORE) != 0};
+				if (!more)
+				{
+					d.accept_armed_ = false;
+				}
+
+				auto& waiting {d.queue(io_direction::read)};
+				if (result >= 0)
+				{
+					if (d.fd_ == -1)
+					{
+						::close(result);
+					}
+					else if (waiting.empty())
+					{
+						d.accepted_.push_back(result);
+					}
+					else
+					{
+						auto op {waiting.pop_front()};
+						op->finish(op, result);
+						finished.push_back(op);
+					}
+				}
+				else if (result == -EINVAL && multishot_accept_.load(std::memory_order_relaxed))
+				{
+					multishot_accept_.store(false, std::memory_order_relaxed);
+				}
+				else if (result != -ECANCELED && result != -ECONNABORTED && !waiting.empty())
+				{
+					auto op {waiting.pop_front()};
+					op->finish(op, result);
+					finished.push_back(op);
+				}
+
+				if (d.retiring_)
+				{
+					if (!d.accept_armed_)
+					{
+						d.retiring_ = false;
+						recycle(d);
+					}
+				}
+				else if (!waiting.empty() && d.fd_ != -1)
+				{
+					arm_accept(d);
+				}
+			}
+
+			std::size_t reap() noexcept
+			{
+				reactor_queue finished;
+				{
+					std::lock_guard l {complete_m_};
+					ring_->consume_completions([this, &finished](const ::io_uring_cqe& cqe) {
+						if (cqe.user_data == 0)
+						{
+							return;
+						}
+						else if (cqe.user_data & accept_tag)
+						{
+							accepted(*reinterpret_cast<io_descriptor*>(cqe.user_data & ~accept_tag), cqe.res, cqe.flags, finished);
+						}
+						else
+						{
+							const auto op {reinterpret_cast<reactor_operation*>(cqe.user_data)};
+							op->finish(op, cqe.res);
+							finished.push_back(op);
+						}
+					});
+				}
+
+				std::size_t handled {0};
+				while (!finished.empty())
+				{
+					auto op {finished.pop_front()};
+					op->complete(op);
+					work_finished();
+					++handled;
+				}
+
+				return handled;
+			}
+	};
+
+	// Records a negated errno from the ring in ec, returning whether the
+	// operation succeeded.
+	bool ring_result(int result, std::error_code& ec) noexcept
+	{
+		if (result >= 0)
+		{
+			ec.clear();
+			return true;
+		}
+		else if (result == -ECANCELED)
+		{
+			ec = std::make_error_code(std::errc::operation_canceled);
+		}
+		else
+		{
+			ec.assign(-result, std::generic_category());
+		}
+
+		return false;
+	}
+
+	// Finds the registered buffer that holds all of [data, data + size).
+	[[nodiscard]] std::optional<std::uint16_t> registered_index(const void* data, std::size_t size, std::span<const mutable_buffer> registered) noexcept
+	{
+		const auto begin {static_cast<const char*>(data)};
+		for (std::size_t i {0}; i < registered.size(); ++i)
+		{
+			const auto region {static_cast<const char*>(registered[i].data())};
+			if (begin >= region && begin + size <= region + registered[i].size())
+			{
+				return static_cast<std::uint16_t>(i);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	// The non-blocking system calls behind each sender. A call that would
+	// block returns false and is retried when epoll reports the descriptor
+	// ready again. prepare and finish are the io_uring equivalent.
+	struct read_some_action
+	{
+		mutable_buffer buffer;
+		std::size_t transferred {0};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			if (buffer.size() == 0)
+			{
+				ec.clear();
+				return true;
+			}
+
+			while (true)
+			{
+				const auto result {::recv(fd, buffer.data(), buffer.size(), 0)};
+				if (result > 0)
+				{
+					transferred = static_cast<std::size_t>(result);
+					ec.clear();
+					return true;
+				}
+				else if (result == 0)
+				{
+					ec = std::make_error_code(stream_errc::eof);
+					return true;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return false;
+				}
+				else if (errno != EINTR)
+				{
+					ec.assign(errno, std::generic_category());
+					return true;
+				}
+			}
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer> registered) noexcept
+		{
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t>(buffer.data());
+			sqe.len = static_cast<std::uint32_t>(buffer.size());
+			if (const auto index {registered_index(buffer.data(), buffer.size(), registered)})
+			{
+				sqe.opcode = IORING_OP_READ_FIXED;
+				sqe.off = static_cast<std::uint64_t>(-1);
+				sqe.buf_index = *index;
+			}
+			else
+			{
+				sqe.opcode = IORING_OP_RECV;
+			}
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			if (ring_result(result, ec))
+			{
+				transferred = static_cast<std::size_t>(result);
+				if (result == 0 && buffer.size() != 0)
+				{
+					ec = std::make_error_code(stream_errc::eof);
+				}
+			}
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r), transferred);
+		}
+	};
+
+	struct write_some_action
+	{
+		const_buffer buffer;
+		std::size_t transferred {0};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			if (buffer.size() == 0)
+			{
+				ec.clear();
+				return true;
+			}
+
+			while (true)
+			{
+				const auto result {::send(fd, buffer.data(), buffer.size(), MSG_NOSIGNAL)};
+				if (result >= 0)
+				{
+					transferred = static_cast<std::size_t>(result);
+					ec.clear();
+					return true;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return false;
+				}
+				else if (errno != EINTR)
+				{
+					ec.assign(errno, std::generic_category());
+					return true;
+				}
+			}
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer> registered) noexcept
+		{
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t>(buffer.data());
+			sqe.len = static_cast<std::uint32_t>(buffer.size());
+			if (const auto index {registered_index(buffer.data(), buffer.size(), registered)})
+			{
+				sqe.opcode = IORING_OP_WRITE_FIXED;
+				sqe.off = static_cast<std::uint64_t>(-1);
+				sqe.buf_index = *index;
+			}
+			else
+			{
+				sqe.opcode = IORING_OP_SEND;
+				sqe.msg_flags = MSG_NOSIGNAL;
+			}
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			if (ring_result(result, ec))
+			{
+				transferred = static_cast<std::size_t>(result);
+			}
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r), transferred);
+		}
+	};
+
+	// The iovecs behind a scatter/gather operation. Sequences longer than
+	// max_buffers are cut short, as read_some and write_some may be. The
+	// message header points back into the action, so it is only built once
+	// the action has reached its final home in the operation state.
+	struct io_vectors
+	{
+		std::array<::iovec, max_buffers> iov {};
+		std::size_t count {0};
+		std::size_t size {0};
+		::msghdr msg {};
+
+		template<class Buffer, class BufferSequence>
+		[[nodiscard]] static io_vectors from(const BufferSequence& buffers) noexcept
+		{
+			io_vectors v;
+			for (const auto& b : consuming_buffers<Buffer, BufferSequence>{buffers}.prepare(std::numeric_limits<std::size_t>::max()))
+			{
+				v.iov[v.count++] = ::iovec{const_cast<void*>(b.data()), b.size()};
+				v.size += b.size();
+			}
+
+			return v;
+		}
+
+		[[nodiscard]] ::msghdr* header() noexcept
+		{
+			msg = {};
+			msg.msg_iov = iov.data();
+			msg.msg_iovlen = count;
+			return &msg;
+		}
+	};
+
+	struct read_some_buffers_action
+	{
+		io_vectors buffers;
+		std::size_t transferred {0};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			if (buffers.size == 0)
+			{
+				ec.clear();
+				return true;
+			}
+
+			while (true)
+			{
+				const auto result {::recvmsg(fd, buffers.header(), 0)};
+				if (result > 0)
+				{
+					transferred = static_cast<std::size_t>(result);
+					ec.clear();
+					return true;
+				}
+				else if (result == 0)
+				{
+					ec = std::make_error_code(stream_errc::eof);
+					return true;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return false;
+				}
+				else if (errno != EINTR)
+				{
+					ec.assign(errno, std::generic_category());
+					return true;
+				}
+			}
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer>) noexcept
+		{
+			sqe.opcode = IORING_OP_RECVMSG;
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t>(buffers.header());
+			sqe.len = 1;
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			if (ring_result(result, ec))
+			{
+				transferred = static_cast<std::size_t>(result);
+				if (result == 0 && buffers.size != 0)
+				{
+					ec = std::make_error_code(stream_errc::eof);
+				}
+			}
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r), transferred);
+		}
+	};
+
+	struct write_some_buffers_action
+	{
+		io_vectors buffers;
+		std::size_t transferred {0};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			if (buffers.size == 0)
+			{
+				ec.clear();
+				return true;
+			}
+
+			while (true)
+			{
+				const auto result {::sendmsg(fd, buffers.header(), MSG_NOSIGNAL)};
+				if (result >= 0)
+				{
+					transferred = static_cast<std::size_t>(result);
+					ec.clear();
+					return true;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return false;
+				}
+				else if (errno != EINTR)
+				{
+					ec.assign(errno, std::generic_category());
+					return true;
+				}
+			}
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer>) noexcept
+		{
+			sqe.opcode = IORING_OP_SENDMSG;
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t>(buffers.header());
+			sqe.len = 1;
+			sqe.msg_flags = MSG_NOSIGNAL;
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			if (ring_result(result, ec))
+			{
+				transferred = static_cast<std::size_t>(result);
+			}
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r), transferred);
+		}
+	};
+
+	struct accept_action
+	{
+		int accepted {-1};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			while (true)
+			{
+				const auto result {::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)};
+				if (result >= 0)
+				{
+					accepted = result;
+					ec.clear();
+					return true;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return false;
+				}
+				// A connection that was reset while queued is skipped rather
+				// than failing the accept.
+				else if (errno != EINTR && errno != ECONNABORTED && errno != EPROTO)
+				{
+					ec.assign(errno, std::generic_category());
+					return true;
+				}
+			}
+		}
+
+		// Accepts are armed by the context rather than submitted one by one.
+		void prepare(::io_uring_sqe&, int, std::span<const mutable_buffer>) noexcept {}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			if (ring_result(result, ec))
+			{
+				accepted = result;
+			}
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r), accepted);
+		}
+	};
+
+	struct connect_action
+	{
+		::sockaddr_storage address {};
+		::socklen_t length {0};
+		bool started {false};
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			if (!started)
+			{
+				started = true;
+				int result;
+				do
+				{
+					result = ::connect(fd, reinterpret_cast<const ::sockaddr*>(&address), length);
+				} while (result == -1 && errno == EINTR);
+
+				if (result == 0)
+				{
+					ec.clear();
+					return true;
+				}
+				else if (errno == EINPROGRESS || errno == EALREADY)
+				{
+					return false;
+				}
+
+				ec.assign(errno, std::generic_category());
+				return true;
+			}
+
+			int error {0};
+			::socklen_t error_length {sizeof(error)};
+			if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length) == -1)
+			{
+				ec.assign(errno, std::generic_category());
+				return true;
+			}
+
+			if (error != 0)
+			{
+				ec.assign(error, std::generic_category());
+				return true;
+			}
+
+			// An unconnected socket reports itself writable as soon as it is
+			// registered, so make sure the connection really is established.
+			::sockaddr_storage peer;
+			::socklen_t peer_length {sizeof(peer)};
+			if (::getpeername(fd, reinterpret_cast<::sockaddr*>(&peer), &peer_length) == -1)
+			{
+				if (errno == ENOTCONN)
+				{
+					return false;
+				}
+
+				ec.assign(errno, std::generic_category());
+				return true;
+			}
+
+			ec.clear();
+			return true;
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer>) noexcept
+		{
+			sqe.opcode = IORING_OP_CONNECT;
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t>(&address);
+			sqe.off = length;
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			(void) ring_result(result, ec);
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r));
+		}
+	};
+
+	struct wait_action
+	{
+		short events;
+
+		bool operator()(int fd, std::error_code& ec) noexcept
+		{
+			::pollfd p {fd, events, 0};
+			const auto result {::poll(&p, 1, 0)};
+			if (result > 0)
+			{
+				ec.clear();
+				return true;
+			}
+			else if (result == 0 || errno == EINTR)
+			{
+				return false;
+			}
+
+			ec.assign(errno, std::generic_category());
+			return true;
+		}
+
+		void prepare(::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer>) noexcept
+		{
+			sqe.opcode = IORING_OP_POLL_ADD;
+			sqe.fd = fd;
+			sqe.poll32_events = static_cast<std::uint16_t>(events);
+		}
+
+		void finish(int result, std::error_code& ec) noexcept
+		{
+			(void) ring_result(result, ec);
+		}
+
+		template<class R>
+		void set_value(R&& r)
+		{
+			cmoon::execution::set_value(std::forward<R>(r));
+		}
+	};
+
+	template<cmoon::execution::receiver R>
+	struct io_schedule_operation : public reactor_operation
+	{
+		public:
+			io_schedule_operation(io_context& ctx, R&& r)
+				: ctx_{ctx}, r_{std::forward<R>(r)}
+			{
+				this->complete = [](reactor_operation* o) noexcept
+				{
+					auto& op {*static_cast<io_schedule_operation*>(o)};
+					if (cmoon::execution::get_stop_token(op.r_).stop_requested())
+					{
+						cmoon::execution::set_done(std::move(op.r_));
+						return;
+					}
+
+					try
+					{
+						cmoon::execution::set_value(std::move(op.r_));
+					}
+					catch (...)
+					{
+						cmoon::execution::set_error(std::move(op.r_), std::current_exception());
+					}
+				};
+			}
+
+			friend void tag_invoke(cmoon::execution::start_t, io_schedule_operation& o) noexcept
+			{
+				o.start_helper();
+			}
+		private:
+			io_context& ctx_;
+			R r_;
+
+			void start_helper() noexcept
+			{
+				ctx_.post(this);
+			}
+	};
+
+	template<class Action, cmoon::execution::receiver R>
+	struct io_operation : public reactor_operation
+	{
+		public:
+			io_operation(io_descriptor& d, io_direction direction, Action action, R&& r)
+				: descriptor_{d}, direction_{direction}, action_{std::move(action)}, r_{std::forward<R>(r)}
+			{
+				this->perform = [](reactor_operation* o) noexcept
+				{
+					auto& op {*static_cast<io_operation*>(o)};
+					return op.action_(op.descriptor_.native_handle(), op.ec);
+				};
+
+				this->prepare = [](reactor_operation* o, ::io_uring_sqe& sqe, int fd, std::span<const mutable_buffer> registered) noexcept
+				{
+					static_cast<io_operation*>(o)->action_.prepare(sqe, fd, registered);
+				};
+
+				this->finish = [](reactor_operation* o, int result) noexcept
+				{
+					auto& op {*static_cast<io_operation*>(o)};
+					op.action_.finish(result, op.ec);
+				};
+
+				this->complete = [](reactor_operation* o) noexcept
+				{
+					auto& op {*static_cast<io_operation*>(o)};
+					if (op.ec == std::errc::operation_canceled || cmoon::execution::get_stop_token(op.r_).stop_requested())
+					{
+						cmoon::execution::set_done(std::move(op.r_));
+					}
+					else if (op.ec)
+					{
+						cmoon::execution::set_error(std::move(op.r_), op.ec);
+					}
+					else
+					{
+						try
+						{
+							op.action_.set_value(std::move(op.r_));
+						}
+						catch (...)
+						{
+							cmoon::execution::set_error(std::move(op.r_), std::current_exception());
+						}
+					}
+				};
+			}
+
+			friend void tag_invoke(cmoon::execution::start_t, io_operation& o) noexcept
+			{
+				o.start_helper();
+			}
+		private:
+			io_descriptor& descriptor_;
+			io_direction direction_;
+			Action action_;
+			R r_;
+
+			void start_helper() noexcept
+			{
+				auto& ctx {descriptor_.context()};
+				if constexpr (std::same_as<Action, accept_action>)
+				{
+					if (ctx.backend() == io_backend::io_uring)
+					{
+						ctx.start_accept(descriptor_, this);
+						return;
+					}
+				}
+
+				ctx.start_operation(descriptor_, direction_, this);
+			}
+	};
+
+	template<class Action, class... Values>
+	struct io_sender
+	{
+		io_descriptor* descriptor_;
+		io_direction direction_;
+		Action action_;
+
+		template<template<class...> class Tuple, template<class...> class Variant>
+		using value_types = Variant<Tuple<Values...>>;
+
+		template<template<class...> class Variant>
+		using error_types = Variant<std::error_code, std::exception_ptr>;
+
+		static constexpr bool sends_done {true};
+
+		template<cmoon::execution::receiver R>
+		friend io_operation<Action, std::decay_t<R>> tag_invoke(cmoon::execution::connect_t, io_sender s, R&& r)
+		{
+			return {*s.descriptor_, s.direction_, std::move(s.action_), std::forward<R>(r)};
+		}
+
+		template<class CPO>
+		friend io_context::scheduler_t tag_invoke(cmoon::execution::get_completion_scheduler_t<CPO>, const io_sender& s) noexcept
+		{
+			return s.descriptor_->context().get_scheduler();
+		}
+	};
+
+	export
+	using async_read_some_sender = io_sender<read_some_action, std::size_t>;
+
+	export
+	using async_write_some_sender = io_sender<write_some_action, std::size_t>;
+
+	export
+	using async_read_some_buffers_sender = io_sender<read_some_buffers_action, std::size_t>;
+
+	export
+	using async_write_some_buffers_sender = io_sender<write_some_buffers_action, std::size_t>;
+
+	export
+	using async_accept_sender = io_sender<accept_action, int>;
+
+	export
+	using async_connect_sender = io_sender<connect_action>;
+
+	export
+	using async_wait_sender = io_sender<wait_action>;
+
+	// Sends the number of bytes read, or stream_errc::eof once the peer has
+	// shut down its side of the connection.
+	export
+	[[nodiscard]] async_read_some_sender async_read_some(io_descriptor& d, const mutable_buffer& buffer) noexcept
+	{
+		return {std::addressof(d), io_direction::read, read_some_action{buffer}};
+	}
+
+	export
+	[[nodiscard]] async_write_some_sender async_write_some(io_descriptor& d, const const_buffer& buffer) noexcept
+	{
+		return {std::addressof(d), io_direction::write, write_some_action{buffer}};
+	}
+
+	// Reads into as many buffers of the sequence as one recvmsg accepts.
+	export
+	template<class MutableBufferSequence>
+		requires(is_mutable_buffer_sequence_v<MutableBufferSequence> && !std::convertible_to<const MutableBufferSequence&, mutable_buffer>)
+	[[nodiscard]] async_read_some_buffers_sender async_read_some(io_descriptor& d, const MutableBufferSequence& buffers) noexcept
+	{
+		return {std::addressof(d), io_direction::read, read_some_buffers_action{io_vectors::from<mutable_buffer>(buffers)}};
+	}
+
+	// Writes as many buffers of the sequence as one sendmsg accepts.
+	export
+	template<class ConstBufferSequence>
+		requires(is_const_buffer_sequence_v<ConstBufferSequence> && !std::convertible_to<const ConstBufferSequence&, const_buffer>)
+	[[nodiscard]] async_write_some_buffers_sender async_write_some(io_descriptor& d, const ConstBufferSequence& buffers) noexcept
+	{
+		return {std::addressof(d), io_direction::write, write_some_buffers_action{io_vectors::from<const_buffer>(buffers)}};
+	}
+
+	// Sends the native handle of the accepted connection, already
+	// non-blocking.
+	export
+	[[nodiscard]] async_accept_sender async_accept(io_descriptor& d) noexcept
+	{
+		return {std::addressof(d), io_direction::read, accept_action{}};
+	}
+
+	export
+	[[nodiscard]] async_connect_sender async_connect(io_descriptor& d, const void* address, std::size_t length) noexcept
+	{
+		connect_action action;
+		length = std::min(length, sizeof(action.address));
+		std::memcpy(&action.address, address, length);
+		action.length = static_cast<::socklen_t>(length);
+		return {std::addressof(d), io_direction::write, action};
+	}
+
+	// Sends once the descriptor is ready for the given poll events.
+	export
+	[[nodiscard]] async_wait_sender async_wait(io_descriptor& d, short events) noexcept
+	{
+		return {std::addressof(d), (events & POLLOUT) ? io_direction::write : io_direction::read, wait_action{events}};
+	}
+}
+#endif
@@ -0,0 +1,286 @@
+module;
+
+#if defined(__linux__)
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+	#include <errno.h>
+#endif
+
+export module cmoon.net.execution.io_ring;
+
+import <cstddef>;
+import <cstdint>;
+import <cstring>;
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <initializer_list>;
+import <span>;
+import <system_error>;
+import <utility>;
+
+#if defined(__linux__)
+namespace cmoon::net
+{
+	// The submission and completion rings of an io_uring instance, mapped
+	// into this process. Callers serialize access to each ring themselves;
+	// the two rings may be used from different threads at once.
+	export
+	class io_ring
+	{
+		public:
+			explicit io_ring(unsigned entries)
+			{
+				::io_uring_params params {};
+				fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+				if (fd_ == -1)
+				{
+					throw std::system_error{errno, std::generic_category(), "io_ring"};
+				}
+
+				if (!map(params))
+				{
+					const auto error {errno};
+					unmap();
+					::close(fd_);
+					throw std::system_error{error, std::generic_category(), "io_ring"};
+				}
+			}
+
+			io_ring(const io_ring&) = delete;
+			io_ring& operator=(const io_ring&) = delete;
+
+			~io_ring() noexcept
+			{
+				unmap();
+				::close(fd_);
+			}
+
+			[[nodiscard]] int native_handle() const noexcept
+			{
+				return fd_;
+			}
+
+			// Returns a zeroed entry, or nullptr when every entry is waiting to
+			// be consumed by the kernel.
+			[[nodiscard]] ::io_uring_sqe* get_sqe() noexcept
+			{
+				const auto head {std::atomic_ref{*sq_head_}.load(std::memory_order_acquire)};
+				if (sqe_tail_ - head >= sq_entries_)
+				{
+					return nullptr;
+				}
+
+				const auto sqe {sqes_ + (sqe_tail_ & sq_mask_)};
+				++sqe_tail_;
+				std::memset(sqe, 0, sizeof(::io_uring_sqe));
+				return sqe;
+			}
+
+			[[nodiscard]] bool has_pending() const noexcept
+			{
+				return sqe_tail_ != std::atomic_ref{*sq_tail_}.load(std::memory_order_relaxed);
+			}
+
+			// Publishes every entry handed out since the last call and hands
+			// them to the kernel in a single system call. Returns the number
+			// consumed, or a negated errno.
+			int submit() noexcept
+			{
+				std::atomic_ref{*sq_tail_}.store(sqe_tail_, std::memory_order_release);
+				const auto to_submit {sqe_tail_ - std::atomic_ref{*sq_head_}.load(std::memory_order_acquire)};
+				if (to_submit == 0)
+				{
+					return 0;
+				}
+
+				return enter(to_submit, 0);
+			}
+
+			// Calls f with every completion that has been posted, including
+			// ones the kernel had to hold back because the ring was full.
+			template<class F>
+			std::size_t consume_completions(F&& f)
+			{
+				std::size_t consumed {0};
+				auto head {std::atomic_ref{*cq_head_}.load(std::memory_order_relaxed)};
+				while (true)
+				{
+					const auto tail {std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire)};
+					if (head == tail)
+					{
+						if ((std::atomic_ref{*sq_flags_}.load(std::memory_order_acquire) & IORING_SQ_CQ_OVERFLOW) == 0)
+						{
+							return consumed;
+						}
+
+						(void) enter(0, IORING_ENTER_GETEVENTS);
+						continue;
+					}
+
+					for (; head != tail; ++head, ++consumed)
+					{
+						f(cqes_[head & cq_mask_]);
+					}
+
+					std::atomic_ref{*cq_head_}.store(head, std::memory_order_release);
+				}
+			}
+
+			// Pins buffers for the fixed-buffer opcodes, replacing any that
+			// were registered before.
+			void register_buffers(std::span<const ::iovec> buffers)
+			{
+				if (buffers_registered_)
+				{
+					(void) ::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+					buffers_registered_ = false;
+				}
+
+				if (buffers.empty())
+				{
+					return;
+				}
+
+				if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers.data(), static_cast<unsigned>(buffers.size())) == -1)
+				{
+					throw std::system_error{errno, std::generic_category(), "io_ring::register_buffers"};
+				}
+
+				buffers_registered_ = true;
+			}
+
+			// Whether the kernel implements every one of the given opcodes.
+			[[nodiscard]] bool supports(std::initializer_list<std::uint8_t> opcodes) const noexcept
+			{
+				constexpr std::size_t probe_ops {256};
+				alignas(::io_uring_probe) std::array<std::byte, sizeof(::io_uring_probe) + probe_ops * sizeof(::io_uring_probe_op)> storage {};
+				const auto probe {reinterpret_cast<::io_uring_probe*>(storage.data())};
+				if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, static_cast<unsigned>(probe_ops)) == -1)
+				{
+					return false;
+				}
+
+				return std::ranges::all_of(opcodes, [probe](std::uint8_t op) {
+					return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+				});
+			}
+		private:
+			int fd_ {-1};
+			void* sq_ring_ {MAP_FAILED};
+			std::size_t sq_ring_size_ {0};
+			void* cq_ring_ {MAP_FAILED};
+			std::size_t cq_ring_size_ {0};
+			::io_uring_sqe* sqes_ {nullptr};
+			std::size_t sqes_size_ {0};
+
+			unsigned* sq_head_ {nullptr};
+			unsigned* sq_tail_ {nullptr};
+			unsigned* sq_flags_ {nullptr};
+			unsigned sq_mask_ {0};
+			unsigned sq_entries_ {0};
+			unsigned sqe_tail_ {0};
+
+			unsigned* cq_head_ {nullptr};
+			unsigned* cq_tail_ {nullptr};
+			unsigned cq_mask_ {0};
+			::io_uring_cqe* cqes_ {nullptr};
+
+			bool buffers_registered_ {false};
+
+			int enter(unsigned to_submit, unsigned flags) noexcept
+			{
+				long result;
+				do
+				{
+					result = ::syscall(__NR_io_uring_enter, fd_, to_submit, 0, flags, nullptr, 0);
+				} while (result == -1 && errno == EINTR);
+
+				return result == -1 ? -errno : static_cast<int>(result);
+			}
+
+			[[nodiscard]] bool map(const ::io_uring_params& params) noexcept
+			{
+				sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+				cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+				const bool single_mmap {(params.features & IORING_FEAT_SINGLE_MMAP) != 0};
+				if (single_mmap)
+				{
+					sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+				}
+
+				sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+				if (sq_ring_ == MAP_FAILED)
+				{
+					return false;
+				}
+
+				if (single_mmap)
+				{
+					cq_ring_ = sq_ring_;
+				}
+				else
+				{
+					cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+					if (cq_ring_ == MAP_FAILED)
+					{
+						return false;
+					}
+				}
+
+				sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+				const auto sqes {::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES)};
+				if (sqes == MAP_FAILED)
+				{
+					return false;
+				}
+
+				sqes_ = static_cast<::io_uring_sqe*>(sqes);
+
+				const auto sq {static_cast<char*>(sq_ring_)};
+				sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+				sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+				sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+				sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+				sq_entries_ = params.sq_entries;
+				sqe_tail_ = *sq_tail_;
+
+				// Entries are always used in ring order, so the indirection
+				// array is filled in once.
+				const auto array {reinterpret_cast<unsigned*>(sq + params.sq_off.array)};
+				for (unsigned i {0}; i < sq_entries_; ++i)
+				{
+					array[i] = i;
+				}
+
+				const auto cq {static_cast<char*>(cq_ring_)};
+				cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+				cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+				cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+				cqes_ = reinterpret_cast<::io_uring_cqe*>(cq + params.cq_off.cqes);
+				return true;
+			}
+
+			void unmap() noexcept
+			{
+				if (sqes_ != nullptr)
+				{
+					::munmap(sqes_, sqes_size_);
+				}
+
+				if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+				{
+					::munmap(cq_ring_, cq_ring_size_);
+				}
+
+				if (sq_ring_ != MAP_FAILED)
+				{
+					::munmap(sq_ring_, sq_ring_size_);
+				}
+			}
+	};
+}
+#endif
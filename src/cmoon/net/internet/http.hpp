@@ -15,6 +15,12 @@
 #include <iterator>
 #include <charconv>
 #include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <cctype>
 
 #include "cmoon/net/socket.hpp"
 #include "cmoon/net/internet.hpp"
@@ -168,7 +174,7 @@ namespace cmoon
 			constexpr std::string_view payment_required_message{"Payment Required"};
 			constexpr std::string_view forbidden_message{"Forbidden"};
 			constexpr std::string_view not_found_message{"Not Found"};
-			constexpr std::string_view method_not_allowed_message{"METHOD_NOT_ALLOWED"};
+			constexpr std::string_view method_not_allowed_message{"Method Not Allowed"};
 			constexpr std::string_view not_acceptable_message{"Not Acceptable"};
 			constexpr std::string_view proxy_authentication_required_message{"Proxy Authentication Required"};
 			constexpr std::string_view request_timeout_message{"Request Timeout"};
@@ -327,6 +333,7 @@ namespace cmoon
 		constexpr std::string_view get {"GET"};
 		constexpr std::string_view put {"PUT"};
 		constexpr std::string_view post {"POST"};
+		constexpr std::string_view head {"HEAD"};
 
 		constexpr std::string_view line_terminator = "\r\n";
 
@@ -558,12 +565,12 @@ namespace cmoon
 
 				void add_header(std::string_view name, std::string_view value)
 				{
-					headers_[name.data()] = value;
+					headers_[std::string{name}] = value;
 				}
 
 				const std::string& get_header(std::string_view name) const
 				{
-					return headers_.at(name.data());
+					return headers_.at(std::string{name});
 				}
 
 				const std::map<std::string, std::string>& headers() const noexcept
@@ -711,6 +718,165 @@ namespace cmoon
 			return is;
 		}
 
+		[[nodiscard]] inline bool equals_ignore_case(std::string_view lhs, std::string_view rhs) noexcept
+		{
+			return std::ranges::equal(lhs, rhs, [](char l, char r) {
+				return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+			});
+		}
+
+		// Header names are case-insensitive, while the maps they are kept in
+		// are not.
+		[[nodiscard]] inline const std::string* find_header(const std::map<std::string, std::string>& fields, std::string_view name)
+		{
+			for (const auto& [key, value] : fields)
+			{
+				if (equals_ignore_case(key, name))
+				{
+					return std::addressof(value);
+				}
+			}
+
+			return nullptr;
+		}
+
+		[[nodiscard]] inline std::string_view trim_whitespace(std::string_view str) noexcept
+		{
+			const auto first = str.find_first_not_of(" \t");
+			if (first == std::string_view::npos)
+			{
+				return {};
+			}
+
+			return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+		}
+
+		// Whether a comma-separated header value, such as Connection, lists
+		// the given token.
+		[[nodiscard]] inline bool has_token(const std::string* value, std::string_view token)
+		{
+			if (value == nullptr)
+			{
+				return false;
+			}
+
+			std::string_view rest {*value};
+			while (!rest.empty())
+			{
+				const auto comma = rest.find(',');
+				if (equals_ignore_case(trim_whitespace(rest.substr(0, comma)), token))
+				{
+					return true;
+				}
+
+				if (comma == std::string_view::npos)
+				{
+					break;
+				}
+
+				rest.remove_prefix(comma + 1);
+			}
+
+			return false;
+		}
+
+		// Methods a client may safely send again if the connection fails
+		// before their response arrives. Method names are case-sensitive.
+		[[nodiscard]] inline bool is_idempotent(std::string_view method) noexcept
+		{
+			constexpr std::array<std::string_view, 6> idempotent {get, head, put, "DELETE", "OPTIONS", "TRACE"};
+			return std::ranges::find(idempotent, method) != idempotent.end();
+		}
+
+		struct keep_alive_policy
+		{
+			bool persistent {false};
+			std::optional<std::chrono::seconds> timeout;
+			std::optional<std::size_t> max;
+		};
+
+		// HTTP/1.1 connections persist unless either side sends
+		// "Connection: close"; HTTP/1.0 ones only when asked to. A Keep-Alive
+		// header can further limit how long, and for how many requests.
+		[[nodiscard]] inline keep_alive_policy keep_alive(http_version version, const std::map<std::string, std::string>& fields)
+		{
+			const auto connection = find_header(fields, headers::connection);
+
+			keep_alive_policy policy;
+			policy.persistent = version == http_version::HTTP_1 ? has_token(connection, "keep-alive")
+																: !has_token(connection, "close");
+
+			if (const auto params = find_header(fields, headers::keep_alive))
+			{
+				std::string_view rest {*params};
+				while (!rest.empty())
+				{
+					const auto comma = rest.find(',');
+					const auto param = trim_whitespace(rest.substr(0, comma));
+					const auto equals = param.find('=');
+					if (equals != std::string_view::npos)
+					{
+						const auto name = trim_whitespace(param.substr(0, equals));
+						const auto value = trim_whitespace(param.substr(equals + 1));
+						std::size_t n;
+						if (std::from_chars(value.data(), value.data() + value.size(), n).ec == std::errc{})
+						{
+							if (equals_ignore_case(name, "timeout"))
+							{
+								policy.timeout = std::chrono::seconds(n);
+							}
+							else if (equals_ignore_case(name, "max"))
+							{
+								policy.max = n;
+							}
+						}
+					}
+
+					if (comma == std::string_view::npos)
+					{
+						break;
+					}
+
+					rest.remove_prefix(comma + 1);
+				}
+			}
+
+			return policy;
+		}
+
+		struct http_pool_options
+		{
+			// Connections kept open between requests, per host.
+			std::size_t max_idle_per_host {8};
+
+			// Requests to a host wait once this many connections are in use.
+			// Zero is taken as one.
+			std::size_t max_connections_per_host {32};
+
+			std::chrono::milliseconds idle_timeout {std::chrono::seconds(30)};
+
+			// Requests written before the first response is read. Zero is
+			// taken as one.
+			std::size_t max_pipeline_depth {16};
+		};
+
+		struct http_pool_statistics
+		{
+			std::size_t requests {0};
+			std::size_t reused {0};
+			std::size_t connections_opened {0};
+			std::size_t connections_closed {0};
+
+			[[nodiscard]] double reuse_rate() const noexcept
+			{
+				return requests == 0 ? 0.0 : static_cast<double>(reused) / static_cast<double>(requests);
+			}
+		};
+
+		// Keeps connections to each host open between requests. Connections
+		// are only returned to the pool once their response has been read in
+		// full and both sides agreed to keep them alive; TLS connections
+		// also remember their session so new ones can resume it.
 		template<bool SSL>
 		class basic_http_client
 		{
@@ -723,10 +889,11 @@ namespace cmoon
 			private:
 				using iostream_socket_type = std::conditional_t<using_ssl, net::basic_socket_ssl_iostream<protocol_type>,
 																		   net::basic_socket_iostream<protocol_type>>;
+				using clock = std::chrono::steady_clock;
 			public:
 
-				basic_http_client(cmoon::net::io_context& ctx)
-					: ctx_{ctx}
+				basic_http_client(cmoon::net::io_context& ctx, const http_pool_options& options = {})
+					: ctx_{ctx}, pool_{std::make_shared<pool>(options)}
 				{
 					if constexpr (cmoon::win32_api)
 					{
@@ -743,196 +910,492 @@ namespace cmoon
 					return ctx_.get();
 				}
 
+				[[nodiscard]] const http_pool_options& options() const noexcept
+				{
+					return pool_->options;
+				}
+
+				[[nodiscard]] http_pool_statistics statistics() const
+				{
+					std::scoped_lock l {pool_->m};
+					return pool_->statistics;
+				}
+
+				// Closes every idle connection. Connections in use are closed
+				// when they are released.
+				void clear()
+				{
+					std::vector<std::unique_ptr<iostream_socket_type>> closing;
+					std::scoped_lock l {pool_->m};
+					for (auto& [key, host] : pool_->hosts)
+					{
+						for (auto& c : host.idle)
+						{
+							closing.push_back(std::move(c.stream));
+						}
+
+						pool_->statistics.connections_closed += host.idle.size();
+						host.open -= host.idle.size();
+						host.idle.clear();
+					}
+				}
+
 				[[nodiscard]] socket_type connect(const http_request& request, std::error_code& ec) const
 				{
-					socket_type socket{context()};
-					ec.clear();
-					std::string service_string;
-					if (request.url().port())
+					return connect(request, nullptr, ec);
+				}
+
+				std::optional<http_response> send(http_request& req, std::error_code& ec) const
+				{
+					discard_buffer discard;
+					std::ostream os {std::addressof(discard)};
+					return send(req, os, ec);
+				}
+
+				std::optional<http_response> send(http_request& req, std::ostream& os, std::error_code& ec) const
+				{
+					std::ostream* const body {std::addressof(os)};
+					auto responses = send_pipelined(std::span{std::addressof(req), 1}, std::span{std::addressof(body), 1}, ec);
+					if (responses.empty())
 					{
-						service_string = std::to_string(request.url().port().value());
+						return {};
 					}
-					else if (request.url().protocol())
+
+					return std::move(responses.front());
+				}
+
+				http_response send(http_request& req) const
+				{
+					std::error_code ec;
+					auto op = send(req, ec);
+					if (ec)
 					{
-						service_string = request.url().protocol().value();
+						throw std::system_error{ec};
 					}
-					else
+
+					return std::move(op).value();
+				}
+
+				http_response send(http_request& req, std::ostream& os) const
+				{
+					std::error_code ec;
+					auto op = send(req, os, ec);
+					if (ec)
 					{
-						if constexpr (using_ssl)
+						throw std::system_error{ec};
+					}
+
+					return std::move(op).value();
+				}
+
+				// Writes up to max_pipeline_depth requests to a connection
+				// before reading their responses, which come back in order.
+				// Only idempotent requests are pipelined or sent again after
+				// a connection fails; any other request is sent on its own,
+				// and fails rather than risk being processed twice.
+				// Each response body goes to the matching stream in bodies,
+				// or is discarded if that stream is null. Returns the
+				// responses read before any error.
+				std::vector<http_response> send_pipelined(std::span<http_request> requests, std::span<std::ostream* const> bodies, std::error_code& ec) const
+				{
+					ec.clear();
+					std::vector<http_response> responses;
+					responses.reserve(requests.size());
+
+					discard_buffer discard;
+					std::ostream discarded {std::addressof(discard)};
+
+					std::size_t next {0};
+					bool retried {false};
+					while (next < requests.size())
+					{
+						auto l = acquire(requests[next], ec);
+						if (ec)
 						{
-							service_string = "https";
+							return responses;
 						}
-						else
+
+						auto& stream = *l.conn.stream;
+						const auto idempotent = is_idempotent(requests[next].method());
+						std::size_t batch {0};
+						while (next + batch < requests.size() &&
+							   batch < std::min(pool_->options.max_pipeline_depth, l.conn.remaining) &&
+							   (batch == 0 || (idempotent && is_idempotent(requests[next + batch].method()) && pool_key(requests[next + batch]) == l.key)))
 						{
-							service_string = "http";
+							stream << requests[next + batch];
+							++batch;
 						}
-					}
 
-					const auto results = protocol_type::resolver(context()).resolve(request.url().host(), service_string);
-					for (const auto& result : results)
-					{
-						socket.open(result.endpoint().protocol(), ec);
-						if (ec)
+						stream.flush();
+
+						bool persistent {static_cast<bool>(stream)};
+						std::size_t done {0};
+						while (persistent && done < batch)
 						{
-							continue;
+							auto& req = requests[next + done];
+							http_response res;
+							if (!(stream >> res))
+							{
+								persistent = false;
+								break;
+							}
+
+							auto body = next + done < bodies.size() && bodies[next + done] != nullptr ? bodies[next + done] : std::addressof(discarded);
+							const auto delimited = read_message_body(req, res, stream, *body, ec);
+							if (ec)
+							{
+								persistent = false;
+								break;
+							}
+
+							const auto policy = keep_alive(res.version(), res.headers());
+							persistent = delimited && policy.persistent && !has_token(find_header(req.headers(), headers::connection), "close");
+							if (policy.timeout)
+							{
+								l.conn.expires = std::min(l.conn.expires, clock::now() + *policy.timeout);
+							}
+
+							if (policy.max)
+							{
+								l.conn.remaining = std::min(l.conn.remaining, *policy.max);
+							}
+
+							responses.push_back(std::move(res));
+							++done;
 						}
 
-						socket.set_option(net::socket_base::timeout(request.timeout()), ec);
+						{
+							std::scoped_lock lock {pool_->m};
+							pool_->statistics.requests += done;
+							pool_->statistics.reused += done == 0 ? 0 : (l.reused ? done : done - 1);
+						}
+
+						l.conn.remaining -= std::min(l.conn.remaining, done);
+						const auto reused = l.reused;
+						release(std::move(l), persistent && done == batch);
 						if (ec)
 						{
-							continue;
+							return responses;
 						}
 
-						socket.connect(result.endpoint(), ec);
-						if (!ec)
+						if (done == 0)
 						{
-							break;
+							// A pooled connection the server had already
+							// closed fails before anything is read, so try
+							// once more on a fresh one.
+							if (reused && !retried && idempotent)
+							{
+								retried = true;
+								continue;
+							}
+
+							ec = make_error_code(http_errc::malformed_response);
+							return responses;
 						}
+
+						retried = false;
+						next += done;
 					}
 
-					return socket;
+					return responses;
 				}
 
-				std::optional<http_response> send(http_request& req, std::error_code& ec) const
+				std::vector<http_response> send_pipelined(std::span<http_request> requests, std::error_code& ec) const
 				{
-					ec.clear();
-					auto socket = connect(req, ec);
-					if (ec)
-					{
-						return {};
-					}
+					return send_pipelined(requests, {}, ec);
+				}
+
+				std::future<std::optional<http_response>> async_send(http_request& req, std::error_code& ec, const std::launch l = std::launch::async) const
+				{
+					using func_t = std::optional<http_response>(basic_http_client::*)(http_request&, std::error_code&) const;
+					auto f = static_cast<func_t>(&basic_http_client::send);
+					return std::async(l, f, std::ref(*this), std::ref(req), std::ref(ec));
+				}
+
+				std::future<http_response> async_send(http_request& req, const std::launch l = std::launch::async) const
+				{
+					using func_t = http_response(basic_http_client::*)(http_request&) const;
+					auto f = static_cast<func_t>(&basic_http_client::send);
+					return std::async(l, f, std::ref(*this), std::ref(req));
+				}
+			private:
+				using session_type = std::conditional_t<using_ssl, std::shared_ptr<SSL_SESSION>, std::nullptr_t>;
+
+				struct connection
+				{
+					std::unique_ptr<iostream_socket_type> stream;
+					clock::time_point expires;
+					std::size_t remaining {std::numeric_limits<std::size_t>::max()};
+				};
+
+				struct host_connections
+				{
+					std::vector<connection> idle;
+					std::size_t open {0};
+					session_type session {};
+				};
 
-					iostream_socket_type socket_stream{std::move(socket)};
-					if (!(socket_stream << req))
+				struct pool
+				{
+					explicit pool(const http_pool_options& options)
+						: options{checked(options)} {}
+
+					// A limit of zero would leave nothing that could be sent.
+					[[nodiscard]] static http_pool_options checked(http_pool_options options) noexcept
 					{
-						return {};
+						options.max_connections_per_host = std::max(options.max_connections_per_host, std::size_t{1});
+						options.max_pipeline_depth = std::max(options.max_pipeline_depth, std::size_t{1});
+						return options;
 					}
 
-					socket_stream.sync();
-					http_response res;
-					if (!(socket_stream >> res))
-					{
-						if (socket_stream.fail())
+					const http_pool_options options;
+					std::mutex m;
+					std::condition_variable released;
+					std::map<std::string, host_connections, std::less<>> hosts;
+					http_pool_statistics statistics;
+				};
+
+				struct lease
+				{
+					std::string key;
+					connection conn;
+					bool reused {false};
+				};
+
+				class discard_buffer : public std::streambuf
+				{
+					protected:
+						int_type overflow(int_type c) override
 						{
-							ec = make_error_code(http_errc::malformed_response);
+							return traits_type::not_eof(c);
 						}
 
-						return {};
-					}
+						std::streamsize xsputn(const char_type*, std::streamsize n) override
+						{
+							return n;
+						}
+				};
 
-					return res;
-				}
+				std::reference_wrapper<cmoon::net::io_context> ctx_;
+				std::shared_ptr<pool> pool_;
 
-				std::optional<http_response> send(http_request& req, std::ostream& os, std::error_code& ec) const
+				[[nodiscard]] static std::string pool_key(const http_request& request)
 				{
-					ec.clear();
-					auto socket = connect(req, ec);
-					if (ec)
+					std::string key {request.url().host()};
+					key += ':';
+					if (request.url().port())
 					{
-						return {};
+						key += std::to_string(request.url().port().value());
+					}
+					else if (request.url().protocol())
+					{
+						key += request.url().protocol().value();
 					}
 
-					iostream_socket_type socket_stream{std::move(socket)};
-					if (!(socket_stream << req))
+					return key;
+				}
+
+				// An idle connection the server has closed, or that has
+				// unexpected data waiting, reports itself readable.
+				[[nodiscard]] static bool still_open(iostream_socket_type& stream) noexcept
+				{
+					if (!stream || stream.rdbuf()->in_avail() > 0)
 					{
-						return {};
+						return false;
 					}
 
-					socket_stream.sync();
-					http_response res;
-					if (!(socket_stream >> res))
+					::pollfd p {stream.socket().native_handle(), POLLIN, 0};
+					#ifdef _WIN32
+					return ::WSAPoll(&p, 1, 0) == 0;
+					#else
+					return ::poll(&p, 1, 0) == 0;
+					#endif
+				}
+
+				[[nodiscard]] lease acquire(const http_request& request, std::error_code& ec) const
+				{
+					auto key = pool_key(request);
+					std::vector<std::unique_ptr<iostream_socket_type>> closing;
+					std::unique_lock l {pool_->m};
+					auto& host = pool_->hosts[key];
+					while (true)
 					{
-						if (socket_stream.fail())
+						const auto now = clock::now();
+						while (!host.idle.empty())
 						{
-							ec = make_error_code(http_errc::malformed_response);
+							auto c = std::move(host.idle.back());
+							host.idle.pop_back();
+							if (c.expires > now && c.remaining > 0 && still_open(*c.stream))
+							{
+								return lease{std::move(key), std::move(c), true};
+							}
+
+							closing.push_back(std::move(c.stream));
+							--host.open;
+							++pool_->statistics.connections_closed;
+						}
+
+						if (host.open < pool_->options.max_connections_per_host)
+						{
+							break;
 						}
 
+						pool_->released.wait(l);
+					}
+
+					++host.open;
+					auto session = host.session;
+					l.unlock();
+
+					auto socket = connect(request, session, ec);
+					l.lock();
+					if (ec)
+					{
+						--host.open;
+						pool_->released.notify_one();
 						return {};
 					}
 
-					read_message_body(res, socket_stream, os, ec);
+					++pool_->statistics.connections_opened;
+					if constexpr (using_ssl)
+					{
+						host.session.reset(socket.get_session(), SSL_SESSION_free);
+					}
 
-					return res;
+					l.unlock();
+					return lease{std::move(key), connection{std::make_unique<iostream_socket_type>(std::move(socket)), clock::now() + pool_->options.idle_timeout}, false};
 				}
 
-				http_response send(http_request& req) const
+				void release(lease&& l, bool reusable) const
 				{
-					std::error_code ec;
-					auto op = send(req, ec);
-					if (ec)
+					std::unique_ptr<iostream_socket_type> closing;
+					std::scoped_lock lock {pool_->m};
+					auto& host = pool_->hosts[l.key];
+					if (reusable && l.conn.remaining > 0 && host.idle.size() < pool_->options.max_idle_per_host)
 					{
-						throw std::system_error{ec};
+						host.idle.push_back(std::move(l.conn));
+					}
+					else
+					{
+						closing = std::move(l.conn.stream);
+						--host.open;
+						++pool_->statistics.connections_closed;
 					}
 
-					return std::move(op).value();
+					pool_->released.notify_one();
 				}
 
-				http_response send(http_request& req, std::ostream& os) const
+				[[nodiscard]] socket_type connect(const http_request& request, const session_type& session, std::error_code& ec) const
 				{
-					std::error_code ec;
-					auto op = send(req, os, ec);
-					if (ec)
+					socket_type socket{context()};
+					ec.clear();
+					std::string service_string;
+					if (request.url().port())
 					{
-						throw std::system_error{ec};
+						service_string = std::to_string(request.url().port().value());
+					}
+					else if (request.url().protocol())
+					{
+						service_string = request.url().protocol().value();
+					}
+					else
+					{
+						if constexpr (using_ssl)
+						{
+							service_string = "https";
+						}
+						else
+						{
+							service_string = "http";
+						}
 					}
 
-					return std::move(op).value();
+					const auto results = protocol_type::resolver(context()).resolve(request.url().host(), service_string);
+					for (const auto& result : results)
+					{
+						socket.open(result.endpoint().protocol(), ec);
+						if (ec)
+						{
+							continue;
+						}
+
+						socket.set_option(net::socket_base::timeout(request.timeout()), ec);
+						if (ec)
+						{
+							continue;
+						}
+
+						if constexpr (using_ssl)
+						{
+							if (session)
+							{
+								socket.set_session(session.get());
+							}
+						}
+
+						socket.connect(result.endpoint(), ec);
+						if (!ec)
+						{
+							break;
+						}
+					}
+
+					return socket;
 				}
 
-				std::future<std::optional<http_response>> async_send(http_request& req, std::error_code& ec, const std::launch l = std::launch::async) const
+				[[nodiscard]] static bool has_body(const http_request& req, const http_response& res) noexcept
 				{
-					using func_t = std::optional<http_response>(basic_http_client::*)(http_request&, std::error_code&);
-					auto f = static_cast<func_t>(&basic_http_client::send);
-					return std::async(l, f, std::ref(*this), std::ref(req), std::ref(ec));
+					const auto code = res.status().code;
+					return req.method() != head && code >= 200 && code != 204 && code != 304;
 				}
 
-				std::future<http_response> async_send(http_request& req, const std::launch l = std::launch::async) const
+				// Returns whether the body had a known length. One that runs
+				// until the server closes the connection leaves nothing to
+				// reuse.
+				bool read_message_body(const http_request& req, const http_response& res, iostream_socket_type& socket_stream, std::ostream& os, std::error_code& ec) const
 				{
-					using func_t = http_response(basic_http_client::*)(http_request&, std::error_code&);
-					auto f = static_cast<func_t>(&basic_http_client::send);
-					return std::async(l, f, std::ref(*this), std::ref(req));
-				}
-			private:
-				std::reference_wrapper<cmoon::net::io_context> ctx_;
+					if (!has_body(req, res))
+					{
+						return true;
+					}
 
-				void read_message_body(const http_response& res, iostream_socket_type& socket_stream, std::ostream& os, std::error_code& ec) const
-				{	
-					if (const auto te_it = res.headers().find(std::string{headers::transfer_encoding}); te_it != res.headers().end())
+					if (const auto te = find_header(res.headers(), headers::transfer_encoding); te != nullptr)
 					{
-						if (te_it->second == "chunked")
+						if (has_token(te, "chunked"))
 						{
 							read_chunked_encoding(socket_stream, os, ec);
-							return;
+							return !ec;
 						}
 					}
-					else if (const auto cl_it = res.headers().find(std::string{headers::content_length}); cl_it != res.headers().end())
+					else if (const auto cl = find_header(res.headers(), headers::content_length); cl != nullptr)
 					{
 						std::streamsize size;
-						if (const auto result = std::from_chars(cl_it->second.data(), 
-																cl_it->second.data() + cl_it->second.size(), 
-																size); result.ec == std::errc{})
+						if (const auto result = std::from_chars(cl->data(), cl->data() + cl->size(), size); result.ec == std::errc{})
 						{
-							while (size--)
-							{
-								char ch;
-								if (socket_stream.get(ch))
-								{
-									if (!os.put(ch))
-									{
-										return;
-									}
-								}
-								else
-								{
-									ec = make_error_code(http_errc::malformed_response);
-									return;
-								}
-							}
-							return;
+							copy_body(socket_stream, os, size, ec);
+							return !ec;
 						}
 					}
 
 					os << socket_stream.rdbuf();
+					return false;
+				}
+
+				void copy_body(iostream_socket_type& socket_stream, std::ostream& os, std::streamsize size, std::error_code& ec) const
+				{
+					std::array<char, 4096> buffer;
+					while (size > 0)
+					{
+						const auto n = std::min(size, static_cast<std::streamsize>(buffer.size()));
+						if (!socket_stream.read(buffer.data(), n))
+						{
+							ec = make_error_code(http_errc::malformed_response);
+							return;
+						}
+
+						os.write(buffer.data(), n);
+						size -= n;
+					}
 				}
 
 				void read_chunked_encoding(iostream_socket_type& socket_stream, std::ostream& os, std::error_code& ec) const
@@ -947,34 +1410,27 @@ namespace cmoon
 						if (result.ec != std::errc{})
 						{
 							ec = make_error_code(http_errc::malformed_response);
-							break;
+							return;
 						}
 
 						if (size == 0)
 						{
-							socket_stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-							break;
+							// Skip any trailers up to the blank line ending the
+							// message.
+							while (cmoon::getline(socket_stream, size_input) && size_input.find_first_not_of('\r') != std::string::npos) {}
+							return;
 						}
 
-						while (size--)
+						copy_body(socket_stream, os, size, ec);
+						if (ec)
 						{
-							char ch;
-							if (socket_stream.get(ch))
-							{
-								if (!os.put(ch))
-								{
-									return;
-								}
-							}
-							else
-							{
-								ec = make_error_code(http_errc::malformed_response);
-								return;
-							}
+							return;
 						}
 
 						socket_stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 					}
+
+					ec = make_error_code(http_errc::malformed_response);
 				}
 		};
 
@@ -0,0 +1,851 @@
+export module cmoon.net.internet.http_parser;
+
+import <cstddef>;
+import <cstdint>;
+import <array>;
+import <algorithm>;
+import <charconv>;
+import <limits>;
+import <optional>;
+import <span>;
+import <string>;
+import <string_view>;
+import <system_error>;
+
+import cmoon.net.buffers.const_buffer;
+
+namespace cmoon::http
+{
+	class http_parse_category_t : public std::error_category
+	{
+		public:
+			const char* name() const noexcept override
+			{
+				return "http parse";
+			}
+
+			std::string message(int ev) const override
+			{
+				switch (ev)
+				{
+					case 1:
+						return "malformed start line";
+					case 2:
+						return "unsupported http version";
+					case 3:
+						return "malformed header";
+					case 4:
+						return "message head too large";
+					case 5:
+						return "too many headers";
+					case 6:
+						return "invalid content length";
+					case 7:
+						return "malformed chunk";
+					case 8:
+						return "invalid transfer encoding";
+					default:
+						return "unknown http parse error";
+				}
+			}
+	};
+
+	export
+	enum class http_parse_errc
+	{
+		bad_start_line = 1,
+		bad_version = 2,
+		bad_header = 3,
+		head_too_large = 4,
+		too_many_headers = 5,
+		bad_content_length = 6,
+		bad_chunk = 7,
+		bad_transfer_encoding = 8
+	};
+
+	export
+	const std::error_category& http_parse_category() noexcept
+	{
+		static http_parse_category_t category;
+		return category;
+	}
+}
+
+namespace std
+{
+	export
+	std::error_code make_error_code(cmoon::http::http_parse_errc e) noexcept
+	{
+		return std::error_code{static_cast<int>(e), cmoon::http::http_parse_category()};
+	}
+
+	export
+	std::error_condition make_error_condition(cmoon::http::http_parse_errc e) noexcept
+	{
+		return std::error_condition{static_cast<int>(e), cmoon::http::http_parse_category()};
+	}
+}
+
+namespace cmoon::http
+{
+	export
+	struct http_header_field
+	{
+		std::string_view name;
+		std::string_view value;
+	};
+
+	export
+	enum class http_message_kind
+	{
+		request,
+		response
+	};
+
+	export
+	enum class http_parse_event
+	{
+		// Every byte offered was consumed, or the head is not complete yet.
+		need_more,
+
+		// The start line and headers are available.
+		head,
+
+		// result.body holds the next piece of the body.
+		body,
+
+		message_complete
+	};
+
+	export
+	struct http_parse_result
+	{
+		http_parse_event event {http_parse_event::need_more};
+		std::size_t consumed {0};
+		std::string_view body;
+	};
+
+	// An incremental HTTP/1.1 parser that never copies the message. Feed it
+	// everything received but not yet consumed; it returns how much it used,
+	// and the caller drops that much from the front of its buffer before
+	// calling again with the rest and any new data.
+	//
+	// Nothing is consumed until the whole head has arrived, so the head
+	// stays contiguous in the caller's buffer and the start line and header
+	// views point straight into it. They stay valid until the caller
+	// discards the head's bytes. Body pieces are likewise views into the
+	// input, with chunked framing stripped. Parsing another message after
+	// message_complete starts over, which suits keep-alive and pipelined
+	// connections.
+	export
+	class http_parser
+	{
+		public:
+			static constexpr std::size_t max_headers {64};
+			static constexpr std::size_t default_max_head_size {16 * 1024};
+
+			explicit http_parser(http_message_kind kind, std::size_t max_head_size = default_max_head_size) noexcept
+				: kind_{kind}, max_head_size_{max_head_size} {}
+
+			http_parse_result parse(std::string_view data, std::error_code& ec) noexcept
+			{
+				ec.clear();
+				if (state_ == state::reported)
+				{
+					reset();
+				}
+
+				if (state_ == state::head)
+				{
+					return parse_head(data, ec);
+				}
+
+				return parse_body(data, ec);
+			}
+
+			http_parse_result parse(std::string_view data)
+			{
+				std::error_code ec;
+				const auto result {parse(data, ec)};
+				if (ec)
+				{
+					throw std::system_error{ec, "http_parser::parse"};
+				}
+
+				return result;
+			}
+
+			http_parse_result parse(const cmoon::net::const_buffer& data, std::error_code& ec) noexcept
+			{
+				return parse(std::string_view{static_cast<const char*>(data.data()), data.size()}, ec);
+			}
+
+			http_parse_result parse(const cmoon::net::const_buffer& data)
+			{
+				return parse(std::string_view{static_cast<const char*>(data.data()), data.size()});
+			}
+
+			// For a response whose body runs until the connection closes,
+			// marks it complete once the peer has shut down. Returns whether
+			// the message was complete.
+			bool finish() noexcept
+			{
+				if (state_ == state::until_eof)
+				{
+					state_ = state::complete;
+				}
+
+				return message_complete();
+			}
+
+			// Responses to HEAD requests, and 1xx, 204 and 304 responses,
+			// carry no body whatever their headers say. Call this before
+			// parsing the response to a HEAD request.
+			void expect_no_body() noexcept
+			{
+				if (state_ == state::reported)
+				{
+					reset();
+				}
+
+				no_body_ = true;
+			}
+
+			void reset() noexcept
+			{
+				state_ = state::head;
+				scanned_ = 0;
+				header_count_ = 0;
+				method_ = {};
+				target_ = {};
+				reason_ = {};
+				status_ = 0;
+				version_minor_ = 1;
+				content_length_.reset();
+				chunked_ = false;
+				transfer_encoded_ = false;
+				close_ = false;
+				keep_alive_ = false;
+				no_body_ = false;
+				until_eof_ = false;
+				remaining_ = 0;
+			}
+
+			[[nodiscard]] http_message_kind kind() const noexcept
+			{
+				return kind_;
+			}
+
+			[[nodiscard]] bool head_complete() const noexcept
+			{
+				return state_ != state::head;
+			}
+
+			[[nodiscard]] bool message_complete() const noexcept
+			{
+				return state_ == state::complete || state_ == state::reported;
+			}
+
+			[[nodiscard]] std::string_view method() const noexcept
+			{
+				return method_;
+			}
+
+			[[nodiscard]] std::string_view target() const noexcept
+			{
+				return target_;
+			}
+
+			[[nodiscard]] unsigned int status() const noexcept
+			{
+				return status_;
+			}
+
+			[[nodiscard]] std::string_view reason() const noexcept
+			{
+				return reason_;
+			}
+
+			// 0 for HTTP/1.0, 1 for HTTP/1.1.
+			[[nodiscard]] int version_minor() const noexcept
+			{
+				return version_minor_;
+			}
+
+			[[nodiscard]] std::span<const http_header_field> headers() const noexcept
+			{
+				return {headers_.data(), header_count_};
+			}
+
+			// The first value of a header, matched case-insensitively.
+			[[nodiscard]] std::string_view header(std::string_view name) const noexcept
+			{
+				for (const auto& h : headers())
+				{
+					if (equals_ignore_case(h.name, name))
+					{
+						return h.value;
+					}
+				}
+
+				return {};
+			}
+
+			[[nodiscard]] bool chunked() const noexcept
+			{
+				return chunked_;
+			}
+
+			[[nodiscard]] std::optional<std::uint64_t> content_length() const noexcept
+			{
+				return content_length_;
+			}
+
+			// Whether the connection may carry another message after this one.
+			[[nodiscard]] bool keep_alive() const noexcept
+			{
+				// A response framed both ways may have been read differently
+				// by something in between, so nothing after it can be trusted.
+				if (until_eof_ || close_ || (transfer_encoded_ && content_length_))
+				{
+					return false;
+				}
+
+				return version_minor_ == 1 || keep_alive_;
+			}
+		private:
+			enum class state
+			{
+				head,
+				fixed,
+				chunk_size,
+				chunk_extension,
+				chunk_size_lf,
+				chunk_data,
+				chunk_data_cr,
+				chunk_data_lf,
+				trailer_start,
+				trailer_line,
+				trailer_end_lf,
+				until_eof,
+				complete,
+				reported
+			};
+
+			http_message_kind kind_;
+			std::size_t max_head_size_;
+			state state_ {state::head};
+			std::size_t scanned_ {0};
+
+			std::array<http_header_field, max_headers> headers_ {};
+			std::size_t header_count_ {0};
+			std::string_view method_;
+			std::string_view target_;
+			std::string_view reason_;
+			unsigned int status_ {0};
+			int version_minor_ {1};
+
+			std::optional<std::uint64_t> content_length_;
+			bool chunked_ {false};
+			bool transfer_encoded_ {false};
+			bool close_ {false};
+			bool keep_alive_ {false};
+			bool no_body_ {false};
+			bool until_eof_ {false};
+			std::uint64_t remaining_ {0};
+
+			[[nodiscard]] static bool equals_ignore_case(std::string_view lhs, std::string_view rhs) noexcept
+			{
+				return std::ranges::equal(lhs, rhs, [](char l, char r) {
+					return to_lower(l) == to_lower(r);
+				});
+			}
+
+			[[nodiscard]] static constexpr char to_lower(char c) noexcept
+			{
+				return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+			}
+
+			[[nodiscard]] static constexpr bool is_token_char(char c) noexcept
+			{
+				constexpr std::string_view specials {"!#$%&'*+-.^_`|~"};
+				return (c >= '0' && c <= '9') ||
+					   (c >= 'a' && c <= 'z') ||
+					   (c >= 'A' && c <= 'Z') ||
+					   specials.find(c) != std::string_view::npos;
+			}
+
+			[[nodiscard]] static constexpr std::string_view trim(std::string_view s) noexcept
+			{
+				while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+				{
+					s.remove_prefix(1);
+				}
+
+				while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+				{
+					s.remove_suffix(1);
+				}
+
+				return s;
+			}
+
+			// Whether a comma-separated list, such as a Connection header,
+			// contains token.
+			[[nodiscard]] static bool has_token(std::string_view list, std::string_view token) noexcept
+			{
+				while (!list.empty())
+				{
+					const auto comma {list.find(',')};
+					if (equals_ignore_case(trim(list.substr(0, comma)), token))
+					{
+						return true;
+					}
+
+					if (comma == std::string_view::npos)
+					{
+						break;
+					}
+
+					list.remove_prefix(comma + 1);
+				}
+
+				return false;
+			}
+
+			// The last non-empty element of a comma-separated list.
+			[[nodiscard]] static std::string_view last_token(std::string_view list) noexcept
+			{
+				std::string_view last;
+				while (!list.empty())
+				{
+					const auto comma {list.find(',')};
+					if (const auto token {trim(list.substr(0, comma))}; !token.empty())
+					{
+						last = token;
+					}
+
+					if (comma == std::string_view::npos)
+					{
+						break;
+					}
+
+					list.remove_prefix(comma + 1);
+				}
+
+				return last;
+			}
+
+			// Splits off the next line, without its line ending.
+			[[nodiscard]] static std::string_view next_line(std::string_view& head) noexcept
+			{
+				const auto lf {head.find('\n')};
+				auto line {head.substr(0, lf)};
+				head.remove_prefix(lf == std::string_view::npos ? head.size() : lf + 1);
+				if (!line.empty() && line.back() == '\r')
+				{
+					line.remove_suffix(1);
+				}
+
+				return line;
+			}
+
+			[[nodiscard]] bool parse_version(std::string_view v) noexcept
+			{
+				if (v == "HTTP/1.1")
+				{
+					version_minor_ = 1;
+					return true;
+				}
+				else if (v == "HTTP/1.0")
+				{
+					version_minor_ = 0;
+					return true;
+				}
+
+				return false;
+			}
+
+			void parse_start_line(std::string_view line, std::error_code& ec) noexcept
+			{
+				const auto first_space {line.find(' ')};
+				const auto second_space {first_space == std::string_view::npos ? std::string_view::npos : line.find(' ', first_space + 1)};
+				if (first_space == std::string_view::npos ||
+					(kind_ == http_message_kind::request && second_space == std::string_view::npos))
+				{
+					ec = std::make_error_code(http_parse_errc::bad_start_line);
+					return;
+				}
+
+				if (kind_ == http_message_kind::request)
+				{
+					method_ = line.substr(0, first_space);
+					target_ = line.substr(first_space + 1, second_space - first_space - 1);
+					if (method_.empty() || target_.empty() || !std::ranges::all_of(method_, is_token_char))
+					{
+						ec = std::make_error_code(http_parse_errc::bad_start_line);
+					}
+					else if (!parse_version(line.substr(second_space + 1)))
+					{
+						ec = std::make_error_code(http_parse_errc::bad_version);
+					}
+
+					return;
+				}
+
+				if (!parse_version(line.substr(0, first_space)))
+				{
+					ec = std::make_error_code(http_parse_errc::bad_version);
+					return;
+				}
+
+				const auto code {line.substr(first_space + 1, second_space == std::string_view::npos ? std::string_view::npos : second_space - first_space - 1)};
+				const auto [end, error] {std::from_chars(code.data(), code.data() + code.size(), status_)};
+				if (code.size() != 3 || error != std::errc{} || end != code.data() + code.size())
+				{
+					ec = std::make_error_code(http_parse_errc::bad_start_line);
+					return;
+				}
+
+				reason_ = second_space == std::string_view::npos ? std::string_view{} : line.substr(second_space + 1);
+			}
+
+			void add_header(std::string_view line, std::error_code& ec) noexcept
+			{
+				const auto colon {line.find(':')};
+				if (colon == std::string_view::npos || colon == 0)
+				{
+					ec = std::make_error_code(http_parse_errc::bad_header);
+					return;
+				}
+
+				const auto name {line.substr(0, colon)};
+				if (!std::ranges::all_of(name, is_token_char))
+				{
+					ec = std::make_error_code(http_parse_errc::bad_header);
+					return;
+				}
+
+				if (header_count_ == max_headers)
+				{
+					ec = std::make_error_code(http_parse_errc::too_many_headers);
+					return;
+				}
+
+				const auto value {trim(line.substr(colon + 1))};
+				headers_[header_count_++] = {name, value};
+
+				if (equals_ignore_case(name, "content-length"))
+				{
+					std::uint64_t length;
+					const auto [end, error] {std::from_chars(value.data(), value.data() + value.size(), length)};
+					if (value.empty() || error != std::errc{} || end != value.data() + value.size() ||
+						(content_length_ && *content_length_ != length))
+					{
+						ec = std::make_error_code(http_parse_errc::bad_content_length);
+						return;
+					}
+
+					content_length_ = length;
+				}
+				else if (equals_ignore_case(name, "transfer-encoding"))
+				{
+					// Repeated headers make up one list, and only a final
+					// chunked coding frames the message.
+					transfer_encoded_ = true;
+					if (const auto coding {last_token(value)}; !coding.empty())
+					{
+						chunked_ = equals_ignore_case(coding, "chunked");
+					}
+				}
+				else if (equals_ignore_case(name, "connection"))
+				{
+					close_ = close_ || has_token(value, "close");
+					keep_alive_ = keep_alive_ || has_token(value, "keep-alive");
+				}
+			}
+
+			http_parse_result parse_head(std::string_view data, std::error_code& ec) noexcept
+			{
+				// Resume the search for the blank line where the last call
+				// stopped, backing up in case its terminator was split.
+				const auto from {scanned_ > 3 ? scanned_ - 3 : 0};
+				auto end {std::string_view::npos};
+				for (auto i {data.find('\n', from)}; i != std::string_view::npos; i = data.find('\n', i + 1))
+				{
+					if ((i >= 1 && data[i - 1] == '\n') ||
+						(i >= 2 && data[i - 1] == '\r' && data[i - 2] == '\n'))
+					{
+						end = i + 1;
+						break;
+					}
+				}
+
+				if (end == std::string_view::npos)
+				{
+					scanned_ = data.size();
+					if (data.size() > max_head_size_)
+					{
+						ec = std::make_error_code(http_parse_errc::head_too_large);
+					}
+
+					return {http_parse_event::need_more, 0};
+				}
+
+				if (end > max_head_size_)
+				{
+					ec = std::make_error_code(http_parse_errc::head_too_large);
+					return {http_parse_event::need_more, 0};
+				}
+
+				auto head {data.substr(0, end)};
+
+				// Tolerate blank lines ahead of a message, as left behind by
+				// a previous message's stray line ending.
+				auto line {next_line(head)};
+				while (line.empty() && !head.empty())
+				{
+					line = next_line(head);
+				}
+
+				parse_start_line(line, ec);
+				while (!ec)
+				{
+					line = next_line(head);
+					if (line.empty())
+					{
+						break;
+					}
+
+					// Obsolete line folding is rejected rather than unfolded,
+					// since unfolding would need a copy.
+					if (line.front() == ' ' || line.front() == '\t')
+					{
+						ec = std::make_error_code(http_parse_errc::bad_header);
+						break;
+					}
+
+					add_header(line, ec);
+				}
+
+				// A request body that is not chunked last, or that also has a
+				// length, could be framed differently by a server in front of
+				// this one, letting a second request be smuggled inside it.
+				if (!ec && kind_ == http_message_kind::request && transfer_encoded_ && (!chunked_ || content_length_))
+				{
+					ec = std::make_error_code(http_parse_errc::bad_transfer_encoding);
+				}
+
+				if (ec)
+				{
+					return {http_parse_event::need_more, 0};
+				}
+
+				start_body();
+				return {http_parse_event::head, end};
+			}
+
+			void start_body() noexcept
+			{
+				// scanned_ counted head bytes until now; from here on it
+				// counts the digits of the chunk size being read.
+				scanned_ = 0;
+				const bool bodiless_response {kind_ == http_message_kind::response &&
+											  (no_body_ || status_ < 200 || status_ == 204 || status_ == 304)};
+				if (bodiless_response)
+				{
+					state_ = state::complete;
+				}
+				else if (chunked_)
+				{
+					remaining_ = 0;
+					state_ = state::chunk_size;
+				}
+				else if (content_length_ && !transfer_encoded_)
+				{
+					remaining_ = *content_length_;
+					state_ = remaining_ == 0 ? state::complete : state::fixed;
+				}
+				else
+				{
+					until_eof_ = kind_ == http_message_kind::response;
+					state_ = until_eof_ ? state::until_eof : state::complete;
+				}
+			}
+
+			http_parse_result parse_body(std::string_view data, std::error_code& ec) noexcept
+			{
+				std::size_t i {0};
+				while (true)
+				{
+					switch (state_)
+					{
+						case state::complete:
+							state_ = state::reported;
+							return {http_parse_event::message_complete, i};
+						case state::until_eof:
+							return {data.size() == i ? http_parse_event::need_more : http_parse_event::body, data.size(), data.substr(i)};
+						case state::fixed:
+						case state::chunk_data:
+						{
+							if (i == data.size())
+							{
+								return {http_parse_event::need_more, i};
+							}
+
+							const auto n {static_cast<std::size_t>(std::min<std::uint64_t>(remaining_, data.size() - i))};
+							remaining_ -= n;
+							if (remaining_ == 0)
+							{
+								state_ = state_ == state::fixed ? state::complete : state::chunk_data_cr;
+							}
+
+							return {http_parse_event::body, i + n, data.substr(i, n)};
+						}
+						default:
+							break;
+					}
+
+					if (i == data.size())
+					{
+						return {http_parse_event::need_more, i};
+					}
+
+					const auto c {data[i++]};
+					switch (state_)
+					{
+						case state::chunk_size:
+						{
+							int digit {-1};
+							if (c >= '0' && c <= '9')
+							{
+								digit = c - '0';
+							}
+							else if (to_lower(c) >= 'a' && to_lower(c) <= 'f')
+							{
+								digit = to_lower(c) - 'a' + 10;
+							}
+
+							if (digit >= 0)
+							{
+								if (remaining_ > (std::numeric_limits<std::uint64_t>::max() >> 4))
+								{
+									ec = std::make_error_code(http_parse_errc::bad_chunk);
+									return {http_parse_event::need_more, i - 1};
+								}
+
+								remaining_ = (remaining_ << 4) | static_cast<std::uint64_t>(digit);
+								scanned_ = 1;
+							}
+							else if (scanned_ == 0)
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+							else if (c == ';' || c == ' ' || c == '\t')
+							{
+								state_ = state::chunk_extension;
+							}
+							else if (c == '\r')
+							{
+								state_ = state::chunk_size_lf;
+							}
+							else if (c == '\n')
+							{
+								end_chunk_size();
+							}
+							else
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+							break;
+						}
+						case state::chunk_extension:
+							if (c == '\n')
+							{
+								end_chunk_size();
+							}
+							break;
+						case state::chunk_size_lf:
+							if (c != '\n')
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+
+							end_chunk_size();
+							break;
+						case state::chunk_data_cr:
+							if (c == '\r')
+							{
+								state_ = state::chunk_data_lf;
+							}
+							else if (c == '\n')
+							{
+								start_chunk();
+							}
+							else
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+							break;
+						case state::chunk_data_lf:
+							if (c != '\n')
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+
+							start_chunk();
+							break;
+						case state::trailer_start:
+							if (c == '\r')
+							{
+								state_ = state::trailer_end_lf;
+							}
+							else if (c == '\n')
+							{
+								state_ = state::complete;
+							}
+							else
+							{
+								state_ = state::trailer_line;
+							}
+							break;
+						case state::trailer_line:
+							if (c == '\n')
+							{
+								state_ = state::trailer_start;
+							}
+							break;
+						case state::trailer_end_lf:
+							if (c != '\n')
+							{
+								ec = std::make_error_code(http_parse_errc::bad_chunk);
+								return {http_parse_event::need_more, i - 1};
+							}
+
+							state_ = state::complete;
+							break;
+						default:
+							break;
+					}
+				}
+			}
+
+			void start_chunk() noexcept
+			{
+				remaining_ = 0;
+				scanned_ = 0;
+				state_ = state::chunk_size;
+			}
+
+			void end_chunk_size() noexcept
+			{
+				scanned_ = 0;
+				state_ = remaining_ == 0 ? state::trailer_start : state::chunk_data;
+			}
+	};
+}
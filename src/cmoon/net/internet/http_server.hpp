@@ -0,0 +1,1033 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <map>
+#include <vector>
+#include <list>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <chrono>
+#include <concepts>
+#include <type_traits>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+#include <charconv>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <exception>
+#include <system_error>
+
+#include "cmoon/net/http.hpp"
+
+import cmoon.execution;
+import cmoon.executors.static_thread_pool;
+import cmoon.executors.timer_context;
+import cmoon.net.buffers;
+import cmoon.net.execution.io_context;
+import cmoon.net.internet.http_parser;
+
+namespace cmoon
+{
+	namespace http
+	{
+		// Fills in the response and writes its body to the stream. The
+		// server adds Content-Length and Connection itself.
+		using http_handler = std::function<void(http_request&, http_response&, std::ostream&)>;
+
+		class http_router
+		{
+			public:
+				http_router& route(std::string_view method, std::string_view path, http_handler handler)
+				{
+					auto it = exact_.find(path);
+					if (it == exact_.end())
+					{
+						it = exact_.emplace(std::string{path}, method_handlers{}).first;
+					}
+
+					it->second.set(method, std::move(handler));
+					return *this;
+				}
+
+				// Handles every path starting with prefix that has no exact
+				// route. The longest matching prefix wins.
+				http_router& route_prefix(std::string_view method, std::string_view prefix, http_handler handler)
+				{
+					auto it = std::ranges::find(prefixes_, prefix, &prefix_route::prefix);
+					if (it == prefixes_.end())
+					{
+						const auto position = std::ranges::find_if(prefixes_, [&prefix](const auto& p) { return p.prefix.size() < prefix.size(); });
+						it = prefixes_.insert(position, prefix_route{std::string{prefix}, {}});
+					}
+
+					it->handlers.set(method, std::move(handler));
+					return *this;
+				}
+
+				// Calls the handler routed for the request. Unknown paths get
+				// 404, and known paths without a handler for the method get
+				// 405. HEAD requests fall back to the GET handler.
+				void dispatch(http_request& req, http_response& res, std::ostream& body) const
+				{
+					const auto handlers = find(req.url().resource());
+					if (handlers == nullptr)
+					{
+						res.status() = status::http_status{404u, status::not_found_message};
+						return;
+					}
+
+					auto handler = handlers->find(req.method());
+					if (handler == nullptr && req.method() == head)
+					{
+						handler = handlers->find(get);
+					}
+
+					if (handler == nullptr)
+					{
+						res.status() = status::http_status{405u, status::method_not_allowed_message};
+						res.headers()[std::string{headers::allow}] = handlers->allowed();
+						return;
+					}
+
+					(*handler)(req, res, body);
+				}
+			private:
+				struct method_handlers
+				{
+					std::vector<std::pair<std::string, http_handler>> handlers;
+
+					void set(std::string_view method, http_handler handler)
+					{
+						auto it = std::ranges::find(handlers, method, &std::pair<std::string, http_handler>::first);
+						if (it == handlers.end())
+						{
+							handlers.emplace_back(std::string{method}, std::move(handler));
+						}
+						else
+						{
+							it->second = std::move(handler);
+						}
+					}
+
+					[[nodiscard]] const http_handler* find(std::string_view method) const noexcept
+					{
+						const auto it = std::ranges::find(handlers, method, &std::pair<std::string, http_handler>::first);
+						return it == handlers.end() ? nullptr : std::addressof(it->second);
+					}
+
+					[[nodiscard]] std::string allowed() const
+					{
+						std::string result;
+						for (const auto& [method, handler] : handlers)
+						{
+							if (!result.empty())
+							{
+								result += ", ";
+							}
+
+							result += method;
+						}
+
+						return result;
+					}
+				};
+
+				struct prefix_route
+				{
+					std::string prefix;
+					method_handlers handlers;
+				};
+
+				std::map<std::string, method_handlers, std::less<>> exact_;
+
+				// Kept longest first.
+				std::vector<prefix_route> prefixes_;
+
+				[[nodiscard]] const method_handlers* find(std::string_view path) const noexcept
+				{
+					if (const auto it = exact_.find(path); it != exact_.end())
+					{
+						return std::addressof(it->second);
+					}
+
+					for (const auto& p : prefixes_)
+					{
+						if (path.starts_with(p.prefix))
+						{
+							return std::addressof(p.handlers);
+						}
+					}
+
+					return nullptr;
+				}
+		};
+
+		struct http_server_options
+		{
+			// Threads in the pool that runs the server's io_context. Handlers
+			// run on these threads too, straight after their request is read.
+			std::size_t threads {std::max(std::thread::hardware_concurrency(), 1u)};
+
+			net::io_backend backend {net::io_backend::epoll};
+
+			// Requests served on one connection before it is closed.
+			std::size_t max_keep_alive_requests {1000};
+
+			std::size_t max_head_size {http_parser::default_max_head_size};
+			std::size_t max_body_size {1024 * 1024};
+
+			// Grows as needed, up to max_head_size, while a head is read.
+			std::size_t receive_buffer_size {4096};
+
+			// How long a connection may wait for the first byte of a
+			// request, and how long a head may then take to arrive in
+			// full. Zero means no limit.
+			std::chrono::milliseconds idle_timeout {std::chrono::seconds{60}};
+			std::chrono::milliseconds header_timeout {std::chrono::seconds{30}};
+		};
+
+		struct http_server_statistics
+		{
+			std::size_t connections_accepted {0};
+			std::size_t connections_open {0};
+			std::size_t requests {0};
+		};
+
+		// Accepts connections and serves each with a small state machine:
+		// read until the parser has a whole request, run its handler, write
+		// the response with one gathered write, then either read the next
+		// request or close. Requests a client pipelines are answered in
+		// order from what is already buffered. Each connection only ever has
+		// one operation in flight, so it needs no locking of its own beyond
+		// what stop() and the timeout sweep use to cancel it.
+		//
+		// A connection left idle past idle_timeout, or sending its head for
+		// longer than header_timeout, is closed; deadlines are checked every
+		// quarter of the shorter timeout, and at least once a second.
+		// Reading a body and writing a response have no time limit.
+		template<class Protocol>
+		class basic_http_server
+		{
+			public:
+				using protocol_type = Protocol;
+				using endpoint_type = typename protocol_type::endpoint;
+				using acceptor_type = typename protocol_type::acceptor;
+				using socket_type = typename protocol_type::socket;
+
+				basic_http_server(const endpoint_type& endpoint, http_router router, const http_server_options& options = {})
+					: options_{options}, ctx_{options.backend}, acceptor_{ctx_, endpoint}, router_{std::move(router)} {}
+
+				basic_http_server(const basic_http_server&) = delete;
+				basic_http_server& operator=(const basic_http_server&) = delete;
+
+				~basic_http_server() noexcept
+				{
+					stop();
+				}
+
+				[[nodiscard]] net::io_context& context() noexcept
+				{
+					return ctx_;
+				}
+
+				[[nodiscard]] const http_server_options& options() const noexcept
+				{
+					return options_;
+				}
+
+				[[nodiscard]] endpoint_type local_endpoint()
+				{
+					return acceptor_.local_endpoint();
+				}
+
+				[[nodiscard]] http_server_statistics statistics() const noexcept
+				{
+					return {
+						connections_accepted_.load(std::memory_order_relaxed),
+						connections_open_.load(std::memory_order_relaxed),
+						requests_.load(std::memory_order_relaxed)
+					};
+				}
+
+				// Starts accepting on the pool's threads and returns straight
+				// away.
+				void start()
+				{
+					if (pool_)
+					{
+						return;
+					}
+
+					if (sweep_interval())
+					{
+						timers_.emplace();
+					}
+
+					work_.emplace(ctx_);
+					pool_.emplace(options_.threads);
+					cmoon::execution::start_detached(
+						cmoon::execution::bulk(cmoon::execution::schedule(pool_->get_scheduler()), options_.threads,
+							[this](std::size_t) {
+								ctx_.run();
+							})
+					);
+
+					std::scoped_lock l {accept_m_};
+					accept();
+					schedule_sweep();
+				}
+
+				// Closes the acceptor and every connection, then waits for the
+				// pool to finish. Responses being written are cut off. A
+				// stopped server cannot be started again.
+				void stop() noexcept
+				{
+					if (!pool_)
+					{
+						return;
+					}
+
+					stopping_.store(true, std::memory_order_release);
+					std::error_code ec;
+					{
+						std::scoped_lock l {accept_m_};
+						acceptor_.close(ec);
+					}
+
+					if (timers_)
+					{
+						timers_->request_stop();
+						timers_->join();
+					}
+
+					{
+						std::scoped_lock l {m_};
+						for (auto& c : connections_)
+						{
+							std::scoped_lock cl {c.m};
+							c.socket.cancel(ec);
+						}
+					}
+
+					work_.reset();
+					pool_.reset();
+				}
+			private:
+				struct connection;
+
+				template<class Sender, class Receiver>
+				struct operation
+				{
+					operation(Sender&& s, Receiver r)
+						: state{cmoon::execution::connect(std::move(s), std::move(r))} {}
+
+					cmoon::execution::connect_result_t<Sender, Receiver> state;
+				};
+
+				// Receivers that hand each completion back to the object that
+				// started the operation.
+				template<class T, void (T::*Value)(std::size_t) noexcept>
+				struct transfer_receiver
+				{
+					T* self;
+
+					friend void tag_invoke(cmoon::execution::set_value_t, transfer_receiver&& r, std::size_t n) noexcept
+					{
+						(r.self->*Value)(n);
+					}
+
+					template<class E>
+					friend void tag_invoke(cmoon::execution::set_error_t, transfer_receiver&& r, E&&) noexcept
+					{
+						r.self->close();
+					}
+
+					friend void tag_invoke(cmoon::execution::set_done_t, transfer_receiver&& r) noexcept
+					{
+						r.self->close();
+					}
+				};
+
+				struct accept_receiver
+				{
+					basic_http_server* server;
+
+					friend void tag_invoke(cmoon::execution::set_value_t, accept_receiver&& r, socket_type s) noexcept
+					{
+						r.run(std::move(s));
+					}
+
+					template<class E>
+					friend void tag_invoke(cmoon::execution::set_error_t, accept_receiver&& r, E&& e) noexcept
+					{
+						if constexpr (std::same_as<std::remove_cvref_t<E>, std::error_code>)
+						{
+							r.fail(e);
+						}
+						else
+						{
+							// Making the socket threw, most likely for want
+							// of memory, which may well pass.
+							r.fail(std::make_error_code(std::errc::not_enough_memory));
+						}
+					}
+
+					friend void tag_invoke(cmoon::execution::set_done_t, accept_receiver&&) noexcept {}
+					private:
+						void run(socket_type s) noexcept
+						{
+							server->accepted(std::move(s));
+						}
+
+						void fail(const std::error_code& ec) noexcept
+						{
+							server->accept_failed(ec);
+						}
+				};
+
+				struct backoff_receiver
+				{
+					basic_http_server* server;
+
+					friend void tag_invoke(cmoon::execution::set_value_t, backoff_receiver&& r) noexcept
+					{
+						r.run();
+					}
+
+					template<class E>
+					friend void tag_invoke(cmoon::execution::set_error_t, backoff_receiver&&, E&&) noexcept {}
+
+					friend void tag_invoke(cmoon::execution::set_done_t, backoff_receiver&&) noexcept {}
+					private:
+						void run() noexcept
+						{
+							std::scoped_lock l {server->accept_m_};
+							server->accept();
+						}
+				};
+
+				struct sweep_receiver
+				{
+					basic_http_server* server;
+
+					friend void tag_invoke(cmoon::execution::set_value_t, sweep_receiver&& r) noexcept
+					{
+						r.run();
+					}
+
+					template<class E>
+					friend void tag_invoke(cmoon::execution::set_error_t, sweep_receiver&&, E&&) noexcept {}
+
+					friend void tag_invoke(cmoon::execution::set_done_t, sweep_receiver&&) noexcept {}
+					private:
+						void run() noexcept
+						{
+							server->sweep();
+						}
+				};
+
+				class view_buffer : public std::streambuf
+				{
+					public:
+						void reset(std::string_view s) noexcept
+						{
+							const auto p = const_cast<char*>(s.data());
+							setg(p, p, p + s.size());
+						}
+				};
+
+				using read_sender = net::async_read_some_sender;
+				using write_sender = net::async_write_some_buffers_sender;
+				using accept_sender = decltype(std::declval<acceptor_type&>().async_accept(std::declval<net::io_context&>()));
+				using backoff_sender = decltype(cmoon::execution::schedule_after(std::declval<cmoon::executors::timer_context&>().get_scheduler(), std::chrono::milliseconds{}));
+
+				// Accepting again after running out of descriptors or memory
+				// would only fail again at once, so the retries back off
+				// from min_accept_backoff, doubling up to max_accept_backoff.
+				static constexpr std::chrono::milliseconds min_accept_backoff {1};
+				static constexpr std::chrono::milliseconds max_accept_backoff {1000};
+
+				static constexpr std::chrono::milliseconds min_sweep_interval {1};
+				static constexpr std::chrono::milliseconds max_sweep_interval {1000};
+
+				using clock = std::chrono::steady_clock;
+
+				enum class wait_phase
+				{
+					none,
+					idle,
+					head
+				};
+
+				struct connection
+				{
+					connection(basic_http_server& server, socket_type&& s)
+						: server{server},
+						  socket{std::move(s)},
+						  parser{http_message_kind::request, server.options_.max_head_size},
+						  buffer(server.options_.receive_buffer_size) {}
+
+					basic_http_server& server;
+					socket_type socket;
+					std::mutex m;
+					typename std::list<connection>::iterator self;
+
+					http_parser parser;
+					std::vector<char> buffer;
+
+					// The unparsed bytes in buffer.
+					std::size_t begin {0};
+					std::size_t end {0};
+
+					std::optional<http_request> request;
+					std::optional<unsigned int> error_status;
+
+					// A body that arrived whole in one read is used where it
+					// lies; one spread across reads is gathered in body.
+					std::string_view body_view;
+					std::string body;
+					view_buffer body_in;
+
+					std::stringbuf response_body;
+					std::ostream body_out {std::addressof(response_body)};
+					std::string head;
+					std::array<net::const_buffer, 2> out;
+					std::optional<net::consuming_buffers<net::const_buffer, std::array<net::const_buffer, 2>>> remaining;
+					bool keep_alive {false};
+					std::size_t served {0};
+
+					// Read by the sweep, which cancels the connection once
+					// this has passed.
+					wait_phase waiting {wait_phase::none};
+					std::atomic<clock::time_point> deadline {clock::time_point::max()};
+
+					// Starts the clock for phase, unless it is already
+					// running for it, so a head sent a byte at a time still
+					// has to arrive within header_timeout of its first byte.
+					void wait(wait_phase phase) noexcept
+					{
+						if (phase == waiting)
+						{
+							return;
+						}
+
+						waiting = phase;
+						auto timeout = std::chrono::milliseconds{0};
+						if (phase == wait_phase::idle)
+						{
+							timeout = server.options_.idle_timeout;
+						}
+						else if (phase == wait_phase::head)
+						{
+							timeout = server.options_.header_timeout;
+						}
+
+						const auto now = clock::now();
+						const auto limited = timeout > std::chrono::milliseconds{0} && timeout < clock::time_point::max() - now;
+						deadline.store(limited ? now + timeout : clock::time_point::max(), std::memory_order_relaxed);
+					}
+
+					void start_read() noexcept
+					{
+						if (!body_view.empty())
+						{
+							body.assign(body_view);
+							body_view = {};
+						}
+
+						if (begin == end)
+						{
+							begin = end = 0;
+						}
+						else if (end == buffer.size())
+						{
+							// Nothing before begin is referred to anymore, so the
+							// unparsed bytes can move up to make room. A head
+							// that fills the whole buffer needs a bigger one.
+							if (begin > 0)
+							{
+								std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+								end -= begin;
+								begin = 0;
+							}
+							else
+							{
+								buffer.resize(buffer.size() * 2);
+							}
+						}
+
+						if (!parser.head_complete())
+						{
+							wait(begin == end ? wait_phase::idle : wait_phase::head);
+						}
+
+						std::unique_lock l {m};
+						if (server.stopping_.load(std::memory_order_acquire))
+						{
+							l.unlock();
+							close();
+							return;
+						}
+
+						read_op.emplace(socket.async_read_some(net::mutable_buffer{buffer.data() + end, buffer.size() - end}),
+										transfer_receiver<connection, &connection::on_read>{this});
+						cmoon::execution::start(read_op->state);
+					}
+
+					void on_read(std::size_t n) noexcept
+					{
+						end += n;
+						process();
+					}
+
+					// Parses what has been read so far, answering every whole
+					// request in it.
+					void process() noexcept
+					{
+						while (true)
+						{
+							std::error_code ec;
+							const auto result = parser.parse(std::string_view{buffer.data() + begin, end - begin}, ec);
+							if (ec)
+							{
+								fail(ec == std::make_error_code(http_parse_errc::head_too_large) ? 431u : 400u);
+								return;
+							}
+
+							begin += result.consumed;
+							switch (result.event)
+							{
+								case http_parse_event::need_more:
+									start_read();
+									return;
+								case http_parse_event::head:
+									wait(wait_phase::none);
+									if (!start_request())
+									{
+										return;
+									}
+									break;
+								case http_parse_event::body:
+									if (body.size() + body_view.size() + result.body.size() > server.options_.max_body_size)
+									{
+										fail(413u);
+										return;
+									}
+
+									if (body.empty() && body_view.empty())
+									{
+										body_view = result.body;
+									}
+									else
+									{
+										body.append(body_view);
+										body_view = {};
+										body.append(result.body);
+									}
+									break;
+								case http_parse_event::message_complete:
+									respond();
+									return;
+							}
+						}
+					}
+
+					// Copies the parsed head into request, returning false if
+					// the request was refused instead.
+					bool start_request() noexcept
+					{
+						try
+						{
+							if (parser.content_length().value_or(0) > server.options_.max_body_size)
+							{
+								fail(413u);
+								return false;
+							}
+
+							auto& request = this->request.emplace(std::addressof(body_in));
+							request.method() = parser.method();
+							request.version() = parser.version_minor() == 0 ? http_version::HTTP_1 : http_version::HTTP_1_1;
+
+							// The query is left percent-encoded.
+							const auto target = parser.target();
+							const auto query = target.find('?');
+							request.url().resource() = target.substr(0, query);
+							if (query != std::string_view::npos)
+							{
+								auto rest = target.substr(query + 1);
+								while (!rest.empty())
+								{
+									const auto amp = rest.find('&');
+									const auto param = rest.substr(0, amp);
+									const auto equals = param.find('=');
+									request.url().parameters()[std::string{param.substr(0, equals)}] = equals == std::string_view::npos ? std::string{} : std::string{param.substr(equals + 1)};
+									rest.remove_prefix(amp == std::string_view::npos ? rest.size() : amp + 1);
+								}
+							}
+
+							for (const auto& [name, value] : parser.headers())
+							{
+								request.add_header(name, value);
+							}
+
+							if (const auto host = parser.header(headers::host); !host.empty())
+							{
+								request.url().host() = host.substr(0, host.rfind(':'));
+							}
+						}
+						catch (...)
+						{
+							fail(500u);
+							return false;
+						}
+
+						return true;
+					}
+
+					void respond() noexcept
+					{
+						auto& request = *this->request;
+						body_in.reset(body_view.empty() ? std::string_view{body} : body_view);
+
+						auto reused = std::move(response_body).str();
+						reused.clear();
+						response_body.str(std::move(reused));
+						body_out.clear();
+
+						http_response response;
+						response.version() = request.version();
+						response.status() = status::http_status{200u, status::ok_message};
+						try
+						{
+							server.router_.dispatch(request, response, body_out);
+						}
+						catch (...)
+						{
+							response.headers().clear();
+							response.status() = status::http_status{500u, status::internal_server_error_message};
+							response_body.str(std::string{});
+						}
+
+						server.requests_.fetch_add(1, std::memory_order_relaxed);
+						keep_alive = parser.keep_alive() &&
+									 ++served < server.options_.max_keep_alive_requests &&
+									 !has_token(find_header(response.headers(), headers::connection), "close");
+
+						body.clear();
+						body_view = {};
+
+						// A response to HEAD has the length its body would have.
+						const auto content = response_body.view();
+						send(response, request.method() == http::head ? std::string_view{} : content, content.size());
+					}
+
+					// Answers a request that could not be parsed, then closes.
+					void fail(unsigned int code) noexcept
+					{
+						keep_alive = false;
+						http_response response;
+						response.version() = http_version::HTTP_1_1;
+						response.status() = status::http_status{code, status::code_to_message.at(code)};
+						send(response, {}, 0);
+					}
+
+					void send(const http_response& response, std::string_view content, std::size_t content_length) noexcept
+					{
+						wait(wait_phase::none);
+						try
+						{
+							write_head(response, content_length);
+						}
+						catch (...)
+						{
+							close();
+							return;
+						}
+
+						out = {net::const_buffer{head.data(), head.size()}, net::const_buffer{content.data(), content.size()}};
+						remaining.emplace(out);
+						start_write();
+					}
+
+					void write_head(const http_response& response, std::size_t content_length)
+					{
+						const auto code = response.status().code;
+						std::array<char, 24> digits;
+
+						head.clear();
+						head += http_version_string(response.version());
+						head += ' ';
+						head.append(digits.data(), std::to_chars(digits.data(), digits.data() + digits.size(), code).ptr);
+						head += ' ';
+						head += response.status().message;
+						head += line_terminator;
+
+						for (const auto& [name, value] : response.headers())
+						{
+							if (equals_ignore_case(name, headers::content_length) || equals_ignore_case(name, headers::connection))
+							{
+								continue;
+							}
+
+							head += name;
+							head += ": ";
+							head += value;
+							head += line_terminator;
+						}
+
+						if (code >= 200 && code != 204 && code != 304)
+						{
+							head += headers::content_length;
+							head += ": ";
+							head.append(digits.data(), std::to_chars(digits.data(), digits.data() + digits.size(), content_length).ptr);
+							head += line_terminator;
+						}
+
+						if (!keep_alive)
+						{
+							head += "Connection: close\r\n";
+						}
+						else if (response.version() == http_version::HTTP_1)
+						{
+							head += "Connection: keep-alive\r\n";
+						}
+
+						head += line_terminator;
+					}
+
+					void start_write() noexcept
+					{
+						std::unique_lock l {m};
+						if (server.stopping_.load(std::memory_order_acquire))
+						{
+							l.unlock();
+							close();
+							return;
+						}
+
+						write_op.emplace(socket.async_write_some(remaining->prepare(std::numeric_limits<std::size_t>::max())),
+										 transfer_receiver<connection, &connection::on_write>{this});
+						cmoon::execution::start(write_op->state);
+					}
+
+					void on_write(std::size_t n) noexcept
+					{
+						remaining->consume(n);
+						if (!remaining->empty())
+						{
+							start_write();
+						}
+						else if (keep_alive)
+						{
+							process();
+						}
+						else
+						{
+							std::error_code ec;
+							socket.shutdown(net::socket_base::shutdown_send, ec);
+							close();
+						}
+					}
+
+					// Destroys the connection, so nothing may touch it after.
+					void close() noexcept
+					{
+						{
+							std::scoped_lock l {m};
+							std::error_code ec;
+							socket.close(ec);
+						}
+
+						server.remove(self);
+					}
+
+					std::optional<operation<read_sender, transfer_receiver<connection, &connection::on_read>>> read_op;
+					std::optional<operation<write_sender, transfer_receiver<connection, &connection::on_write>>> write_op;
+				};
+
+				http_server_options options_;
+				net::io_context ctx_;
+				acceptor_type acceptor_;
+				http_router router_;
+
+				std::optional<net::io_context::work_guard> work_;
+				std::optional<cmoon::executors::static_thread_pool> pool_;
+				std::atomic<bool> stopping_ {false};
+
+				std::mutex accept_m_;
+				std::optional<operation<accept_sender, accept_receiver>> accept_op_;
+				std::optional<operation<backoff_sender, backoff_receiver>> backoff_op_;
+				std::chrono::milliseconds accept_backoff_ {0};
+
+				// Made when the server starts if it has timeouts to enforce,
+				// and otherwise only once accepting first fails.
+				std::optional<cmoon::executors::timer_context> timers_;
+				std::optional<operation<backoff_sender, sweep_receiver>> sweep_op_;
+
+				std::mutex m_;
+				std::list<connection> connections_;
+
+				std::atomic<std::size_t> connections_accepted_ {0};
+				std::atomic<std::size_t> connections_open_ {0};
+				std::atomic<std::size_t> requests_ {0};
+
+				// Called with accept_m_ held.
+				void accept() noexcept
+				{
+					if (stopping_.load(std::memory_order_acquire))
+					{
+						return;
+					}
+
+					accept_op_.emplace(acceptor_.async_accept(ctx_), accept_receiver{this});
+					cmoon::execution::start(accept_op_->state);
+				}
+
+				void accepted(socket_type s) noexcept
+				{
+					// Accept the next connection before serving this one, so
+					// another thread can pick it up.
+					{
+						std::scoped_lock l {accept_m_};
+						accept_backoff_ = std::chrono::milliseconds{0};
+						accept();
+					}
+
+					connection* c;
+					try
+					{
+						std::scoped_lock l {m_};
+						c = std::addressof(connections_.emplace_front(*this, std::move(s)));
+						c->self = connections_.begin();
+					}
+					catch (...)
+					{
+						return;
+					}
+
+					connections_accepted_.fetch_add(1, std::memory_order_relaxed);
+					connections_open_.fetch_add(1, std::memory_order_relaxed);
+					c->start_read();
+				}
+
+				// A connection that went away before it was accepted says
+				// nothing about the listener, so the next accept starts at
+				// once. Running out of descriptors, buffers or memory should
+				// pass, so the next one waits. Anything else means the
+				// listening socket itself is broken, and the server stops
+				// accepting; connections already open are still served.
+				void accept_failed(const std::error_code& ec) noexcept
+				{
+					std::scoped_lock l {accept_m_};
+					if (stopping_.load(std::memory_order_acquire))
+					{
+						return;
+					}
+
+					if (ec == std::errc::connection_aborted ||
+						ec == std::errc::interrupted ||
+						ec == std::errc::resource_unavailable_try_again ||
+						ec == std::errc::operation_would_block ||
+						ec == std::errc::protocol_error)
+					{
+						accept();
+					}
+					else if (ec == std::errc::too_many_files_open ||
+							 ec == std::errc::too_many_files_open_in_system ||
+							 ec == std::errc::no_buffer_space ||
+							 ec == std::errc::not_enough_memory)
+					{
+						accept_backoff_ = std::clamp(accept_backoff_ * 2, min_accept_backoff, max_accept_backoff);
+						try
+						{
+							if (!timers_)
+							{
+								timers_.emplace();
+							}
+
+							backoff_op_.emplace(cmoon::execution::schedule_after(timers_->get_scheduler(), accept_backoff_), backoff_receiver{this});
+							cmoon::execution::start(backoff_op_->state);
+						}
+						catch (...) {}
+					}
+				}
+
+				// How often connection deadlines are checked, or nothing if
+				// neither timeout is set.
+				[[nodiscard]] std::optional<std::chrono::milliseconds> sweep_interval() const noexcept
+				{
+					std::optional<std::chrono::milliseconds> shortest;
+					for (const auto timeout : {options_.idle_timeout, options_.header_timeout})
+					{
+						if (timeout > std::chrono::milliseconds{0})
+						{
+							shortest = std::min(shortest.value_or(timeout), timeout);
+						}
+					}
+
+					if (!shortest)
+					{
+						return {};
+					}
+
+					return std::clamp(*shortest / 4, min_sweep_interval, max_sweep_interval);
+				}
+
+				// Only ever one sweep is pending, started either by start()
+				// or by the sweep before it.
+				void schedule_sweep() noexcept
+				{
+					const auto interval = sweep_interval();
+					if (!interval || stopping_.load(std::memory_order_acquire))
+					{
+						return;
+					}
+
+					try
+					{
+						sweep_op_.emplace(cmoon::execution::schedule_after(timers_->get_scheduler(), *interval), sweep_receiver{this});
+						cmoon::execution::start(sweep_op_->state);
+					}
+					catch (...) {}
+				}
+
+				// Cancels whatever a connection past its deadline is waiting
+				// on, which then fails and closes it. One that is between
+				// operations is caught by a later sweep.
+				void sweep() noexcept
+				{
+					const auto now = clock::now();
+					{
+						std::scoped_lock l {m_};
+						for (auto& c : connections_)
+						{
+							if (c.deadline.load(std::memory_order_relaxed) <= now)
+							{
+								std::scoped_lock cl {c.m};
+								std::error_code ec;
+								c.socket.cancel(ec);
+							}
+						}
+					}
+
+					schedule_sweep();
+				}
+
+				void remove(typename std::list<connection>::iterator it) noexcept
+				{
+					connections_open_.fetch_sub(1, std::memory_order_relaxed);
+					std::scoped_lock l {m_};
+					connections_.erase(it);
+				}
+		};
+
+		using http_server = basic_http_server<net::ip::tcp>;
+	}
+}
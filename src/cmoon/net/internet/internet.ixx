@@ -0,0 +1,2 @@
+export module cmoon.net.internet;
+export import cmoon.net.internet.http_parser;
\ No newline at end of file
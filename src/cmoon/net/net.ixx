@@ -1,2 +1,4 @@
 export module cmoon.net;
-export import cmoon.net.execution;
\ No newline at end of file
+export import cmoon.net.buffers;
+export import cmoon.net.execution;
+export import cmoon.net.internet;
\ No newline at end of file
@@ -40,12 +40,18 @@
 #include <bit>
 #include <span>
 
-#include "cmoon/net/iocontext.hpp"
 #include "cmoon/net/buffers.hpp"
 #include "cmoon/utility.hpp"
 #include "cmoon/platform.hpp"
 #include "cmoon/net/windows_socket_service.hpp"
 
+import cmoon.execution;
+import cmoon.net.buffers;
+
+#if defined(__linux__)
+import cmoon.net.execution.io_context;
+#endif
+
 namespace cmoon
 {
 	namespace net
@@ -58,6 +64,13 @@ namespace cmoon
 		#endif
 		;
 
+		#if !defined(__linux__)
+		// io_context's reactor, and so every asynchronous socket operation,
+		// only exists on Linux. Elsewhere sockets hold a context but only
+		// offer their synchronous operations.
+		class io_context {};
+		#endif
+
 		[[nodiscard]] constexpr uint16_t swap_bytes(uint16_t data) noexcept
 		{
 			return static_cast<uint16_t>(
@@ -1260,7 +1273,7 @@ namespace cmoon
 		}
 
 		template<std::size_t Ext>
-		auto socket_receive(socket_type s, std::span<msgtype, Ext> bufs, int flags, std::error_code& ec) noexcept
+		std::size_t socket_receive(socket_type s, std::span<msgtype, Ext> bufs, int flags, std::error_code& ec) noexcept
 		{
 			clear_last_error();
 			ec.clear();
@@ -1276,13 +1289,14 @@ namespace cmoon
 			#else
 			struct msghdr msg {};
 			msg.msg_iov = bufs.data();
-			msg.msg_iovlen = static_cast<int>(buf.size());
+			msg.msg_iovlen = bufs.size();
 			const auto result = ::recvmsg(s, &msg, flags);
-			if(result != 0)
+			if(result < 0)
 			{
 				ec.assign(get_last_error(), std::generic_category());
+				return 0;
 			}
-			return result;
+			return static_cast<std::size_t>(result);
 			#endif
 		}
 
@@ -1336,16 +1350,31 @@ namespace cmoon
 			#else
 			struct msghdr msg {};
 			msg.msg_iov = bufs.data();
-			msg.msg_iovlen = static_cast<int>(buf.size());
-			const auto result = ::sendmsg(s, &msg, flags);
-			if (result != 0)
+			msg.msg_iovlen = bufs.size();
+			const auto result = ::sendmsg(s, &msg, flags | MSG_NOSIGNAL);
+			if (result < 0)
 			{
 				ec.assign(get_last_error(), std::generic_category());
+				return 0;
 			}
-			return result;
+			return static_cast<std::size_t>(result);
 			#endif
 		}
 
+		// Fills msgs with as much of a buffer sequence as a single vectored
+		// receive or send accepts.
+		template<class Buffer, class BufferSequence>
+		std::span<msgtype> to_msgbufs(const BufferSequence& buffers, std::array<msgtype, max_buffers>& msgs) noexcept
+		{
+			std::size_t count {0};
+			for (const auto& b : consuming_buffers<Buffer, BufferSequence>{buffers}.prepare(std::numeric_limits<std::size_t>::max()))
+			{
+				msgs[count++] = msgbuf{static_cast<msgbuf::pointer_type>(const_cast<void*>(b.data())), static_cast<msgbuf::len_type>(b.size())};
+			}
+
+			return {msgs.data(), count};
+		}
+
 		template<class ElementType, std::size_t Extent>
 		std::size_t socket_send(socket_type s, std::span<const ElementType, Extent> buf, int flags, std::error_code& ec) noexcept
 		{
@@ -1389,12 +1418,20 @@ namespace cmoon
 					: ctx{ctx} {}
 
 				socket_impl(socket_impl&& rhs) noexcept
-					: ctx{rhs.ctx}, sockfd{std::exchange(rhs.sockfd, socket_base::invalid_socket)}, bits{std::exchange(rhs.bits, {})} {}
+					: ctx{rhs.ctx}, sockfd{std::exchange(rhs.sockfd, socket_base::invalid_socket)}, bits{std::exchange(rhs.bits, {})}
+				{
+					#if defined(__linux__)
+						descriptor = std::exchange(rhs.descriptor, nullptr);
+					#endif
+				}
 
 				socket_impl& operator=(socket_impl&& rhs) noexcept
 				{
 					ctx = rhs.ctx;
 					sockfd = std::exchange(rhs.sockfd, socket_base::invalid_socket);
+					#if defined(__linux__)
+						descriptor = std::exchange(rhs.descriptor, nullptr);
+					#endif
 					bits = std::exchange(rhs.bits, {});
 					return *this;
 				}
@@ -1417,6 +1454,7 @@ namespace cmoon
 					if (is_open())
 					{
 						cancel(ec);
+						deregister();
 						if(!ec)
 						{
 							int err;
@@ -1438,9 +1476,41 @@ namespace cmoon
 					}
 				}
 
-				void cancel(std::error_code&) noexcept
+				void cancel(std::error_code& ec) noexcept
+				{
+					#if defined(__linux__)
+						if (descriptor != nullptr)
+						{
+							ctx.get().cancel(*descriptor);
+						}
+					#endif
+
+					ec.clear();
+				}
+
+				#if defined(__linux__)
+				// The socket joins the reactor the first time an asynchronous
+				// operation is started on it, which also makes it non-blocking.
+				[[nodiscard]] io_descriptor& reactor_descriptor()
+				{
+					if (descriptor == nullptr)
+					{
+						descriptor = std::addressof(ctx.get().register_descriptor(sockfd));
+						bits.native_non_blocking = true;
+					}
+
+					return *descriptor;
+				}
+				#endif
+
+				void deregister() noexcept
 				{
-					// TODO
+					#if defined(__linux__)
+						if (descriptor != nullptr)
+						{
+							ctx.get().deregister_descriptor(*std::exchange(descriptor, nullptr));
+						}
+					#endif
 				}
 
 				void non_blocking(bool mode, std::error_code& ec) noexcept
@@ -1499,6 +1569,9 @@ namespace cmoon
 
 				std::reference_wrapper<io_context> ctx;
 				native_handle_type sockfd {socket_base::invalid_socket};
+				#if defined(__linux__)
+				io_descriptor* descriptor {nullptr};
+				#endif
 
 				struct
 				{
@@ -1596,6 +1669,7 @@ namespace cmoon
 				[[nodiscard]] base::native_handle_type release(std::error_code& ec) noexcept
 				{
 					base::cancel(ec);
+					base::deregister();
 					return std::exchange(base::sockfd, socket_base::invalid_socket);
 				}
 
@@ -1949,15 +2023,17 @@ namespace cmoon
 					connect(endpoint, cmoon::throw_on_error("basic_socket::connect"));
 				}
 
-				std::future<void> async_connect(const endpoint_type& endpoint, std::error_code& ec)
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_connect_sender async_connect(const endpoint_type& endpoint)
 				{
-					return std::async(&basic_socket::connect, std::cref(endpoint), std::ref(ec));
-				}
+					if (!is_open())
+					{
+						open(endpoint.protocol());
+					}
 
-				std::future<void> async_connect(const endpoint_type& endpoint)
-				{
-					return std::async(&basic_socket::connect, endpoint);
+					return cmoon::net::async_connect(base::reactor_descriptor(), endpoint.data(), endpoint.size());
 				}
+				#endif
 
 				int wait(wait_type w, std::error_code& ec) noexcept
 				{
@@ -1984,15 +2060,12 @@ namespace cmoon
 					return wait(w, cmoon::throw_on_error("basic_socket::wait"));
 				}
 
-				std::future<int> async_wait(wait_type w, std::error_code& ec)
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_wait_sender async_wait(wait_type w)
 				{
-					return std::async(&basic_socket::wait, w, std::ref(ec));
-				}
-
-				std::future<int> async_wait(wait_type w)
-				{
-					return std::async(&basic_socket::wait, w);
+					return cmoon::net::async_wait(base::reactor_descriptor(), static_cast<short>(w));
 				}
+				#endif
 
 				[[nodiscard]] explicit operator bool() const noexcept
 				{
@@ -2360,40 +2433,36 @@ namespace cmoon
 					return accept(ctx, endpoint, cmoon::throw_on_error{"basic_socket_acceptor::accept"});
 				}
 
-				[[nodiscard]] std::future<socket_type> async_accept(io_context& ctx, endpoint_type& endpoint, std::error_code& ec, const std::launch l = std::launch::async) noexcept
-				{
-					return std::async(l, &basic_socket_acceptor::accept, std::ref(ctx), std::ref(endpoint), std::ref(ec));
-				}
-
-				[[nodiscard]] std::future<socket_type> async_accept(std::error_code& ec, const std::launch l = std::launch::async) noexcept
+				#if defined(__linux__)
+				// Sends the accepted socket, bound to ctx.
+				[[nodiscard]] auto async_accept(io_context& ctx)
 				{
-					return async_accept(cmoon::net::io_context{}, endpoint_type{}, ec, l);
+					return cmoon::execution::then(cmoon::net::async_accept(base::reactor_descriptor()),
+						[&ctx, protocol = base::protocol_](int handle) {
+							return socket_type{ctx, protocol, handle};
+						});
 				}
 
-				[[nodiscard]] std::future<socket_type> async_accept(const std::launch l = std::launch::async)
+				[[nodiscard]] auto async_accept()
 				{
-					return async_accept(cmoon::net::io_context{}, endpoint_type{}, cmoon::throw_on_error{"basic_socket_acceptor::async_accept"}, l);
+					return async_accept(base::ctx.get());
 				}
 
-				[[nodiscard]] std::future<socket_type> async_accept(io_context& ctx, const std::launch l = std::launch::async)
+				// Also fills endpoint with the peer's address once accepted.
+				[[nodiscard]] auto async_accept(io_context& ctx, endpoint_type& endpoint)
 				{
-					return async_accept(ctx, endpoint_type{}, cmoon::throw_on_error{"basic_socket_acceptor::async_accept"}, l);
+					return cmoon::execution::then(async_accept(ctx),
+						[&endpoint](socket_type s) {
+							endpoint = s.remote_endpoint();
+							return s;
+						});
 				}
 
-				[[nodiscard]] std::future<socket_type> async_accept(endpoint_type& endpoint, const std::launch l = std::launch::async)
+				[[nodiscard]] auto async_accept(endpoint_type& endpoint)
 				{
-					return async_acccept(cmoon::net::io_context{}, endpoint, cmoon::throw_on_error{"basic_socket_acceptor::async_accept"}, l);
-				}
-
-				[[nodiscard]] std::future<socket_type> async_accept(endpoint_type& endpoint, std::error_code& ec, const std::launch l = std::launch::async) noexcept
-				{
-					return async_accept(cmoon::net::io_context{}, endpoint, ec, l);
-				}
-
-				[[nodiscard]] std::future<socket_type> async_accept(io_context& ctx, endpoint_type& endpoint, const std::launch l = std::launch::async)
-				{
-					return async_accept(ctx, endpoint, cmoon::throw_on_error{"basic_socket_acceptor::async_accept"}, l);
+					return async_accept(base::ctx.get(), endpoint);
 				}
+				#endif
 
 				void shutdown(shutdown_type what, std::error_code& ec) noexcept
 				{
@@ -2453,10 +2522,17 @@ namespace cmoon
 					}
 				}
 
-				std::future<void> async_connect(const endpoint_type& endpoint, std::error_code& ec, const std::launch l = std::launch::async) noexcept
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_connect_sender async_connect(const endpoint_type& endpoint)
 				{
-					return std::async(l, &basic_socket_acceptor::connect, std::cref(endpoint), std::ref(ec));
+					if (!is_open())
+					{
+						open(endpoint.protocol());
+					}
+
+					return cmoon::net::async_connect(base::reactor_descriptor(), endpoint.data(), endpoint.size());
 				}
+				#endif
 
 				int wait(wait_type w, std::error_code& ec) noexcept
 				{
@@ -2483,15 +2559,12 @@ namespace cmoon
 					return wait(w, cmoon::throw_on_error{"basic_socket::wait"});
 				}
 
-				std::future<int> async_wait(wait_type w, std::error_code& ec, const std::launch l = std::launch::async) noexcept
-				{
-					return std::async(l, &basic_socket_acceptor::wait, w, std::ref(ec));
-				}
-
-				std::future<int> async_wait(wait_type w, const std::launch l = std::launch::async)
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_wait_sender async_wait(wait_type w)
 				{
-					return async_wait(w, cmoon::throw_on_error{"basic_socket::async_wait"}, l);
+					return cmoon::net::async_wait(base::reactor_descriptor(), static_cast<short>(w));
 				}
+				#endif
 
 				[[nodiscard]] explicit operator bool() const noexcept
 				{
@@ -2648,17 +2721,41 @@ namespace cmoon
 					return result;
 				}
 
-				template<class ElementType, std::size_t Extent>
-				std::future<std::size_t> async_receive(std::span<ElementType, Extent> buf, std::error_code& ec, int flags = 0, const std::launch l = std::launch::async) noexcept
+				// Scatters into the whole sequence with one system call.
+				template<class MutableBufferSequence>
+					requires(is_mutable_buffer_sequence_v<MutableBufferSequence>)
+				std::size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec) noexcept
 				{
-					return std::async(l, &basic_stream_socket::receive, buf, std::ref(ec), flags);
+					std::array<msgtype, max_buffers> msgs;
+					return socket_receive(base::native_handle(), to_msgbufs<mutable_buffer>(buffers, msgs), 0, ec);
+				}
+
+				template<class MutableBufferSequence>
+					requires(is_mutable_buffer_sequence_v<MutableBufferSequence>)
+				std::size_t read_some(const MutableBufferSequence& buffers)
+				{
+					return read_some(buffers, cmoon::throw_on_error{"basic_stream_socket::read_some"});
+				}
+
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_read_some_sender async_read_some(const mutable_buffer& buf)
+				{
+					return cmoon::net::async_read_some(base::reactor_descriptor(), buf);
+				}
+
+				template<class MutableBufferSequence>
+					requires(is_mutable_buffer_sequence_v<MutableBufferSequence> && !std::convertible_to<const MutableBufferSequence&, mutable_buffer>)
+				[[nodiscard]] cmoon::net::async_read_some_buffers_sender async_read_some(const MutableBufferSequence& buffers)
+				{
+					return cmoon::net::async_read_some(base::reactor_descriptor(), buffers);
 				}
 
 				template<class ElementType, std::size_t Extent>
-				std::future<std::size_t> async_receive(std::span<ElementType, Extent> buf, int flags = 0, const std::launch l = std::launch::async)
+				[[nodiscard]] cmoon::net::async_read_some_sender async_receive(std::span<ElementType, Extent> buf)
 				{
-					return async_receive(buf, cmoon::throw_on_error{ "basic_stream_socket::async_receive" }, flags, l);
+					return async_read_some(mutable_buffer{buf.data(), buf.size_bytes()});
 				}
+				#endif
 
 				template<class ElementType, std::size_t Extent>
 				std::size_t send(std::span<const ElementType, Extent> buf, std::error_code& ec, int flags = 0) noexcept
@@ -2671,17 +2768,41 @@ namespace cmoon
 					return result;
 				}
 
-				template<class ElementType, std::size_t Extent>
-				std::future<std::size_t> async_send(std::span<const ElementType, Extent> buf, std::error_code& ec, int flags = 0, const std::launch l = std::launch::async) noexcept
+				// Gathers the whole sequence into one system call.
+				template<class ConstBufferSequence>
+					requires(is_const_buffer_sequence_v<ConstBufferSequence>)
+				std::size_t write_some(const ConstBufferSequence& buffers, std::error_code& ec) noexcept
 				{
-					return std::async(l, &basic_stream_socket::send, std::ref(ec), flags);
+					std::array<msgtype, max_buffers> msgs;
+					return socket_send(base::native_handle(), to_msgbufs<const_buffer>(buffers, msgs), 0, ec);
+				}
+
+				template<class ConstBufferSequence>
+					requires(is_const_buffer_sequence_v<ConstBufferSequence>)
+				std::size_t write_some(const ConstBufferSequence& buffers)
+				{
+					return write_some(buffers, cmoon::throw_on_error{"basic_stream_socket::write_some"});
+				}
+
+				#if defined(__linux__)
+				[[nodiscard]] cmoon::net::async_write_some_sender async_write_some(const const_buffer& buf)
+				{
+					return cmoon::net::async_write_some(base::reactor_descriptor(), buf);
+				}
+
+				template<class ConstBufferSequence>
+					requires(is_const_buffer_sequence_v<ConstBufferSequence> && !std::convertible_to<const ConstBufferSequence&, const_buffer>)
+				[[nodiscard]] cmoon::net::async_write_some_buffers_sender async_write_some(const ConstBufferSequence& buffers)
+				{
+					return cmoon::net::async_write_some(base::reactor_descriptor(), buffers);
 				}
 
 				template<class ElementType, std::size_t Extent>
-				std::future<std::size_t> async_send(std::span<const ElementType, Extent> buf, int flags = 0, const std::launch l = std::launch::async)
+				[[nodiscard]] cmoon::net::async_write_some_sender async_send(std::span<const ElementType, Extent> buf)
 				{
-					return async_send(buf, cmoon::throw_on_error{ "basic_stream_socket::async_send" }, flags, l);
+					return async_write_some(const_buffer{buf.data(), buf.size_bytes()});
 				}
+				#endif
 		};
 
 		template<class Protocol>
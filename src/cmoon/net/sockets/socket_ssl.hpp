@@ -243,6 +243,20 @@ namespace cmoon
 				{
 					return ssl;
 				}
+
+				// The negotiated session, which a later connection to the same
+				// server can resume to skip a full handshake. The caller owns
+				// the returned reference.
+				[[nodiscard]] SSL_SESSION* get_session() const noexcept
+				{
+					return SSL_get1_session(ssl);
+				}
+
+				// Must be called before connect().
+				void set_session(SSL_SESSION* session) noexcept
+				{
+					SSL_set_session(ssl, session);
+				}
 			private:
 				ssl_socket_type ssl;
 		};
@@ -1,4 +1,5 @@
 export module cmoon.parallel;
+export import cmoon.simd.instruction_set;
 export import cmoon.simd.fixed_size;
 export import cmoon.simd.scalar;
 export import cmoon.simd.native;
@@ -1,11 +1,634 @@
 export module cmoon.simd.algorithm;
 
+import <cstddef>;
 import <functional>;
 import <type_traits>;
 import <algorithm>;
+import <concepts>;
+import <iterator>;
+import <memory>;
+import <numeric>;
+import <ranges>;
+import <utility>;
 
 import cmoon.simd.simd;
+import cmoon.simd.tag;
+import cmoon.simd.where_expression;
+import cmoon.simd.impl.operations;
 
 namespace cmoon
 {
-}
\ No newline at end of file
+	// The algorithms below walk a contiguous range one native_simd at a
+	// time. Callables are invoked with whole simd objects, so generic
+	// lambdas and the transparent std function objects work as they are;
+	// predicates return a simd_mask. The last, partial block is loaded and
+	// stored under a mask, so nothing outside the range is touched.
+	export
+	template<class R>
+	concept simd_range = std::ranges::contiguous_range<R> &&
+						 std::ranges::sized_range<R> &&
+						 is_simd_v<native_simd<std::ranges::range_value_t<R>>>;
+
+	template<class V>
+	[[nodiscard]] typename V::mask_type first_lanes(std::size_t n) noexcept
+	{
+		using T = typename V::value_type;
+		const V index {[](auto i) { return static_cast<T>(i); }};
+		return index < V{static_cast<T>(n)};
+	}
+
+	// Lanes past n keep fill, which callers set to an element of the range
+	// so that the callable never sees a value the range could not hold.
+	template<class V>
+	[[nodiscard]] V load_first(const typename V::value_type* mem, std::size_t n, V fill) noexcept
+	{
+		where(first_lanes<V>(n), fill).copy_from(mem, element_aligned);
+		return fill;
+	}
+
+	template<class V>
+	void store_first(typename V::value_type* mem, std::size_t n, const V& v) noexcept
+	{
+		where(first_lanes<V>(n), v).copy_to(mem, element_aligned);
+	}
+
+	template<class V, class T, class BinaryOp>
+	[[nodiscard]] T fold_lanes(const V& v, T init, BinaryOp& op)
+	{
+		for (std::size_t i {0}; i < V::size(); ++i)
+		{
+			init = std::invoke(op, init, v[i]);
+		}
+
+		return init;
+	}
+
+	// Folds block(i, count) over the range lane by lane. There must be at
+	// least one whole block; independent accumulators keep the loop from
+	// waiting on the latency of op.
+	template<class Block, class BinaryOp>
+	[[nodiscard]] auto fold_blocks(std::size_t n, Block& block, BinaryOp& op)
+	{
+		using V = std::invoke_result_t<Block&, std::size_t, std::size_t>;
+		constexpr auto w {V::size()};
+
+		V acc {block(0, w)};
+		std::size_t i {w};
+		if (n >= 4 * w)
+		{
+			V acc1 {block(w, w)};
+			V acc2 {block(2 * w, w)};
+			V acc3 {block(3 * w, w)};
+			for (i = 4 * w; i + 4 * w <= n; i += 4 * w)
+			{
+				acc = std::invoke(op, acc, block(i, w));
+				acc1 = std::invoke(op, acc1, block(i + w, w));
+				acc2 = std::invoke(op, acc2, block(i + 2 * w, w));
+				acc3 = std::invoke(op, acc3, block(i + 3 * w, w));
+			}
+
+			acc = std::invoke(op, std::invoke(op, acc, acc1), std::invoke(op, acc2, acc3));
+		}
+
+		for (; i + w <= n; i += w)
+		{
+			acc = std::invoke(op, acc, block(i, w));
+		}
+
+		if (i != n)
+		{
+			where(first_lanes<V>(n - i), acc) = std::invoke(op, acc, block(i, n - i));
+		}
+
+		return acc;
+	}
+
+	template<class R>
+	[[nodiscard]] std::ranges::borrowed_iterator_t<R> iterator_at(R& r, std::size_t i)
+	{
+		if constexpr (std::ranges::borrowed_range<R>)
+		{
+			return std::ranges::begin(r) + static_cast<std::ranges::range_difference_t<R>>(i);
+		}
+		else
+		{
+			return {};
+		}
+	}
+
+	template<class T>
+	[[nodiscard]] auto block_loader(const T* in) noexcept
+	{
+		return [in](std::size_t i, std::size_t count) {
+			using V = native_simd<T>;
+			return count == V::size() ? V{in + i, element_aligned} : load_first(in + i, count, V{in[i]});
+		};
+	}
+
+	export
+	struct simd_minimum
+	{
+		template<class T>
+		[[nodiscard]] T operator()(const T& a, const T& b) const noexcept
+		{
+			if constexpr (is_simd_v<T>)
+			{
+				auto r {a};
+				where(b < a, r) = b;
+				return r;
+			}
+			else
+			{
+				return b < a ? b : a;
+			}
+		}
+	};
+
+	export
+	struct simd_maximum
+	{
+		template<class T>
+		[[nodiscard]] T operator()(const T& a, const T& b) const noexcept
+		{
+			if constexpr (is_simd_v<T>)
+			{
+				auto r {a};
+				where(a < b, r) = b;
+				return r;
+			}
+			else
+			{
+				return a < b ? b : a;
+			}
+		}
+	};
+
+	export
+	template<simd_range R, std::contiguous_iterator O, class F>
+	O transform(R&& r, O out, F f)
+	{
+		using T = std::ranges::range_value_t<R>;
+		using V = native_simd<T>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		const auto o {std::to_address(out)};
+
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			std::invoke(f, V{in + i, element_aligned}).copy_to(o + i, element_aligned);
+		}
+
+		if (i != n)
+		{
+			store_first(o + i, n - i, std::invoke(f, load_first(in + i, n - i, V{in[i]})));
+		}
+
+		return out + static_cast<std::iter_difference_t<O>>(n);
+	}
+
+	// r2 must hold at least as many elements as r1.
+	export
+	template<simd_range R1, simd_range R2, std::contiguous_iterator O, class F>
+	O transform(R1&& r1, R2&& r2, O out, F f)
+	{
+		using V1 = native_simd<std::ranges::range_value_t<R1>>;
+		using V2 = native_simd<std::ranges::range_value_t<R2>>;
+		static_assert(V1::size() == V2::size(), "Both ranges must fill the same number of lanes");
+		constexpr auto w {V1::size()};
+
+		const auto n {std::ranges::size(r1)};
+		const auto in1 {std::ranges::data(r1)};
+		const auto in2 {std::ranges::data(r2)};
+		const auto o {std::to_address(out)};
+
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			std::invoke(f, V1{in1 + i, element_aligned}, V2{in2 + i, element_aligned}).copy_to(o + i, element_aligned);
+		}
+
+		if (i != n)
+		{
+			store_first(o + i, n - i, std::invoke(f, load_first(in1 + i, n - i, V1{in1[i]}),
+													 load_first(in2 + i, n - i, V2{in2[i]})));
+		}
+
+		return out + static_cast<std::iter_difference_t<O>>(n);
+	}
+
+	// op must be associative and commutative, as for std::reduce.
+	export
+	template<simd_range R, class BinaryOp = std::plus<>>
+	[[nodiscard]] std::ranges::range_value_t<R> reduce(R&& r, std::ranges::range_value_t<R> init = {}, BinaryOp op = {})
+	{
+		using T = std::ranges::range_value_t<R>;
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		if (n < native_simd<T>::size())
+		{
+			return std::accumulate(in, in + n, init, op);
+		}
+
+		auto block {block_loader(in)};
+		return fold_lanes(fold_blocks(n, block, op), init, op);
+	}
+
+	export
+	template<simd_range R, class T, class BinaryOp, class UnaryOp>
+	[[nodiscard]] T transform_reduce(R&& r, T init, BinaryOp reduce_op, UnaryOp transform_op)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		if (n < V::size())
+		{
+			for (std::size_t i {0}; i < n; ++i)
+			{
+				init = std::invoke(reduce_op, init, std::invoke(transform_op, in[i]));
+			}
+
+			return init;
+		}
+
+		auto load {block_loader(in)};
+		auto block = [&](std::size_t i, std::size_t count) {
+			return std::invoke(transform_op, load(i, count));
+		};
+
+		return fold_lanes(fold_blocks(n, block, reduce_op), init, reduce_op);
+	}
+
+	// r2 must hold at least as many elements as r1.
+	export
+	template<simd_range R1, simd_range R2, class T, class BinaryOp1, class BinaryOp2>
+	[[nodiscard]] T transform_reduce(R1&& r1, R2&& r2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op)
+	{
+		using V = native_simd<std::ranges::range_value_t<R1>>;
+
+		const auto n {std::ranges::size(r1)};
+		const auto in1 {std::ranges::data(r1)};
+		const auto in2 {std::ranges::data(r2)};
+		if (n < V::size())
+		{
+			for (std::size_t i {0}; i < n; ++i)
+			{
+				init = std::invoke(reduce_op, init, std::invoke(transform_op, in1[i], in2[i]));
+			}
+
+			return init;
+		}
+
+		auto load1 {block_loader(in1)};
+		auto load2 {block_loader(in2)};
+		auto block = [&](std::size_t i, std::size_t count) {
+			return std::invoke(transform_op, load1(i, count), load2(i, count));
+		};
+
+		return fold_lanes(fold_blocks(n, block, reduce_op), init, reduce_op);
+	}
+
+	// The sum of the products of corresponding elements, using fused
+	// multiply-add where the instruction set has it.
+	export
+	template<simd_range R1, simd_range R2>
+		requires(std::same_as<std::ranges::range_value_t<R1>, std::ranges::range_value_t<R2>>)
+	[[nodiscard]] std::ranges::range_value_t<R1> dot(R1&& r1, R2&& r2)
+	{
+		using T = std::ranges::range_value_t<R1>;
+		using V = native_simd<T>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r1)};
+		const auto a {std::ranges::data(r1)};
+		const auto b {std::ranges::data(r2)};
+
+		V acc0 {T{}};
+		V acc1 {T{}};
+		V acc2 {T{}};
+		V acc3 {T{}};
+		std::size_t i {0};
+		for (; i + 4 * w <= n; i += 4 * w)
+		{
+			acc0 = fma(V{a + i, element_aligned}, V{b + i, element_aligned}, acc0);
+			acc1 = fma(V{a + i + w, element_aligned}, V{b + i + w, element_aligned}, acc1);
+			acc2 = fma(V{a + i + 2 * w, element_aligned}, V{b + i + 2 * w, element_aligned}, acc2);
+			acc3 = fma(V{a + i + 3 * w, element_aligned}, V{b + i + 3 * w, element_aligned}, acc3);
+		}
+
+		for (; i + w <= n; i += w)
+		{
+			acc0 = fma(V{a + i, element_aligned}, V{b + i, element_aligned}, acc0);
+		}
+
+		if (i != n)
+		{
+			acc1 = fma(load_first(a + i, n - i, V{T{}}), load_first(b + i, n - i, V{T{}}), acc1);
+		}
+
+		std::plus<> plus;
+		return fold_lanes((acc0 + acc1) + (acc2 + acc3), T{}, plus);
+	}
+
+	// The range must not be empty.
+	export
+	template<simd_range R>
+	[[nodiscard]] std::ranges::range_value_t<R> min(R&& r)
+	{
+		const auto in {std::ranges::data(r)};
+		return cmoon::reduce(r, in[0], simd_minimum{});
+	}
+
+	// The range must not be empty.
+	export
+	template<simd_range R>
+	[[nodiscard]] std::ranges::range_value_t<R> max(R&& r)
+	{
+		const auto in {std::ranges::data(r)};
+		return cmoon::reduce(r, in[0], simd_maximum{});
+	}
+
+	// The range must not be empty. Both bounds come from a single pass.
+	export
+	template<simd_range R>
+	[[nodiscard]] std::ranges::min_max_result<std::ranges::range_value_t<R>> minmax(R&& r)
+	{
+		using T = std::ranges::range_value_t<R>;
+		using V = native_simd<T>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		const simd_minimum minimum;
+		const simd_maximum maximum;
+
+		std::ranges::min_max_result<T> result {in[0], in[0]};
+		if (n < w)
+		{
+			for (std::size_t i {1}; i < n; ++i)
+			{
+				result.min = minimum(result.min, in[i]);
+				result.max = maximum(result.max, in[i]);
+			}
+
+			return result;
+		}
+
+		V lo {in, element_aligned};
+		V hi {lo};
+		std::size_t i {w};
+		for (; i + w <= n; i += w)
+		{
+			const V v {in + i, element_aligned};
+			lo = minimum(lo, v);
+			hi = maximum(hi, v);
+		}
+
+		// Padding lanes repeat an element of the block, which cannot change
+		// either bound.
+		if (i != n)
+		{
+			const auto v {load_first(in + i, n - i, V{in[i]})};
+			lo = minimum(lo, v);
+			hi = maximum(hi, v);
+		}
+
+		for (std::size_t l {0}; l < w; ++l)
+		{
+			result.min = minimum(result.min, std::as_const(lo)[l]);
+			result.max = maximum(result.max, std::as_const(hi)[l]);
+		}
+
+		return result;
+	}
+
+	export
+	template<simd_range R, class Pred>
+	[[nodiscard]] std::ranges::borrowed_iterator_t<R> find_if(R&& r, Pred pred)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			const auto m {std::invoke(pred, V{in + i, element_aligned})};
+			if (any_of(m))
+			{
+				return iterator_at<R>(r, i + static_cast<std::size_t>(find_first_set(m)));
+			}
+		}
+
+		if (i != n)
+		{
+			const auto m {std::invoke(pred, load_first(in + i, n - i, V{in[i]})) && first_lanes<V>(n - i)};
+			if (any_of(m))
+			{
+				return iterator_at<R>(r, i + static_cast<std::size_t>(find_first_set(m)));
+			}
+		}
+
+		return iterator_at<R>(r, n);
+	}
+
+	export
+	template<simd_range R>
+	[[nodiscard]] std::ranges::borrowed_iterator_t<R> find(R&& r, const std::ranges::range_value_t<R>& value)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		const V target {value};
+		return cmoon::find_if(r, [&target](const V& v) { return v == target; });
+	}
+
+	export
+	template<simd_range R, class Pred>
+	[[nodiscard]] std::ranges::range_difference_t<R> count_if(R&& r, Pred pred)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+
+		std::ranges::range_difference_t<R> total {0};
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			total += popcount(std::invoke(pred, V{in + i, element_aligned}));
+		}
+
+		if (i != n)
+		{
+			total += popcount(std::invoke(pred, load_first(in + i, n - i, V{in[i]})) && first_lanes<V>(n - i));
+		}
+
+		return total;
+	}
+
+	export
+	template<simd_range R>
+	[[nodiscard]] std::ranges::range_difference_t<R> count(R&& r, const std::ranges::range_value_t<R>& value)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		const V target {value};
+		return cmoon::count_if(r, [&target](const V& v) { return v == target; });
+	}
+
+	export
+	template<simd_range R, class Pred>
+	[[nodiscard]] bool any_of(R&& r, Pred pred)
+	{
+		return cmoon::find_if(r, std::ref(pred)) != std::ranges::end(r);
+	}
+
+	export
+	template<simd_range R, class Pred>
+	[[nodiscard]] bool none_of(R&& r, Pred pred)
+	{
+		return !cmoon::any_of(r, std::ref(pred));
+	}
+
+	export
+	template<simd_range R, class Pred>
+	[[nodiscard]] bool all_of(R&& r, Pred pred)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		return cmoon::find_if(r, [&pred](const V& v) { return !std::invoke(pred, v); }) == std::ranges::end(r);
+	}
+
+	// Copies the elements that satisfy pred, keeping their order, and
+	// returns the end of what was written. Blocks that match entirely are
+	// stored in one go and blocks that do not match at all are skipped.
+	export
+	template<simd_range R, std::contiguous_iterator O, class Pred>
+	O copy_if(R&& r, O out, Pred pred)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+		constexpr auto w {V::size()};
+
+		const auto n {std::ranges::size(r)};
+		const auto in {std::ranges::data(r)};
+		auto o {std::to_address(out)};
+		const auto first {o};
+
+		// Every lane is written and only the kept ones advance, so a mixed
+		// block costs no mispredicted branches.
+		const auto compact = [&o](const auto* block, const typename V::mask_type& m, std::size_t count) {
+			bool keep[w];
+			m.copy_to(keep, element_aligned);
+
+			typename V::value_type kept[w];
+			std::size_t k {0};
+			for (std::size_t l {0}; l < count; ++l)
+			{
+				kept[k] = block[l];
+				k += keep[l];
+			}
+
+			o = std::copy_n(kept, k, o);
+		};
+
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			const V v {in + i, element_aligned};
+			const auto m {std::invoke(pred, v)};
+			if (all_of(m))
+			{
+				v.copy_to(o, element_aligned);
+				o += w;
+			}
+			else if (any_of(m))
+			{
+				compact(in + i, m, w);
+			}
+		}
+
+		if (i != n)
+		{
+			compact(in + i, std::invoke(pred, load_first(in + i, n - i, V{in[i]})), n - i);
+		}
+
+		return out + static_cast<std::iter_difference_t<O>>(o - first);
+	}
+
+	// A prefix combination within one block, in log2(size()) steps: each
+	// step combines every lane with the one S lanes below it.
+	template<class V, std::size_t S = 1, class BinaryOp>
+	[[nodiscard]] V scan_lanes(V v, BinaryOp& op)
+	{
+		if constexpr (S < V::size())
+		{
+			using physical_type = typename V::physical_type;
+			using ops = simd_abi::simd_operations<typename V::value_type, physical_type, V::size()>;
+
+			const V shifted {ops::template shift_lanes_up<S>(static_cast<physical_type>(v))};
+			where(!first_lanes<V>(S), v) = std::invoke(op, shifted, v);
+			return scan_lanes<V, S * 2>(v, op);
+		}
+		else
+		{
+			return v;
+		}
+	}
+
+	template<class V, class BinaryOp>
+	void scan_blocks(const typename V::value_type* in, typename V::value_type* o, std::size_t n, BinaryOp& op, V carry, bool carrying)
+	{
+		constexpr auto w {V::size()};
+
+		std::size_t i {0};
+		for (; i + w <= n; i += w)
+		{
+			auto v {scan_lanes(V{in + i, element_aligned}, op)};
+			if (carrying)
+			{
+				v = std::invoke(op, carry, v);
+			}
+
+			v.copy_to(o + i, element_aligned);
+			carry = V{std::as_const(v)[w - 1]};
+			carrying = true;
+		}
+
+		if (i != n)
+		{
+			auto v {scan_lanes(load_first(in + i, n - i, V{in[i]}), op)};
+			if (carrying)
+			{
+				v = std::invoke(op, carry, v);
+			}
+
+			store_first(o + i, n - i, v);
+		}
+	}
+
+	// op must be associative, as for std::inclusive_scan.
+	export
+	template<simd_range R, std::contiguous_iterator O, class BinaryOp = std::plus<>>
+	O inclusive_scan(R&& r, O out, BinaryOp op = {})
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+
+		const auto n {std::ranges::size(r)};
+		scan_blocks(std::ranges::data(r), std::to_address(out), n, op, V{}, false);
+		return out + static_cast<std::iter_difference_t<O>>(n);
+	}
+
+	export
+	template<simd_range R, std::contiguous_iterator O, class BinaryOp>
+	O inclusive_scan(R&& r, O out, BinaryOp op, std::ranges::range_value_t<R> init)
+	{
+		using V = native_simd<std::ranges::range_value_t<R>>;
+
+		const auto n {std::ranges::size(r)};
+		scan_blocks(std::ranges::data(r), std::to_address(out), n, op, V{init}, true);
+		return out + static_cast<std::iter_difference_t<O>>(n);
+	}
+}
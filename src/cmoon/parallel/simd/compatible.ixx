@@ -1,34 +1,12 @@
 export module cmoon.simd.compatible;
 
-import <type_traits>;
-import <cstdint>;
-
-import <immintrin.h>;
+import cmoon.simd.instruction_set;
 
 namespace cmoon::simd_abi
 {
-	template<class T>
-	struct compatible_impl;
-
-	template<>
-	struct compatible_impl<std::int8_t> : std::type_identity<__m128i> {};
-
-	template<>
-	struct compatible_impl<std::int16_t> : std::type_identity<__m128i> {};
-
-	template<>
-	struct compatible_impl<std::int32_t> : std::type_identity<__m128i> {};
-
-	template<>
-	struct compatible_impl<std::int64_t> : std::type_identity<__m128i> {};
-
-	template<>
-	struct compatible_impl<float> : std::type_identity<__m128> {};
-
-	template<>
-	struct compatible_impl<double> : std::type_identity<__m128d> {};
-	
+	// At most 256 bits wide, so that code built for AVX-512 and for AVX2
+	// agrees on the layout of compatible<T>.
 	export
 	template<class T>
-	using compatible = typename compatible_impl<T>::type;
-}
\ No newline at end of file
+	using compatible = instruction_set_abi<T, compiled_instruction_set == instruction_set::avx512 ? instruction_set::avx2 : compiled_instruction_set>;
+}
@@ -43,6 +43,54 @@ namespace cmoon::simd_abi
 	template<class... Abis>
 	struct deduce<std::int64_t, 2, Abis...> : std::type_identity<__m128i> {};
 
+	export
+	template<class... Abis>
+	struct deduce<float, 8, Abis...> : std::type_identity<__m256> {};
+
+	export
+	template<class... Abis>
+	struct deduce<double, 4, Abis...> : std::type_identity<__m256d> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int8_t, 32, Abis...> : std::type_identity<__m256i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int16_t, 16, Abis...> : std::type_identity<__m256i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int32_t, 8, Abis...> : std::type_identity<__m256i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int64_t, 4, Abis...> : std::type_identity<__m256i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<float, 16, Abis...> : std::type_identity<__m512> {};
+
+	export
+	template<class... Abis>
+	struct deduce<double, 8, Abis...> : std::type_identity<__m512d> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int8_t, 64, Abis...> : std::type_identity<__m512i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int16_t, 32, Abis...> : std::type_identity<__m512i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int32_t, 16, Abis...> : std::type_identity<__m512i> {};
+
+	export
+	template<class... Abis>
+	struct deduce<std::int64_t, 8, Abis...> : std::type_identity<__m512i> {};
+
 	export
 	template<class T, std::size_t N, class... Abis>
 	using deduce_t = typename deduce<T, N, Abis...>::type;
@@ -1,48 +1,33 @@
 export module cmoon.simd.impl.deduce_physical;
 
 import <cstddef>;
-import <cstdint>;
 import <type_traits>;
 
-import <immintrin.h>;
-
 import cmoon.simd.simd_size;
+import cmoon.simd.instruction_set;
 
 namespace cmoon::simd_abi
 {
+	// The narrowest register that holds N elements of T and that this
+	// translation unit can generate code for.
 	export
 	template<class T, std::size_t N>
 	struct deduce_physical;
 
 	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<float, __m128>)
-	struct deduce_physical<float, N> : std::type_identity<__m128> {};
-
-	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<double, __m128d>)
-	struct deduce_physical<double, N> : std::type_identity<__m128d> {};
-
-	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<std::int8_t, __m128i>)
-	struct deduce_physical<std::int8_t, N> : std::type_identity<__m128i> {};
-
-	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<std::int16_t, __m128i>)
-	struct deduce_physical<std::int16_t, N> : std::type_identity<__m128i> {};
+	template<class T, std::size_t N>
+		requires(N <= simd_size_v<T, sse4<T>>)
+	struct deduce_physical<T, N> : std::type_identity<sse4<T>> {};
 
 	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<std::int32_t, __m128i>)
-	struct deduce_physical<std::int32_t, N> : std::type_identity<__m128i> {};
+	template<class T, std::size_t N>
+		requires(instruction_set_enabled<instruction_set::avx2> && N > simd_size_v<T, sse4<T>> && N <= simd_size_v<T, avx2<T>>)
+	struct deduce_physical<T, N> : std::type_identity<avx2<T>> {};
 
 	export
-	template<std::size_t N>
-		requires(N <= simd_size_v<std::int64_t, __m128i>)
-	struct deduce_physical<std::int64_t, N> : std::type_identity<__m128i> {};
+	template<class T, std::size_t N>
+		requires(instruction_set_enabled<instruction_set::avx512> && N > simd_size_v<T, avx2<T>> && N <= simd_size_v<T, avx512<T>>)
+	struct deduce_physical<T, N> : std::type_identity<avx512<T>> {};
 
 	export
 	template<class T, std::size_t N>
@@ -55,4 +40,4 @@ namespace cmoon::simd_abi
 	{
 		typename deduce_physical<T, N>::type;
 	};
-}
\ No newline at end of file
+}
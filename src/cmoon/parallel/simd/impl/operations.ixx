@@ -6,6 +6,8 @@ import <type_traits>;
 import <cstdint>;
 import <functional>;
 import <limits>;
+import <cstring>;
+import <bit>;
 
 import <immintrin.h>;
 
@@ -18,6 +20,46 @@ import cmoon.simd.tag;
 
 namespace cmoon::simd_abi
 {
+	// Moves the whole register Bytes bytes towards its top, crossing the
+	// 128-bit lanes that the byte shift instructions stay within, and
+	// shifts in zeros.
+	template<std::size_t Bytes>
+	[[nodiscard]] inline __m128i shift_bytes_up(__m128i v) noexcept
+	{
+		return _mm_slli_si128(v, Bytes);
+	}
+
+	template<std::size_t Bytes>
+	[[nodiscard]] inline __m256i shift_bytes_up(__m256i v) noexcept
+	{
+		const auto low_to_high {_mm256_permute2x128_si256(v, v, 0x08)};
+		if constexpr (Bytes < 16)
+		{
+			return _mm256_alignr_epi8(v, low_to_high, 16 - Bytes);
+		}
+		else
+		{
+			return _mm256_slli_si256(low_to_high, Bytes - 16);
+		}
+	}
+
+	template<std::size_t Bytes>
+	[[nodiscard]] inline __m512i shift_bytes_up(__m512i v) noexcept
+	{
+		if constexpr (Bytes % 4 == 0)
+		{
+			return _mm512_alignr_epi32(v, _mm512_setzero_si512(), 16 - Bytes / 4);
+		}
+		else
+		{
+			return _mm512_alignr_epi8(v, _mm512_alignr_epi32(v, _mm512_setzero_si512(), 12), 16 - Bytes);
+		}
+	}
+
+	template<class V>
+	using integer_register = std::conditional_t<sizeof(V) == 16, __m128i,
+							 std::conditional_t<sizeof(V) == 32, __m256i, __m512i>>;
+
 	template<class Derived, class T, class V, std::size_t N>
 	struct simd_operations_base
 	{
@@ -55,23 +97,7 @@ namespace cmoon::simd_abi
 		}
 
 		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load(const value_type* mem, Flag = {}) noexcept
-		{
-			if constexpr (virtual_size() == physical_size())
-			{
-				return Derived::load_all(mem);
-			}
-			else
-			{
-				value_type buf[physical_size()];
-				std::copy_n(mem, virtual_size(), buf);
-				return Derived::load_all(buf);
-			}
-		}
-
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load(const value_type* mem, overaligned_tag<A> f) noexcept
+		[[nodiscard]] inline static physical_type load(const value_type* mem, Flag f = {}) noexcept
 		{
 			if constexpr (virtual_size() == physical_size())
 			{
@@ -79,30 +105,14 @@ namespace cmoon::simd_abi
 			}
 			else
 			{
-				alignas(A) value_type buf[physical_size()];
+				alignas(physical_type) value_type buf[physical_size()];
 				std::copy_n(mem, virtual_size(), buf);
-				return Derived::load_all(buf, f);
+				return Derived::load_all(buf, vector_aligned);
 			}
 		}
 
 		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store(value_type* buf, physical_type v, Flag = {}) noexcept
-		{
-			if constexpr (virtual_size() == physical_size())
-			{
-				Derived::store_all(buf, v);
-			}
-			else
-			{
-				value_type buf2[physical_size()];
-				Derived::store_all(buf2, v);
-				std::copy_n(buf2, virtual_size(), buf);
-			}
-		}
-
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store(value_type* buf, physical_type v, overaligned_tag<A> f) noexcept
+		inline static void store(value_type* buf, physical_type v, Flag f = {}) noexcept
 		{
 			if constexpr (virtual_size() == physical_size())
 			{
@@ -110,43 +120,43 @@ namespace cmoon::simd_abi
 			}
 			else
 			{
-				alignas(A) value_type buf2[physical_size()];
-				Derived::store_all(buf2, v, f);
+				alignas(physical_type) value_type buf2[physical_size()];
+				Derived::store_all(buf2, v, vector_aligned);
 				std::copy_n(buf2, virtual_size(), buf);
 			}
 		}
 
 		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
 		{
-			value_type buf[physical_size()];
-			Derived::store_all(buf, v);
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, v, vector_aligned);
 			return buf[i];
 		}
 
 		template<class F>
 		[[nodiscard]] inline static physical_type transform(physical_type v1, physical_type v2, F&& f) noexcept
 		{
-			value_type buf1[physical_size()];
-			value_type buf2[physical_size()];
+			alignas(physical_type) value_type buf1[physical_size()];
+			alignas(physical_type) value_type buf2[physical_size()];
 
-			Derived::store_all(buf1, v1);
-			Derived::store_all(buf2, v2);
+			Derived::store_all(buf1, v1, vector_aligned);
+			Derived::store_all(buf2, v2, vector_aligned);
 
 			std::ranges::transform(buf1, buf2, buf2, std::forward<F>(f));
 
-			return Derived::load_all(buf2);
+			return Derived::load_all(buf2, vector_aligned);
 		}
 
 		template<class F>
 		[[nodiscard]] inline static physical_type transform(physical_type v1, F&& f) noexcept
 		{
-			value_type buf1[physical_size()];
+			alignas(physical_type) value_type buf1[physical_size()];
 
-			Derived::store_all(buf1, v1);
+			Derived::store_all(buf1, v1, vector_aligned);
 
 			std::ranges::transform(buf1, buf1, std::forward<F>(f));
 
-			return Derived::load_all(buf1);
+			return Derived::load_all(buf1, vector_aligned);
 		}
 
 		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
@@ -169,6 +179,11 @@ namespace cmoon::simd_abi
 			return transform(v1, v2, std::modulus<value_type>{});
 		}
 
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			return Derived::plus(Derived::multiply(v1, v2), v3);
+		}
+
 		[[nodiscard]] inline static physical_type logical_and(physical_type v1, physical_type v2) noexcept
 		{
 			return transform(v1, v2, std::logical_and<value_type>{});
@@ -216,12 +231,12 @@ namespace cmoon::simd_abi
 
 		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
 		{
-			transform(v1, v2, std::equal_to<value_type>{});
+			return transform(v1, v2, std::equal_to<value_type>{});
 		}
 
-		[[nodiscard]] inline static physical_type neq(physical_type v1, physical_type v2) noexcept
+		[[nodiscard]] inline static auto neq(physical_type v1, physical_type v2) noexcept
 		{
-			return Derived::logical_not(Derived::eq(v1, v2));
+			return Derived::mask_not(Derived::eq(v1, v2));
 		}
 
 		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
@@ -229,20 +244,153 @@ namespace cmoon::simd_abi
 			return transform(v1, v2, std::less<value_type>{});
 		}
 
-		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		[[nodiscard]] inline static auto gt(physical_type v1, physical_type v2) noexcept
 		{
-			return lt(v2, v1);
+			return Derived::lt(v2, v1);
 		}
 
-		[[nodiscard]] inline static physical_type le(physical_type v1, physical_type v2) noexcept
+		[[nodiscard]] inline static auto le(physical_type v1, physical_type v2) noexcept
 		{
-			return logical_not(lt(v2, v1));
+			return Derived::mask_not(Derived::lt(v2, v1));
 		}
 
-		[[nodiscard]] inline static physical_type ge(physical_type v1, physical_type v2) noexcept
+		[[nodiscard]] inline static auto ge(physical_type v1, physical_type v2) noexcept
+		{
+			return Derived::mask_not(Derived::lt(v1, v2));
+		}
+
+		// Masks are vectors whose lanes are all ones or all zeros, unless a
+		// specialization keeps them in mask registers and says so with its
+		// own mask_type.
+		using mask_type = physical_type;
+
+		[[nodiscard]] inline static physical_type all_ones() noexcept
+		{
+			const auto z {Derived::zero()};
+			return Derived::eq(z, z);
+		}
+
+		[[nodiscard]] inline static physical_type mask_broadcast(bool b) noexcept
+		{
+			return b ? Derived::all_ones() : Derived::zero();
+		}
+
+		[[nodiscard]] inline static bool mask_get(physical_type m, std::size_t i) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, m, vector_aligned);
+			return std::bit_cast<lane_bits>(buf[i]) != 0;
+		}
+
+		[[nodiscard]] inline static physical_type mask_set(physical_type m, std::size_t i, bool b) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, m, vector_aligned);
+			std::memset(buf + i, b ? 0xFF : 0, sizeof(value_type));
+			return Derived::load_all(buf, vector_aligned);
+		}
+
+		[[nodiscard]] inline static physical_type mask_and(physical_type m1, physical_type m2) noexcept
+		{
+			return Derived::bit_and(m1, m2);
+		}
+
+		[[nodiscard]] inline static physical_type mask_or(physical_type m1, physical_type m2) noexcept
+		{
+			return Derived::bit_or(m1, m2);
+		}
+
+		[[nodiscard]] inline static physical_type mask_xor(physical_type m1, physical_type m2) noexcept
 		{
-			return logical_not(lt(v1, v2));
+			return Derived::bit_xor(m1, m2);
 		}
+
+		[[nodiscard]] inline static physical_type mask_not(physical_type m) noexcept
+		{
+			return Derived::bit_xor(m, Derived::all_ones());
+		}
+
+		// Bit i is set when lane i is; lanes past virtual_size() are included.
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, m, vector_aligned);
+
+			std::uint64_t bits {0};
+			for (std::size_t i {0}; i < physical_size(); ++i)
+			{
+				if (std::bit_cast<lane_bits>(buf[i]) != 0)
+				{
+					bits |= std::uint64_t{1} << i;
+				}
+			}
+
+			return bits;
+		}
+
+		// Lanes of if_true where m is set, of if_false elsewhere.
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return Derived::bit_xor(if_false, Derived::bit_and(m, Derived::bit_xor(if_true, if_false)));
+		}
+
+		// Only the lanes set in m are read from or written to memory.
+		[[nodiscard]] inline static physical_type masked_load(physical_type m, physical_type src, const value_type* mem) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, src, vector_aligned);
+			const auto bits {Derived::mask_bits(m)};
+			for (std::size_t i {0}; i < virtual_size(); ++i)
+			{
+				if (bits & (std::uint64_t{1} << i))
+				{
+					buf[i] = mem[i];
+				}
+			}
+
+			return Derived::load_all(buf, vector_aligned);
+		}
+
+		inline static void masked_store(physical_type m, value_type* mem, physical_type v) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, v, vector_aligned);
+			const auto bits {Derived::mask_bits(m)};
+			for (std::size_t i {0}; i < virtual_size(); ++i)
+			{
+				if (bits & (std::uint64_t{1} << i))
+				{
+					mem[i] = buf[i];
+				}
+			}
+		}
+
+		// The first n elements of mem, zeros after.
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()] {};
+			std::copy_n(mem, std::min(n, virtual_size()), buf);
+			return Derived::load_all(buf, vector_aligned);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			alignas(physical_type) value_type buf[physical_size()];
+			Derived::store_all(buf, v, vector_aligned);
+			std::copy_n(buf, std::min(n, virtual_size()), mem);
+		}
+
+		// Lane i + S gets lane i, and the bottom S lanes get zero.
+		template<std::size_t S>
+			requires(S < N)
+		[[nodiscard]] inline static physical_type shift_lanes_up(physical_type v) noexcept
+		{
+			return std::bit_cast<physical_type>(shift_bytes_up<S * sizeof(value_type)>(std::bit_cast<integer_register<physical_type>>(v)));
+		}
+		private:
+			using lane_bits = std::conditional_t<sizeof(value_type) == 1, std::uint8_t,
+							  std::conditional_t<sizeof(value_type) == 2, std::uint16_t,
+							  std::conditional_t<sizeof(value_type) == 4, std::uint32_t, std::uint64_t>>>;
 	};
 
 	export
@@ -369,15 +517,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
@@ -401,15 +548,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, [[maybe_unused]] Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_si128(reinterpret_cast<const __m128i*>(mem));
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mem));
 		}
@@ -456,6 +602,16 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpgt_epi8(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_epi8(if_false, if_true, m);
+		}
 	};
 
 	export
@@ -504,15 +660,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
@@ -536,15 +691,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, [[maybe_unused]] Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_si128(reinterpret_cast<const __m128i*>(mem));
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mem));
 		}
@@ -583,6 +737,16 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpgt_epi16(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128())));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_epi8(if_false, if_true, m);
+		}
 	};
 
 	export
@@ -649,15 +813,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
@@ -681,15 +844,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, [[maybe_unused]] Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_si128(reinterpret_cast<const __m128i*>(mem));
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mem));
 		}
@@ -728,6 +890,16 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpgt_epi32(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_epi8(if_false, if_true, m);
+		}
 	};
 
 	export
@@ -768,29 +940,25 @@ namespace cmoon::simd_abi
 			requires(sizeof...(Args) == base::virtual_size())
 		[[nodiscard]] inline static physical_type set(Args... args) noexcept
 		{
+			const value_type values[] {static_cast<value_type>(args)...};
 			if constexpr (base::virtual_size() == base::physical_size())
 			{
-				return _mm_setr_epi64(args...);
+				return _mm_set_epi64x(values[1], values[0]);
 			}
 			else
 			{
-				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
-
-				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
-					return _mm_setr_epi64(args..., Zeros...);
-				}(extra_args{});
+				return _mm_set_epi64x(0, values[0]);
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), v);
 		}
@@ -814,15 +982,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, [[maybe_unused]] Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_si128(reinterpret_cast<const __m128i*>(mem));
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mem));
 		}
@@ -869,6 +1036,16 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpgt_epi64(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_epi8(if_false, if_true, m);
+		}
 	};
 
 	export
@@ -915,15 +1092,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_ps(buf, v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_ps(buf, v);
 		}
@@ -952,15 +1128,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_ps(mem);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_ps(mem);
 		}
@@ -985,6 +1160,15 @@ namespace cmoon::simd_abi
 			return _mm_div_ps(v1, v2);
 		}
 
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			#if defined(__FMA__) || defined(__AVX2__)
+			return _mm_fmadd_ps(v1, v2, v3);
+			#else
+			return _mm_add_ps(_mm_mul_ps(v1, v2), v3);
+			#endif
+		}
+
 		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
 		{
 			return _mm_and_ps(v1, v2);
@@ -1029,6 +1213,16 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpge_ps(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_ps(m));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_ps(if_false, if_true, m);
+		}
 	};
 
 	export
@@ -1063,27 +1257,26 @@ namespace cmoon::simd_abi
 		{
 			if constexpr (base::virtual_size() == base::physical_size())
 			{
-				return _mm_set_pd(args...);
+				return _mm_setr_pd(args...);
 			}
 			else
 			{
 				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
 
 				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
-					return _mm_set_pd(args..., Zeros...);
+					return _mm_setr_pd(args..., Zeros...);
 				}(extra_args{});
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		inline static void store_all(value_type* buf, physical_type v, [[maybe_unused]] Flag = {}) noexcept
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
 		{
 			_mm_store_pd(buf, v);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		inline static void store_all(value_type* buf, physical_type v, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
 		{
 			_mm_storeu_pd(buf, v);
 		}
@@ -1107,15 +1300,14 @@ namespace cmoon::simd_abi
 			}
 		}
 
-		template<simd_flag_type Flag = element_aligned_tag>
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
 		{
 			return _mm_load_pd(mem);
 		}
 
-		template<std::size_t A>
-			requires(A != alignof(value_type))
-		[[nodiscard]] inline static physical_type load_all(const value_type* mem, overaligned_tag<A>) noexcept
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
 		{
 			return _mm_loadu_pd(mem);
 		}
@@ -1140,6 +1332,15 @@ namespace cmoon::simd_abi
 			return _mm_div_pd(v1, v2);
 		}
 
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			#if defined(__FMA__) || defined(__AVX2__)
+			return _mm_fmadd_pd(v1, v2, v3);
+			#else
+			return _mm_add_pd(_mm_mul_pd(v1, v2), v3);
+			#endif
+		}
+
 		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
 		{
 			return _mm_and_pd(v1, v2);
@@ -1184,6 +1385,2081 @@ namespace cmoon::simd_abi
 		{
 			return _mm_cmpge_pd(v1, v2);
 		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm_movemask_pd(m));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm_blendv_pd(if_false, if_true, m);
+		}
+	};
+
+	struct simd_m256i_operations
+	{
+		[[nodiscard]] inline static __m256i zero() noexcept
+		{
+			return _mm256_setzero_si256();
+		}
+
+		[[nodiscard]] inline static __m256i bit_and(__m256i v1, __m256i v2) noexcept
+		{
+			return _mm256_and_si256(v1, v2);
+		}
+
+		[[nodiscard]] inline static __m256i bit_or(__m256i v1, __m256i v2) noexcept
+		{
+			return _mm256_or_si256(v1, v2);
+		}
+
+		[[nodiscard]] inline static __m256i bit_xor(__m256i v1, __m256i v2) noexcept
+		{
+			return _mm256_xor_si256(v1, v2);
+		}
+
+		[[nodiscard]] inline static __m256i select(__m256i m, __m256i if_true, __m256i if_false) noexcept
+		{
+			return _mm256_blendv_epi8(if_false, if_true, m);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int8_t, __m256i, N> : public simd_m256i_operations, simd_operations_base<simd_operations<std::int8_t, __m256i, N>, std::int8_t, __m256i, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<std::int8_t, __m256i, N>, std::int8_t, __m256i, N>;
+		public:
+		using value_type = std::int8_t;
+		using physical_type = __m256i;
+
+		using simd_m256i_operations::zero;
+		using simd_m256i_operations::bit_and;
+		using simd_m256i_operations::bit_or;
+		using simd_m256i_operations::bit_xor;
+		using simd_m256i_operations::select;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_epi8(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_epi8(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_epi8(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return static_cast<value_type>(_mm256_extract_epi8(v, static_cast<int>(I)));
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return get<0>(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			const auto even {_mm256_mullo_epi16(v1, v2)};
+			const auto odd {_mm256_mullo_epi16(_mm256_srli_epi16(v1, 8), _mm256_srli_epi16(v2, 8))};
+
+			return _mm256_or_si256(_mm256_slli_epi16(odd, 8),
+								   _mm256_and_si256(even, _mm256_set1_epi16(0x00FF)));
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpeq_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return gt(v2, v1);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpgt_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int16_t, __m256i, N> : public simd_m256i_operations, simd_operations_base<simd_operations<std::int16_t, __m256i, N>, std::int16_t, __m256i, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<std::int16_t, __m256i, N>, std::int16_t, __m256i, N>;
+		public:
+		using value_type = std::int16_t;
+		using physical_type = __m256i;
+
+		using simd_m256i_operations::zero;
+		using simd_m256i_operations::bit_and;
+		using simd_m256i_operations::bit_or;
+		using simd_m256i_operations::bit_xor;
+		using simd_m256i_operations::select;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_epi16(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_epi16(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_epi16(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return static_cast<value_type>(_mm256_extract_epi16(v, static_cast<int>(I)));
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return get<0>(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_mullo_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpeq_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return gt(v2, v1);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpgt_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			const auto bytes {static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(m, _mm256_setzero_si256())))};
+			return (bytes & 0xFF) | ((bytes >> 8) & 0xFF00);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int32_t, __m256i, N> : public simd_m256i_operations, simd_operations_base<simd_operations<std::int32_t, __m256i, N>, std::int32_t, __m256i, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<std::int32_t, __m256i, N>, std::int32_t, __m256i, N>;
+		public:
+		using value_type = std::int32_t;
+		using physical_type = __m256i;
+
+		using simd_m256i_operations::zero;
+		using simd_m256i_operations::bit_and;
+		using simd_m256i_operations::bit_or;
+		using simd_m256i_operations::bit_xor;
+		using simd_m256i_operations::select;
+
+		template<std::same_as<float>>
+		[[nodiscard]] inline static physical_type convert(__m256 v) noexcept
+		{
+			return _mm256_cvtps_epi32(v);
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_epi32(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_epi32(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_epi32(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return static_cast<value_type>(_mm256_extract_epi32(v, static_cast<int>(I)));
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return get<0>(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_mullo_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpeq_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return gt(v2, v1);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpgt_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(physical_type m, physical_type src, const value_type* mem) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_blendv_epi8(src, _mm256_maskload_epi32(reinterpret_cast<const int*>(mem), m), m);
+			}
+			else
+			{
+				return base::masked_load(m, src, mem);
+			}
+		}
+
+		inline static void masked_store(physical_type m, value_type* mem, physical_type v) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				_mm256_maskstore_epi32(reinterpret_cast<int*>(mem), m, v);
+			}
+			else
+			{
+				base::masked_store(m, mem, v);
+			}
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int64_t, __m256i, N> : public simd_m256i_operations, simd_operations_base<simd_operations<std::int64_t, __m256i, N>, std::int64_t, __m256i, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<std::int64_t, __m256i, N>, std::int64_t, __m256i, N>;
+		public:
+		using value_type = std::int64_t;
+		using physical_type = __m256i;
+
+		using simd_m256i_operations::zero;
+		using simd_m256i_operations::bit_and;
+		using simd_m256i_operations::bit_or;
+		using simd_m256i_operations::bit_xor;
+		using simd_m256i_operations::select;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_epi64x(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_epi64x(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_epi64x(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return static_cast<value_type>(_mm256_extract_epi64(v, static_cast<int>(I)));
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return get<0>(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mem));
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			const auto ac {_mm256_mul_epu32(v1, v2)};
+			const auto b {_mm256_srli_epi64(v1, 32)};
+			const auto bc {_mm256_mul_epu32(b, v2)};
+			const auto d {_mm256_srli_epi64(v2, 32)};
+			const auto ad {_mm256_mul_epu32(v1, d)};
+			const auto high {_mm256_slli_epi64(_mm256_add_epi64(bc, ad),
+											   32)};
+
+			return _mm256_add_epi64(high, ac);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpeq_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return gt(v2, v1);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmpgt_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(physical_type m, physical_type src, const value_type* mem) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_blendv_epi8(src, _mm256_maskload_epi64(reinterpret_cast<const long long*>(mem), m), m);
+			}
+			else
+			{
+				return base::masked_load(m, src, mem);
+			}
+		}
+
+		inline static void masked_store(physical_type m, value_type* mem, physical_type v) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				_mm256_maskstore_epi64(reinterpret_cast<long long*>(mem), m, v);
+			}
+			else
+			{
+				base::masked_store(m, mem, v);
+			}
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<float, __m256, N> : public simd_operations_base<simd_operations<float, __m256, N>, float, __m256, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<float, __m256, N>, float, __m256, N>;
+		public:
+		using value_type = float;
+		using physical_type = __m256;
+
+		template<std::same_as<std::int32_t>>
+		[[nodiscard]] inline static physical_type convert(__m256i v) noexcept
+		{
+			return _mm256_cvtepi32_ps(v);
+		}
+
+		[[nodiscard]] inline static physical_type zero() noexcept
+		{
+			return _mm256_setzero_ps();
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_ps(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_ps(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_ps(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_ps(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_ps(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return _mm256_cvtss_f32(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_ps(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_ps(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_mul_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			#if defined(__FMA__) || defined(__AVX2__)
+			return _mm256_fmadd_ps(v1, v2, v3);
+			#else
+			return _mm256_add_ps(_mm256_mul_ps(v1, v2), v3);
+			#endif
+		}
+
+		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_and_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_or(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_or_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_xor(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_xor_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_EQ_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_NEQ_UQ);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_LT_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_GT_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_LE_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_ps(v1, v2, _CMP_GE_OQ);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_ps(m));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm256_blendv_ps(if_false, if_true, m);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(physical_type m, physical_type src, const value_type* mem) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_blendv_ps(src, _mm256_maskload_ps(reinterpret_cast<const float*>(mem), _mm256_castps_si256(m)), m);
+			}
+			else
+			{
+				return base::masked_load(m, src, mem);
+			}
+		}
+
+		inline static void masked_store(physical_type m, value_type* mem, physical_type v) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				_mm256_maskstore_ps(reinterpret_cast<float*>(mem), _mm256_castps_si256(m), v);
+			}
+			else
+			{
+				base::masked_store(m, mem, v);
+			}
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<double, __m256d, N> : public simd_operations_base<simd_operations<double, __m256d, N>, double, __m256d, N>
+	{
+		private:
+			using base = simd_operations_base<simd_operations<double, __m256d, N>, double, __m256d, N>;
+		public:
+		using value_type = double;
+		using physical_type = __m256d;
+
+		template<std::same_as<std::int32_t>>
+		[[nodiscard]] inline static physical_type convert(__m128i v) noexcept
+		{
+			return _mm256_cvtepi32_pd(v);
+		}
+
+		[[nodiscard]] inline static physical_type zero() noexcept
+		{
+			return _mm256_setzero_pd();
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm256_set1_pd(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_setr_pd(args...);
+			}
+			else
+			{
+				using extra_args = cmoon::meta::gen_value_list_t<base::physical_size() - base::virtual_size(), value_type(0)>;
+
+				return [=]<auto... Zeros>(cmoon::meta::value_list<Zeros...>) {
+					return _mm256_setr_pd(args..., Zeros...);
+				}(extra_args{});
+			}
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm256_store_pd(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm256_storeu_pd(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return _mm256_cvtsd_f64(v);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm256_load_pd(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm256_loadu_pd(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_add_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_sub_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_mul_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_div_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			#if defined(__FMA__) || defined(__AVX2__)
+			return _mm256_fmadd_pd(v1, v2, v3);
+			#else
+			return _mm256_add_pd(_mm256_mul_pd(v1, v2), v3);
+			#endif
+		}
+
+		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_and_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_or(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_or_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_xor(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_xor_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_EQ_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_NEQ_UQ);
+		}
+
+		[[nodiscard]] inline static physical_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_LT_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_GT_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_LE_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm256_cmp_pd(v1, v2, _CMP_GE_OQ);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(physical_type m) noexcept
+		{
+			return static_cast<std::uint32_t>(_mm256_movemask_pd(m));
+		}
+
+		[[nodiscard]] inline static physical_type select(physical_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm256_blendv_pd(if_false, if_true, m);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(physical_type m, physical_type src, const value_type* mem) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				return _mm256_blendv_pd(src, _mm256_maskload_pd(reinterpret_cast<const double*>(mem), _mm256_castpd_si256(m)), m);
+			}
+			else
+			{
+				return base::masked_load(m, src, mem);
+			}
+		}
+
+		inline static void masked_store(physical_type m, value_type* mem, physical_type v) noexcept
+		{
+			if constexpr (base::virtual_size() == base::physical_size())
+			{
+				_mm256_maskstore_pd(reinterpret_cast<double*>(mem), _mm256_castpd_si256(m), v);
+			}
+			else
+			{
+				base::masked_store(m, mem, v);
+			}
+		}
+	};
+
+	// AVX-512 comparisons produce a bit per lane in a mask register rather
+	// than a vector of lanes.
+	template<class Mask>
+	struct simd_mask_register_operations
+	{
+		using mask_type = Mask;
+
+		[[nodiscard]] inline static constexpr mask_type lanes(std::size_t n) noexcept
+		{
+			return n >= bits_in_type<mask_type> ? static_cast<mask_type>(~mask_type{0}) : static_cast<mask_type>((std::uint64_t{1} << n) - 1);
+		}
+
+		[[nodiscard]] inline static mask_type mask_broadcast(bool b) noexcept
+		{
+			return b ? static_cast<mask_type>(~mask_type{0}) : mask_type{0};
+		}
+
+		[[nodiscard]] inline static bool mask_get(mask_type m, std::size_t i) noexcept
+		{
+			return (m >> i) & 1;
+		}
+
+		[[nodiscard]] inline static mask_type mask_set(mask_type m, std::size_t i, bool b) noexcept
+		{
+			const auto bit {static_cast<mask_type>(std::uint64_t{1} << i)};
+			return b ? static_cast<mask_type>(m | bit) : static_cast<mask_type>(m & ~bit);
+		}
+
+		[[nodiscard]] inline static mask_type mask_and(mask_type m1, mask_type m2) noexcept
+		{
+			return static_cast<mask_type>(m1 & m2);
+		}
+
+		[[nodiscard]] inline static mask_type mask_or(mask_type m1, mask_type m2) noexcept
+		{
+			return static_cast<mask_type>(m1 | m2);
+		}
+
+		[[nodiscard]] inline static mask_type mask_xor(mask_type m1, mask_type m2) noexcept
+		{
+			return static_cast<mask_type>(m1 ^ m2);
+		}
+
+		[[nodiscard]] inline static mask_type mask_not(mask_type m) noexcept
+		{
+			return static_cast<mask_type>(~m);
+		}
+
+		[[nodiscard]] inline static std::uint64_t mask_bits(mask_type m) noexcept
+		{
+			return m;
+		}
+	};
+
+	struct simd_m512i_operations
+	{
+		[[nodiscard]] inline static __m512i zero() noexcept
+		{
+			return _mm512_setzero_si512();
+		}
+
+		[[nodiscard]] inline static __m512i bit_and(__m512i v1, __m512i v2) noexcept
+		{
+			return _mm512_and_si512(v1, v2);
+		}
+
+		[[nodiscard]] inline static __m512i bit_or(__m512i v1, __m512i v2) noexcept
+		{
+			return _mm512_or_si512(v1, v2);
+		}
+
+		[[nodiscard]] inline static __m512i bit_xor(__m512i v1, __m512i v2) noexcept
+		{
+			return _mm512_xor_si512(v1, v2);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int8_t, __m512i, N> : public simd_m512i_operations, simd_mask_register_operations<__mmask64>, simd_operations_base<simd_operations<std::int8_t, __m512i, N>, std::int8_t, __m512i, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask64>;
+			using base = simd_operations_base<simd_operations<std::int8_t, __m512i, N>, std::int8_t, __m512i, N>;
+		public:
+		using value_type = std::int8_t;
+		using physical_type = __m512i;
+
+		using simd_m512i_operations::zero;
+		using simd_m512i_operations::bit_and;
+		using simd_m512i_operations::bit_or;
+		using simd_m512i_operations::bit_xor;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_epi8(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_si512(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_si512(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_si512(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_si512(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			const auto even {_mm512_mullo_epi16(v1, v2)};
+			const auto odd {_mm512_mullo_epi16(_mm512_srli_epi16(v1, 8), _mm512_srli_epi16(v2, 8))};
+
+			return _mm512_mask_blend_epi8(0xAAAAAAAAAAAAAAAA, even, _mm512_slli_epi16(odd, 8));
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_epi8(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpeq_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpneq_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmplt_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpgt_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmple_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpge_epi8_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_epi8(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_epi8(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_epi8(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_epi8(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_epi8(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int16_t, __m512i, N> : public simd_m512i_operations, simd_mask_register_operations<__mmask32>, simd_operations_base<simd_operations<std::int16_t, __m512i, N>, std::int16_t, __m512i, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask32>;
+			using base = simd_operations_base<simd_operations<std::int16_t, __m512i, N>, std::int16_t, __m512i, N>;
+		public:
+		using value_type = std::int16_t;
+		using physical_type = __m512i;
+
+		using simd_m512i_operations::zero;
+		using simd_m512i_operations::bit_and;
+		using simd_m512i_operations::bit_or;
+		using simd_m512i_operations::bit_xor;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_epi16(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_si512(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_si512(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_si512(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_si512(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_mullo_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_epi16(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpeq_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpneq_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmplt_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpgt_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmple_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpge_epi16_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_epi16(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_epi16(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_epi16(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_epi16(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_epi16(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int32_t, __m512i, N> : public simd_m512i_operations, simd_mask_register_operations<__mmask16>, simd_operations_base<simd_operations<std::int32_t, __m512i, N>, std::int32_t, __m512i, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask16>;
+			using base = simd_operations_base<simd_operations<std::int32_t, __m512i, N>, std::int32_t, __m512i, N>;
+		public:
+		using value_type = std::int32_t;
+		using physical_type = __m512i;
+
+		using simd_m512i_operations::zero;
+		using simd_m512i_operations::bit_and;
+		using simd_m512i_operations::bit_or;
+		using simd_m512i_operations::bit_xor;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		template<std::same_as<float>>
+		[[nodiscard]] inline static physical_type convert(__m512 v) noexcept
+		{
+			return _mm512_cvtps_epi32(v);
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_epi32(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_si512(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_si512(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_si512(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_si512(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_mullo_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_epi32(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpeq_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpneq_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmplt_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpgt_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmple_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpge_epi32_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_epi32(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_epi32(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_epi32(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_epi32(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_epi32(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<std::int64_t, __m512i, N> : public simd_m512i_operations, simd_mask_register_operations<__mmask8>, simd_operations_base<simd_operations<std::int64_t, __m512i, N>, std::int64_t, __m512i, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask8>;
+			using base = simd_operations_base<simd_operations<std::int64_t, __m512i, N>, std::int64_t, __m512i, N>;
+		public:
+		using value_type = std::int64_t;
+		using physical_type = __m512i;
+
+		using simd_m512i_operations::zero;
+		using simd_m512i_operations::bit_and;
+		using simd_m512i_operations::bit_or;
+		using simd_m512i_operations::bit_xor;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_epi64(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_si512(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_si512(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_si512(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_si512(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_mullo_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_epi64(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpeq_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpneq_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmplt_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpgt_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmple_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmpge_epi64_mask(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_epi64(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_epi64(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_epi64(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_epi64(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_epi64(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<float, __m512, N> : public simd_mask_register_operations<__mmask16>, simd_operations_base<simd_operations<float, __m512, N>, float, __m512, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask16>;
+			using base = simd_operations_base<simd_operations<float, __m512, N>, float, __m512, N>;
+		public:
+		using value_type = float;
+		using physical_type = __m512;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		template<std::same_as<std::int32_t>>
+		[[nodiscard]] inline static physical_type convert(__m512i v) noexcept
+		{
+			return _mm512_cvtepi32_ps(v);
+		}
+
+		[[nodiscard]] inline static physical_type zero() noexcept
+		{
+			return _mm512_setzero_ps();
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_ps(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_ps(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_ps(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_ps(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_ps(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_mul_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			return _mm512_fmadd_ps(v1, v2, v3);
+		}
+
+		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_and_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_or(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_or_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_xor(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_xor_ps(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_EQ_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_NEQ_UQ);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_LT_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_GT_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_LE_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_ps_mask(v1, v2, _CMP_GE_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_ps(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_ps(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_ps(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_ps(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_ps(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
+	};
+
+	export
+	template<std::size_t N>
+	struct simd_operations<double, __m512d, N> : public simd_mask_register_operations<__mmask8>, simd_operations_base<simd_operations<double, __m512d, N>, double, __m512d, N>
+	{
+		private:
+			using mask_operations = simd_mask_register_operations<__mmask8>;
+			using base = simd_operations_base<simd_operations<double, __m512d, N>, double, __m512d, N>;
+		public:
+		using value_type = double;
+		using physical_type = __m512d;
+
+		using mask_type = typename mask_operations::mask_type;
+		using mask_operations::mask_broadcast;
+		using mask_operations::mask_get;
+		using mask_operations::mask_set;
+		using mask_operations::mask_and;
+		using mask_operations::mask_or;
+		using mask_operations::mask_xor;
+		using mask_operations::mask_not;
+		using mask_operations::mask_bits;
+
+		template<std::same_as<std::int32_t>>
+		[[nodiscard]] inline static physical_type convert(__m256i v) noexcept
+		{
+			return _mm512_cvtepi32_pd(v);
+		}
+
+		[[nodiscard]] inline static physical_type zero() noexcept
+		{
+			return _mm512_setzero_pd();
+		}
+
+		[[nodiscard]] inline static physical_type broadcast(value_type v1) noexcept
+		{
+			return _mm512_set1_pd(v1);
+		}
+
+		template<std::convertible_to<value_type>... Args>
+			requires(sizeof...(Args) == base::virtual_size())
+		[[nodiscard]] inline static physical_type set(Args... args) noexcept
+		{
+			alignas(physical_type) value_type buf[base::physical_size()] {static_cast<value_type>(args)...};
+			return load_all(buf, vector_aligned);
+		}
+
+		inline static void store_all(value_type* buf, physical_type v, vector_aligned_tag) noexcept
+		{
+			_mm512_store_pd(buf, v);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		inline static void store_all(value_type* buf, physical_type v, Flag = {}) noexcept
+		{
+			_mm512_storeu_pd(buf, v);
+		}
+
+		template<std::size_t I>
+			requires(I < base::virtual_size())
+		[[nodiscard]] inline static value_type get(physical_type v) noexcept
+		{
+			return get(v, I);
+		}
+
+		[[nodiscard]] inline static value_type get(physical_type v, std::size_t i) noexcept
+		{
+			if constexpr (base::virtual_size() == 1)
+			{
+				return base::get(v, 0);
+			}
+			else
+			{
+				return base::get(v, i);
+			}
+		}
+
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, vector_aligned_tag) noexcept
+		{
+			return _mm512_load_pd(mem);
+		}
+
+		template<simd_flag_type Flag = element_aligned_tag>
+			requires(!std::same_as<Flag, vector_aligned_tag>)
+		[[nodiscard]] inline static physical_type load_all(const value_type* mem, Flag = {}) noexcept
+		{
+			return _mm512_loadu_pd(mem);
+		}
+
+		[[nodiscard]] inline static physical_type plus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_add_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type minus(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_sub_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type multiply(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_mul_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type divide(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_div_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type fma(physical_type v1, physical_type v2, physical_type v3) noexcept
+		{
+			return _mm512_fmadd_pd(v1, v2, v3);
+		}
+
+		[[nodiscard]] inline static physical_type bit_and(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_and_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_or(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_or_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static physical_type bit_xor(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_xor_pd(v1, v2);
+		}
+
+		[[nodiscard]] inline static mask_type eq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_EQ_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type neq(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_NEQ_UQ);
+		}
+
+		[[nodiscard]] inline static mask_type lt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_LT_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type gt(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_GT_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type le(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_LE_OQ);
+		}
+
+		[[nodiscard]] inline static mask_type ge(physical_type v1, physical_type v2) noexcept
+		{
+			return _mm512_cmp_pd_mask(v1, v2, _CMP_GE_OQ);
+		}
+
+		[[nodiscard]] inline static physical_type select(mask_type m, physical_type if_true, physical_type if_false) noexcept
+		{
+			return _mm512_mask_blend_pd(m, if_false, if_true);
+		}
+
+		[[nodiscard]] inline static physical_type masked_load(mask_type m, physical_type src, const value_type* mem) noexcept
+		{
+			return _mm512_mask_loadu_pd(src, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), mem);
+		}
+
+		inline static void masked_store(mask_type m, value_type* mem, physical_type v) noexcept
+		{
+			_mm512_mask_storeu_pd(mem, static_cast<mask_type>(m & mask_operations::lanes(base::virtual_size())), v);
+		}
+
+		[[nodiscard]] inline static physical_type load_partial(const value_type* mem, std::size_t n) noexcept
+		{
+			return _mm512_maskz_loadu_pd(mask_operations::lanes(std::min(n, base::virtual_size())), mem);
+		}
+
+		inline static void store_partial(value_type* mem, physical_type v, std::size_t n) noexcept
+		{
+			_mm512_mask_storeu_pd(mem, mask_operations::lanes(std::min(n, base::virtual_size())), v);
+		}
 	};
 
 	export
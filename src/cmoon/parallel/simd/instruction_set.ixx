@@ -0,0 +1,208 @@
+module;
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+export module cmoon.simd.instruction_set;
+
+import <cstdint>;
+import <concepts>;
+import <functional>;
+import <utility>;
+import <type_traits>;
+
+import <immintrin.h>;
+
+namespace cmoon::simd_abi
+{
+	// sse4 is the baseline every other ABI assumes. avx2 includes FMA, and
+	// avx512 is the F, BW, DQ and VL subsets.
+	export
+	enum class instruction_set
+	{
+		sse4,
+		avx2,
+		avx512
+	};
+
+	export
+	inline constexpr instruction_set compiled_instruction_set =
+	#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+	instruction_set::avx512
+	#elif defined(__AVX2__)
+	instruction_set::avx2
+	#else
+	instruction_set::sse4
+	#endif
+	;
+
+	// Whether this translation unit can generate code for an instruction
+	// set. MSVC emits any intrinsic whatever /arch is given; other compilers
+	// only those of the target they were told to assume.
+	export
+	template<instruction_set I>
+	inline constexpr bool instruction_set_enabled =
+	#if defined(_MSC_VER) && !defined(__clang__)
+	true
+	#else
+	I <= compiled_instruction_set
+	#endif
+	;
+
+	template<class T>
+	concept vectorizable = std::same_as<T, float> ||
+						   std::same_as<T, double> ||
+						   std::same_as<T, std::int8_t> ||
+						   std::same_as<T, std::int16_t> ||
+						   std::same_as<T, std::int32_t> ||
+						   std::same_as<T, std::int64_t>;
+
+	template<class T, class F, class D, class I>
+	using pick_physical = std::conditional_t<std::same_as<T, float>, F, std::conditional_t<std::same_as<T, double>, D, I>>;
+
+	template<class T, instruction_set I>
+	struct instruction_set_abi_impl;
+
+	template<vectorizable T>
+	struct instruction_set_abi_impl<T, instruction_set::sse4> : std::type_identity<pick_physical<T, __m128, __m128d, __m128i>> {};
+
+	template<vectorizable T>
+	struct instruction_set_abi_impl<T, instruction_set::avx2> : std::type_identity<pick_physical<T, __m256, __m256d, __m256i>> {};
+
+	template<vectorizable T>
+	struct instruction_set_abi_impl<T, instruction_set::avx512> : std::type_identity<pick_physical<T, __m512, __m512d, __m512i>> {};
+
+	export
+	template<class T, instruction_set I>
+	using instruction_set_abi = typename instruction_set_abi_impl<T, I>::type;
+
+	export
+	template<class T>
+	using sse4 = instruction_set_abi<T, instruction_set::sse4>;
+
+	export
+	template<class T>
+	using avx2 = instruction_set_abi<T, instruction_set::avx2>;
+
+	export
+	template<class T>
+	using avx512 = instruction_set_abi<T, instruction_set::avx512>;
+
+	struct cpuid_registers
+	{
+		std::uint32_t eax {0};
+		std::uint32_t ebx {0};
+		std::uint32_t ecx {0};
+		std::uint32_t edx {0};
+	};
+
+	[[nodiscard]] inline cpuid_registers cpuid(std::uint32_t leaf, std::uint32_t subleaf = 0) noexcept
+	{
+		cpuid_registers r;
+		#if defined(_MSC_VER)
+		int info[4];
+		__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+		r = {static_cast<std::uint32_t>(info[0]), static_cast<std::uint32_t>(info[1]), static_cast<std::uint32_t>(info[2]), static_cast<std::uint32_t>(info[3])};
+		#else
+		if (leaf <= __get_cpuid_max(0, nullptr))
+		{
+			__cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+		}
+		#endif
+		return r;
+	}
+
+	// The register state the operating system saves on a context switch.
+	[[nodiscard]] inline std::uint64_t enabled_register_state() noexcept
+	{
+		#if defined(_MSC_VER)
+		return _xgetbv(0);
+		#else
+		std::uint32_t eax;
+		std::uint32_t edx;
+		__asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<std::uint64_t>(edx) << 32) | eax;
+		#endif
+	}
+
+	[[nodiscard]] inline bool has_bits(std::uint64_t value, std::uint64_t bits) noexcept
+	{
+		return (value & bits) == bits;
+	}
+
+	export
+	[[nodiscard]] inline instruction_set detect_instruction_set() noexcept
+	{
+		constexpr std::uint32_t fma {1u << 12};
+		constexpr std::uint32_t osxsave {1u << 27};
+		constexpr std::uint32_t avx {1u << 28};
+		constexpr std::uint32_t avx2_bit {1u << 5};
+		constexpr std::uint32_t avx512_bits {(1u << 16) | (1u << 17) | (1u << 30) | (1u << 31)};
+		constexpr std::uint64_t ymm_state {0x06};
+		constexpr std::uint64_t zmm_state {0xE6};
+
+		const auto features {cpuid(1)};
+		if (!has_bits(features.ecx, fma | osxsave | avx))
+		{
+			return instruction_set::sse4;
+		}
+
+		const auto state {enabled_register_state()};
+		const auto extended {cpuid(7)};
+		if (!has_bits(state, ymm_state) || !has_bits(extended.ebx, avx2_bit))
+		{
+			return instruction_set::sse4;
+		}
+
+		if (!has_bits(state, zmm_state) || !has_bits(extended.ebx, avx512_bits))
+		{
+			return instruction_set::avx2;
+		}
+
+		return instruction_set::avx512;
+	}
+
+	// Detected once, on first use.
+	export
+	[[nodiscard]] inline instruction_set supported_instruction_set() noexcept
+	{
+		static const auto supported {detect_instruction_set()};
+		return supported;
+	}
+
+	export
+	template<instruction_set I>
+	using instruction_set_constant = std::integral_constant<instruction_set, I>;
+
+	// Calls f with the widest instruction_set_constant that both the
+	// processor supports and this translation unit can generate code for,
+	// so a single binary can use simd<T, instruction_set_abi<T, I>> for
+	// the best I at run time. Every instantiation of f must return the
+	// same type.
+	export
+	template<class F>
+	std::invoke_result_t<F, instruction_set_constant<instruction_set::sse4>> simd_dispatch(F&& f)
+	{
+		const auto supported {supported_instruction_set()};
+		if constexpr (instruction_set_enabled<instruction_set::avx512>)
+		{
+			if (supported == instruction_set::avx512)
+			{
+				return std::invoke(std::forward<F>(f), instruction_set_constant<instruction_set::avx512>{});
+			}
+		}
+
+		if constexpr (instruction_set_enabled<instruction_set::avx2>)
+		{
+			if (supported >= instruction_set::avx2)
+			{
+				return std::invoke(std::forward<F>(f), instruction_set_constant<instruction_set::avx2>{});
+			}
+		}
+
+		return std::invoke(std::forward<F>(f), instruction_set_constant<instruction_set::sse4>{});
+	}
+}
@@ -36,6 +36,30 @@ namespace cmoon
 	template<>
 	struct is_abi_tag<__m128d> : std::true_type {};
 
+	export
+	template<>
+	struct is_abi_tag<__m256> : std::true_type {};
+
+	export
+	template<>
+	struct is_abi_tag<__m256i> : std::true_type {};
+
+	export
+	template<>
+	struct is_abi_tag<__m256d> : std::true_type {};
+
+	export
+	template<>
+	struct is_abi_tag<__m512> : std::true_type {};
+
+	export
+	template<>
+	struct is_abi_tag<__m512i> : std::true_type {};
+
+	export
+	template<>
+	struct is_abi_tag<__m512d> : std::true_type {};
+
 	export
 	template<class T>
 	inline constexpr bool is_abi_tag_v = is_abi_tag<T>::value;
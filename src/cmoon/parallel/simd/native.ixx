@@ -1,10 +1,10 @@
 export module cmoon.simd.native;
 
-import cmoon.simd.compatible;
+import cmoon.simd.instruction_set;
 
 namespace cmoon::simd_abi
 {
 	export
 	template<class T>
-	using native = compatible<T>;
-}
\ No newline at end of file
+	using native = instruction_set_abi<T, compiled_instruction_set>;
+}
@@ -5,6 +5,8 @@ import <cstdint>;
 import <concepts>;
 import <utility>;
 import <type_traits>;
+import <bit>;
+import <algorithm>;
 
 import <immintrin.h>;
 
@@ -79,10 +81,10 @@ namespace cmoon
 					template<std::convertible_to<value_type> U>
 					reference_t operator=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] = std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -91,10 +93,10 @@ namespace cmoon
 						requires(cmoon::plus_assignable<value_type, U>)
 					reference_t operator+=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] += std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -103,10 +105,10 @@ namespace cmoon
 						requires(cmoon::minus_assignable<value_type, U>)
 					reference_t operator-=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] -= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -115,10 +117,10 @@ namespace cmoon
 						requires(cmoon::multiply_assignable<value_type, U>)
 					reference_t operator*=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] *= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -127,10 +129,10 @@ namespace cmoon
 						requires(cmoon::divide_assignable<value_type, U>)
 					reference_t operator/=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] /= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -139,10 +141,10 @@ namespace cmoon
 						requires(cmoon::modulus_assignable<value_type, U>)
 					reference_t operator%=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] %= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -151,10 +153,10 @@ namespace cmoon
 						requires(cmoon::bit_or_assignable<value_type, U>)
 					reference_t operator|=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] |= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -163,10 +165,10 @@ namespace cmoon
 						requires(cmoon::bit_and_assignable<value_type, U>)
 					reference_t operator&=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] &= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
@@ -175,74 +177,74 @@ namespace cmoon
 						requires(cmoon::bit_xor_assignable<value_type, U>)
 					reference_t operator^=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						buf[index] ^= std::forward<U>(x);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
 
 					reference_t operator++() && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						++buf[index];
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
 
 					value_type operator++(int) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						const auto tmp {buf[index]++};
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return tmp;
 					}
 
 					reference_t operator--() && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						--buf[index];
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return {*owner, index};
 					}
 
 					value_type operator--(int) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						const auto tmp {buf[index]--};
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 
 						return tmp;
 					}
 
 					void swap(reference_t&& other) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						value_type buf2[op::physical_size()];
+						alignas(physical_type) value_type buf[op::physical_size()];
+						alignas(physical_type) value_type buf2[op::physical_size()];
 
-						op::store_all(buf, owner->v);
-						op::store_all(buf2, other.owner->v);
+						op::store_all(buf, owner->v, vector_aligned);
+						op::store_all(buf2, other.owner->v, vector_aligned);
 
 						std::swap(buf[index], buf2[other.index]);
 
-						owner->v = op::load_all(buf);
-						other.owner->v = op::load_all(buf2);
+						owner->v = op::load_all(buf, vector_aligned);
+						other.owner->v = op::load_all(buf2, vector_aligned);
 					}
 
 					void swap(value_type& a) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
+						alignas(physical_type) value_type buf[op::physical_size()];
+						op::store_all(buf, owner->v, vector_aligned);
 						std::swap(a, buf[index]);
-						owner->v = op::load_all(buf);
+						owner->v = op::load_all(buf, vector_aligned);
 					}
 
 					friend void swap(reference_t&& a, reference_t&& b) noexcept
@@ -325,7 +327,7 @@ namespace cmoon
 			{
 				using other_op = typename simd_abi::fixed_size<size()>::op;
 
-				value_type buf1[op::physical_size()];
+				alignas(physical_type) value_type buf1[op::physical_size()];
 				U buf2[simd<U, other_op::physical_size()>];
 
 				other_op::store_all(buf2, x.v);
@@ -335,7 +337,7 @@ namespace cmoon
 							   buf1,
 							   [](const auto& i) { return static_cast<value_type>(i); });
 
-				v = op::load_all(buf1);
+				v = op::load_all(buf1, vector_aligned);
 			}
 
 			template<std::invocable<std::integral_constant<std::size_t, 0>> G>
@@ -371,12 +373,12 @@ namespace cmoon
 				}
 				else
 				{
-					value_type buf[op::physical_size()];
+					alignas(physical_type) value_type buf[op::physical_size()];
 					std::transform(mem,
 								   mem + size(),
 								   buf,
 								   [](const auto& m) { return static_cast<value_type>(m); });
-					v = op::load_all(buf);
+					v = op::load_all(buf, vector_aligned);
 				}
 			}
 
@@ -389,8 +391,8 @@ namespace cmoon
 				}
 				else
 				{
-					value_type buf[op::physical_size()];
-					op::store_all(buf, v);
+					alignas(physical_type) value_type buf[op::physical_size()];
+					op::store_all(buf, v, vector_aligned);
 					std::transform(buf,
 								   buf + size(),
 								   mem,
@@ -571,6 +573,11 @@ namespace cmoon
 				return lhs >>= n;
 			}
 
+			[[nodiscard]] friend simd fma(const simd& a, const simd& b, const simd& c) noexcept
+			{
+				return simd{op::fma(a.v, b.v, c.v)};
+			}
+
 			[[nodiscard]] friend mask_type operator==(const simd& lhs, const simd& rhs) noexcept
 			{
 				return mask_type{op::eq(lhs.v, rhs.v)};
@@ -630,6 +637,9 @@ namespace cmoon
 		requires(is_simd_v<simd<T, Abi>>)
 	class simd_mask<T, Abi>
 	{
+		template<class T2, class Abi2>
+		friend class simd_mask;
+
 		public:
 			using value_type = bool;
 			using abi_type = Abi;
@@ -643,6 +653,11 @@ namespace cmoon
 			using physical_type = simd_abi::deduce_physical_t<T, size()>;
 		private:
 			using op = cmoon::simd_abi::simd_operations<T, physical_type, size()>;
+		public:
+			// Lanes of all ones or all zeros, or a mask register on AVX-512.
+			using register_type = typename op::mask_type;
+		private:
+			static constexpr std::uint64_t lanes {size() >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << size()) - 1};
 
 			class reference_t
 			{
@@ -652,76 +667,50 @@ namespace cmoon
 
 					[[nodiscard]] operator value_type() const noexcept
 					{
-						return std::as_const(*owner)[index];
+						return op::mask_get(owner->m, index);
 					}
 
 					template<std::convertible_to<value_type> U>
 					reference_t operator=(U&& x) && noexcept
 					{
-						T buf[op::physical_size()];
-						op::store_all(buf, owner->v);
-						buf[index] = std::forward<U>(x);
-						owner->v = op::load_all(buf);
-
+						owner->m = op::mask_set(owner->m, index, static_cast<value_type>(std::forward<U>(x)));
 						return {*owner, index};
 					}
 
-					template<class U>
-						requires(cmoon::bit_or_assignable<value_type, U>)
+					template<std::convertible_to<value_type> U>
 					reference_t operator|=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
-						buf[index] |= std::forward<U>(x);
-						owner->v = op::load_all(buf);
-
-						return {*owner, index};
+						const bool b {*this};
+						return std::move(*this) = b || static_cast<value_type>(std::forward<U>(x));
 					}
 
-					template<class U>
-						requires(cmoon::bit_and_assignable<value_type, U>)
+					template<std::convertible_to<value_type> U>
 					reference_t operator&=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
-						buf[index] &= std::forward<U>(x);
-						owner->v = op::load_all(buf);
-
-						return {*owner, index};
+						const bool b {*this};
+						return std::move(*this) = b && static_cast<value_type>(std::forward<U>(x));
 					}
 
-					template<class U>
-						requires(cmoon::bit_xor_assignable<value_type, U>)
+					template<std::convertible_to<value_type> U>
 					reference_t operator^=(U&& x) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
-						buf[index] ^= std::forward<U>(x);
-						owner->v = op::load_all(buf);
-
-						return {*owner, index};
+						const bool b {*this};
+						return std::move(*this) = b != static_cast<value_type>(std::forward<U>(x));
 					}
 
 					void swap(reference_t&& other) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						value_type buf2[op::physical_size()];
-
-						op::store_all(buf, owner->v);
-						op::store_all(buf2, other.owner->v);
-
-						std::swap(buf[index], buf2[other.index]);
-
-						owner->v = op::load_all(buf);
-						other.owner->v = op::load_all(buf2);
+						const bool a {*this};
+						const bool b {other};
+						std::move(*this) = b;
+						std::move(other) = a;
 					}
 
 					void swap(value_type& a) && noexcept
 					{
-						value_type buf[op::physical_size()];
-						op::store_all(buf, owner->v);
-						std::swap(a, buf[index]);
-						owner->v = op::load_all(buf);
+						const bool b {*this};
+						std::move(*this) = a;
+						a = b;
 					}
 
 					friend void swap(reference_t&& a, reference_t&& b) noexcept
@@ -748,26 +737,6 @@ namespace cmoon
 					{
 						return !(a == b);
 					}
-
-					[[nodiscard]] friend bool operator<(const reference_t& a, const reference_t& b) noexcept
-					{
-						return static_cast<value_type>(a) < static_cast<value_type>(b);
-					}
-
-					[[nodiscard]] friend bool operator>(const reference_t& a, const reference_t& b) noexcept
-					{
-						return b < a;
-					}
-
-					[[nodiscard]] friend bool operator<=(const reference_t& a, const reference_t& b) noexcept
-					{
-						return !(b < a);
-					}
-
-					[[nodiscard]] friend bool operator>=(const reference_t& a, const reference_t& b) noexcept
-					{
-						return !(a < b);
-					}
 				private:
 					reference_t(simd_mask& owner, std::size_t index) noexcept
 						: owner{std::addressof(owner)}, index{index} {}
@@ -784,45 +753,33 @@ namespace cmoon
 
 			simd_mask() noexcept = default;
 
-			simd_mask(physical_type v) noexcept
-				: v{v} {}
+			simd_mask(register_type m) noexcept
+				: m{m} {}
 
 			simd_mask(value_type u) noexcept
-				: v{u} {}
-
-			simd_mask(const simd_mask<value_type, simd_abi::fixed_size<size()>>& x) noexcept
-				: v{static_cast<physical_type>(x)} {}
+				: m{op::mask_broadcast(u)} {}
 
-			template<std::convertible_to<value_type> U>
-				requires(can_simd_convert<op, U, physical_type>)
-			simd_mask(const simd_mask<U, simd_abi::fixed_size<size()>>& x) noexcept
-				: v{op::template convert(static_cast<typename simd_mask<U, simd_abi::fixed_size<size()>>::physical_type>(x))} {}
-
-			template<std::convertible_to<value_type> U>
+			template<class U>
+				requires(is_simd_v<simd<U, simd_abi::fixed_size<size()>>>)
 			simd_mask(const simd_mask<U, simd_abi::fixed_size<size()>>& x) noexcept
+				: m{op::mask_broadcast(false)}
 			{
-				using other_op = typename simd_abi::fixed_size<size()>::op;
-
-				value_type buf1[op::physical_size()];
-				U buf2[simd_mask<U, other_op::physical_size()>];
-
-				other_op::store_all(buf2, static_cast<typename other_op::physical_type>(x.v));
-
-				std::transform(buf2,
-							   buf2 + size(),
-							   buf1,
-							   [](const auto& i) { return static_cast<value_type>(i); });
-
-				v = op::load_all(buf1);
+				const auto bits {x.bits()};
+				for (std::size_t i {0}; i < size(); ++i)
+				{
+					m = op::mask_set(m, i, (bits >> i) & 1);
+				}
 			}
 
 			template<simd_flag_type Flags>
 			simd_mask(const value_type* mem, Flags f) noexcept
-				: v{mem, f} {}
+			{
+				copy_from(mem, f);
+			}
 
-			[[nodiscard]] explicit operator physical_type() const noexcept
+			[[nodiscard]] explicit operator register_type() const noexcept
 			{
-				return static_cast<physical_type>(v);
+				return m;
 			}
 
 			[[nodiscard]] reference operator[](std::size_t i) noexcept
@@ -832,41 +789,49 @@ namespace cmoon
 
 			[[nodiscard]] value_type operator[](std::size_t i) const noexcept
 			{
-				return static_cast<value_type>(v[i]);
+				return op::mask_get(m, i);
 			}
 
 			template<simd_flag_type Flags>
 			void copy_from(const value_type* mem, [[maybe_unused]] Flags f) noexcept
 			{
-				v.copy_from(mem, f);
+				m = op::mask_broadcast(false);
+				for (std::size_t i {0}; i < size(); ++i)
+				{
+					m = op::mask_set(m, i, mem[i]);
+				}
 			}
 
 			template<simd_flag_type Flags>
 			void copy_to(value_type* mem, [[maybe_unused]] Flags f) const noexcept
 			{
-				v.copy_to(mem, f);
+				const auto b {bits()};
+				for (std::size_t i {0}; i < size(); ++i)
+				{
+					mem[i] = (b >> i) & 1;
+				}
 			}
 
 			simd_mask operator!() const noexcept
 			{
-				return simd_mask{op::logical_not(static_cast<physical_type>(v))};
+				return simd_mask{op::mask_not(m)};
 			}
 
 			simd_mask& operator&=(const simd_mask& other) noexcept
 			{
-				v &= other.v;
+				m = op::mask_and(m, other.m);
 				return *this;
 			}
 
 			simd_mask& operator|=(const simd_mask& other) noexcept
 			{
-				v |= other.v;
+				m = op::mask_or(m, other.m);
 				return *this;
 			}
 
 			simd_mask& operator^=(const simd_mask& other) noexcept
 			{
-				v ^= other.v;
+				m = op::mask_xor(m, other.m);
 				return *this;
 			}
 
@@ -897,17 +862,58 @@ namespace cmoon
 
 			friend simd_mask operator==(const simd_mask& lhs, const simd_mask& rhs) noexcept
 			{
-				return op::eq(static_cast<physical_type>(lhs),
-							  static_cast<physical_type>(rhs));
+				return simd_mask{op::mask_not(op::mask_xor(lhs.m, rhs.m))};
 			}
 
 			friend simd_mask operator!=(const simd_mask& lhs, const simd_mask& rhs) noexcept
 			{
-				return op::neq(static_cast<physical_type>(lhs),
-							   static_cast<physical_type>(rhs));
+				return simd_mask{op::mask_xor(lhs.m, rhs.m)};
+			}
+
+			[[nodiscard]] friend bool all_of(const simd_mask& k) noexcept
+			{
+				return k.bits() == lanes;
+			}
+
+			[[nodiscard]] friend bool any_of(const simd_mask& k) noexcept
+			{
+				return k.bits() != 0;
+			}
+
+			[[nodiscard]] friend bool none_of(const simd_mask& k) noexcept
+			{
+				return k.bits() == 0;
+			}
+
+			[[nodiscard]] friend bool some_of(const simd_mask& k) noexcept
+			{
+				const auto b {k.bits()};
+				return b != 0 && b != lanes;
+			}
+
+			[[nodiscard]] friend int popcount(const simd_mask& k) noexcept
+			{
+				return std::popcount(k.bits());
+			}
+
+			// Undefined if no lane is set, as with std::experimental::simd.
+			[[nodiscard]] friend int find_first_set(const simd_mask& k) noexcept
+			{
+				return std::countr_zero(k.bits());
+			}
+
+			[[nodiscard]] friend int find_last_set(const simd_mask& k) noexcept
+			{
+				return 63 - std::countl_zero(k.bits());
 			}
 		private:
-			simd_type v;
+			register_type m;
+
+			// One bit per lane, with padding lanes cleared.
+			[[nodiscard]] std::uint64_t bits() const noexcept
+			{
+				return op::mask_bits(m) & lanes;
+			}
 	};
 
 	export
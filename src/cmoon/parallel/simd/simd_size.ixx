@@ -47,6 +47,54 @@ namespace cmoon::simd_abi
 	template<>
 	struct simd_size<std::int64_t, __m128i> : std::integral_constant<std::size_t, 2> {};
 
+	export
+	template<>
+	struct simd_size<float, __m256> : std::integral_constant<std::size_t, 8> {};
+
+	export
+	template<>
+	struct simd_size<double, __m256d> : std::integral_constant<std::size_t, 4> {};
+
+	export
+	template<>
+	struct simd_size<std::int8_t, __m256i> : std::integral_constant<std::size_t, 32> {};
+
+	export
+	template<>
+	struct simd_size<std::int16_t, __m256i> : std::integral_constant<std::size_t, 16> {};
+
+	export
+	template<>
+	struct simd_size<std::int32_t, __m256i> : std::integral_constant<std::size_t, 8> {};
+
+	export
+	template<>
+	struct simd_size<std::int64_t, __m256i> : std::integral_constant<std::size_t, 4> {};
+
+	export
+	template<>
+	struct simd_size<float, __m512> : std::integral_constant<std::size_t, 16> {};
+
+	export
+	template<>
+	struct simd_size<double, __m512d> : std::integral_constant<std::size_t, 8> {};
+
+	export
+	template<>
+	struct simd_size<std::int8_t, __m512i> : std::integral_constant<std::size_t, 64> {};
+
+	export
+	template<>
+	struct simd_size<std::int16_t, __m512i> : std::integral_constant<std::size_t, 32> {};
+
+	export
+	template<>
+	struct simd_size<std::int32_t, __m512i> : std::integral_constant<std::size_t, 16> {};
+
+	export
+	template<>
+	struct simd_size<std::int64_t, __m512i> : std::integral_constant<std::size_t, 8> {};
+
 	export
 	template<class T, class Abi>
 	inline constexpr auto simd_size_v = simd_size<T, Abi>::value;
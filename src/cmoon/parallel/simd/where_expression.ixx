@@ -1,70 +1,220 @@
 export module cmoon.simd.where_expression;
 
+import <cstddef>;
+import <concepts>;
+import <utility>;
+import <type_traits>;
+
+import cmoon.simd.simd;
+import cmoon.simd.tag;
+import cmoon.simd.impl.operations;
+
 namespace cmoon
 {
 	export
 	template<class M, class T>
 	class const_where_expression
 	{
+		protected:
+			using simd_type = std::remove_const_t<T>;
+			using value_type = typename simd_type::value_type;
+			using physical_type = typename simd_type::physical_type;
+			using register_type = typename M::register_type;
+			using op = simd_abi::simd_operations<value_type, physical_type, simd_type::size()>;
 		public:
+			const_where_expression(const M& mask, T& data) noexcept
+				: mask{mask}, data{data} {}
+
 			const_where_expression(const const_where_expression&) = delete;
 			const_where_expression& operator=(const const_where_expression&) = delete;
 
-			T operator-() const && noexcept;
-			T operator+() const && noexcept;
-			T operator~() const && noexcept;
-
-			template<class U, class Flags>
-			void copy_to(U* mem, Flags f) const &&;
-		private:
+			[[nodiscard]] simd_type operator-() const && noexcept
+			{
+				return blend(-data);
+			}
+
+			[[nodiscard]] simd_type operator+() const && noexcept
+			{
+				return data;
+			}
+
+			[[nodiscard]] simd_type operator~() const && noexcept
+				requires(std::integral<value_type>)
+			{
+				return blend(data ^ simd_type{static_cast<value_type>(~value_type{0})});
+			}
+
+			template<std::convertible_to<value_type> U, simd_flag_type Flags>
+			void copy_to(U* mem, [[maybe_unused]] Flags f) const && noexcept
+			{
+				if constexpr (std::same_as<U, value_type>)
+				{
+					op::masked_store(static_cast<register_type>(mask), mem, static_cast<physical_type>(data));
+				}
+				else
+				{
+					for (std::size_t i {0}; i < simd_type::size(); ++i)
+					{
+						if (mask[i])
+						{
+							mem[i] = static_cast<U>(data[i]);
+						}
+					}
+				}
+			}
+		protected:
 			const M mask;
 			T& data;
+
+			// The lanes of v where the mask is set and of data elsewhere.
+			[[nodiscard]] simd_type blend(const simd_type& v) const noexcept
+			{
+				return simd_type{op::select(static_cast<register_type>(mask),
+											static_cast<physical_type>(v),
+											static_cast<physical_type>(data))};
+			}
 	};
 
 	export
 	template<class M, class T>
 	class where_expression : public const_where_expression<M, T>
 	{
-		public:
-			template<class U>
-			void operator=(U&& x) && noexcept;
-
-			template<class U>
-			void operator+=(U&& x) && noexcept;
-
-			template<class U>
-			void operator-=(U&& x) && noexcept;
-
-			template<class U>
-			void operator*=(U&& x) && noexcept;
-
-			template<class U>
-			void operator/=(U&& x) && noexcept;
+		using base = const_where_expression<M, T>;
+		using typename base::simd_type;
+		using typename base::value_type;
+		using typename base::physical_type;
+		using typename base::register_type;
+		using typename base::op;
 
-			template<class U>
-			void operator%=(U&& x) && noexcept;
-
-			template<class U>
-			void operator&=(U&& x) && noexcept;
-
-			template<class U>
-			void operator|=(U&& x) && noexcept;
-
-			template<class U>
-			void operator^=(U&& x) && noexcept;
+		public:
+			using base::base;
+
+			template<std::convertible_to<simd_type> U>
+			void operator=(U&& x) && noexcept
+			{
+				this->data = this->blend(static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator+=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data + static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator-=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data - static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator*=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data * static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator/=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data / divisor(static_cast<simd_type>(std::forward<U>(x))));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator%=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data % divisor(static_cast<simd_type>(std::forward<U>(x))));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator&=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data & static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator|=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data | static_cast<simd_type>(std::forward<U>(x)));
+			}
+
+			template<std::convertible_to<simd_type> U>
+			void operator^=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data ^ static_cast<simd_type>(std::forward<U>(x)));
+			}
 
 			template<class U>
-			void operator<<=(U&& x) && noexcept;
+			void operator<<=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data << std::forward<U>(x));
+			}
 
 			template<class U>
-			void operator>>=(U&& x) && noexcept;
+			void operator>>=(U&& x) && noexcept
+			{
+				this->data = this->blend(this->data >> std::forward<U>(x));
+			}
+
+			void operator++() && noexcept
+			{
+				this->data = this->blend(this->data + simd_type{value_type{1}});
+			}
+
+			void operator++(int) && noexcept
+			{
+				this->data = this->blend(this->data + simd_type{value_type{1}});
+			}
+
+			void operator--() && noexcept
+			{
+				this->data = this->blend(this->data - simd_type{value_type{1}});
+			}
+
+			void operator--(int) && noexcept
+			{
+				this->data = this->blend(this->data - simd_type{value_type{1}});
+			}
+
+			template<std::convertible_to<value_type> U, simd_flag_type Flags>
+			void copy_from(const U* mem, [[maybe_unused]] Flags f) && noexcept
+			{
+				if constexpr (std::same_as<U, value_type>)
+				{
+					this->data = simd_type{op::masked_load(static_cast<register_type>(this->mask), static_cast<physical_type>(this->data), mem)};
+				}
+				else
+				{
+					for (std::size_t i {0}; i < simd_type::size(); ++i)
+					{
+						if (this->mask[i])
+						{
+							this->data[i] = static_cast<value_type>(mem[i]);
+						}
+					}
+				}
+			}
+		private:
+			// Lanes left out of the expression divide by one rather than by
+			// whatever they happen to hold.
+			[[nodiscard]] simd_type divisor(const simd_type& x) const noexcept
+			{
+				return simd_type{op::select(static_cast<register_type>(this->mask),
+											static_cast<physical_type>(x),
+											static_cast<physical_type>(simd_type{value_type{1}}))};
+			}
+	};
 
-			void operator++() && noexcept;
-			void operator++(int) && noexcept;
-			void operator--() && noexcept;
-			void operator--(int) && noexcept;
+	export
+	template<class T, class Abi>
+	[[nodiscard]] where_expression<simd_mask<T, Abi>, simd<T, Abi>> where(const typename simd<T, Abi>::mask_type& k, simd<T, Abi>& v) noexcept
+	{
+		return {k, v};
+	}
 
-			template<class U, class Flags>
-			void copy_from(const U* mem, Flags) &&;
-	};
-}
\ No newline at end of file
+	export
+	template<class T, class Abi>
+	[[nodiscard]] const_where_expression<simd_mask<T, Abi>, const simd<T, Abi>> where(const typename simd<T, Abi>::mask_type& k, const simd<T, Abi>& v) noexcept
+	{
+		return {k, v};
+	}
+}
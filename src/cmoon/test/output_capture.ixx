@@ -0,0 +1,107 @@
+export module cmoon.test.output_capture;
+
+import <iostream>;
+import <streambuf>;
+import <string>;
+import <utility>;
+import <functional>;
+
+import cmoon.scope;
+
+namespace cmoon::test
+{
+	// While one exists, std::cout, std::cerr and std::clog write into
+	// whichever string the writing thread was given by redirect, and
+	// straight through to where they wrote before otherwise. Only one may
+	// exist at a time.
+	export
+	class output_capture
+	{
+		public:
+			output_capture()
+				: cout_{std::cout.rdbuf()}, cerr_{std::cerr.rdbuf()}, clog_{std::clog.rdbuf()}
+			{
+				std::cout.flush();
+				std::cerr.flush();
+				std::clog.flush();
+				std::cout.rdbuf(&cout_);
+				std::cerr.rdbuf(&cerr_);
+				std::clog.rdbuf(&clog_);
+			}
+
+			output_capture(const output_capture&) = delete;
+			output_capture& operator=(const output_capture&) = delete;
+
+			~output_capture() noexcept
+			{
+				std::cout.rdbuf(cout_.original);
+				std::cerr.rdbuf(cerr_.original);
+				std::clog.rdbuf(clog_.original);
+			}
+
+			// Calls f with everything the calling thread writes to the
+			// standard streams appended to out. Threads f starts are not
+			// captured.
+			template<class F>
+			decltype(auto) redirect(std::string& out, F&& f)
+			{
+				const auto previous {std::exchange(target_, &out)};
+				cmoon::scope_exit restore {[previous] {
+					target_ = previous;
+				}};
+
+				return std::invoke(std::forward<F>(f));
+			}
+		private:
+			struct capture_buf : public std::streambuf
+			{
+				std::streambuf* original;
+
+				explicit capture_buf(std::streambuf* original) noexcept
+					: original{original} {}
+
+				int_type overflow(int_type ch) override
+				{
+					if (traits_type::eq_int_type(ch, traits_type::eof()))
+					{
+						return traits_type::not_eof(ch);
+					}
+
+					if (target_ != nullptr)
+					{
+						target_->push_back(traits_type::to_char_type(ch));
+						return ch;
+					}
+
+					return original != nullptr ? original->sputc(traits_type::to_char_type(ch)) : traits_type::eof();
+				}
+
+				std::streamsize xsputn(const char_type* s, std::streamsize count) override
+				{
+					if (target_ != nullptr)
+					{
+						target_->append(s, static_cast<std::size_t>(count));
+						return count;
+					}
+
+					return original != nullptr ? original->sputn(s, count) : 0;
+				}
+
+				int sync() override
+				{
+					if (target_ != nullptr || original == nullptr)
+					{
+						return 0;
+					}
+
+					return original->pubsync();
+				}
+			};
+
+			static thread_local inline std::string* target_ {nullptr};
+
+			capture_buf cout_;
+			capture_buf cerr_;
+			capture_buf clog_;
+	};
+}
\ No newline at end of file
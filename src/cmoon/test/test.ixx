@@ -4,4 +4,6 @@ export import cmoon.test.assert;
 export import cmoon.test.test_case;
 export import cmoon.test.test_result;
 export import cmoon.test.test_suite;
+export import cmoon.test.test_run_options;
+export import cmoon.test.output_capture;
 export import cmoon.test.text_test_runner;
\ No newline at end of file
@@ -5,6 +5,7 @@ import <stdexcept>;
 import <exception>;
 import <utility>;
 import <memory>;
+import <chrono>;
 
 import cmoon.test.assert_exception;
 import cmoon.test.test_result;
@@ -27,6 +28,7 @@ namespace cmoon::test
 			test_result run()
 			{
 				test_result result;
+				const auto start {std::chrono::steady_clock::now()};
 
 				try
 				{
@@ -47,6 +49,7 @@ namespace cmoon::test
 					result.add_error(std::runtime_error{"Unknown Exception"});
 				}
 
+				result.set_duration(std::chrono::steady_clock::now() - start);
 				return result;
 			}
 
@@ -6,6 +6,8 @@ import <utility>;
 import <memory>;
 import <type_traits>;
 import <ranges>;
+import <chrono>;
+import <string>;
 
 import cmoon.test.assert_exception;
 
@@ -46,8 +48,33 @@ namespace cmoon::test
 			{
 				return passed();
 			}
+
+			void set_duration(std::chrono::nanoseconds duration) noexcept
+			{
+				duration_ = duration;
+			}
+
+			// How long set_up, the test itself and tear_down took together.
+			[[nodiscard]] std::chrono::nanoseconds duration() const noexcept
+			{
+				return duration_;
+			}
+
+			void set_output(std::string output) noexcept
+			{
+				output_ = std::move(output);
+			}
+
+			// What the test wrote to the standard streams, when the runner
+			// captured it.
+			[[nodiscard]] const std::string& output() const noexcept
+			{
+				return output_;
+			}
 		private:
 			std::deque<std::exception> errors_;
 			std::deque<std::exception> failures_;
+			std::chrono::nanoseconds duration_ {0};
+			std::string output_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+export module cmoon.test.test_run_options;
+
+import <cstddef>;
+import <string>;
+import <string_view>;
+import <stdexcept>;
+import <charconv>;
+
+namespace cmoon::test
+{
+	export
+	struct test_run_options
+	{
+		// Threads to run test cases on. 0 uses one per hardware thread.
+		std::size_t threads {0};
+
+		// Only every shard_count'th test case is run, starting from the
+		// shard_index'th, so that shard_count runs together cover the suite
+		// once.
+		std::size_t shard_index {0};
+		std::size_t shard_count {1};
+
+		// How many of the slowest test cases to list after the results.
+		std::size_t slowest {10};
+	};
+
+	[[nodiscard]] std::size_t parse_count(std::string_view flag, std::string_view value)
+	{
+		std::size_t n;
+		const auto [end, ec] {std::from_chars(value.data(), value.data() + value.size(), n)};
+		if (ec != std::errc{} || end != value.data() + value.size())
+		{
+			throw std::invalid_argument{std::string{flag} + " expects a number, got '" + std::string{value} + "'"};
+		}
+
+		return n;
+	}
+
+	// Reads --jobs N (or -j N), --shard i/n and --slowest N from a
+	// program's arguments. Arguments it does not know are left for the
+	// program.
+	export
+	[[nodiscard]] test_run_options parse_test_run_options(int argc, const char* const argv[])
+	{
+		test_run_options options;
+
+		for (int i {1}; i < argc; ++i)
+		{
+			const std::string_view arg {argv[i]};
+			if (arg != "--jobs" && arg != "-j" && arg != "--shard" && arg != "--slowest")
+			{
+				continue;
+			}
+
+			if (i + 1 == argc)
+			{
+				throw std::invalid_argument{std::string{arg} + " expects a value"};
+			}
+
+			const std::string_view value {argv[++i]};
+			if (arg == "--shard")
+			{
+				const auto slash {value.find('/')};
+				if (slash == std::string_view::npos)
+				{
+					throw std::invalid_argument{"--shard expects i/n, got '" + std::string{value} + "'"};
+				}
+
+				options.shard_index = parse_count(arg, value.substr(0, slash));
+				options.shard_count = parse_count(arg, value.substr(slash + 1));
+				if (options.shard_count == 0 || options.shard_index >= options.shard_count)
+				{
+					throw std::invalid_argument{"--shard expects i/n with i < n, got '" + std::string{value} + "'"};
+				}
+			}
+			else if (arg == "--slowest")
+			{
+				options.slowest = parse_count(arg, value);
+			}
+			else
+			{
+				options.threads = parse_count(arg, value);
+			}
+		}
+
+		return options;
+	}
+}
\ No newline at end of file
@@ -8,6 +8,13 @@ import <vector>;
 import <format>;
 import <string_view>;
 import <iterator>;
+import <string>;
+import <thread>;
+import <mutex>;
+import <condition_variable>;
+import <atomic>;
+import <algorithm>;
+import <cstddef>;
 
 import cmoon.utility;
 import cmoon.scope;
@@ -17,6 +24,8 @@ import cmoon.ranges;
 import cmoon.test.test_case;
 import cmoon.test.test_suite;
 import cmoon.test.test_result;
+import cmoon.test.test_run_options;
+import cmoon.test.output_capture;
 
 namespace cmoon::test
 {
@@ -68,42 +77,141 @@ namespace cmoon::test
 			std::vector<test_result> run(test_suite& t_suite)
 			{
 				std::vector<test_result> results;
-				std::size_t num_passed {0};
-				std::size_t num_errored {0};
-				std::size_t num_failed {0};
+				tally counts;
 
-				if (!t_suite.name().empty())
-				{
-					output_ << "Running test suite: ";
-					output_ << t_suite.name();
-					output_ << '\n';
-				}
+				print_suite_name(t_suite);
 				print_header();
 				stopwatch.reset();
 				for (auto t_case : t_suite)
 				{
 					results.push_back(t_case->run());
-					if (!results.back().errors().empty())
+					print_progress(results.back(), counts);
+				}
+				const auto duration {stopwatch.get_elapsed_time()};
+
+				print_report(results, t_suite, counts, duration);
+
+				return results;
+			}
+
+			// Runs the options' shard of the suite on a pool of threads, each
+			// test case with its output captured, and reports it as the
+			// serial run does, in suite order. Failures are followed by what
+			// the test wrote, and the report by the slowest test cases.
+			std::vector<test_result> run(test_suite& t_suite, const test_run_options& options)
+			{
+				std::vector<test_case*> cases;
+				std::size_t index {0};
+				for (auto t_case : t_suite)
+				{
+					if (index++ % options.shard_count == options.shard_index)
 					{
-						num_errored++;
-						output_ << 'E';
+						cases.push_back(t_case);
 					}
-					else if (!results.back().failures().empty())
+				}
+
+				std::vector<test_result> results(std::size(cases));
+				std::vector<bool> finished(std::size(cases));
+				tally counts;
+
+				print_suite_name(t_suite);
+				if (options.shard_count > 1)
+				{
+					output_ << "Running shard " << options.shard_index << '/' << options.shard_count << '\n';
+				}
+				print_header();
+				stopwatch.reset();
+				{
+					output_.flush();
+					output_capture capture;
+					std::mutex finished_mut;
+					std::condition_variable finished_cv;
+					std::atomic<std::size_t> next {0};
+
+					const auto work = [&] {
+						for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < std::size(cases);)
+						{
+							std::string output;
+							auto result {capture.redirect(output, [t_case = cases[i]] { return t_case->run(); })};
+							result.set_output(std::move(output));
+
+							std::lock_guard l {finished_mut};
+							results[i] = std::move(result);
+							finished[i] = true;
+							finished_cv.notify_one();
+						}
+					};
+
+					const auto hardware {std::max(std::thread::hardware_concurrency(), 1u)};
+					const auto count {std::min<std::size_t>(options.threads == 0 ? hardware : options.threads, std::size(cases))};
+					std::vector<std::jthread> workers;
+					workers.reserve(count);
+					for (std::size_t i {0}; i < count; ++i)
 					{
-						num_failed++;
-						output_ << 'F';
+						workers.emplace_back(work);
 					}
-					else
+
+					// Progress is printed in suite order, as far as every test
+					// case up to it has finished.
+					std::unique_lock l {finished_mut};
+					for (std::size_t i {0}; i < std::size(cases); ++i)
 					{
-						num_passed++;
-						output_ << '.';
+						finished_cv.wait(l, [&finished, i] { return finished[i]; });
+						print_progress(results[i], counts);
 					}
 				}
 				const auto duration {stopwatch.get_elapsed_time()};
 
+				print_report(results, cases, counts, duration);
+				print_slowest(results, cases, options.slowest);
+
+				return results;
+			}
+		private:
+			struct tally
+			{
+				std::size_t passed {0};
+				std::size_t errored {0};
+				std::size_t failed {0};
+			};
+
+			void print_suite_name(const test_suite& t_suite)
+			{
+				if (!t_suite.name().empty())
+				{
+					output_ << "Running test suite: ";
+					output_ << t_suite.name();
+					output_ << '\n';
+				}
+			}
+
+			void print_progress(const test_result& result, tally& counts)
+			{
+				if (!result.errors().empty())
+				{
+					counts.errored++;
+					output_ << 'E';
+				}
+				else if (!result.failures().empty())
+				{
+					counts.failed++;
+					output_ << 'F';
+				}
+				else
+				{
+					counts.passed++;
+					output_ << '.';
+				}
+			}
+
+			// Lists each failed test case, with anything it wrote, then the
+			// totals. cases holds the test case of each result.
+			template<class Cases, class Duration>
+			void print_report(const std::vector<test_result>& results, Cases&& cases, const tally& counts, const Duration& duration)
+			{
 				output_ << "\n\n=======================================\n";
 
-				for (const auto& [result, test_case] : cmoon::ranges::views::zip(results, t_suite))
+				for (const auto& [result, test_case] : cmoon::ranges::views::zip(results, cases))
 				{
 					if (!result.passed())
 					{
@@ -111,13 +219,22 @@ namespace cmoon::test
 						output_ << test_case->name();
 						output_ << '\n';
 						print_test_result(result);
+						if (!result.output().empty())
+						{
+							output_ << "Output:\n";
+							output_ << result.output().c_str();
+							if (!result.output().ends_with('\n'))
+							{
+								output_ << '\n';
+							}
+						}
 					}
 				}
 
 				output_ << "=======================================\n";
 				print_footer(duration);
 
-				if (num_passed == std::size(results))
+				if (counts.passed == std::size(results))
 				{
 					output_ << "\nOK!";
 				}
@@ -126,29 +243,27 @@ namespace cmoon::test
 					output_ << "\nFAILED!";
 				}
 
-				if (num_passed != 0)
+				if (counts.passed != 0)
 				{
 					output_ << ' ';
-					output_ << num_passed;
+					output_ << counts.passed;
 					output_ << " passed";
 				}
-				if (num_errored != 0)
+				if (counts.errored != 0)
 				{
 					output_ << ' ';
-					output_ << num_errored;
+					output_ << counts.errored;
 					output_ << " errored";
 				}
-				if (num_failed != 0)
+				if (counts.failed != 0)
 				{
 					output_ << ' ';
-					output_ << num_failed;
+					output_ << counts.failed;
 					output_ << " failed";
 				}
 				output_ << '\n';
-
-				return results;
 			}
-		private:
+
 			void print_header()
 			{
 				output_ << "Starting testing at ";
@@ -164,7 +279,12 @@ namespace cmoon::test
 				output_ << std::format(output_.getloc(), "{:%F %T}",
 									   std::chrono::zoned_time{std::chrono::current_zone(), std::chrono::system_clock::now()});
 				output_ << " : ";
+				print_duration(duration);
+			}
 
+			template<class Duration>
+			void print_duration(const Duration& duration)
+			{
 				cmoon::scope_exit reset_fmt {[this, before_fmt = output_.flags()] {
 					output_.setf(before_fmt);
 				}};
@@ -190,6 +310,34 @@ namespace cmoon::test
 				}
 			}
 
+			void print_slowest(const std::vector<test_result>& results, const std::vector<test_case*>& cases, std::size_t count)
+			{
+				std::vector<std::size_t> order(std::size(results));
+				for (std::size_t i {0}; i < std::size(order); ++i)
+				{
+					order[i] = i;
+				}
+
+				count = std::min(count, std::size(order));
+				if (count == 0)
+				{
+					return;
+				}
+
+				std::ranges::partial_sort(order, std::begin(order) + count, std::ranges::greater{},
+										  [&results](std::size_t i) { return results[i].duration(); });
+
+				output_ << "\nSlowest test cases:\n";
+				for (std::size_t i {0}; i < count; ++i)
+				{
+					output_ << "  ";
+					print_duration(results[order[i]].duration());
+					output_ << ' ';
+					output_ << cases[order[i]]->name();
+					output_ << '\n';
+				}
+			}
+
 			void print_test_result(const test_result& result)
 			{
 				if (!result.errors().empty())
@@ -0,0 +1,327 @@
+module;
+
+#if defined(__linux__)
+	#include <sched.h>
+	#include <pthread.h>
+#elif defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#endif
+
+export module cmoon.thread.cpu_topology;
+
+import <cstddef>;
+import <cstdint>;
+import <vector>;
+import <string>;
+import <string_view>;
+import <charconv>;
+import <fstream>;
+import <filesystem>;
+import <algorithm>;
+import <optional>;
+import <span>;
+import <stdexcept>;
+import <system_error>;
+import <thread>;
+import <utility>;
+
+namespace cmoon
+{
+	[[nodiscard]] constexpr std::string_view trim_cpu_list(std::string_view s) noexcept
+	{
+		constexpr std::string_view whitespace {" \t\r\n"};
+		const auto first {s.find_first_not_of(whitespace)};
+		if (first == std::string_view::npos)
+		{
+			return {};
+		}
+
+		return s.substr(first, s.find_last_not_of(whitespace) - first + 1);
+	}
+
+	[[nodiscard]] unsigned parse_cpu_number(std::string_view s)
+	{
+		unsigned cpu;
+		const auto [ptr, ec] {std::from_chars(s.data(), s.data() + s.size(), cpu)};
+		if (ec != std::errc{} || ptr != s.data() + s.size())
+		{
+			throw std::invalid_argument{"invalid cpu list"};
+		}
+
+		return cpu;
+	}
+
+	// Parses a cpu list in the format Linux uses in sysfs, such as "0-3,8,10-11".
+	// The result is sorted and has no duplicates.
+	export
+	[[nodiscard]] std::vector<unsigned> parse_cpu_list(std::string_view list)
+	{
+		std::vector<unsigned> cpus;
+		list = trim_cpu_list(list);
+
+		while (!list.empty())
+		{
+			const auto comma {list.find(',')};
+			const auto part {trim_cpu_list(list.substr(0, comma))};
+			list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+			const auto dash {part.find('-')};
+			const auto first {parse_cpu_number(part.substr(0, dash))};
+			const auto last {dash == std::string_view::npos ? first : parse_cpu_number(part.substr(dash + 1))};
+			if (last < first)
+			{
+				throw std::invalid_argument{"invalid cpu list"};
+			}
+
+			for (auto cpu {first}; cpu <= last; ++cpu)
+			{
+				cpus.push_back(cpu);
+			}
+		}
+
+		std::ranges::sort(cpus);
+		cpus.erase(std::ranges::unique(cpus).begin(), cpus.end());
+		return cpus;
+	}
+
+	// The cpus of the machine grouped by NUMA node. Nodes are numbered densely
+	// in the order the system lists them, and nodes without cpus are left out.
+	export
+	class cpu_topology
+	{
+		public:
+			cpu_topology() = default;
+
+			explicit cpu_topology(std::vector<std::vector<unsigned>> nodes)
+				: nodes_{std::move(nodes)}
+			{
+				std::erase_if(nodes_, [](const auto& n) { return n.empty(); });
+			}
+
+			// Reads the layout from /sys/devices/system/node on Linux and from
+			// the NUMA api on Windows. Only cpus this process may run on are
+			// included. Falls back to a single node when nothing is reported.
+			[[nodiscard]] static cpu_topology detect()
+			{
+				std::vector<std::vector<unsigned>> nodes;
+
+				#if defined(__linux__)
+					cpu_set_t allowed;
+					CPU_ZERO(&allowed);
+					const auto has_allowed {::sched_getaffinity(0, sizeof(allowed), &allowed) == 0};
+					const auto is_allowed = [&](unsigned cpu) {
+						return !has_allowed || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+					};
+
+					std::vector<std::pair<unsigned, std::vector<unsigned>>> found;
+					std::error_code ec;
+					for (const auto& entry : std::filesystem::directory_iterator{"/sys/devices/system/node", ec})
+					{
+						const auto name {entry.path().filename().string()};
+						if (!name.starts_with("node"))
+						{
+							continue;
+						}
+
+						unsigned id;
+						const auto [ptr, parse_ec] {std::from_chars(name.data() + 4, name.data() + name.size(), id)};
+						if (parse_ec != std::errc{} || ptr != name.data() + name.size())
+						{
+							continue;
+						}
+
+						std::ifstream in {entry.path() / "cpulist"};
+						std::string list;
+						if (!std::getline(in, list))
+						{
+							continue;
+						}
+
+						try
+						{
+							auto cpus {parse_cpu_list(list)};
+							std::erase_if(cpus, [&](unsigned cpu) { return !is_allowed(cpu); });
+							found.emplace_back(id, std::move(cpus));
+						}
+						catch (const std::invalid_argument&) {}
+					}
+
+					std::ranges::sort(found, {}, &std::pair<unsigned, std::vector<unsigned>>::first);
+					for (auto& [id, cpus] : found)
+					{
+						nodes.push_back(std::move(cpus));
+					}
+
+					if (has_allowed && std::ranges::all_of(nodes, [](const auto& n) { return n.empty(); }))
+					{
+						nodes.assign(1, {});
+						for (unsigned cpu {0}; cpu < CPU_SETSIZE; ++cpu)
+						{
+							if (CPU_ISSET(cpu, &allowed))
+							{
+								nodes.front().push_back(cpu);
+							}
+						}
+					}
+				#elif defined(_WIN32)
+					DWORD_PTR process_mask;
+					DWORD_PTR system_mask;
+					const auto has_allowed {::GetProcessAffinityMask(::GetCurrentProcess(), &process_mask, &system_mask) != 0};
+					const auto allowed {has_allowed ? static_cast<ULONGLONG>(process_mask) : ~ULONGLONG{0}};
+
+					ULONG highest;
+					if (::GetNumaHighestNodeNumber(&highest))
+					{
+						for (ULONG node {0}; node <= highest; ++node)
+						{
+							ULONGLONG mask;
+							auto& cpus {nodes.emplace_back()};
+							if (::GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask))
+							{
+								mask &= allowed;
+								for (unsigned cpu {0}; cpu < 64; ++cpu)
+								{
+									if (mask & (ULONGLONG{1} << cpu))
+									{
+										cpus.push_back(cpu);
+									}
+								}
+							}
+						}
+					}
+
+					if (has_allowed && std::ranges::all_of(nodes, [](const auto& n) { return n.empty(); }))
+					{
+						nodes.assign(1, {});
+						for (unsigned cpu {0}; cpu < sizeof(DWORD_PTR) * 8; ++cpu)
+						{
+							if (process_mask & (DWORD_PTR{1} << cpu))
+							{
+								nodes.front().push_back(cpu);
+							}
+						}
+					}
+				#endif
+
+				cpu_topology t {std::move(nodes)};
+				if (t.nodes_.empty())
+				{
+					auto& cpus {t.nodes_.emplace_back()};
+					const auto count {std::max(std::thread::hardware_concurrency(), 1u)};
+					for (unsigned cpu {0}; cpu < count; ++cpu)
+					{
+						cpus.push_back(cpu);
+					}
+				}
+
+				return t;
+			}
+
+			[[nodiscard]] std::size_t node_count() const noexcept
+			{
+				return std::size(nodes_);
+			}
+
+			[[nodiscard]] std::span<const unsigned> cpus(std::size_t node) const noexcept
+			{
+				return nodes_[node];
+			}
+
+			[[nodiscard]] std::size_t cpu_count() const noexcept
+			{
+				std::size_t count {0};
+				for (const auto& n : nodes_)
+				{
+					count += std::size(n);
+				}
+
+				return count;
+			}
+
+			[[nodiscard]] std::optional<std::size_t> node_of(unsigned cpu) const noexcept
+			{
+				for (std::size_t i {0}; i < std::size(nodes_); ++i)
+				{
+					if (std::ranges::binary_search(nodes_[i], cpu))
+					{
+						return i;
+					}
+				}
+
+				return std::nullopt;
+			}
+
+			[[nodiscard]] friend bool operator==(const cpu_topology&, const cpu_topology&) noexcept = default;
+		private:
+			std::vector<std::vector<unsigned>> nodes_;
+	};
+
+	// The cpu the calling thread is running on right now, if the system can tell.
+	export
+	[[nodiscard]] std::optional<unsigned> current_cpu() noexcept
+	{
+		#if defined(__linux__)
+			const auto cpu {::sched_getcpu()};
+			if (cpu >= 0)
+			{
+				return static_cast<unsigned>(cpu);
+			}
+		#elif defined(_WIN32)
+			return static_cast<unsigned>(::GetCurrentProcessorNumber());
+		#endif
+
+		return std::nullopt;
+	}
+
+	// Restricts a thread to run only on the given cpus.
+	export
+	void pin_thread(std::thread& t, std::span<const unsigned> cpus, std::error_code& ec) noexcept
+	{
+		ec.clear();
+		#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (const auto cpu : cpus)
+			{
+				if (cpu < CPU_SETSIZE)
+				{
+					CPU_SET(cpu, &set);
+				}
+			}
+
+			if (const auto result {::pthread_setaffinity_np(t.native_handle(), sizeof(set), &set)}; result != 0)
+			{
+				ec.assign(result, std::generic_category());
+			}
+		#elif defined(_WIN32)
+			DWORD_PTR mask {0};
+			for (const auto cpu : cpus)
+			{
+				if (cpu < sizeof(DWORD_PTR) * 8)
+				{
+					mask |= DWORD_PTR{1} << cpu;
+				}
+			}
+
+			if (::SetThreadAffinityMask(t.native_handle(), mask) == 0)
+			{
+				ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+			}
+		#else
+			ec = std::make_error_code(std::errc::operation_not_supported);
+		#endif
+	}
+
+	export
+	void pin_thread(std::thread& t, std::span<const unsigned> cpus)
+	{
+		std::error_code ec;
+		pin_thread(t, cpus, ec);
+		if (ec)
+		{
+			throw std::system_error{ec, "pin_thread"};
+		}
+	}
+}
\ No newline at end of file
@@ -336,7 +336,7 @@ namespace cmoon
 			template<class T>
 				requires(std::constructible_from<F, T>)
 			explicit in_place_stop_callback(in_place_stop_token token, T&& func) noexcept(std::is_nothrow_constructible_v<F, T>)
-				: in_place_stop_callback_base(token.source_, &in_place_stop_callback::execute_impl),
+				: in_place_stop_callback_base(token.source_),
 				  func_{std::forward<T>(func)}
 				{
 					register_callback();
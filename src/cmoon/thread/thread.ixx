@@ -1,2 +1,3 @@
 export module cmoon.thread;
-export import cmoon.thread.stop_token;
\ No newline at end of file
+export import cmoon.thread.stop_token;
+export import cmoon.thread.cpu_topology;
\ No newline at end of file
@@ -0,0 +1,8 @@
+import <iostream>;
+
+import cmoon.benchmarking;
+
+int main(int argc, char* argv[])
+{
+	return cmoon::benchmarking::run_benchmark_comparison(argc, argv, std::cout);
+}
\ No newline at end of file
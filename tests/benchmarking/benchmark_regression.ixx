@@ -0,0 +1,104 @@
+export module cmoon.tests.benchmarking.benchmark_regression;
+
+import <chrono>;
+import <vector>;
+import <string>;
+import <initializer_list>;
+
+import cmoon.test;
+import cmoon.benchmarking;
+
+namespace cmoon::tests::benchmarking
+{
+	export
+	class welch_t_test_test : public cmoon::test::test_case
+	{
+		public:
+			welch_t_test_test()
+				: cmoon::test::test_case{"welch_t_test_test"} {}
+
+			void operator()() override
+			{
+				const std::vector<double> a {10, 11, 12, 13, 14};
+				const std::vector<double> b {12, 14, 16, 18, 20, 22};
+
+				const auto result {cmoon::benchmarking::welch_t_test(a, b)};
+				cmoon::test::assert_almost_equal(result.t, 2.97044, 1e-5);
+				cmoon::test::assert_almost_equal(result.degrees_of_freedom, 6.97226, 1e-5);
+				cmoon::test::assert_almost_equal(result.p_value, 0.02089, 1e-5);
+
+				cmoon::test::assert_almost_equal(cmoon::benchmarking::welch_t_test(a, a).p_value, 1.0, 1e-12);
+				cmoon::test::assert_equal(cmoon::benchmarking::welch_t_test(a, std::vector<double>{12}).p_value, 1.0);
+				cmoon::test::assert_equal(cmoon::benchmarking::welch_t_test(std::vector<double>{1, 1}, std::vector<double>{2, 2}).p_value, 0.0);
+			}
+	};
+
+	cmoon::benchmarking::benchmark_record make_record(std::string name, std::initializer_list<long long> run_times)
+	{
+		cmoon::benchmarking::benchmark_record record;
+		record.name = std::move(name);
+		record.iterations_per_run = 1;
+		for (const auto t : run_times)
+		{
+			auto& run {record.runs.emplace_back()};
+			run.iterations = 1;
+			run.total_time = std::chrono::nanoseconds{t};
+			run.average = run.total_time;
+			run.fastest = run.total_time;
+			run.slowest = run.total_time;
+		}
+
+		return record;
+	}
+
+	export
+	class compare_reports_test : public cmoon::test::test_case
+	{
+		public:
+			compare_reports_test()
+				: cmoon::test::test_case{"compare_reports_test"} {}
+
+			void operator()() override
+			{
+				using cmoon::benchmarking::benchmark_change;
+
+				cmoon::benchmarking::benchmark_report baseline {cmoon::benchmarking::benchmark_environment{}};
+				baseline.add(make_record("steady", {100, 101, 99, 100}));
+				baseline.add(make_record("slower", {100, 101, 99, 100}));
+				baseline.add(make_record("faster", {200, 202, 198, 200}));
+				baseline.add(make_record("slightly", {100, 101, 99, 100}));
+				baseline.add(make_record("gone", {100, 100}));
+
+				cmoon::benchmarking::benchmark_report current {cmoon::benchmarking::benchmark_environment{}};
+				current.add(make_record("steady", {100, 100, 101, 99}));
+				current.add(make_record("slower", {130, 131, 129, 132}));
+				current.add(make_record("faster", {100, 101, 99, 100}));
+				current.add(make_record("slightly", {102, 103, 101, 102}));
+				current.add(make_record("new", {100, 100}));
+
+				const auto comparisons {cmoon::benchmarking::compare_reports(baseline, current)};
+				cmoon::test::assert_equal(comparisons.size(), 6);
+
+				const std::vector<benchmark_change> expected {
+					benchmark_change::unchanged,
+					benchmark_change::regressed,
+					benchmark_change::improved,
+					benchmark_change::unchanged,
+					benchmark_change::added,
+					benchmark_change::removed
+				};
+
+				for (std::size_t i {0}; i < expected.size(); ++i)
+				{
+					cmoon::test::assert_true(comparisons[i].verdict == expected[i], comparisons[i].name);
+				}
+
+				cmoon::test::assert_almost_equal(comparisons[1].change, 0.305, 1e-9);
+				cmoon::test::assert_less(comparisons[3].test.p_value, 0.05);
+				cmoon::test::assert_true(cmoon::benchmarking::has_regressions(comparisons));
+
+				const auto relaxed {cmoon::benchmarking::compare_reports(baseline, current, {.threshold = 0.5})};
+				cmoon::test::assert_false(cmoon::benchmarking::has_regressions(relaxed));
+			}
+	};
+}
\ No newline at end of file
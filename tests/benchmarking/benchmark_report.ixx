@@ -0,0 +1,87 @@
+export module cmoon.tests.benchmarking.benchmark_report;
+
+import <chrono>;
+import <sstream>;
+import <string>;
+
+import cmoon.test;
+import cmoon.json;
+import cmoon.benchmarking;
+
+namespace cmoon::tests::benchmarking
+{
+	cmoon::benchmarking::benchmark_report make_report()
+	{
+		cmoon::benchmarking::benchmark_report report {cmoon::benchmarking::benchmark_environment{
+			.cpu_model = "Test \"CPU\" @ 3.00GHz",
+			.compiler = "gcc",
+			.compiler_version = "13.2.0",
+			.operating_system = "linux",
+			.architecture = "amd64",
+			.hardware_threads = 8,
+			.debug = false,
+			.timestamp = "2024-01-02T03:04:05Z"
+		}};
+
+		cmoon::benchmarking::benchmark_result result;
+		result.start_run();
+		result.add_iteration(std::chrono::nanoseconds{5});
+		result.add_iteration(std::chrono::nanoseconds{15});
+		result.start_run();
+		result.add_iteration(std::chrono::nanoseconds{7});
+		report.add({"sort, small", 2, result});
+
+		return report;
+	}
+
+	export
+	class benchmark_report_json_test : public cmoon::test::test_case
+	{
+		public:
+			benchmark_report_json_test()
+				: cmoon::test::test_case{"benchmark_report_json_test"} {}
+
+			void operator()() override
+			{
+				const auto report {make_report()};
+				const auto& record {*report.find("sort, small")};
+				cmoon::test::assert_equal(record.total_iterations(), 3);
+				cmoon::test::assert_equal(record.total_run_time(), std::chrono::nanoseconds{27});
+				cmoon::test::assert_equal(record.average_iteration_time().count(), 9.0);
+				cmoon::test::assert_equal(record.fastest_iteration(), std::chrono::nanoseconds{5});
+				cmoon::test::assert_equal(record.slowest_iteration(), std::chrono::nanoseconds{15});
+				cmoon::test::assert_equal(record.runs[0].mean_iteration_time().count(), 10.0);
+
+				std::stringstream ss;
+				cmoon::benchmarking::write_json_report(ss, report);
+				const auto read {cmoon::benchmarking::read_json_report(ss)};
+
+				cmoon::test::assert_true(read.environment() == report.environment());
+				cmoon::test::assert_equal(read.size(), 1);
+				cmoon::test::assert_true(*read.begin() == record);
+
+				std::istringstream bad {"{\"version\": 1}"};
+				cmoon::test::assert_throws<cmoon::json::invalid_json>([&bad] { (void) cmoon::benchmarking::read_json_report(bad); });
+			}
+	};
+
+	export
+	class benchmark_report_csv_test : public cmoon::test::test_case
+	{
+		public:
+			benchmark_report_csv_test()
+				: cmoon::test::test_case{"benchmark_report_csv_test"} {}
+
+			void operator()() override
+			{
+				std::ostringstream os;
+				cmoon::benchmarking::write_csv_report(os, make_report());
+				const auto csv {os.str()};
+
+				cmoon::test::assert_true(csv.starts_with("# cpu_model: Test \"CPU\" @ 3.00GHz\n"));
+				cmoon::test::assert_not_equal(csv.find("\nbenchmark,run,iterations,total_ns,average_ns,fastest_ns,slowest_ns\n"
+													   "\"sort, small\",0,2,20,10,5,15\n"
+													   "\"sort, small\",1,1,7,7,7,7\n"), std::string::npos);
+			}
+	};
+}
\ No newline at end of file
@@ -3,6 +3,8 @@ export import cmoon.tests.benchmarking.run_result;
 export import cmoon.tests.benchmarking.benchmark_result;
 export import cmoon.tests.benchmarking.benchmark_function;
 export import cmoon.tests.benchmarking.noop_benchmark;
+export import cmoon.tests.benchmarking.benchmark_report;
+export import cmoon.tests.benchmarking.benchmark_regression;
 
 import <utility>;
 
@@ -22,6 +24,10 @@ namespace cmoon
 			suite.add_test_case<cmoon::tests::benchmarking::benchmark_result_test>();
 			suite.add_test_case<cmoon::tests::benchmarking::benchmark_function_test>();
 			suite.add_test_case<cmoon::tests::benchmarking::noop_benchmark_test>();
+			suite.add_test_case<cmoon::tests::benchmarking::benchmark_report_json_test>();
+			suite.add_test_case<cmoon::tests::benchmarking::benchmark_report_csv_test>();
+			suite.add_test_case<cmoon::tests::benchmarking::welch_t_test_test>();
+			suite.add_test_case<cmoon::tests::benchmarking::compare_reports_test>();
 
 			return std::move(suite);
 		}
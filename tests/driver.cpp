@@ -13,11 +13,12 @@ import cmoon.tests.functional;
 import cmoon.tests.io;
 import cmoon.tests.math;
 import cmoon.tests.meta;
+import cmoon.tests.memory;
 import cmoon.tests.ranges;
 import cmoon.tests.ratio;
 import cmoon.tests.thread;
 
-int main()
+int main(int argc, char* argv[])
 {
 	cmoon::test::test_suite suite;
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::benchmarking>::tests());
@@ -28,11 +29,13 @@ int main()
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::io>::tests());
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::math>::tests());
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::meta>::tests());
+	suite.add_test_suite(cmoon::library_traits<cmoon::library::memory>::tests());
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::ranges>::tests());
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::ratio>::tests());
 	suite.add_test_suite(cmoon::library_traits<cmoon::library::thread>::tests());
 
+	const auto options {cmoon::test::parse_test_run_options(argc, argv)};
 	cmoon::test::text_test_runner runner{std::cout};
 
-	return std::ranges::any_of(runner.run(suite), [](const auto& r) { return !r.passed(); });
+	return std::ranges::any_of(runner.run(suite, options), [](const auto& r) { return !r.passed(); });
 }
\ No newline at end of file
@@ -19,10 +19,14 @@ export import cmoon.tests.execution.ensure_started;
 //export import cmoon.tests.execution.sync_wait;
 //export import cmoon.tests.execution.execute;
 //export import cmoon.tests.execution.async;
+export import cmoon.tests.execution.task;
+export import cmoon.tests.execution.tracer;
 
 import <utility>;
 import <exception>;
 import <atomic>;
+import <memory>;
+import <cstddef>;
 
 import cmoon.meta;
 import cmoon.test;
@@ -532,6 +536,96 @@ namespace cmoon::tests::execution
 			}
 	};
 
+	export
+	class split_allocator_test : public cmoon::test::test_case
+	{
+		template<class T>
+		struct counting_allocator
+		{
+			using value_type = T;
+
+			int* live;
+
+			counting_allocator(int* live) noexcept
+				: live{live} {}
+
+			template<class U>
+			counting_allocator(const counting_allocator<U>& other) noexcept
+				: live{other.live} {}
+
+			T* allocate(std::size_t n)
+			{
+				++*live;
+				return std::allocator<T>{}.allocate(n);
+			}
+
+			void deallocate(T* p, std::size_t n) noexcept
+			{
+				--*live;
+				std::allocator<T>{}.deallocate(p, n);
+			}
+
+			template<class U>
+			[[nodiscard]] friend bool operator==(const counting_allocator& a, const counting_allocator<U>& b) noexcept
+			{
+				return a.live == b.live;
+			}
+		};
+
+		struct dummy_r
+		{
+			friend void tag_invoke(cmoon::execution::set_value_t, dummy_r&& r, int v) noexcept
+			{
+				*r.v = v;
+			}
+
+			template<class E>
+			friend void tag_invoke(cmoon::execution::set_error_t, dummy_r&&, E&&) noexcept
+			{
+			}
+
+			friend void tag_invoke(cmoon::execution::set_done_t, dummy_r&&) noexcept
+			{
+			}
+
+			int* v;
+		};
+
+		public:
+			split_allocator_test()
+				: cmoon::test::test_case{"split_allocator_test"} {}
+
+			void operator()() override
+			{
+				constexpr int expected {5};
+				int live {0};
+				int value {0};
+				int value2 {0};
+
+				{
+					auto s = cmoon::execution::split(
+								cmoon::execution::just(expected),
+								counting_allocator<int>{&live}
+							 );
+
+					cmoon::test::assert_equal(live, 1);
+
+					auto op = cmoon::execution::connect(s, dummy_r{&value});
+					auto op2 = cmoon::execution::connect(std::move(s), dummy_r{&value2});
+					cmoon::execution::start(op);
+					cmoon::execution::start(op2);
+
+					cmoon::test::assert_equal(value, expected);
+					cmoon::test::assert_equal(value2, expected);
+				}
+
+				cmoon::test::assert_equal(live, 0);
+
+				cmoon::execution::start_detached(cmoon::execution::just(expected), counting_allocator<int>{&live});
+				cmoon::test::assert_equal(live, 0);
+			}
+	};
+
 	export
 	class sync_wait_value_test : public cmoon::test::test_case
 	{
@@ -760,6 +854,7 @@ namespace cmoon::tests
 		suite.add_test_case<execution::split_single_test>();
 		suite.add_test_case<execution::split_multi_test>();
 		suite.add_test_case<execution::split_cancel_test>();
+		suite.add_test_case<execution::split_allocator_test>();
 		suite.add_test_case<execution::when_all_single_value_test>();
 		suite.add_test_case<execution::when_all_single_error_test>();
 		suite.add_test_case<execution::when_all_single_done_test>();
@@ -774,6 +869,15 @@ namespace cmoon::tests
 		suite.add_test_case<execution::sync_wait_done_test>();
 		suite.add_test_case<execution::execute_test>();
 		suite.add_test_case<execution::async_test>();
+		suite.add_test_case<execution::task_value_test>();
+		suite.add_test_case<execution::task_error_test>();
+		suite.add_test_case<execution::task_done_test>();
+		suite.add_test_case<execution::task_inline_loop_test>();
+		suite.add_test_case<execution::task_allocator_test>();
+		suite.add_test_case<execution::tracer_record_test>();
+		suite.add_test_case<execution::latency_histogram_test>();
+		suite.add_test_case<execution::tracer_chrome_trace_test>();
+		suite.add_test_case<execution::traced_test>();
 
 		return std::move(suite);
 	}
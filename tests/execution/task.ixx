@@ -0,0 +1,190 @@
+export module cmoon.tests.execution.task;
+
+import <memory>;
+import <stdexcept>;
+import <cstddef>;
+
+import cmoon.execution;
+import cmoon.test;
+
+namespace cmoon::tests::execution
+{
+	cmoon::execution::task<int> add_one(int x)
+	{
+		co_return x + co_await cmoon::execution::just(1);
+	}
+
+	cmoon::execution::task<int> add_both()
+	{
+		const int a {co_await cmoon::execution::just(2)};
+		const int b {co_await add_one(a)};
+		co_return a + b;
+	}
+
+	cmoon::execution::task<void> throws_runtime_error()
+	{
+		co_await cmoon::execution::just();
+		throw std::runtime_error{"task"};
+	}
+
+	cmoon::execution::task<int> catches_runtime_error()
+	{
+		try
+		{
+			co_await throws_runtime_error();
+		}
+		catch (const std::runtime_error&)
+		{
+			co_return 1;
+		}
+
+		co_return 0;
+	}
+
+	cmoon::execution::task<int> awaits_done()
+	{
+		co_await cmoon::execution::just_done();
+		co_return 0;
+	}
+
+	cmoon::execution::task<int> awaits_awaits_done()
+	{
+		co_return co_await awaits_done() + 1;
+	}
+
+	cmoon::execution::task<long long> sum_inline(int count)
+	{
+		long long sum {0};
+		for (int i {0}; i < count; ++i)
+		{
+			sum += co_await cmoon::execution::just(i);
+		}
+
+		co_return sum;
+	}
+
+	template<class T>
+	struct counting_allocator
+	{
+		using value_type = T;
+
+		int* count;
+
+		counting_allocator(int* c) noexcept
+			: count{c} {}
+
+		template<class U>
+		counting_allocator(const counting_allocator<U>& other) noexcept
+			: count{other.count} {}
+
+		T* allocate(std::size_t n)
+		{
+			++*count;
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			--*count;
+			std::allocator<T>{}.deallocate(p, n);
+		}
+
+		template<class U>
+		friend bool operator==(const counting_allocator& lhs, const counting_allocator<U>& rhs) noexcept
+		{
+			return lhs.count == rhs.count;
+		}
+	};
+
+	cmoon::execution::task<int> doubled(std::allocator_arg_t, counting_allocator<int>, int x)
+	{
+		co_return x * 2;
+	}
+
+	export
+	class task_value_test : public cmoon::test::test_case
+	{
+		public:
+			task_value_test()
+				: cmoon::test::test_case{"task_value_test"} {}
+
+			void operator()() override
+			{
+				const auto [value] = cmoon::execution::sync_wait(add_both()).value();
+				cmoon::test::assert_equal(value, 5);
+			}
+	};
+
+	export
+	class task_error_test : public cmoon::test::test_case
+	{
+		public:
+			task_error_test()
+				: cmoon::test::test_case{"task_error_test"} {}
+
+			void operator()() override
+			{
+				const auto [value] = cmoon::execution::sync_wait(catches_runtime_error()).value();
+				cmoon::test::assert_equal(value, 1);
+
+				auto fn = [] {
+					cmoon::execution::sync_wait(throws_runtime_error());
+				};
+
+				cmoon::test::assert_throws<std::runtime_error>(fn);
+			}
+	};
+
+	export
+	class task_done_test : public cmoon::test::test_case
+	{
+		public:
+			task_done_test()
+				: cmoon::test::test_case{"task_done_test"} {}
+
+			void operator()() override
+			{
+				cmoon::test::assert_false(cmoon::execution::sync_wait(awaits_done()).has_value());
+				cmoon::test::assert_false(cmoon::execution::sync_wait(awaits_awaits_done()).has_value());
+			}
+	};
+
+	export
+	class task_inline_loop_test : public cmoon::test::test_case
+	{
+		public:
+			task_inline_loop_test()
+				: cmoon::test::test_case{"task_inline_loop_test"} {}
+
+			void operator()() override
+			{
+				constexpr int count {1000000};
+				const auto [value] = cmoon::execution::sync_wait(sum_inline(count)).value();
+				cmoon::test::assert_equal(value, static_cast<long long>(count) * (count - 1) / 2);
+			}
+	};
+
+	export
+	class task_allocator_test : public cmoon::test::test_case
+	{
+		public:
+			task_allocator_test()
+				: cmoon::test::test_case{"task_allocator_test"} {}
+
+			void operator()() override
+			{
+				int count {0};
+
+				{
+					auto t = doubled(std::allocator_arg, counting_allocator<int>{&count}, 4);
+					cmoon::test::assert_equal(count, 1);
+				}
+
+				cmoon::test::assert_equal(count, 0);
+
+				const auto [value] = cmoon::execution::sync_wait(doubled(std::allocator_arg, counting_allocator<int>{&count}, 4)).value();
+				cmoon::test::assert_equal(value, 8);
+				cmoon::test::assert_equal(count, 0);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+export module cmoon.tests.execution.tracer;
+
+import <chrono>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <vector>;
+
+import cmoon.execution;
+import cmoon.test;
+
+namespace cmoon::tests::execution
+{
+	export
+	class tracer_record_test : public cmoon::test::test_case
+	{
+		public:
+			tracer_record_test()
+				: cmoon::test::test_case{"tracer_record_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t capacity {64};
+				constexpr std::size_t per_thread {100};
+				cmoon::execution::tracer t {capacity};
+
+				std::vector<std::thread> threads;
+				for (int i {0}; i < 4; ++i)
+				{
+					threads.emplace_back([&t, i] {
+						for (std::size_t j {0}; j < per_thread; ++j)
+						{
+							const auto now {cmoon::execution::tracer::clock::now()};
+							t.record(i % 2 == 0 ? "even" : "odd", now, now + std::chrono::microseconds{1}, now + std::chrono::microseconds{3});
+						}
+					});
+				}
+
+				for (auto& th : threads)
+				{
+					th.join();
+				}
+
+				const auto records {t.records()};
+				cmoon::test::assert_equal(records.size(), 4 * capacity);
+				cmoon::test::assert_equal(t.dropped(), 4 * (per_thread - capacity));
+				cmoon::test::assert_equal(records.front().queue_time(), std::chrono::nanoseconds{std::chrono::microseconds{1}});
+				cmoon::test::assert_equal(records.front().run_time(), std::chrono::nanoseconds{std::chrono::microseconds{2}});
+
+				const auto summaries {t.summarize()};
+				cmoon::test::assert_equal(summaries.size(), std::size_t{2});
+				cmoon::test::assert_equal(summaries[0].name, std::string{"even"});
+				cmoon::test::assert_equal(summaries[0].run_time.count(), 2 * capacity);
+				cmoon::test::assert_equal(summaries[0].run_time.max(), std::chrono::nanoseconds{std::chrono::microseconds{2}});
+			}
+	};
+
+	export
+	class latency_histogram_test : public cmoon::test::test_case
+	{
+		public:
+			latency_histogram_test()
+				: cmoon::test::test_case{"latency_histogram_test"} {}
+
+			void operator()() override
+			{
+				cmoon::execution::latency_histogram h;
+				for (int i {1}; i <= 1000; ++i)
+				{
+					h.add(std::chrono::nanoseconds{i});
+				}
+
+				cmoon::test::assert_equal(h.count(), std::size_t{1000});
+				cmoon::test::assert_equal(h.min(), std::chrono::nanoseconds{1});
+				cmoon::test::assert_equal(h.max(), std::chrono::nanoseconds{1000});
+				cmoon::test::assert_equal(h.mean(), std::chrono::nanoseconds{500});
+				cmoon::test::assert_equal(h.bucket(10), std::size_t{489});
+				cmoon::test::assert_greater_equal(h.percentile(0.5), std::chrono::nanoseconds{500});
+				cmoon::test::assert_less_equal(h.percentile(0.5), std::chrono::nanoseconds{1000});
+				cmoon::test::assert_equal(h.percentile(1.0), h.max());
+			}
+	};
+
+	export
+	class tracer_chrome_trace_test : public cmoon::test::test_case
+	{
+		public:
+			tracer_chrome_trace_test()
+				: cmoon::test::test_case{"tracer_chrome_trace_test"} {}
+
+			void operator()() override
+			{
+				cmoon::execution::tracer t;
+				const auto now {cmoon::execution::tracer::clock::now()};
+				t.record("queued", now, now + std::chrono::microseconds{5}, now + std::chrono::microseconds{12});
+				t.record("inline", now, now, now + std::chrono::microseconds{1});
+
+				std::ostringstream os;
+				t.write_chrome_trace(os);
+				const auto json {os.str()};
+
+				cmoon::test::assert_true(json.starts_with("{\"displayTimeUnit\": \"ns\", \"traceEvents\": ["));
+				cmoon::test::assert_not_equal(json.find("\"name\": \"queued\", \"cat\": \"queue\", \"ph\": \"b\""), std::string::npos);
+				cmoon::test::assert_not_equal(json.find("\"name\": \"queued\", \"cat\": \"run\", \"ph\": \"X\""), std::string::npos);
+				cmoon::test::assert_equal(json.find("\"name\": \"inline\", \"cat\": \"queue\""), std::string::npos);
+			}
+	};
+
+	export
+	class traced_test : public cmoon::test::test_case
+	{
+		public:
+			traced_test()
+				: cmoon::test::test_case{"traced_test"} {}
+
+			void operator()() override
+			{
+				cmoon::execution::tracer t;
+
+				auto work = cmoon::execution::just(5) |
+							cmoon::execution::traced(t, "just") |
+							cmoon::execution::then([](int v) { return v + 1; });
+
+				const auto [value] = cmoon::execution::sync_wait(std::move(work)).value();
+				cmoon::test::assert_equal(value, 6);
+
+				const auto records {t.records()};
+				cmoon::test::assert_equal(records.size(), std::size_t{1});
+				cmoon::test::assert_equal(std::string{records[0].name}, std::string{"just"});
+				cmoon::test::assert_equal(records[0].queue_time(), std::chrono::nanoseconds{0});
+			}
+	};
+}
\ No newline at end of file
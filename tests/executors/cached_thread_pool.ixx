@@ -1,7 +1,14 @@
 export module cmoon.tests.executors.cached_thread_pool;
 
 import <array>;
+import <atomic>;
 import <chrono>;
+import <exception>;
+import <thread>;
+import <vector>;
+import <cstddef>;
+import <stdexcept>;
+import <string>;
 
 import cmoon.property;
 import cmoon.execution;
@@ -74,6 +81,76 @@ namespace cmoon::tests::executors
 			}
 	};
 
+	export
+	class cached_thread_pool_bulk_empty_test : public cmoon::test::test_case
+	{
+		public:
+			cached_thread_pool_bulk_empty_test()
+				: cmoon::test::test_case{"cached_thread_pool_bulk_empty_test"} {}
+
+			void operator()() override
+			{
+				std::atomic<int> calls {0};
+				cmoon::executors::cached_thread_pool p;
+
+				const auto result = cmoon::execution::sync_wait(
+					cmoon::execution::bulk(cmoon::execution::schedule(p.get_scheduler()), std::size_t{0},
+										   [&calls](std::size_t) {
+											   ++calls;
+										   }));
+
+				cmoon::test::assert_true(result.has_value());
+				cmoon::test::assert_equal(calls.load(), 0);
+			}
+	};
+
+	export
+	class cached_thread_pool_bulk_error_test : public cmoon::test::test_case
+	{
+		public:
+			cached_thread_pool_bulk_error_test()
+				: cmoon::test::test_case{"cached_thread_pool_bulk_error_test"} {}
+
+			void operator()() override
+			{
+				std::array<std::atomic<int>, 16> values {};
+				std::atomic<int> errors {0};
+				std::string message;
+				cmoon::executors::cached_thread_pool p;
+
+				auto s = cmoon::execution::bulk(cmoon::execution::schedule(p.get_scheduler()), std::size(values),
+												[&values](std::size_t i) {
+													++values[i];
+													if (i == 3)
+													{
+														throw std::runtime_error{"bulk failed"};
+													}
+												}) |
+						 cmoon::execution::upon_error([&errors, &message](std::exception_ptr e) {
+							 try
+							 {
+								 std::rethrow_exception(e);
+							 }
+							 catch (const std::runtime_error& ex)
+							 {
+								 message = ex.what();
+							 }
+							 ++errors;
+							 errors.notify_one();
+						 });
+
+				cmoon::execution::start_detached(std::move(s));
+				errors.wait(0);
+
+				cmoon::test::assert_equal(errors.load(), 1);
+				cmoon::test::assert_equal(message, std::string{"bulk failed"});
+				for (const auto& v : values)
+				{
+					cmoon::test::assert_equal(v.load(), 1);
+				}
+			}
+	};
+
 	export
 	class cached_thread_pool_schedule_test : public cmoon::test::test_case
 	{
@@ -157,4 +234,133 @@ namespace cmoon::tests::executors
 				cmoon::test::assert_equal(value2, expected2);
 			}
 	};
+
+	export
+	class cached_thread_pool_bounded_test : public cmoon::test::test_case
+	{
+		public:
+			cached_thread_pool_bounded_test()
+				: cmoon::test::test_case{"cached_thread_pool_bounded_test"} {}
+
+			void operator()() override
+			{
+				constexpr int tasks {1000};
+				constexpr std::size_t max_threads {2};
+
+				std::atomic<int> running {0};
+				std::atomic<int> peak {0};
+				std::atomic<int> done {0};
+				cmoon::executors::cached_thread_pool p{{.max_threads = max_threads}};
+
+				auto s = p.get_scheduler();
+
+				for (int i {0}; i < tasks; ++i)
+				{
+					cmoon::execution::execute(s, [&running, &peak, &done] {
+						const auto now {++running};
+						auto highest {peak.load()};
+						while (now > highest && !peak.compare_exchange_weak(highest, now)) {}
+
+						std::this_thread::sleep_for(std::chrono::microseconds{50});
+						--running;
+						++done;
+					});
+
+					cmoon::test::assert_less_equal(p.thread_count(), max_threads);
+				}
+
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_equal(done.load(), tasks);
+				cmoon::test::assert_less_equal(peak.load(), static_cast<int>(max_threads));
+			}
+	};
+
+	export
+	class cached_thread_pool_overflow_test : public cmoon::test::test_case
+	{
+		public:
+			cached_thread_pool_overflow_test()
+				: cmoon::test::test_case{"cached_thread_pool_overflow_test"} {}
+
+			void operator()() override
+			{
+				std::atomic<bool> started {false};
+				std::atomic<bool> release {false};
+				std::atomic<int> ran {0};
+				std::atomic<int> rejected {0};
+				cmoon::executors::cached_thread_pool p{{.max_threads = 1, .max_queued = 1, .overflow = cmoon::executors::overflow_policy::reject}};
+
+				auto s = p.get_scheduler();
+
+				cmoon::execution::execute(s, [&started, &release, &ran] {
+					started = true;
+					started.notify_one();
+					release.wait(false);
+					++ran;
+				});
+
+				started.wait(false);
+
+				for (int i {0}; i < 2; ++i)
+				{
+					auto work = cmoon::execution::schedule(s) |
+								cmoon::execution::then([&ran] { ++ran; }) |
+								cmoon::execution::upon_error([&rejected](std::exception_ptr) { ++rejected; });
+
+					cmoon::execution::start_detached(std::move(work));
+				}
+
+				cmoon::test::assert_equal(p.queued(), std::size_t{1});
+
+				release = true;
+				release.notify_one();
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_equal(ran.load(), 2);
+				cmoon::test::assert_equal(rejected.load(), 1);
+			}
+	};
+
+	export
+	class cached_thread_pool_priority_test : public cmoon::test::test_case
+	{
+		public:
+			cached_thread_pool_priority_test()
+				: cmoon::test::test_case{"cached_thread_pool_priority_test"} {}
+
+			void operator()() override
+			{
+				using cmoon::executors::task_priority;
+
+				std::atomic<bool> release {false};
+				std::vector<int> order;
+				cmoon::executors::cached_thread_pool p{{.min_threads = 1, .max_threads = 1}};
+
+				auto s = p.get_scheduler();
+
+				// Holds the only thread so the rest are all queued before any runs.
+				cmoon::execution::execute(s, [&release] { release.wait(false); });
+
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::priority(task_priority::low)), [&order] { order.push_back(3); });
+				cmoon::execution::execute(s, [&order] { order.push_back(2); });
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::deadline(std::chrono::seconds{1})), [&order] { order.push_back(1); });
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::priority(task_priority::high)), [&order] { order.push_back(0); });
+
+				cmoon::test::assert_equal(cmoon::query(cmoon::require(s, cmoon::executors::priority(task_priority::high)), cmoon::executors::priority), task_priority::high);
+
+				release = true;
+				release.notify_one();
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_sequence_equal(order, std::vector<int>{0, 1, 2, 3});
+				cmoon::test::assert_equal(p.stats(task_priority::normal).started, std::size_t{2});
+				cmoon::test::assert_equal(p.stats(task_priority::low).started, std::size_t{1});
+				cmoon::test::assert_equal(p.deadline_stats().started, std::size_t{1});
+				cmoon::test::assert_equal(p.deadline_stats().depth, std::size_t{0});
+			}
+	};
 }
\ No newline at end of file
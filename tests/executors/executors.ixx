@@ -3,7 +3,8 @@ export import cmoon.tests.executors.inline_scheduler;
 export import cmoon.tests.executors.static_thread_pool;
 export import cmoon.tests.executors.cached_thread_pool;
 export import cmoon.tests.executors.single_thread_context;
-//export import cmoon.tests.executors.strand;
+export import cmoon.tests.executors.strand;
+export import cmoon.tests.executors.timer_context;
 
 import <utility>;
 
@@ -21,18 +22,33 @@ namespace cmoon::tests
 		suite.add_test_case<executors::inline_scheduler_test>();
 		suite.add_test_case<executors::static_thread_pool_execute_test>();
 		suite.add_test_case<executors::static_thread_pool_bulk_execute_test>();
+		suite.add_test_case<executors::static_thread_pool_bulk_empty_test>();
 		suite.add_test_case<executors::static_thread_pool_schedule_test>();
 		suite.add_test_case<executors::static_thread_pool_schedule_on_test>();
+		suite.add_test_case<executors::static_thread_pool_placement_test>();
+		suite.add_test_case<executors::static_thread_pool_priority_test>();
+		suite.add_test_case<executors::static_thread_pool_parallel_bulk_test>();
+		suite.add_test_case<executors::static_thread_pool_task_test>();
+		suite.add_test_case<executors::static_thread_pool_trace_test>();
 		suite.add_test_case<executors::cached_thread_pool_execute_test>();
 		suite.add_test_case<executors::cached_thread_pool_bulk_execute_test>();
+		suite.add_test_case<executors::cached_thread_pool_bulk_empty_test>();
+		suite.add_test_case<executors::cached_thread_pool_bulk_error_test>();
 		suite.add_test_case<executors::cached_thread_pool_schedule_test>();
 		suite.add_test_case<executors::cached_thread_pool_schedule_on_test>();
 		suite.add_test_case<executors::cached_thread_pool_timeout_test>();
+		suite.add_test_case<executors::cached_thread_pool_bounded_test>();
+		suite.add_test_case<executors::cached_thread_pool_overflow_test>();
+		suite.add_test_case<executors::cached_thread_pool_priority_test>();
 		suite.add_test_case<executors::single_thread_context_execute_test>();
 		suite.add_test_case<executors::single_thread_context_bulk_execute_test>();
 		suite.add_test_case<executors::single_thread_context_schedule_test>();
 		suite.add_test_case<executors::single_thread_context_schedule_on_test>();
-		//suite.add_test_case<executors::strand_single_execute_test>();
+		suite.add_test_case<executors::strand_single_execute_test>();
+		suite.add_test_case<executors::strand_serial_execute_test>();
+		suite.add_test_case<executors::timer_context_schedule_after_test>();
+		suite.add_test_case<executors::timer_context_schedule_at_test>();
+		suite.add_test_case<executors::timer_context_cancel_test>();
 
 		return std::move(suite);
 	}
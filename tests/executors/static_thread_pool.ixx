@@ -3,10 +3,18 @@ export module cmoon.tests.executors.static_thread_pool;
 import <array>;
 import <atomic>;
 import <concepts>;
+import <cstddef>;
+import <exception>;
+import <vector>;
+import <chrono>;
+import <thread>;
+import <string>;
 
+import cmoon.property;
 import cmoon.execution;
 import cmoon.executors;
 import cmoon.test;
+import cmoon.thread;
 
 namespace cmoon::tests::executors
 {
@@ -74,6 +82,29 @@ namespace cmoon::tests::executors
 			}
 	};
 
+	export
+	class static_thread_pool_bulk_empty_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_bulk_empty_test()
+				: cmoon::test::test_case{"static_thread_pool_bulk_empty_test"} {}
+
+			void operator()() override
+			{
+				std::atomic<int> calls {0};
+				cmoon::executors::static_thread_pool p {2};
+
+				const auto result = cmoon::execution::sync_wait(
+					cmoon::execution::bulk(cmoon::execution::schedule(p.get_scheduler()), std::size_t{0},
+										   [&calls](std::size_t) {
+											   ++calls;
+										   }));
+
+				cmoon::test::assert_true(result.has_value());
+				cmoon::test::assert_equal(calls.load(), 0);
+			}
+	};
+
 	export
 	class static_thread_pool_schedule_test : public cmoon::test::test_case
 	{
@@ -127,4 +158,192 @@ namespace cmoon::tests::executors
 				cmoon::test::assert_equal(value, expected);
 			}
 	};
+
+	export
+	class static_thread_pool_placement_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_placement_test()
+				: cmoon::test::test_case{"static_thread_pool_placement_test"} {}
+
+			void operator()() override
+			{
+				constexpr int expected {5};
+
+				std::array values {0, 0, 0, 0};
+				cmoon::executors::static_thread_pool p {{
+					.threads = 2,
+					.placement = cmoon::executors::thread_placement::nodes,
+					.topology = cmoon::cpu_topology{{{0}, {0}}}
+				}};
+
+				cmoon::test::assert_equal(p.node_count(), std::size_t{2});
+				cmoon::test::assert_equal(cmoon::execution::get_numa_node(p.get_scheduler(0)), std::size_t{0});
+				cmoon::test::assert_equal(cmoon::execution::get_numa_node(p.get_scheduler(1)), std::size_t{1});
+				cmoon::test::assert_equal(cmoon::execution::get_numa_node(p.get_scheduler(3)), std::size_t{1});
+
+				for (std::size_t i {0}; i < std::size(values); ++i)
+				{
+					cmoon::execution::execute(p.get_scheduler(i), [&values, i, expected] { values[i] = expected; });
+				}
+
+				p.request_stop();
+				p.join();
+
+				for (const auto v : values)
+				{
+					cmoon::test::assert_equal(v, expected);
+				}
+			}
+	};
+
+	export
+	class static_thread_pool_priority_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_priority_test()
+				: cmoon::test::test_case{"static_thread_pool_priority_test"} {}
+
+			void operator()() override
+			{
+				using cmoon::executors::task_priority;
+
+				std::atomic<bool> release {false};
+				std::vector<int> order;
+				cmoon::executors::static_thread_pool p {1};
+
+				auto s = p.get_scheduler();
+
+				// Holds the only thread so the rest are all queued before any runs.
+				cmoon::execution::execute(s, [&release] { release.wait(false); });
+
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::priority(task_priority::low)), [&order] { order.push_back(3); });
+				cmoon::execution::execute(s, [&order] { order.push_back(2); });
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::deadline(std::chrono::seconds{1})), [&order] { order.push_back(1); });
+				cmoon::execution::execute(cmoon::require(s, cmoon::executors::priority(task_priority::high)), [&order] { order.push_back(0); });
+
+				cmoon::test::assert_equal(cmoon::query(cmoon::require(s, cmoon::executors::priority(task_priority::high)), cmoon::executors::priority), task_priority::high);
+
+				release = true;
+				release.notify_one();
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_sequence_equal(order, std::vector<int>{0, 1, 2, 3});
+				cmoon::test::assert_equal(p.stats(task_priority::normal).started, std::size_t{2});
+				cmoon::test::assert_equal(p.stats(task_priority::low).started, std::size_t{1});
+				cmoon::test::assert_equal(p.deadline_stats().started, std::size_t{1});
+				cmoon::test::assert_equal(p.deadline_stats().depth, std::size_t{0});
+			}
+	};
+
+	export
+	class static_thread_pool_parallel_bulk_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_parallel_bulk_test()
+				: cmoon::test::test_case{"static_thread_pool_parallel_bulk_test"} {}
+
+			void operator()() override
+			{
+				constexpr int expected {3};
+				std::array<std::atomic<int>, 100> values {};
+				std::atomic<int> result {0};
+				std::atomic<int> errors {0};
+				cmoon::executors::static_thread_pool p {4};
+
+				// then has no bulk of its own, so this takes the default, which
+				// spreads the shape over the pool then completes on the scheduler.
+				auto work = cmoon::execution::schedule(p.get_scheduler()) |
+							cmoon::execution::then([] { return expected; }) |
+							cmoon::execution::bulk([&values](std::size_t i, int v) { values[i] += v; }, std::size(values)) |
+							cmoon::execution::then([&result](int v) { result = v; result.notify_one(); });
+
+				cmoon::execution::start_detached(std::move(work));
+				result.wait(0);
+
+				cmoon::test::assert_equal(result.load(), expected);
+				for (const auto& v : values)
+				{
+					cmoon::test::assert_equal(v.load(), expected);
+				}
+
+				auto failing = cmoon::execution::schedule(p.get_scheduler()) |
+							   cmoon::execution::then([] {}) |
+							   cmoon::execution::bulk([](std::size_t i) { if (i == 50) { throw expected; } }, std::size(values)) |
+							   cmoon::execution::upon_error([&errors](std::exception_ptr) { ++errors; errors.notify_one(); });
+
+				cmoon::execution::start_detached(std::move(failing));
+				errors.wait(0);
+
+				cmoon::test::assert_equal(errors.load(), 1);
+			}
+	};
+
+	cmoon::execution::task<std::thread::id> thread_after_schedule(cmoon::executors::static_thread_pool& p)
+	{
+		co_await cmoon::execution::schedule(p.get_scheduler());
+		co_return std::this_thread::get_id();
+	}
+
+	export
+	class static_thread_pool_task_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_task_test()
+				: cmoon::test::test_case{"static_thread_pool_task_test"} {}
+
+			void operator()() override
+			{
+				cmoon::executors::static_thread_pool p {1};
+
+				const auto [id] = cmoon::execution::sync_wait(thread_after_schedule(p)).value();
+
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_not_equal(id, std::this_thread::get_id());
+			}
+	};
+
+	export
+	class static_thread_pool_trace_test : public cmoon::test::test_case
+	{
+		public:
+			static_thread_pool_trace_test()
+				: cmoon::test::test_case{"static_thread_pool_trace_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t count {3};
+				std::array values {0, 0, 0};
+				cmoon::execution::tracer t;
+
+				{
+					cmoon::executors::static_thread_pool p {cmoon::executors::static_thread_pool_options{.threads = 2, .tracer = &t}};
+
+					auto work = cmoon::execution::bulk(cmoon::execution::schedule(p.get_scheduler()), count,
+													   [&values](std::size_t i) { values[i] = 1; });
+
+					cmoon::execution::sync_wait(cmoon::execution::schedule(p.get_scheduler()));
+					cmoon::execution::sync_wait(std::move(work));
+					p.request_stop();
+					p.join();
+				}
+
+				const auto records {t.records()};
+				cmoon::test::assert_equal(records.size(), count + 1);
+				for (const auto& r : records)
+				{
+					cmoon::test::assert_less_equal(r.enqueued, r.started);
+					cmoon::test::assert_less_equal(r.started, r.completed);
+				}
+
+				const auto summaries {t.summarize()};
+				cmoon::test::assert_equal(summaries.size(), std::size_t{2});
+				cmoon::test::assert_equal(summaries[0].name, std::string{"static_thread_pool::bulk"});
+				cmoon::test::assert_equal(summaries[0].run_time.count(), count);
+				cmoon::test::assert_equal(summaries[1].name, std::string{"static_thread_pool::schedule"});
+			}
+	};
 }
\ No newline at end of file
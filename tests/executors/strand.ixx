@@ -1,6 +1,8 @@
 export module cmoon.tests.executors.strand;
 
 import <atomic>;
+import <thread>;
+import <vector>;
 
 import cmoon.execution;
 import cmoon.executors;
@@ -20,14 +22,73 @@ namespace cmoon::tests::executors
 				constexpr int expected{5};
 				std::atomic<int> value{0};
 
-				cmoon::executors::cached_thread_pool p;
+				cmoon::executors::static_thread_pool p {2};
 				cmoon::executors::strand s{p.get_scheduler()};
 
-				//cmoon::execution::execute(s.get_scheduler(), [&value, expected] { value = expected; value.notify_one(); });
-				cmoon::test::fail("MSVC has a C1001: Internal compiler error compiling this test");
+				cmoon::execution::execute(s.get_scheduler(), [&value, expected] { value = expected; value.notify_one(); });
 
 				value.wait(0);
-				cmoon::test::assert_equal(value, expected);
+				cmoon::test::assert_equal(value.load(), expected);
 			}
 	};
-}
\ No newline at end of file
+
+	export
+	class strand_serial_execute_test : public cmoon::test::test_case
+	{
+		public:
+			strand_serial_execute_test()
+				: cmoon::test::test_case{"strand_serial_execute_test"} {}
+
+			void operator()() override
+			{
+				constexpr int producers {4};
+				constexpr int jobs {5000};
+
+				int counter {0};
+				std::atomic<int> running {0};
+				std::atomic<int> overlaps {0};
+				std::atomic<int> out_of_order {0};
+				std::vector<int> last_seen(producers, -1);
+
+				cmoon::executors::static_thread_pool p {4};
+				cmoon::executors::strand s{p.get_scheduler(), 8};
+
+				std::vector<std::thread> threads;
+				for (int t {0}; t < producers; ++t)
+				{
+					threads.emplace_back([&, t] {
+						for (int i {0}; i < jobs; ++i)
+						{
+							cmoon::execution::execute(s.get_scheduler(), [&, t, i] {
+								if (running.fetch_add(1) != 0)
+								{
+									++overlaps;
+								}
+
+								++counter;
+								if (last_seen[t] != i - 1)
+								{
+									++out_of_order;
+								}
+
+								last_seen[t] = i;
+								running.fetch_sub(1);
+							});
+						}
+					});
+				}
+
+				for (auto& t : threads)
+				{
+					t.join();
+				}
+
+				p.request_stop();
+				p.join();
+
+				cmoon::test::assert_equal(counter, producers * jobs);
+				cmoon::test::assert_equal(overlaps.load(), 0);
+				cmoon::test::assert_equal(out_of_order.load(), 0);
+			}
+	};
+}
@@ -0,0 +1,144 @@
+export module cmoon.tests.executors.timer_context;
+
+import <array>;
+import <atomic>;
+import <chrono>;
+import <utility>;
+
+import cmoon.thread;
+import cmoon.execution;
+import cmoon.executors;
+import cmoon.test;
+
+namespace cmoon::tests::executors
+{
+	export
+	class timer_context_schedule_after_test : public cmoon::test::test_case
+	{
+		public:
+			timer_context_schedule_after_test()
+				: cmoon::test::test_case{"timer_context_schedule_after_test"} {}
+
+			void operator()() override
+			{
+				std::array<int, 3> order {0, 0, 0};
+				std::atomic<int> fired {0};
+				cmoon::executors::timer_context ctx;
+
+				auto s = ctx.get_scheduler();
+				const auto start = cmoon::execution::now(s);
+
+				const auto after = [&](std::chrono::milliseconds delay, int id) {
+					return cmoon::execution::schedule_after(s, delay) |
+						   cmoon::execution::then([&order, &fired, id] {
+							   order[fired] = id;
+							   ++fired;
+							   fired.notify_one();
+						   });
+				};
+
+				cmoon::execution::start_detached(after(std::chrono::milliseconds{60}, 3));
+				cmoon::execution::start_detached(after(std::chrono::milliseconds{20}, 1));
+				cmoon::execution::start_detached(after(std::chrono::milliseconds{40}, 2));
+
+				for (auto n {fired.load()}; n != 3; n = fired.load())
+				{
+					fired.wait(n);
+				}
+
+				cmoon::test::assert_greater_equal(cmoon::execution::now(s) - start, std::chrono::milliseconds{60});
+				cmoon::test::assert_equal(order[0], 1);
+				cmoon::test::assert_equal(order[1], 2);
+				cmoon::test::assert_equal(order[2], 3);
+			}
+	};
+
+	export
+	class timer_context_schedule_at_test : public cmoon::test::test_case
+	{
+		public:
+			timer_context_schedule_at_test()
+				: cmoon::test::test_case{"timer_context_schedule_at_test"} {}
+
+			void operator()() override
+			{
+				std::atomic<bool> fired {false};
+				cmoon::executors::timer_context ctx;
+
+				auto s = ctx.get_scheduler();
+				const auto deadline = cmoon::execution::now(s) + std::chrono::milliseconds{30};
+
+				auto work = cmoon::execution::schedule_at(s, deadline) |
+							cmoon::execution::then([&fired] {
+								fired = true;
+								fired.notify_one();
+							});
+
+				cmoon::execution::start_detached(std::move(work));
+				fired.wait(false);
+
+				cmoon::test::assert_greater_equal(cmoon::execution::now(s), deadline);
+				cmoon::test::assert_equal(ctx.pending(), std::size_t{0});
+			}
+	};
+
+	export
+	class timer_context_cancel_test : public cmoon::test::test_case
+	{
+		struct stoppable_r
+		{
+			friend void tag_invoke(cmoon::execution::set_value_t, stoppable_r&& r) noexcept
+			{
+				r.result->store(1);
+				r.result->notify_one();
+			}
+
+			template<class E>
+			friend void tag_invoke(cmoon::execution::set_error_t, stoppable_r&& r, E&&) noexcept
+			{
+				r.result->store(2);
+				r.result->notify_one();
+			}
+
+			friend void tag_invoke(cmoon::execution::set_done_t, stoppable_r&& r) noexcept
+			{
+				r.result->store(3);
+				r.result->notify_one();
+			}
+
+			friend cmoon::in_place_stop_token tag_invoke(cmoon::execution::get_stop_token_t, const stoppable_r& r) noexcept
+			{
+				return r.source->get_token();
+			}
+
+			std::atomic<int>* result;
+			cmoon::in_place_stop_source* source;
+		};
+
+		public:
+			timer_context_cancel_test()
+				: cmoon::test::test_case{"timer_context_cancel_test"} {}
+
+			void operator()() override
+			{
+				constexpr int done {3};
+				std::atomic<int> result {0};
+				cmoon::in_place_stop_source source;
+				cmoon::executors::timer_context ctx;
+
+				auto op = cmoon::execution::connect(
+							cmoon::execution::schedule_after(ctx.get_scheduler(), std::chrono::hours{1}),
+							stoppable_r{&result, &source}
+						  );
+
+				cmoon::execution::start(op);
+				cmoon::test::assert_equal(ctx.pending(), std::size_t{1});
+
+				source.request_stop();
+				result.wait(0);
+
+				cmoon::test::assert_equal(result.load(), done);
+				cmoon::test::assert_equal(ctx.pending(), std::size_t{0});
+			}
+	};
+}
\ No newline at end of file
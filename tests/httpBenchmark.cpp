@@ -0,0 +1,193 @@
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include "cmoon/net/http_server.hpp"
+
+import <iostream>;
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cstddef>;
+import <format>;
+import <memory>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <thread>;
+import <vector>;
+
+import cmoon.net;
+import cmoon.benchmarking;
+
+// Each client keeps one connection open and sends its requests one after
+// another, timing each from the write until its whole response is parsed.
+class http_server_benchmark : public cmoon::benchmarking::benchmark
+{
+	using clock = std::chrono::steady_clock;
+
+	static constexpr std::string_view request {"GET /plaintext HTTP/1.1\r\nHost: bench\r\n\r\n"};
+
+	public:
+		http_server_benchmark(cmoon::net::io_backend backend, std::size_t clients, std::size_t requests, std::size_t threads)
+			: cmoon::benchmarking::benchmark{std::format("{} HTTP Server. Clients: {}, Requests: {}, Threads: {}", backend == cmoon::net::io_backend::epoll ? "epoll" : "io_uring", clients, requests, threads), 1, 5},
+			  backend{backend}, clients{clients}, requests{requests}, threads{threads} {}
+
+		void set_up() override
+		{
+			cmoon::http::http_router router;
+			router.route(cmoon::http::get, "/plaintext", [](cmoon::http::http_request&, cmoon::http::http_response& res, std::ostream& body) {
+				res.headers()[std::string{cmoon::http::headers::content_type}] = "text/plain";
+				body << "Hello, World!";
+			});
+
+			cmoon::http::http_server_options options;
+			options.threads = threads;
+			options.backend = backend;
+			options.max_keep_alive_requests = requests * 10;
+
+			server = std::make_unique<cmoon::http::http_server>(
+				cmoon::net::ip::tcp::endpoint{cmoon::net::ip::address{cmoon::net::ip::address_v4::loopback()}, 0}, std::move(router), options);
+			server->start();
+
+			const auto endpoint {server->local_endpoint()};
+			for (std::size_t i {0}; i < clients; ++i)
+			{
+				const auto fd {::socket(AF_INET, SOCK_STREAM, 0)};
+				::connect(fd, static_cast<const ::sockaddr*>(endpoint.data()), static_cast<::socklen_t>(endpoint.size()));
+				connections.push_back(fd);
+			}
+
+			latencies.resize(clients);
+		}
+
+		void tear_down() override
+		{
+			for (const auto fd : connections)
+			{
+				::close(fd);
+			}
+
+			connections.clear();
+			server.reset();
+		}
+
+		void operator()() override
+		{
+			std::vector<std::thread> load;
+			load.reserve(connections.size());
+			const auto start {clock::now()};
+			for (std::size_t i {0}; i < connections.size(); ++i)
+			{
+				load.emplace_back([this, i] {
+					auto& samples {latencies[i]};
+					for (std::size_t r {0}; r < requests; ++r)
+					{
+						const auto sent {clock::now()};
+						round_trip(connections[i]);
+						samples.push_back(clock::now() - sent);
+					}
+				});
+			}
+
+			for (auto& t : load)
+			{
+				t.join();
+			}
+
+			elapsed += clock::now() - start;
+			completed += connections.size() * requests;
+		}
+
+		void report(std::ostream& os) const
+		{
+			std::vector<clock::duration> all;
+			for (const auto& samples : latencies)
+			{
+				all.insert(all.end(), samples.begin(), samples.end());
+			}
+
+			std::ranges::sort(all);
+			const auto percentile = [&all](double p) {
+				const auto index {static_cast<std::size_t>(p * static_cast<double>(all.size() - 1))};
+				return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(all[index]).count();
+			};
+
+			const auto seconds {std::chrono::duration<double>{elapsed}.count()};
+			os << std::format("{}\n  {:.0f} requests/sec, latency us p50 {:.1f}, p90 {:.1f}, p99 {:.1f}, p99.9 {:.1f}, max {:.1f}\n",
+							  name(), static_cast<double>(completed) / seconds,
+							  percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), percentile(1.0));
+		}
+	private:
+		cmoon::net::io_backend backend;
+		std::size_t clients;
+		std::size_t requests;
+		std::size_t threads;
+		std::unique_ptr<cmoon::http::http_server> server;
+		std::vector<int> connections;
+		std::vector<std::vector<clock::duration>> latencies;
+		clock::duration elapsed {};
+		std::size_t completed {0};
+
+		static void round_trip(int fd)
+		{
+			std::size_t sent {0};
+			while (sent < request.size())
+			{
+				const auto n {::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL)};
+				if (n <= 0)
+				{
+					throw std::system_error{errno, std::generic_category(), "send"};
+				}
+
+				sent += static_cast<std::size_t>(n);
+			}
+
+			cmoon::http::http_parser parser {cmoon::http::http_message_kind::response};
+			std::array<char, 1024> buffer;
+			std::size_t begin {0};
+			std::size_t end {0};
+			while (true)
+			{
+				const auto result {parser.parse(std::string_view{buffer.data() + begin, end - begin})};
+				begin += result.consumed;
+				if (result.event == cmoon::http::http_parse_event::message_complete)
+				{
+					return;
+				}
+
+				if (result.event == cmoon::http::http_parse_event::need_more)
+				{
+					const auto n {::recv(fd, buffer.data() + end, buffer.size() - end, 0)};
+					if (n <= 0)
+					{
+						throw std::system_error{errno, std::generic_category(), "recv"};
+					}
+
+					end += static_cast<std::size_t>(n);
+				}
+			}
+		}
+};
+
+void compare_backends(std::size_t clients, std::size_t requests, std::size_t threads)
+{
+	http_server_benchmark epoll {cmoon::net::io_backend::epoll, clients, requests, threads};
+	http_server_benchmark io_uring {cmoon::net::io_backend::io_uring, clients, requests, threads};
+
+	cmoon::benchmarking::benchmark_compare compare;
+	compare.run(epoll);
+	compare.run(io_uring);
+
+	std::cout << compare;
+	epoll.report(std::cout);
+	io_uring.report(std::cout);
+	std::cout << "------------------------------------------\n\n";
+}
+
+int main()
+{
+	compare_backends(1, 10000, 1);
+	compare_backends(16, 2000, 2);
+	compare_backends(64, 500, 4);
+}
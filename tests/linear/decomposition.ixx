@@ -0,0 +1,179 @@
+export module cmoon.tests.linear.decomposition;
+
+import <cstddef>;
+import <stdexcept>;
+
+import cmoon.test;
+import cmoon.linear;
+
+namespace cmoon::tests::linear
+{
+	export
+	class lu_decomposition_test : public cmoon::test::test_case
+	{
+		public:
+			lu_decomposition_test()
+				: cmoon::test::test_case{"lu_decomposition_test"} {}
+
+			void operator()() override
+			{
+				constexpr double delta = 0.000000001;
+				constexpr std::size_t size {150};
+
+				cmoon::linear::matrix<double> a{size, size};
+				for (std::size_t i {0}; i < a.size(); ++i)
+				{
+					a[i] = static_cast<double>((i * i * 7919 + i) % 1009) / 100.0 - 5.0;
+				}
+
+				cmoon::linear::matrix<double> b{size, 3};
+				for (std::size_t i {0}; i < b.size(); ++i)
+				{
+					b[i] = static_cast<double>(i % 17);
+				}
+
+				const cmoon::linear::lu_decomposition lu {a};
+				const auto x = lu.solve(b);
+				const auto ax = cmoon::linear::standard_mult(a, x);
+				cmoon::test::assert_sequence_almost_equal(std::begin(ax), std::end(ax), std::begin(b), delta);
+
+				const auto inv = lu.inverse();
+				const auto identity = cmoon::linear::standard_mult(a, inv);
+				const auto goal = cmoon::linear::identity_matrix<double>(size);
+				cmoon::test::assert_sequence_almost_equal(std::begin(identity), std::end(identity), std::begin(goal), delta);
+
+				constexpr cmoon::linear::static_matrix<int, 4, 4> mat {
+					1, 2, 3, 4,
+					5, 6, 7, 8,
+					2, 6, 4, 8,
+					3, 1, 1, 2
+				};
+
+				cmoon::test::assert_equal(cmoon::linear::determinant(mat), 72);
+				cmoon::test::assert_equal(cmoon::linear::determinant(cmoon::linear::matrix<int>{mat}), 72);
+
+				constexpr cmoon::linear::static_matrix<double, 3, 3> singular {
+					1, 2, 3,
+					2, 4, 6,
+					1, 0, 1
+				};
+
+				const cmoon::linear::lu_decomposition singular_lu {singular};
+				cmoon::test::assert_true(singular_lu.singular());
+				cmoon::test::assert_equal(singular_lu.determinant(), 0.0);
+				cmoon::test::assert_throws<std::invalid_argument>([&singular]() {
+					(void) cmoon::linear::inverse(singular);
+				});
+			}
+	};
+
+	export
+	class cholesky_decomposition_test : public cmoon::test::test_case
+	{
+		public:
+			cholesky_decomposition_test()
+				: cmoon::test::test_case{"cholesky_decomposition_test"} {}
+
+			void operator()() override
+			{
+				constexpr double delta = 0.000000001;
+				constexpr std::size_t size {130};
+
+				// A diagonally dominant symmetric matrix is positive definite.
+				cmoon::linear::matrix<double> a{size, size};
+				for (std::size_t i {0}; i < size; ++i)
+				{
+					for (std::size_t j {0}; j <= i; ++j)
+					{
+						const auto v = static_cast<double>((i * 31 + j * 17) % 13) / 13.0;
+						a(i, j) = v;
+						a(j, i) = v;
+					}
+
+					a(i, i) += static_cast<double>(size);
+				}
+
+				cmoon::linear::matrix<double> b{size, 2};
+				for (std::size_t i {0}; i < b.size(); ++i)
+				{
+					b[i] = static_cast<double>(i % 5) - 2.0;
+				}
+
+				const cmoon::linear::cholesky_decomposition cholesky {a};
+				const auto x = cholesky.solve(b);
+				const auto ax = cmoon::linear::standard_mult(a, x);
+				cmoon::test::assert_sequence_almost_equal(std::begin(ax), std::end(ax), std::begin(b), delta);
+
+				constexpr cmoon::linear::static_matrix<double, 3, 3> spd {
+					4, 12, -16,
+					12, 37, -43,
+					-16, -43, 98
+				};
+
+				constexpr cmoon::linear::static_matrix<double, 3, 3> lower {
+					2, 0, 0,
+					6, 1, 0,
+					-8, 5, 3
+				};
+
+				const cmoon::linear::cholesky_decomposition small {spd};
+				cmoon::test::assert_sequence_almost_equal(std::begin(small.lower()), std::end(small.lower()), std::begin(lower), delta);
+				cmoon::test::assert_almost_equal(small.determinant(), 36.0, delta);
+
+				cmoon::test::assert_throws<std::invalid_argument>([]() {
+					constexpr cmoon::linear::static_matrix<double, 2, 2> indefinite {
+						1, 2,
+						2, 1
+					};
+
+					(void) cmoon::linear::cholesky_decomposition{indefinite};
+				});
+			}
+	};
+
+	export
+	class qr_decomposition_test : public cmoon::test::test_case
+	{
+		public:
+			qr_decomposition_test()
+				: cmoon::test::test_case{"qr_decomposition_test"} {}
+
+			void operator()() override
+			{
+				constexpr double delta = 0.000000001;
+
+				cmoon::linear::matrix<double> a{90, 40};
+				for (std::size_t i {0}; i < a.size(); ++i)
+				{
+					a[i] = static_cast<double>((i * 104729) % 89) / 8.0 - 5.0;
+				}
+
+				const cmoon::linear::qr_decomposition qr {a};
+				const auto q = qr.q();
+				const auto r = qr.r();
+
+				const auto qr_product = cmoon::linear::standard_mult(q, r);
+				cmoon::test::assert_sequence_almost_equal(std::begin(qr_product), std::end(qr_product), std::begin(a), delta);
+
+				for (std::size_t i {0}; i < r.rows(); ++i)
+				{
+					for (std::size_t j {0}; j < i; ++j)
+					{
+						cmoon::test::assert_equal(r(i, j), 0.0);
+					}
+				}
+
+				// The least squares solution of an exactly solvable system is
+				// its solution.
+				cmoon::linear::matrix<double> x{40, 1};
+				for (std::size_t i {0}; i < x.size(); ++i)
+				{
+					x[i] = static_cast<double>(i) / 4.0;
+				}
+
+				const auto b = cmoon::linear::standard_mult(a, x);
+				const auto solved = qr.solve(b);
+				cmoon::test::assert_sequence_almost_equal(std::begin(solved), std::end(solved), std::begin(x), delta);
+			}
+	};
+}
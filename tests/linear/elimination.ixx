@@ -49,4 +49,48 @@ namespace cmoon::tests::linear
 				cmoon::test::assert_equal(result3, result4);
 			}
 	};
+
+	export
+	class integral_gaussian_elimination_test : public cmoon::test::test_case
+	{
+		public:
+			integral_gaussian_elimination_test()
+				: cmoon::test::test_case{"integral_gaussian_elimination_test"} {}
+
+			void operator()() override
+			{
+				constexpr cmoon::linear::static_matrix<int, 3, 3> a_const {2, 1, -1,
+																		   -3, -1, 2,
+																		   -2, 1, 2};
+
+				constexpr cmoon::linear::static_matrix<int, 3, 2> b_const {8, 1,
+																		   -11, -2,
+																		   -3, -4};
+
+				constexpr cmoon::linear::static_matrix<int, 3, 2> goal {2, 2,
+																		3, -2,
+																		-1, 1};
+
+				const cmoon::linear::matrix<int> a {a_const};
+				const cmoon::linear::matrix<int> b {b_const};
+
+				const cmoon::linear::matrix<int> result = cmoon::linear::gaussian_elimination(a, b);
+				const cmoon::linear::matrix<int> result2 = cmoon::linear::gaussian_elimination(a, b_const);
+				const cmoon::linear::matrix<int> result3 = cmoon::linear::gaussian_elimination(a_const, b);
+				const cmoon::linear::static_matrix<int, 3, 2> result4 = cmoon::linear::gaussian_elimination(a_const, b_const);
+
+				cmoon::test::assert_equal(result, goal);
+				cmoon::test::assert_equal(result2, goal);
+				cmoon::test::assert_equal(result3, goal);
+				cmoon::test::assert_equal(result4, goal);
+
+				const cmoon::linear::matrix<int> wide_a {cmoon::linear::static_matrix<int, 2, 2>{1, 0, 0, 2}};
+				const cmoon::linear::matrix<int> wide_b {cmoon::linear::static_matrix<int, 2, 3>{1, 2, 3, 4, 6, 8}};
+
+				const auto wide = cmoon::linear::gaussian_elimination(wide_a, wide_b);
+				cmoon::test::assert_equal(wide.rows(), 2);
+				cmoon::test::assert_equal(wide.cols(), 2);
+				cmoon::test::assert_equal(wide, cmoon::linear::static_matrix<int, 2, 2>{1, 2, 2, 3});
+			}
+	};
 }
\ No newline at end of file
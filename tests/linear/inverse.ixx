@@ -34,7 +34,7 @@ namespace cmoon::tests::linear
 
 				constexpr double delta = 0.00001;
 
-				auto constexpr_test = cmoon::linear::inverse(fixed_input_data);
+				constexpr auto constexpr_test = cmoon::linear::inverse(fixed_input_data);
 				const auto const_test2 = cmoon::linear::inverse(fixed_input_data);
 				const auto test = cmoon::linear::inverse(input_data);
 
@@ -43,4 +43,40 @@ namespace cmoon::tests::linear
 				cmoon::test::assert_sequence_almost_equal(std::begin(constexpr_test), std::end(constexpr_test), std::begin(goal), delta);
 			}
 	};
+
+	export
+	class integral_inverse_test : public cmoon::test::test_case
+	{
+		public:
+			integral_inverse_test()
+				: cmoon::test::test_case{"integral_inverse_test"} {}
+
+			void operator()() override
+			{
+				constexpr cmoon::linear::static_matrix<int, 3, 3> fixed_input_data = 
+				{
+					2, 3, 1,
+					1, 2, 1,
+					1, 1, 1
+				};
+
+				const cmoon::linear::matrix<int> input_data {fixed_input_data};
+
+				constexpr cmoon::linear::static_matrix<int, 3, 3> goal = 
+				{
+					1, -2, 1,
+					0, 1, -1,
+					-1, 1, 1
+				};
+
+				constexpr auto constexpr_test = cmoon::linear::inverse(fixed_input_data);
+				static_assert(constexpr_test == goal);
+
+				const cmoon::linear::static_matrix<int, 3, 3> fixed_test = cmoon::linear::inverse(fixed_input_data);
+				const cmoon::linear::matrix<int> test = cmoon::linear::inverse(input_data);
+
+				cmoon::test::assert_equal(fixed_test, goal);
+				cmoon::test::assert_equal(test, goal);
+			}
+	};
 }
\ No newline at end of file
@@ -11,6 +11,8 @@ export import cmoon.tests.linear.determinant;
 export import cmoon.tests.linear.adjugate;
 export import cmoon.tests.linear.inverse;
 export import cmoon.tests.linear.elimination;
+export import cmoon.tests.linear.decomposition;
+export import cmoon.tests.linear.sparse_matrix;
 
 import <utility>;
 
@@ -37,6 +39,11 @@ namespace cmoon::tests
 		suite.add_test_case<linear::mixed_matrix_add_test>();
 		suite.add_test_case<linear::mixed_matrix_minus_test>();
 		suite.add_test_case<linear::mixed_matrix_multiply_test>();
+		suite.add_test_case<linear::matrix_blocked_multiply_test>();
+		suite.add_test_case<linear::matrix_parallel_multiply_test>();
+		suite.add_test_case<linear::matrix_expression_test>();
+		suite.add_test_case<linear::static_matrix_expression_test>();
+		suite.add_test_case<linear::matrix_expression_temporary_test>();
 		suite.add_test_case<linear::row_test>();
 		suite.add_test_case<linear::static_row_test>();
 		suite.add_test_case<linear::column_test>();
@@ -49,7 +56,14 @@ namespace cmoon::tests
 		suite.add_test_case<linear::determinant_test>();
 		suite.add_test_case<linear::adjugate_test>();
 		suite.add_test_case<linear::inverse_test>();
+		suite.add_test_case<linear::integral_inverse_test>();
 		suite.add_test_case<linear::gaussian_elimination_test>();
+		suite.add_test_case<linear::integral_gaussian_elimination_test>();
+		suite.add_test_case<linear::lu_decomposition_test>();
+		suite.add_test_case<linear::cholesky_decomposition_test>();
+		suite.add_test_case<linear::qr_decomposition_test>();
+		suite.add_test_case<linear::sparse_matrix_constructor_test>();
+		suite.add_test_case<linear::sparse_matrix_multiply_test>();
 
 		return std::move(suite);
 	}
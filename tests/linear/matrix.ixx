@@ -1,7 +1,10 @@
 export module cmoon.tests.linear.matrix;
 
+import <cstddef>;
+
 import cmoon.test;
 import cmoon.linear;
+import cmoon.executors;
 
 namespace cmoon::tests::linear
 {
@@ -288,4 +291,204 @@ namespace cmoon::tests::linear
 				cmoon::test::assert_equal(mat3 * mat4, goal);
 			}
 	};
+
+	export
+	class matrix_blocked_multiply_test : public cmoon::test::test_case
+	{
+		public:
+			matrix_blocked_multiply_test()
+				: cmoon::test::test_case{"matrix_blocked_multiply_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t rows {37};
+				constexpr std::size_t inner {129};
+				constexpr std::size_t cols {23};
+
+				cmoon::linear::matrix<int> mat1{rows, inner};
+				cmoon::linear::matrix<int> mat2{inner, cols};
+
+				for (std::size_t i {0}; i < mat1.size(); ++i)
+				{
+					mat1[i] = static_cast<int>(i % 7) - 3;
+				}
+
+				for (std::size_t i {0}; i < mat2.size(); ++i)
+				{
+					mat2[i] = static_cast<int>(i % 5) - 2;
+				}
+
+				const auto goal = cmoon::linear::standard_mult(mat1, mat2);
+				cmoon::test::assert_equal(cmoon::linear::blocked_mult(mat1, mat2), goal);
+				cmoon::test::assert_equal(mat1 * mat2, goal);
+
+				cmoon::linear::matrix<double> mat3{rows, inner};
+				cmoon::linear::matrix<double> mat4{inner, cols};
+
+				for (std::size_t i {0}; i < mat3.size(); ++i)
+				{
+					mat3[i] = static_cast<double>(i % 11) * 0.5;
+				}
+
+				for (std::size_t i {0}; i < mat4.size(); ++i)
+				{
+					mat4[i] = static_cast<double>(i % 3) * 0.25;
+				}
+
+				cmoon::test::assert_equal(mat3 * mat4, cmoon::linear::standard_mult(mat3, mat4));
+			}
+	};
+
+	export
+	class matrix_parallel_multiply_test : public cmoon::test::test_case
+	{
+		public:
+			matrix_parallel_multiply_test()
+				: cmoon::test::test_case{"matrix_parallel_multiply_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t rows {301};
+				constexpr std::size_t inner {67};
+				constexpr std::size_t cols {45};
+
+				cmoon::linear::matrix<int> mat1{rows, inner};
+				cmoon::linear::matrix<int> mat2{inner, cols};
+
+				for (std::size_t i {0}; i < mat1.size(); ++i)
+				{
+					mat1[i] = static_cast<int>(i % 13) - 6;
+				}
+
+				for (std::size_t i {0}; i < mat2.size(); ++i)
+				{
+					mat2[i] = static_cast<int>(i % 9) - 4;
+				}
+
+				const auto goal = cmoon::linear::standard_mult(mat1, mat2);
+
+				cmoon::executors::static_thread_pool pool {1};
+				cmoon::test::assert_equal(cmoon::linear::parallel_mult(pool.get_scheduler(), mat1, mat2, 4), goal);
+
+				cmoon::executors::static_thread_pool pool2 {4};
+				cmoon::test::assert_equal(cmoon::linear::parallel_mult(pool2.get_scheduler(), mat1, mat2), goal);
+			}
+	};
+
+	export
+	class matrix_expression_test : public cmoon::test::test_case
+	{
+		public:
+			matrix_expression_test()
+				: cmoon::test::test_case{"matrix_expression_test"} {}
+
+			void operator()() override
+			{
+				cmoon::linear::matrix<int> mat1{2, 3};
+				mat1 = {
+					1, 3, 1,
+					0, 1, 2
+				};
+
+				cmoon::linear::matrix<int> mat2{2, 3};
+				mat2 = {
+					0, 0, 7,
+					5, 2, 1
+				};
+
+				const cmoon::linear::static_matrix<int, 2, 3> mat3 = {
+					4, 0, 1,
+					1, 1, 1
+				};
+
+				cmoon::linear::matrix<int> goal{2, 3};
+				goal = {
+					-3, 3, 14,
+					9, 4, 3
+				};
+
+				cmoon::linear::matrix<int> result = mat1 + mat2 * 2 - mat3;
+				cmoon::test::assert_equal(result, goal);
+				cmoon::test::assert_equal(mat1 + mat2 * 2 - mat3, goal);
+
+				result = result - mat1 + mat1;
+				cmoon::test::assert_equal(result, goal);
+
+				result.get_row(0) = mat1.get_row(1) + mat2.get_row(1);
+				result.get_column(2) = mat1.get_column(0) * 3;
+
+				cmoon::linear::matrix<int> goal2{2, 3};
+				goal2 = {
+					5, 3, 3,
+					9, 4, 0
+				};
+
+				cmoon::test::assert_equal(result, goal2);
+
+				cmoon::linear::matrix<int> square{2, 2};
+				square = {
+					1, 2,
+					3, 4
+				};
+
+				cmoon::test::assert_equal((square + square) * square, (square * square) * 2);
+			}
+	};
+
+	[[nodiscard]] cmoon::linear::matrix<int> make_matrix(int first)
+	{
+		cmoon::linear::matrix<int> mat{2, 2};
+		mat = {
+			first, first + 1,
+			first + 2, first + 3
+		};
+
+		return mat;
+	}
+
+	export
+	class matrix_expression_temporary_test : public cmoon::test::test_case
+	{
+		public:
+			matrix_expression_temporary_test()
+				: cmoon::test::test_case{"matrix_expression_temporary_test"} {}
+
+			void operator()() override
+			{
+				cmoon::linear::matrix<int> mat{2, 2};
+				mat = {
+					1, 2,
+					3, 4
+				};
+
+				// Temporaries are moved into the expressions, so these
+				// outlive them.
+				const auto sum = mat + make_matrix(10);
+				const auto scaled = make_matrix(20) * 2 - mat;
+				const auto chain = (mat + make_matrix(1)) - make_matrix(2);
+
+				cmoon::linear::matrix<int> goal{2, 2};
+				goal = {
+					11, 13,
+					15, 17
+				};
+				cmoon::test::assert_equal(cmoon::linear::evaluate(sum), goal);
+
+				goal = {
+					39, 40,
+					41, 42
+				};
+				cmoon::test::assert_equal(cmoon::linear::evaluate(scaled), goal);
+
+				goal = {
+					0, 1,
+					2, 3
+				};
+				cmoon::test::assert_equal(cmoon::linear::evaluate(chain), goal);
+
+				using square = cmoon::linear::static_matrix<int, 2, 2>;
+				const auto static_sum = square{1, 2, 3, 4} + square{5, 6, 7, 8} * 2;
+				cmoon::test::assert_equal(cmoon::linear::evaluate(static_sum), square{11, 14, 17, 20});
+			}
+	};
 }
\ No newline at end of file
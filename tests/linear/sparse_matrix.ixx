@@ -0,0 +1,124 @@
+export module cmoon.tests.linear.sparse_matrix;
+
+import <cstddef>;
+import <algorithm>;
+import <span>;
+import <stdexcept>;
+import <vector>;
+
+import cmoon.test;
+import cmoon.linear;
+import cmoon.executors;
+
+namespace cmoon::tests::linear
+{
+	export
+	class sparse_matrix_constructor_test : public cmoon::test::test_case
+	{
+		public:
+			sparse_matrix_constructor_test()
+				: cmoon::test::test_case{"sparse_matrix_constructor_test"} {}
+
+			void operator()() override
+			{
+				const std::vector<cmoon::linear::triplet<int>> entries {
+					{2, 1, 3},
+					{0, 0, 1},
+					{2, 1, 2},
+					{1, 3, -4},
+					{0, 2, 7},
+					{2, 0, 6}
+				};
+
+				const cmoon::linear::csr_matrix<int> csr {3, 4, entries};
+
+				cmoon::linear::matrix<int> goal{3, 4};
+				goal = {
+					1, 0, 7, 0,
+					0, 0, 0, -4,
+					6, 5, 0, 0
+				};
+
+				cmoon::test::assert_equal(csr.non_zeros(), std::size_t{5});
+				cmoon::test::assert_equal(csr(2, 1), 5);
+				cmoon::test::assert_equal(csr(0, 1), 0);
+				cmoon::test::assert_equal(csr.to_dense(), goal);
+				cmoon::test::assert_true(cmoon::linear::csr_matrix<int>{goal} == csr);
+
+				const cmoon::linear::csc_matrix<int> csc {csr};
+				cmoon::test::assert_equal(csc.to_dense(), goal);
+				cmoon::test::assert_true(cmoon::linear::csc_matrix<int>{goal} == csc);
+				cmoon::test::assert_true(cmoon::linear::csr_matrix<int>{csc} == csr);
+
+				const auto t = cmoon::linear::transpose(csr);
+				cmoon::test::assert_equal(t.to_dense(), cmoon::linear::transpose(goal));
+
+				const auto fixed = static_cast<cmoon::linear::static_matrix<int, 3, 4>>(csr);
+				cmoon::test::assert_equal(fixed, goal);
+
+				cmoon::test::assert_throws<std::out_of_range>([]() {
+					const std::vector<cmoon::linear::triplet<int>> outside {{3, 0, 1}};
+					(void) cmoon::linear::csr_matrix<int>{3, 3, outside};
+				});
+			}
+	};
+
+	export
+	class sparse_matrix_multiply_test : public cmoon::test::test_case
+	{
+		public:
+			sparse_matrix_multiply_test()
+				: cmoon::test::test_case{"sparse_matrix_multiply_test"} {}
+
+			void operator()() override
+			{
+				// A banded matrix with enough non-zeros to be split across tasks.
+				constexpr std::size_t size {3000};
+				std::vector<cmoon::linear::triplet<int>> entries;
+				for (std::size_t i {0}; i < size; ++i)
+				{
+					for (std::size_t j {i < 3 ? 0 : i - 3}; j < std::min(i + 4, size); ++j)
+					{
+						entries.push_back({i, j, static_cast<int>((i + 2 * j) % 7) - 3});
+					}
+				}
+
+				const cmoon::linear::csr_matrix<int> csr {size, size, entries};
+				const cmoon::linear::csc_matrix<int> csc {csr};
+				const auto dense = csr.to_dense();
+
+				cmoon::linear::matrix<int> b{size, 3};
+				for (std::size_t i {0}; i < b.size(); ++i)
+				{
+					b[i] = static_cast<int>(i % 11) - 5;
+				}
+
+				const auto goal = dense * b;
+				cmoon::test::assert_equal(csr * b, goal);
+				cmoon::test::assert_equal(csc * b, goal);
+
+				cmoon::executors::static_thread_pool pool {4};
+				cmoon::test::assert_equal(cmoon::linear::parallel_mult(pool.get_scheduler(), csr, b), goal);
+
+				std::vector<int> x(size);
+				for (std::size_t i {0}; i < size; ++i)
+				{
+					x[i] = b(i, 0);
+				}
+
+				std::vector<int> y(size);
+				std::vector<int> y_csc(size);
+				std::vector<int> y_parallel(size);
+				cmoon::linear::multiply(csr, std::span<const int>{x}, std::span<int>{y});
+				cmoon::linear::multiply(csc, std::span<const int>{x}, std::span<int>{y_csc});
+				cmoon::linear::parallel_multiply(pool.get_scheduler(), csr, std::span<const int>{x}, std::span<int>{y_parallel});
+
+				for (std::size_t i {0}; i < size; ++i)
+				{
+					cmoon::test::assert_equal(y[i], goal(i, 0));
+					cmoon::test::assert_equal(y_csc[i], goal(i, 0));
+					cmoon::test::assert_equal(y_parallel[i], goal(i, 0));
+				}
+			}
+	};
+}
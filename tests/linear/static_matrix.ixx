@@ -130,4 +130,36 @@ namespace cmoon::tests::linear
 				cmoon::test::assert_equal(mat * 2, mat2);
 			}
 	};
+
+	export
+	class static_matrix_expression_test : public cmoon::test::test_case
+	{
+		public:
+			static_matrix_expression_test()
+				: cmoon::test::test_case{"static_matrix_expression_test"} {}
+
+			void operator()() override
+			{
+				constexpr cmoon::linear::static_matrix<int, 2, 2> mat1 = {
+					1, 3,
+					1, 0
+				};
+
+				constexpr cmoon::linear::static_matrix<int, 2, 2> mat2 = {
+					0, 7,
+					5, 2
+				};
+
+				constexpr cmoon::linear::static_matrix<int, 2, 2> goal = {
+					2, 1,
+					-3, 0
+				};
+
+				constexpr cmoon::linear::static_matrix<int, 2, 2> result = mat1 * 2 + mat2 - mat2 * 2 + mat2 * 1 % 5;
+
+				static_assert(result == goal);
+				static_assert(mat1 * 2 + mat2 - mat2 * 2 + mat2 * 1 % 5 == goal);
+				cmoon::test::assert_equal(cmoon::linear::evaluate(mat1 * 2 + mat2 - mat2 * 2 + mat2 * 1 % 5), goal);
+			}
+	};
 }
\ No newline at end of file
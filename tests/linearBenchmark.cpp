@@ -1,23 +1,21 @@
-#include <iostream>
-#include <fstream>
-#include <random>
-#include <string>
-
-#include "cmoon/format.hpp"
-#include "cmoon/linear/matrix.hpp"
-#include "cmoon/linear/algorithms.hpp"
-#include "cmoon/cuda/unified_memory.hpp"
-#include "cmoon/cuda/algorithm.hpp"
-#include "cmoon/benchmark/benchmark.hpp"
-#include "cmoon/benchmark/runner.hpp"
-#include "cmoon/benchmark/suite.hpp"
+import <iostream>;
+import <fstream>;
+import <random>;
+import <string>;
+import <format>;
+import <typeinfo>;
+import <type_traits>;
+
+import cmoon.linear;
+import cmoon.cuda;
+import cmoon.benchmarking;
 
 template<class T, class Allocator>
 void fill_matrix(cmoon::linear::matrix<T, Allocator>& m)
 {
 	std::random_device rd;
 	std::mt19937 gen{rd()};
-	std::conditional_t<std::is_integral_v<T>, 
+	std::conditional_t<std::is_integral_v<T>,
 		std::uniform_int_distribution<T>,
 		std::uniform_real_distribution<T>> d;
 
@@ -32,7 +30,7 @@ void fill_matrix(cmoon::linear::square_matrix<T, S>& m)
 {
 	std::random_device rd;
 	std::mt19937 gen{rd()};
-	std::conditional_t<std::is_integral_v<T>, 
+	std::conditional_t<std::is_integral_v<T>,
 		std::uniform_int_distribution<T>,
 		std::uniform_real_distribution<T>> d;
 
@@ -42,35 +40,47 @@ void fill_matrix(cmoon::linear::square_matrix<T, S>& m)
 	}
 }
 
-//template<class T>
-//void benchmark_inverse_matrix(std::size_t matrix_size)
-//{
-//	std::random_device rd;
-//	std::mt19937 gen{rd()};
-//	std::uniform_int_distribution<> d;
-//
-//	cmoon::linear::matrix<T> m1{matrix_size, matrix_size};
-//
-//	fill_matrix(m1);
-//
-//	std::cout << "Inverse benchmark for a matrix of size " << matrix_size << ":\n";
-//
-//	const auto time_now = std::chrono::system_clock::now();
-//	cmoon::linear::inverse(m1);
-//	const auto elapsed_time = std::chrono::system_clock::now() - time_now;
-//	std::cout << "Time Elapsed: ";
-//	print_time(elapsed_time);
-//	std::cout << '\n';
-//}
+struct naive_mult
+{
+	static constexpr std::string_view name {"Naive"};
 
-template<class T>
-class matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
+	template<class M1, class M2>
+	auto operator()(const M1& lhs, const M2& rhs) const
+	{
+		return cmoon::linear::standard_mult(lhs, rhs);
+	}
+};
+
+struct strassen_mult
+{
+	static constexpr std::string_view name {"Strassen"};
+
+	template<class M1, class M2>
+	auto operator()(const M1& lhs, const M2& rhs) const
+	{
+		return cmoon::linear::strassen_mult(lhs, rhs);
+	}
+};
+
+struct blocked_mult
+{
+	static constexpr std::string_view name {"Blocked"};
+
+	template<class M1, class M2>
+	auto operator()(const M1& lhs, const M2& rhs) const
+	{
+		return lhs * rhs;
+	}
+};
+
+template<class T, class Mult = blocked_mult>
+class matrix_multiplication_benchmark : public cmoon::benchmarking::benchmark
 {
 	public:
 		matrix_multiplication_benchmark(std::size_t size)
-			: cmoon::benchmark::benchmark{cmoon::format("Matrix Multiplication ({0:}). Size: {1:}x{1:}", typeid(T).name(), size), 1, 5}, size{size} {}
+			: cmoon::benchmarking::benchmark{std::format("{0} Matrix Multiplication ({1}). Size: {2}x{2}", Mult::name, typeid(T).name(), size), 1, 5}, size{size} {}
 
-		virtual void set_up() override
+		void set_up() override
 		{
 			m1.resize(size, size);
 			m2.resize(size, size);
@@ -78,16 +88,17 @@ class matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
 			fill_matrix(m2);
 		}
 
-		virtual void tear_down() override
+		void tear_down() override
 		{
 			// Release space between runs
 			m1.resize(0, 0);
 			m2.resize(0, 0);
 		}
 
-		inline virtual void run() override
+		void operator()() override
 		{
-			const auto m3 = m1 * m2;
+			const auto m3 {Mult{}(m1, m2)};
+			cmoon::benchmarking::do_not_optimize(m3);
 		}
 	private:
 		std::size_t size;
@@ -95,22 +106,23 @@ class matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
 		cmoon::linear::matrix<T> m2;
 };
 
-template<class T, std::size_t S>
-class fixed_matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
+template<class T, std::size_t S, class Mult = blocked_mult>
+class fixed_matrix_multiplication_benchmark : public cmoon::benchmarking::benchmark
 {
 	public:
 		fixed_matrix_multiplication_benchmark()
-			: cmoon::benchmark::benchmark{cmoon::format("Fixed Matrix Multiplication ({0:}). Size: {1:}x{1:}", typeid(T).name(), S), 1, 5} {}
+			: cmoon::benchmarking::benchmark{std::format("{0} Fixed Matrix Multiplication ({1}). Size: {2}x{2}", Mult::name, typeid(T).name(), S), 1, 5} {}
 
-		virtual void set_up() override
+		void set_up() override
 		{
 			fill_matrix(m1);
 			fill_matrix(m2);
 		}
 
-		inline virtual void run() override
+		void operator()() override
 		{
-			const auto m3 = m1 * m2;
+			const auto m3 {Mult{}(m1, m2)};
+			cmoon::benchmarking::do_not_optimize(m3);
 		}
 	private:
 		cmoon::linear::square_matrix<T, S> m1;
@@ -118,13 +130,13 @@ class fixed_matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
 };
 
 template<class T>
-class gpu_matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
+class gpu_matrix_multiplication_benchmark : public cmoon::benchmarking::benchmark
 {
 	public:
 		gpu_matrix_multiplication_benchmark(std::size_t size)
-			: cmoon::benchmark::benchmark{cmoon::format("Matrix Multiplication ({0:}) with GPU. Size: {1:}x{1:}", typeid(T).name(), size), 1, 20}, size{size} {}
+			: cmoon::benchmarking::benchmark{std::format("Matrix Multiplication ({0}) with GPU. Size: {1}x{1}", typeid(T).name(), size), 1, 20}, size{size} {}
 
-		virtual void set_up() override
+		void set_up() override
 		{
 			m1.resize(size, size);
 			m2.resize(size, size);
@@ -132,16 +144,17 @@ class gpu_matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
 			fill_matrix(m2);
 		}
 
-		virtual void tear_down() override
+		void tear_down() override
 		{
 			// Release space between runs
 			m1.resize(0, 0);
 			m2.resize(0, 0);
 		}
 
-		inline virtual void run() override
+		void operator()() override
 		{
-			const auto m3 = cmoon::cuda::matrix_multiply(m1, m2);
+			const auto m3 {cmoon::cuda::matrix_multiply(m1, m2)};
+			cmoon::benchmarking::do_not_optimize(m3);
 		}
 	private:
 		std::size_t size;
@@ -149,12 +162,161 @@ class gpu_matrix_multiplication_benchmark : public cmoon::benchmark::benchmark
 		cmoon::linear::matrix<T, cmoon::cuda::unified_memory_allocator<T>> m2;
 };
 
+struct lu_factor
+{
+	static constexpr std::string_view name {"LU"};
+
+	template<class M>
+	auto operator()(const M& m) const
+	{
+		return cmoon::linear::lu_decomposition{m};
+	}
+};
+
+struct cholesky_factor
+{
+	static constexpr std::string_view name {"Cholesky"};
+
+	template<class M>
+	auto operator()(const M& m) const
+	{
+		return cmoon::linear::cholesky_decomposition{m};
+	}
+};
+
+struct qr_factor
+{
+	static constexpr std::string_view name {"QR"};
+
+	template<class M>
+	auto operator()(const M& m) const
+	{
+		return cmoon::linear::qr_decomposition{m};
+	}
+};
+
+// Factors a symmetric positive definite matrix, so every decomposition
+// applies to the same input.
+template<class T, class Factor>
+class decomposition_benchmark : public cmoon::benchmarking::benchmark
+{
+	public:
+		decomposition_benchmark(std::size_t size)
+			: cmoon::benchmarking::benchmark{std::format("{0} Decomposition ({1}). Size: {2}x{2}", Factor::name, typeid(T).name(), size), 1, 3}, size{size} {}
+
+		void set_up() override
+		{
+			cmoon::linear::matrix<T> a{size, size};
+			fill_matrix(a);
+			m = cmoon::linear::transpose(a) * a;
+			for (std::size_t i {0}; i < size; ++i)
+			{
+				m(i, i) += static_cast<T>(size);
+			}
+		}
+
+		void tear_down() override
+		{
+			m.resize(0, 0);
+		}
+
+		void operator()() override
+		{
+			const auto d {Factor{}(m)};
+			cmoon::benchmarking::do_not_optimize(d);
+		}
+	private:
+		std::size_t size;
+		cmoon::linear::matrix<T> m;
+};
+
+// Solves against the same matrix for several right-hand sides, either
+// refactoring for every solve or reusing a single factorization.
+template<class T, bool Refactor>
+class repeated_solve_benchmark : public cmoon::benchmarking::benchmark
+{
+	public:
+		repeated_solve_benchmark(std::size_t size, std::size_t solves)
+			: cmoon::benchmarking::benchmark{std::format("{0} Solve x{1} ({2}). Size: {3}x{3}", Refactor ? "Refactored" : "Factored Once", solves, typeid(T).name(), size), 1, 3}, size{size}, solves{solves} {}
+
+		void set_up() override
+		{
+			m.resize(size, size);
+			b.resize(size, 1);
+			fill_matrix(m);
+			fill_matrix(b);
+		}
+
+		void tear_down() override
+		{
+			m.resize(0, 0);
+			b.resize(0, 0);
+		}
+
+		void operator()() override
+		{
+			if constexpr (Refactor)
+			{
+				for (std::size_t i {0}; i < solves; ++i)
+				{
+					const auto x {cmoon::linear::solve(m, b)};
+					cmoon::benchmarking::do_not_optimize(x);
+				}
+			}
+			else
+			{
+				const cmoon::linear::lu_decomposition lu {m};
+				for (std::size_t i {0}; i < solves; ++i)
+				{
+					const auto x {lu.solve(b)};
+					cmoon::benchmarking::do_not_optimize(x);
+				}
+			}
+		}
+	private:
+		std::size_t size;
+		std::size_t solves;
+		cmoon::linear::matrix<T> m;
+		cmoon::linear::matrix<T> b;
+};
+
+template<class T>
+void compare_multiplication(std::size_t size)
+{
+	cmoon::benchmarking::benchmark_compare compare;
+	compare.run(matrix_multiplication_benchmark<T, naive_mult>{size});
+	compare.run(matrix_multiplication_benchmark<T, strassen_mult>{size});
+	compare.run(matrix_multiplication_benchmark<T, blocked_mult>{size});
+
+	std::cout << compare;
+	std::cout << "------------------------------------------\n\n";
+}
+
+template<class T>
+void compare_decomposition(std::size_t size)
+{
+	cmoon::benchmarking::benchmark_compare compare;
+	compare.run(decomposition_benchmark<T, lu_factor>{size});
+	compare.run(decomposition_benchmark<T, cholesky_factor>{size});
+	compare.run(decomposition_benchmark<T, qr_factor>{size});
+
+	std::cout << compare;
+	std::cout << "------------------------------------------\n\n";
+
+	cmoon::benchmarking::benchmark_compare compare_solve;
+	compare_solve.run(repeated_solve_benchmark<T, true>{size, 10});
+	compare_solve.run(repeated_solve_benchmark<T, false>{size, 10});
+
+	std::cout << compare_solve;
+	std::cout << "------------------------------------------\n\n";
+}
+
 int main()
 {
-	cmoon::benchmark::benchmark_suite cpu_suite;
-	cmoon::benchmark::benchmark_suite cpu_power2_suite;
-	cmoon::benchmark::benchmark_suite cpu_power2_fixed_suite;
-	cmoon::benchmark::benchmark_suite gpu_suite;
+	cmoon::benchmarking::benchmark_suite cpu_suite;
+	cmoon::benchmarking::benchmark_suite cpu_power2_suite;
+	cmoon::benchmarking::benchmark_suite cpu_power2_fixed_suite;
+	cmoon::benchmarking::benchmark_suite gpu_suite;
 	cpu_suite.add_benchmark<matrix_multiplication_benchmark<int>>(10);
 	cpu_suite.add_benchmark<matrix_multiplication_benchmark<int>>(20);
 	cpu_suite.add_benchmark<matrix_multiplication_benchmark<int>>(30);
@@ -203,6 +365,7 @@ int main()
 	cpu_power2_fixed_suite.add_benchmark<fixed_matrix_multiplication_benchmark<int, 32>>();
 	cpu_power2_fixed_suite.add_benchmark<fixed_matrix_multiplication_benchmark<int, 64>>();
 	cpu_power2_fixed_suite.add_benchmark<fixed_matrix_multiplication_benchmark<int, 128>>();
+	cpu_power2_fixed_suite.add_benchmark<fixed_matrix_multiplication_benchmark<int, 128, naive_mult>>();
 
 	gpu_suite.add_benchmark<gpu_matrix_multiplication_benchmark<int>>(10);
 	gpu_suite.add_benchmark<gpu_matrix_multiplication_benchmark<int>>(20);
@@ -233,12 +396,22 @@ int main()
 	std::ofstream cpu_benchmarks {"cpu_matrix_multiplication.txt"};
 	std::ofstream gpu_benchmarks {"gpu_matrix_multiplication.txt"};
 
-	cmoon::benchmark::text_benchmark_runner cpu_runner{std::cout};
-	cmoon::benchmark::text_benchmark_runner cpu_power2_runner {cpu_benchmarks};
-	cmoon::benchmark::text_benchmark_runner gpu_runner{std::cout};
+	cmoon::benchmarking::text_benchmark_runner cpu_runner{std::cout};
+	cmoon::benchmarking::text_benchmark_runner cpu_power2_runner {cpu_benchmarks};
+	cmoon::benchmarking::text_benchmark_runner gpu_runner{std::cout};
+
+	// Strassen only applies to square matrices with a power of 2 dimension
+	compare_multiplication<int>(256);
+	compare_multiplication<int>(512);
+	compare_multiplication<int>(1024);
+	compare_multiplication<float>(512);
+	compare_multiplication<float>(1024);
+	compare_multiplication<double>(1024);
+
+	compare_decomposition<double>(1000);
 
 	//cpu_runner.run(cpu_suite);
 	//cpu_power2_runner.run(cpu_power2_suite);
 	//cpu_power2_runner.run(cpu_power2_fixed_suite);
-	gpu_runner.run(gpu_suite);
-}
\ No newline at end of file
+	//gpu_runner.run(gpu_suite);
+}
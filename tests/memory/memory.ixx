@@ -0,0 +1,24 @@
+export module cmoon.tests.memory;
+export import cmoon.tests.memory.recycling_allocator;
+
+import <utility>;
+
+import cmoon.test;
+import cmoon.library;
+
+namespace cmoon
+{
+	export
+	template<>
+	struct library_traits<library::memory>
+	{
+		static cmoon::test::test_suite tests()
+		{
+			cmoon::test::test_suite suite{"memory library tests"};
+			suite.add_test_case<tests::memory::recycling_allocator_reuse_test>();
+			suite.add_test_case<tests::memory::recycling_allocator_sizes_test>();
+
+			return std::move(suite);
+		}
+	};
+}
\ No newline at end of file
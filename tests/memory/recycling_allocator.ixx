@@ -0,0 +1,81 @@
+export module cmoon.tests.memory.recycling_allocator;
+
+import <cstddef>;
+import <cstdint>;
+import <vector>;
+import <thread>;
+
+import cmoon.test;
+import cmoon.memory;
+
+namespace cmoon::tests::memory
+{
+	export
+	class recycling_allocator_reuse_test : public cmoon::test::test_case
+	{
+		public:
+			recycling_allocator_reuse_test()
+				: cmoon::test::test_case{"recycling_allocator_reuse_test"} {}
+
+			void operator()() override
+			{
+				cmoon::recycling_allocator<int> alloc;
+				const auto first {alloc.allocate(3)};
+				alloc.deallocate(first, 3);
+
+				// 3 and 4 ints fall in the same size class.
+				const auto second {alloc.allocate(4)};
+				cmoon::test::assert_true(second == first);
+				alloc.deallocate(second, 4);
+
+				const auto before {cmoon::recycling_pool::stats()};
+				for (int i {0}; i < 100; ++i)
+				{
+					alloc.deallocate(alloc.allocate(4), 4);
+				}
+				const auto after {cmoon::recycling_pool::stats()};
+
+				cmoon::test::assert_equal(after.upstream_allocations, before.upstream_allocations);
+				cmoon::test::assert_equal(after.recycled_allocations, before.recycled_allocations + 100);
+			}
+	};
+
+	export
+	class recycling_allocator_sizes_test : public cmoon::test::test_case
+	{
+		struct alignas(64) cache_line
+		{
+			std::byte bytes[64];
+		};
+
+		public:
+			recycling_allocator_sizes_test()
+				: cmoon::test::test_case{"recycling_allocator_sizes_test"} {}
+
+			void operator()() override
+			{
+				cmoon::recycling_allocator<std::byte> bytes;
+				const auto large {bytes.allocate(cmoon::recycling_pool::max_block + 1)};
+				bytes.deallocate(large, cmoon::recycling_pool::max_block + 1);
+
+				cmoon::recycling_allocator<cache_line> lines {bytes};
+				const auto line {lines.allocate(1)};
+				cmoon::test::assert_equal(reinterpret_cast<std::uintptr_t>(line) % alignof(cache_line), std::uintptr_t{0});
+				lines.deallocate(line, 1);
+
+				std::vector<int, cmoon::recycling_allocator<int>> v;
+				for (int i {0}; i < 1000; ++i)
+				{
+					v.push_back(i);
+				}
+				cmoon::test::assert_equal(v.back(), 999);
+
+				// Memory can be freed on a different thread than it came from.
+				const auto p {bytes.allocate(32)};
+				std::thread{[p, bytes]() mutable { bytes.deallocate(p, 32); }}.join();
+
+				cmoon::recycling_pool::release();
+				cmoon::test::assert_true(bytes == cmoon::recycling_allocator<int>{});
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+export module cmoon.tests.net.buffer_pool;
+
+import <cstddef>;
+import <algorithm>;
+import <cstring>;
+import <string>;
+import <string_view>;
+import <system_error>;
+
+import cmoon.test;
+import cmoon.net;
+
+namespace cmoon::tests::net
+{
+	// Serves the given text in reads of at most chunk bytes.
+	class text_stream
+	{
+		public:
+			text_stream(std::string_view text, std::size_t chunk)
+				: text_{text}, chunk_{chunk} {}
+
+			template<class MutableBufferSequence>
+			std::size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec)
+			{
+				ec.clear();
+				std::size_t transferred {0};
+				for (auto i {cmoon::net::buffer_sequence_begin(buffers)}; i != cmoon::net::buffer_sequence_end(buffers); ++i)
+				{
+					const cmoon::net::mutable_buffer b {*i};
+					const auto n {std::min({b.size(), text_.size(), chunk_ - transferred})};
+					std::memcpy(b.data(), text_.data(), n);
+					text_.remove_prefix(n);
+					transferred += n;
+				}
+
+				if (transferred == 0)
+				{
+					ec = std::make_error_code(std::errc::connection_reset);
+				}
+
+				return transferred;
+			}
+		private:
+			std::string_view text_;
+			std::size_t chunk_;
+	};
+
+	export
+	class dynamic_slab_buffer_test : public cmoon::test::test_case
+	{
+		public:
+			dynamic_slab_buffer_test()
+				: cmoon::test::test_case{"dynamic_slab_buffer_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::string_view text {"a message long enough to span several small slabs"};
+
+				cmoon::net::buffer_pool pool {16};
+				cmoon::net::slab_chain chain {pool};
+				text_stream stream {text, 7};
+
+				cmoon::test::assert_equal(cmoon::net::read(stream, cmoon::net::dynamic_buffer(chain), cmoon::net::transfer_exactly{40}), std::size_t{40});
+				cmoon::test::assert_equal(chain.slab_count(), std::size_t{3});
+				cmoon::test::assert_equal(contents(chain), std::string{text.substr(0, 40)});
+				cmoon::test::assert_equal(pool.statistics().in_use, std::size_t{3});
+
+				// Consumed slabs go straight back to the pool.
+				chain.consume(20);
+				cmoon::test::assert_equal(chain.slab_count(), std::size_t{2});
+				cmoon::test::assert_equal(contents(chain), std::string{text.substr(20, 20)});
+				cmoon::test::assert_equal(pool.statistics().cached, std::size_t{1});
+
+				cmoon::net::read(stream, cmoon::net::dynamic_buffer(chain));
+				cmoon::test::assert_equal(contents(chain), std::string{text.substr(20)});
+
+				const auto before {pool.statistics()};
+				chain.consume(chain.size());
+				const auto after {pool.statistics()};
+				cmoon::test::assert_equal(chain.slab_count(), std::size_t{0});
+				cmoon::test::assert_equal(after.in_use, std::size_t{0});
+				cmoon::test::assert_equal(after.high_water, before.high_water);
+				cmoon::test::assert_equal(after.cached, before.cached + before.in_use);
+
+				// Reuses a cached slab rather than allocating.
+				chain.grow(1);
+				cmoon::test::assert_equal(pool.statistics().system_allocations, after.system_allocations);
+			}
+		private:
+			static std::string contents(const cmoon::net::slab_chain& chain)
+			{
+				std::string result;
+				for (const cmoon::net::const_buffer b : chain.data(0, chain.size()))
+				{
+					result.append(static_cast<const char*>(b.data()), b.size());
+				}
+
+				return result;
+			}
+	};
+}
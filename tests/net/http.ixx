@@ -0,0 +1,357 @@
+module;
+
+#if defined(__linux__)
+	#include "cmoon/net/http_server.hpp"
+#endif
+
+export module cmoon.tests.net.http;
+
+import <array>;
+import <chrono>;
+import <map>;
+import <span>;
+import <string>;
+import <string_view>;
+import <sstream>;
+import <system_error>;
+import <utility>;
+
+import cmoon.test;
+
+#if defined(__linux__)
+namespace cmoon::tests::net
+{
+	struct routed
+	{
+		cmoon::http::http_response response;
+		std::string body;
+	};
+
+	[[nodiscard]] routed dispatch(const cmoon::http::http_router& router, std::string_view method, std::string_view path)
+	{
+		cmoon::http::http_request request;
+		request.method() = method;
+		request.url().resource() = path;
+
+		routed result;
+		result.response.status() = cmoon::http::status::http_status{200u, cmoon::http::status::ok_message};
+		std::ostringstream body;
+		router.dispatch(request, result.response, body);
+		result.body = body.str();
+		return result;
+	}
+
+	[[nodiscard]] cmoon::http::http_handler respond_with(std::string text)
+	{
+		return [text = std::move(text)](cmoon::http::http_request&, cmoon::http::http_response&, std::ostream& body) {
+			body << text;
+		};
+	}
+
+	export
+	class http_router_test : public cmoon::test::test_case
+	{
+		public:
+			http_router_test()
+				: cmoon::test::test_case{"http_router_test"} {}
+
+			void operator()() override
+			{
+				cmoon::http::http_router router;
+				router.route(cmoon::http::get, "/items", respond_with("get items"))
+					  .route(cmoon::http::post, "/items", respond_with("post items"))
+					  .route_prefix(cmoon::http::get, "/static/", respond_with("static"))
+					  .route_prefix(cmoon::http::get, "/static/images/", respond_with("images"))
+					  .route_prefix(cmoon::http::get, "/", respond_with("fallback"))
+					  .route(cmoon::http::get, "/static/index.html", respond_with("index"));
+
+				const auto get_items = dispatch(router, cmoon::http::get, "/items");
+				cmoon::test::assert_equal(get_items.response.status().code, 200u);
+				cmoon::test::assert_equal(get_items.body, "get items");
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::post, "/items").body, "post items");
+
+				// The longest prefix wins, and an exact route beats any prefix.
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/static/images/logo.png").body, "images");
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/static/style.css").body, "static");
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/static/index.html").body, "index");
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/other").body, "fallback");
+
+				const auto head = dispatch(router, cmoon::http::head, "/items");
+				cmoon::test::assert_equal(head.response.status().code, 200u);
+				cmoon::test::assert_equal(head.body, "get items");
+
+				const auto put = dispatch(router, cmoon::http::put, "/items");
+				cmoon::test::assert_equal(put.response.status().code, 405u);
+				cmoon::test::assert_equal(put.response.headers().at(std::string{cmoon::http::headers::allow}), "GET, POST");
+				cmoon::test::assert_true(put.body.empty());
+
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::post, "/static/style.css").response.status().code, 405u);
+			}
+	};
+
+	export
+	class http_router_not_found_test : public cmoon::test::test_case
+	{
+		public:
+			http_router_not_found_test()
+				: cmoon::test::test_case{"http_router_not_found_test"} {}
+
+			void operator()() override
+			{
+				cmoon::http::http_router router;
+				router.route(cmoon::http::get, "/items", respond_with("items"))
+					  .route_prefix(cmoon::http::get, "/static/", respond_with("static"));
+
+				const auto missing = dispatch(router, cmoon::http::get, "/missing");
+				cmoon::test::assert_equal(missing.response.status().code, 404u);
+				cmoon::test::assert_true(missing.body.empty());
+
+				// Exact routes do not match longer paths, and a prefix must
+				// match whole.
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/items/1").response.status().code, 404u);
+				cmoon::test::assert_equal(dispatch(router, cmoon::http::get, "/static").response.status().code, 404u);
+				cmoon::test::assert_equal(dispatch(cmoon::http::http_router{}, cmoon::http::get, "/").response.status().code, 404u);
+			}
+	};
+
+	export
+	class http_keep_alive_test : public cmoon::test::test_case
+	{
+		public:
+			http_keep_alive_test()
+				: cmoon::test::test_case{"http_keep_alive_test"} {}
+
+			void operator()() override
+			{
+				using cmoon::http::http_version;
+				using fields = std::map<std::string, std::string>;
+
+				const auto plain = cmoon::http::keep_alive(http_version::HTTP_1_1, {});
+				cmoon::test::assert_true(plain.persistent);
+				cmoon::test::assert_false(plain.timeout.has_value());
+				cmoon::test::assert_false(plain.max.has_value());
+
+				cmoon::test::assert_false(cmoon::http::keep_alive(http_version::HTTP_1_1, fields{{"connection", "Upgrade, Close"}}).persistent);
+				cmoon::test::assert_true(cmoon::http::keep_alive(http_version::HTTP_1_1, fields{{"Connection", "closed"}}).persistent);
+
+				// HTTP/1.0 only keeps the connection when asked to.
+				cmoon::test::assert_false(cmoon::http::keep_alive(http_version::HTTP_1, {}).persistent);
+				cmoon::test::assert_false(cmoon::http::keep_alive(http_version::HTTP_1, fields{{"Connection", "close"}}).persistent);
+
+				const auto limited = cmoon::http::keep_alive(http_version::HTTP_1, fields{{"Connection", "keep-alive"}, {"keep-alive", " timeout=5 , MAX=100"}});
+				cmoon::test::assert_true(limited.persistent);
+				cmoon::test::assert_equal(limited.timeout.value(), std::chrono::seconds{5});
+				cmoon::test::assert_equal(limited.max.value(), 100);
+
+				const auto bad = cmoon::http::keep_alive(http_version::HTTP_1_1, fields{{"Keep-Alive", "timeout=soon, max, other=1"}});
+				cmoon::test::assert_true(bad.persistent);
+				cmoon::test::assert_false(bad.timeout.has_value());
+				cmoon::test::assert_false(bad.max.has_value());
+			}
+	};
+
+	export
+	class http_has_token_test : public cmoon::test::test_case
+	{
+		public:
+			http_has_token_test()
+				: cmoon::test::test_case{"http_has_token_test"} {}
+
+			void operator()() override
+			{
+				const std::string single {"close"};
+				const std::string list {"Upgrade,\tKeep-Alive ,TE"};
+				const std::string empty_items {" , ,close"};
+				const std::string partial {"closed, keep-alive-ish"};
+
+				cmoon::test::assert_true(cmoon::http::has_token(&single, "close"));
+				cmoon::test::assert_true(cmoon::http::has_token(&single, "CLOSE"));
+				cmoon::test::assert_true(cmoon::http::has_token(&list, "upgrade"));
+				cmoon::test::assert_true(cmoon::http::has_token(&list, "keep-alive"));
+				cmoon::test::assert_true(cmoon::http::has_token(&list, "te"));
+				cmoon::test::assert_true(cmoon::http::has_token(&empty_items, "close"));
+
+				cmoon::test::assert_false(cmoon::http::has_token(&partial, "close"));
+				cmoon::test::assert_false(cmoon::http::has_token(&partial, "keep-alive"));
+				cmoon::test::assert_false(cmoon::http::has_token(&list, "Keep"));
+				cmoon::test::assert_false(cmoon::http::has_token(nullptr, "close"));
+			}
+	};
+
+	export
+	class http_is_idempotent_test : public cmoon::test::test_case
+	{
+		public:
+			http_is_idempotent_test()
+				: cmoon::test::test_case{"http_is_idempotent_test"} {}
+
+			void operator()() override
+			{
+				cmoon::test::assert_true(cmoon::http::is_idempotent(cmoon::http::get));
+				cmoon::test::assert_true(cmoon::http::is_idempotent(cmoon::http::head));
+				cmoon::test::assert_true(cmoon::http::is_idempotent(cmoon::http::put));
+				cmoon::test::assert_true(cmoon::http::is_idempotent("DELETE"));
+				cmoon::test::assert_true(cmoon::http::is_idempotent("OPTIONS"));
+				cmoon::test::assert_true(cmoon::http::is_idempotent("TRACE"));
+
+				cmoon::test::assert_false(cmoon::http::is_idempotent(cmoon::http::post));
+				cmoon::test::assert_false(cmoon::http::is_idempotent("PATCH"));
+				cmoon::test::assert_false(cmoon::http::is_idempotent("CONNECT"));
+				cmoon::test::assert_false(cmoon::http::is_idempotent("get"));
+			}
+	};
+
+	export
+	class http_server_timeout_test : public cmoon::test::test_case
+	{
+		public:
+			http_server_timeout_test()
+				: cmoon::test::test_case{"http_server_timeout_test"} {}
+
+			void operator()() override
+			{
+				cmoon::http::http_server_options options;
+				options.threads = 1;
+				options.idle_timeout = std::chrono::milliseconds{50};
+				options.header_timeout = std::chrono::milliseconds{100};
+
+				cmoon::http::http_server server {cmoon::net::ip::tcp::endpoint{cmoon::net::ip::address_v4::loopback(), 0}, cmoon::http::http_router{}, options};
+				server.start();
+
+				cmoon::net::io_context ctx;
+				cmoon::http::http_client client {ctx};
+				cmoon::http::http_request request;
+				request.host("127.0.0.1");
+				request.port(server.local_endpoint().port());
+
+				// A client that sends nothing, and one that never finishes
+				// its head, are both closed without a response.
+				for (const std::string_view sent : {std::string_view{}, std::string_view{"GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n"}})
+				{
+					std::error_code ec;
+					auto socket = client.connect(request, ec);
+					cmoon::test::assert_false(static_cast<bool>(ec));
+
+					const auto start = std::chrono::steady_clock::now();
+					(void) socket.send(std::span{sent}, ec);
+					cmoon::test::assert_false(static_cast<bool>(ec));
+
+					std::array<char, 64> received;
+					cmoon::test::assert_equal(socket.receive(std::span{received}, ec), 0);
+					cmoon::test::assert_true(std::chrono::steady_clock::now() - start >= (sent.empty() ? options.idle_timeout : options.header_timeout));
+				}
+			}
+	};
+
+	// Serves "pooled" on 127.0.0.1, closing each connection after its
+	// second request.
+	class pool_test_server
+	{
+		public:
+			pool_test_server()
+				: server_{cmoon::net::ip::tcp::endpoint{cmoon::net::ip::address_v4::loopback(), 0}, router(), options()}
+			{
+				server_.start();
+			}
+
+			void get(const cmoon::http::http_client& client)
+			{
+				cmoon::http::http_request request;
+				request.method() = cmoon::http::get;
+				request.host("127.0.0.1");
+				request.port(server_.local_endpoint().port());
+
+				std::ostringstream body;
+				const auto response = client.send(request, body);
+				cmoon::test::assert_equal(response.status().code, 200u);
+				cmoon::test::assert_equal(body.str(), "pooled");
+			}
+		private:
+			[[nodiscard]] static cmoon::http::http_router router()
+			{
+				cmoon::http::http_router r;
+				r.route(cmoon::http::get, "/", respond_with("pooled"));
+				return r;
+			}
+
+			[[nodiscard]] static cmoon::http::http_server_options options()
+			{
+				cmoon::http::http_server_options o;
+				o.threads = 1;
+				o.max_keep_alive_requests = 2;
+				return o;
+			}
+
+			cmoon::http::http_server server_;
+	};
+
+	export
+	class http_pool_reuse_test : public cmoon::test::test_case
+	{
+		public:
+			http_pool_reuse_test()
+				: cmoon::test::test_case{"http_pool_reuse_test"} {}
+
+			void operator()() override
+			{
+				pool_test_server server;
+				cmoon::net::io_context ctx;
+				cmoon::http::http_client client {ctx};
+				for (int i {0}; i < 4; ++i)
+				{
+					server.get(client);
+				}
+
+				// The server closes each connection after two requests.
+				const auto stats = client.statistics();
+				cmoon::test::assert_equal(stats.requests, 4);
+				cmoon::test::assert_equal(stats.reused, 2);
+				cmoon::test::assert_equal(stats.connections_opened, 2);
+				cmoon::test::assert_equal(stats.connections_closed, 2);
+
+				// A depth of zero is taken as one rather than sending nothing.
+				cmoon::http::http_client unpipelined {ctx, {.max_pipeline_depth = 0}};
+				cmoon::test::assert_equal(unpipelined.options().max_pipeline_depth, 1);
+				server.get(unpipelined);
+				server.get(unpipelined);
+				cmoon::test::assert_equal(unpipelined.statistics().reused, 1);
+			}
+	};
+
+	export
+	class http_pool_eviction_test : public cmoon::test::test_case
+	{
+		public:
+			http_pool_eviction_test()
+				: cmoon::test::test_case{"http_pool_eviction_test"} {}
+
+			void operator()() override
+			{
+				pool_test_server server;
+				cmoon::net::io_context ctx;
+
+				cmoon::http::http_client cleared {ctx};
+				server.get(cleared);
+				cleared.clear();
+				cmoon::test::assert_equal(cleared.statistics().connections_closed, 1);
+				server.get(cleared);
+				cmoon::test::assert_equal(cleared.statistics().reused, 0);
+				cmoon::test::assert_equal(cleared.statistics().connections_opened, 2);
+
+				cmoon::http::http_client expiring {ctx, {.idle_timeout = std::chrono::milliseconds{0}}};
+				server.get(expiring);
+				server.get(expiring);
+				cmoon::test::assert_equal(expiring.statistics().reused, 0);
+				cmoon::test::assert_equal(expiring.statistics().connections_opened, 2);
+				cmoon::test::assert_equal(expiring.statistics().connections_closed, 1);
+
+				cmoon::http::http_client unpooled {ctx, {.max_idle_per_host = 0}};
+				server.get(unpooled);
+				server.get(unpooled);
+				cmoon::test::assert_equal(unpooled.statistics().reused, 0);
+				cmoon::test::assert_equal(unpooled.statistics().connections_opened, 2);
+				cmoon::test::assert_equal(unpooled.statistics().connections_closed, 2);
+			}
+	};
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+export module cmoon.tests.net.http_parser;
+
+import <cstddef>;
+import <cstdint>;
+import <string>;
+import <string_view>;
+import <system_error>;
+
+import cmoon.test;
+import cmoon.net;
+
+namespace cmoon::tests::net
+{
+	// Feeds message to parser until it completes or fails, returning the
+	// body read so far.
+	std::string parse_message(cmoon::http::http_parser& parser, std::string_view message, std::error_code& ec)
+	{
+		std::string body;
+		while (!ec && !parser.message_complete())
+		{
+			const auto result {parser.parse(message, ec)};
+			if (result.event == cmoon::http::http_parse_event::need_more)
+			{
+				break;
+			}
+
+			if (result.event == cmoon::http::http_parse_event::body)
+			{
+				body += result.body;
+			}
+
+			message.remove_prefix(result.consumed);
+		}
+
+		return body;
+	}
+
+	export
+	class http_parser_chunked_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_chunked_test()
+				: cmoon::test::test_case{"http_parser_chunked_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::string_view message {"POST /upload HTTP/1.1\r\n"
+													"Host: example.com\r\n"
+													"Transfer-Encoding: chunked\r\n"
+													"\r\n"
+													"5;name=value\r\nhello\r\n"
+													"0B\r\n, chunked!!\r\n"
+													"0\r\n"
+													"Trailer: ignored\r\n"
+													"\r\n"};
+
+				// Arrives a byte at a time, as a slow peer would send it.
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+				std::string received;
+				std::string body;
+				std::size_t offered {0};
+				bool complete {false};
+				while (!complete)
+				{
+					const auto result {parser.parse(received)};
+					switch (result.event)
+					{
+						case cmoon::http::http_parse_event::head:
+							cmoon::test::assert_equal(parser.method(), std::string_view{"POST"});
+							cmoon::test::assert_equal(parser.target(), std::string_view{"/upload"});
+							cmoon::test::assert_equal(parser.header("host"), std::string_view{"example.com"});
+							cmoon::test::assert_true(parser.chunked());
+							break;
+						case cmoon::http::http_parse_event::body:
+							body += result.body;
+							break;
+						case cmoon::http::http_parse_event::message_complete:
+							complete = true;
+							break;
+						case cmoon::http::http_parse_event::need_more:
+							cmoon::test::assert_true(offered < message.size());
+							received += message[offered++];
+							break;
+					}
+
+					received.erase(0, result.consumed);
+				}
+
+				cmoon::test::assert_equal(body, std::string{"hello, chunked!!"});
+				cmoon::test::assert_equal(offered, message.size());
+				cmoon::test::assert_true(received.empty());
+				cmoon::test::assert_true(parser.keep_alive());
+			}
+	};
+
+	export
+	class http_parser_pipelined_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_pipelined_test()
+				: cmoon::test::test_case{"http_parser_pipelined_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::string_view messages {"PUT /a HTTP/1.1\r\nContent-Length: 5\r\n\r\nfirst"
+													 "GET /b HTTP/1.1\r\nConnection: close\r\n\r\n"};
+
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+				auto remaining {messages};
+
+				auto result {parser.parse(remaining)};
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::head);
+				cmoon::test::assert_equal(parser.content_length().value(), std::uint64_t{5});
+				remaining.remove_prefix(result.consumed);
+
+				// The body is a view of the input, not a copy.
+				result = parser.parse(remaining);
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::body);
+				cmoon::test::assert_equal(result.body, std::string_view{"first"});
+				cmoon::test::assert_true(result.body.data() == remaining.data());
+				remaining.remove_prefix(result.consumed);
+
+				result = parser.parse(remaining);
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::message_complete);
+				cmoon::test::assert_true(parser.keep_alive());
+
+				result = parser.parse(remaining);
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::head);
+				cmoon::test::assert_equal(parser.target(), std::string_view{"/b"});
+				remaining.remove_prefix(result.consumed);
+
+				result = parser.parse(remaining);
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::message_complete);
+				cmoon::test::assert_false(parser.keep_alive());
+				cmoon::test::assert_true(remaining.empty());
+			}
+	};
+
+	export
+	class http_parser_response_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_response_test()
+				: cmoon::test::test_case{"http_parser_response_test"} {}
+
+			void operator()() override
+			{
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::response};
+
+				constexpr std::string_view no_content {"HTTP/1.1 204 No Content\r\nContent-Length: 10\r\n\r\n"};
+				auto result {parser.parse(no_content)};
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::head);
+				cmoon::test::assert_equal(parser.status(), 204u);
+				cmoon::test::assert_equal(parser.reason(), std::string_view{"No Content"});
+				cmoon::test::assert_equal(parser.parse(no_content.substr(result.consumed)).event, cmoon::http::http_parse_event::message_complete);
+
+				// Without framing, the body runs until the connection closes.
+				constexpr std::string_view until_close {"HTTP/1.0 200 OK\n\nall of it"};
+				result = parser.parse(until_close);
+				cmoon::test::assert_equal(result.event, cmoon::http::http_parse_event::head);
+				result = parser.parse(until_close.substr(result.consumed));
+				cmoon::test::assert_equal(result.body, std::string_view{"all of it"});
+				cmoon::test::assert_false(parser.message_complete());
+				cmoon::test::assert_true(parser.finish());
+				cmoon::test::assert_false(parser.keep_alive());
+			}
+	};
+
+	export
+	class http_parser_error_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_error_test()
+				: cmoon::test::test_case{"http_parser_error_test"} {}
+
+			void operator()() override
+			{
+				cmoon::test::assert_equal(parse_error("GET /\r\n\r\n"), std::make_error_code(cmoon::http::http_parse_errc::bad_start_line));
+				cmoon::test::assert_equal(parse_error("GET / HTTP/3\r\n\r\n"), std::make_error_code(cmoon::http::http_parse_errc::bad_version));
+				cmoon::test::assert_equal(parse_error("GET / HTTP/1.1\r\nNo Colon\r\n\r\n"), std::make_error_code(cmoon::http::http_parse_errc::bad_header));
+				cmoon::test::assert_equal(parse_error("GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n"), std::make_error_code(cmoon::http::http_parse_errc::bad_content_length));
+				cmoon::test::assert_equal(parse_error("GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n"), std::make_error_code(cmoon::http::http_parse_errc::bad_chunk));
+				cmoon::test::assert_equal(parse_error(std::string(128, 'a')), std::make_error_code(cmoon::http::http_parse_errc::head_too_large));
+
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+				cmoon::test::assert_throws<std::system_error>([&parser] { (void) parser.parse(std::string_view{"BAD\r\n\r\n"}); });
+			}
+		private:
+			static std::error_code parse_error(std::string_view message)
+			{
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request, 64};
+				std::error_code ec;
+				(void) parse_message(parser, message, ec);
+				return ec;
+			}
+	};
+
+	export
+	class http_parser_transfer_encoding_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_transfer_encoding_test()
+				: cmoon::test::test_case{"http_parser_transfer_encoding_test"} {}
+
+			void operator()() override
+			{
+				const auto bad_transfer_encoding {std::make_error_code(cmoon::http::http_parse_errc::bad_transfer_encoding)};
+
+				// A later header can undo chunked, and a request must end
+				// in it.
+				cmoon::test::assert_equal(request_error("Transfer-Encoding: chunked\r\nTransfer-Encoding: identity\r\n"), bad_transfer_encoding);
+				cmoon::test::assert_equal(request_error("Transfer-Encoding: chunked, gzip\r\n"), bad_transfer_encoding);
+				cmoon::test::assert_equal(request_error("Transfer-Encoding: gzip\r\nContent-Length: 0\r\n"), bad_transfer_encoding);
+
+				// Either way round, a length beside a coding is refused.
+				cmoon::test::assert_equal(request_error("Transfer-Encoding: chunked\r\nContent-Length: 3\r\n"), bad_transfer_encoding);
+				cmoon::test::assert_equal(request_error("Content-Length: 3\r\nTransfer-Encoding: chunked\r\n"), bad_transfer_encoding);
+
+				for (const std::string_view headers : {"Transfer-Encoding: gzip, chunked\r\n", "Transfer-Encoding: identity\r\nTransfer-Encoding: chunked ,\r\n"})
+				{
+					cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+					std::error_code ec;
+					cmoon::test::assert_equal(parse_message(parser, request(headers), ec), std::string{"abc"});
+					cmoon::test::assert_false(static_cast<bool>(ec));
+					cmoon::test::assert_true(parser.chunked());
+					cmoon::test::assert_true(parser.message_complete());
+				}
+
+				// A response not chunked last runs until the connection
+				// closes, whatever its length says.
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::response};
+				std::error_code ec;
+				auto body {parse_message(parser, "HTTP/1.1 200 OK\r\nTransfer-Encoding: gzip\r\nContent-Length: 1\r\n\r\nabc", ec)};
+				cmoon::test::assert_false(static_cast<bool>(ec));
+				cmoon::test::assert_equal(body, std::string{"abc"});
+				cmoon::test::assert_true(parser.finish());
+				cmoon::test::assert_false(parser.keep_alive());
+
+				// Chunked wins over a length, but the connection is not kept.
+				parser.reset();
+				body = parse_message(parser, "HTTP/1.1 200 OK\r\nContent-Length: 1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n", ec);
+				cmoon::test::assert_false(static_cast<bool>(ec));
+				cmoon::test::assert_equal(body, std::string{"abc"});
+				cmoon::test::assert_true(parser.message_complete());
+				cmoon::test::assert_false(parser.keep_alive());
+			}
+		private:
+			static std::string request(std::string_view headers)
+			{
+				return std::string{"POST / HTTP/1.1\r\n"} + std::string{headers} + "\r\n3\r\nabc\r\n0\r\n\r\n";
+			}
+
+			static std::error_code request_error(std::string_view headers)
+			{
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+				std::error_code ec;
+				(void) parse_message(parser, request(headers), ec);
+				return ec;
+			}
+	};
+
+	export
+	class http_parser_split_head_test : public cmoon::test::test_case
+	{
+		public:
+			http_parser_split_head_test()
+				: cmoon::test::test_case{"http_parser_split_head_test"} {}
+
+			void operator()() override
+			{
+				cmoon::http::http_parser parser {cmoon::http::http_message_kind::request};
+				std::string received {"POST /upload HTTP/1.1\r\nTransfer-"};
+				std::error_code ec;
+
+				cmoon::test::assert_true(parser.parse(received, ec).event == cmoon::http::http_parse_event::need_more);
+				received += "Encoding: chunked\r\n";
+				cmoon::test::assert_true(parser.parse(received, ec).event == cmoon::http::http_parse_event::need_more);
+
+				// The chunk size line is missing, so the body starts with a
+				// bare line ending. What was scanned of the head before must
+				// not count as chunk size digits.
+				received += "\r\n\r\n5\r\nhello\r\n0\r\n\r\n";
+				const auto head {parser.parse(received, ec)};
+				cmoon::test::assert_true(head.event == cmoon::http::http_parse_event::head);
+				cmoon::test::assert_false(static_cast<bool>(ec));
+				received.erase(0, head.consumed);
+
+				(void) parser.parse(received, ec);
+				cmoon::test::assert_equal(ec, std::make_error_code(cmoon::http::http_parse_errc::bad_chunk));
+			}
+	};
+}
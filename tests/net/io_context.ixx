@@ -0,0 +1,136 @@
+module;
+
+#if defined(__linux__)
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+#endif
+
+export module cmoon.tests.net.io_context;
+
+import <cstddef>;
+import <array>;
+import <string_view>;
+import <system_error>;
+import <thread>;
+import <vector>;
+
+import cmoon.test;
+import cmoon.execution;
+import cmoon.net;
+
+#if defined(__linux__)
+namespace cmoon::tests::net
+{
+	export
+	class io_context_schedule_test : public cmoon::test::test_case
+	{
+		public:
+			io_context_schedule_test()
+				: cmoon::test::test_case{"io_context_schedule_test"} {}
+
+			void operator()() override
+			{
+				constexpr int expected {5};
+				int value {0};
+
+				cmoon::net::io_context ctx;
+				cmoon::execution::execute(ctx.get_scheduler(), [&value, expected] { value = expected; });
+
+				cmoon::test::assert_equal(ctx.run(), std::size_t{1});
+				cmoon::test::assert_equal(value, expected);
+				cmoon::test::assert_equal(ctx.run(), std::size_t{0});
+			}
+	};
+
+	export
+	class io_context_loopback_test : public cmoon::test::test_case
+	{
+		public:
+			explicit io_context_loopback_test(cmoon::net::io_backend backend = cmoon::net::io_backend::epoll)
+				: cmoon::test::test_case{backend == cmoon::net::io_backend::epoll ? "io_context_loopback_test" : "io_context_io_uring_loopback_test"}, backend{backend} {}
+
+			void operator()() override
+			{
+				const auto listener {::socket(AF_INET, SOCK_STREAM, 0)};
+				::sockaddr_in address {};
+				address.sin_family = AF_INET;
+				address.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+				::socklen_t length {sizeof(address)};
+				cmoon::test::assert_equal(::bind(listener, reinterpret_cast<const ::sockaddr*>(&address), length), 0);
+				cmoon::test::assert_equal(::listen(listener, 16), 0);
+				::getsockname(listener, reinterpret_cast<::sockaddr*>(&address), &length);
+
+				const auto client {::socket(AF_INET, SOCK_STREAM, 0)};
+				std::array<char, 32> received {};
+
+				cmoon::net::io_context ctx {backend};
+				const std::array registered {cmoon::net::mutable_buffer{received.data(), received.size()}};
+				ctx.register_buffers(registered);
+				cmoon::net::io_context::work_guard work {ctx};
+				std::vector<std::thread> runners;
+				for (int i {0}; i < 2; ++i)
+				{
+					runners.emplace_back([&ctx] { ctx.run(); });
+				}
+
+				auto& listener_d {ctx.register_descriptor(listener)};
+				auto& client_d {ctx.register_descriptor(client)};
+
+				const auto [server] = cmoon::execution::sync_wait(
+					cmoon::execution::when_all(
+						cmoon::net::async_accept(listener_d),
+						cmoon::net::async_connect(client_d, &address, sizeof(address))
+					)
+				).value();
+
+				// Both backends hand back a socket that is already
+				// non-blocking and closed on exec.
+				cmoon::test::assert_true((::fcntl(server, F_GETFL) & O_NONBLOCK) != 0);
+				cmoon::test::assert_true((::fcntl(server, F_GETFD) & FD_CLOEXEC) != 0);
+
+				auto& server_d {ctx.register_descriptor(server)};
+
+				constexpr std::string_view message {"hello reactor"};
+				const std::array gathered {cmoon::net::const_buffer{message.data(), 6}, cmoon::net::const_buffer{message.data() + 6, message.size() - 6}};
+				const auto [written] = cmoon::execution::sync_wait(cmoon::net::async_write_some(client_d, gathered)).value();
+				cmoon::test::assert_equal(written, message.size());
+
+				const auto [read] = cmoon::execution::sync_wait(cmoon::net::async_read_some(server_d, cmoon::net::mutable_buffer{received.data(), received.size()})).value();
+				cmoon::test::assert_equal(std::string_view{received.data(), read}, message);
+
+				// Nothing has been sent back, so the read stays queued until it
+				// is canceled.
+				const auto canceled = cmoon::execution::sync_wait(
+					cmoon::execution::when_all(
+						cmoon::net::async_read_some(client_d, cmoon::net::mutable_buffer{received.data(), received.size()}),
+						cmoon::execution::then(cmoon::execution::schedule(ctx.get_scheduler()), [&ctx, &client_d] { ctx.cancel(client_d); })
+					)
+				);
+				cmoon::test::assert_false(canceled.has_value());
+
+				::shutdown(client, SHUT_WR);
+				cmoon::test::assert_throws<std::error_code>([&] {
+					(void) cmoon::execution::sync_wait(cmoon::net::async_read_some(server_d, cmoon::net::mutable_buffer{received.data(), received.size()}));
+				});
+
+				work.reset();
+				for (auto& t : runners)
+				{
+					t.join();
+				}
+
+				ctx.deregister_descriptor(server_d);
+				ctx.deregister_descriptor(client_d);
+				ctx.deregister_descriptor(listener_d);
+				::close(server);
+				::close(client);
+				::close(listener);
+			}
+		private:
+			cmoon::net::io_backend backend;
+	};
+}
+#endif
\ No newline at end of file
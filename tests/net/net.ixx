@@ -1,9 +1,15 @@
 export module cmoon.tests.net;
+export import cmoon.tests.net.io_context;
+export import cmoon.tests.net.read_write;
+export import cmoon.tests.net.buffer_pool;
+export import cmoon.tests.net.http_parser;
+export import cmoon.tests.net.http;
 //export import cmoon.tests.net.system_context;
 
 import <utility>;
 
 import cmoon.test;
+import cmoon.net;
 import cmoon.library;
 
 namespace cmoon::tests
@@ -16,6 +22,33 @@ namespace cmoon::tests
 		{
 			cmoon::test::test_suite suite{"net library tests"};
 			suite.add_test_case<cmoon::tests::net::service_context_test>();
+			#if defined(__linux__)
+				suite.add_test_case<cmoon::tests::net::io_context_schedule_test>();
+				suite.add_test_case<cmoon::tests::net::io_context_loopback_test>();
+				if (cmoon::net::io_uring_supported())
+				{
+					suite.add_test_case<cmoon::tests::net::io_context_loopback_test>(cmoon::net::io_backend::io_uring);
+				}
+			#endif
+			suite.add_test_case<cmoon::tests::net::write_buffer_sequence_test>();
+			suite.add_test_case<cmoon::tests::net::read_buffer_sequence_test>();
+			suite.add_test_case<cmoon::tests::net::dynamic_slab_buffer_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_chunked_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_pipelined_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_response_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_error_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_transfer_encoding_test>();
+			suite.add_test_case<cmoon::tests::net::http_parser_split_head_test>();
+			#if defined(__linux__)
+				suite.add_test_case<cmoon::tests::net::http_router_test>();
+				suite.add_test_case<cmoon::tests::net::http_router_not_found_test>();
+				suite.add_test_case<cmoon::tests::net::http_keep_alive_test>();
+				suite.add_test_case<cmoon::tests::net::http_has_token_test>();
+				suite.add_test_case<cmoon::tests::net::http_is_idempotent_test>();
+				suite.add_test_case<cmoon::tests::net::http_pool_reuse_test>();
+				suite.add_test_case<cmoon::tests::net::http_pool_eviction_test>();
+				suite.add_test_case<cmoon::tests::net::http_server_timeout_test>();
+			#endif
 
 			return std::move(suite);
 		}
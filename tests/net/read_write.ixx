@@ -0,0 +1,127 @@
+export module cmoon.tests.net.read_write;
+
+import <cstddef>;
+import <cstring>;
+import <algorithm>;
+import <array>;
+import <string>;
+import <string_view>;
+import <system_error>;
+
+import cmoon.test;
+import cmoon.net;
+
+namespace cmoon::tests::net
+{
+	// Moves at most chunk bytes per call, counting the calls made.
+	class counting_stream
+	{
+		public:
+			explicit counting_stream(std::size_t chunk)
+				: chunk_{chunk} {}
+
+			template<class MutableBufferSequence>
+			std::size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec)
+			{
+				ec.clear();
+				++calls_;
+				std::size_t transferred {0};
+				for (const auto& b : buffers)
+				{
+					const auto n {std::min({b.size(), data_.size() - position_, chunk_ - transferred})};
+					std::memcpy(b.data(), data_.data() + position_, n);
+					position_ += n;
+					transferred += n;
+				}
+
+				return transferred;
+			}
+
+			template<class ConstBufferSequence>
+			std::size_t write_some(const ConstBufferSequence& buffers, std::error_code& ec)
+			{
+				ec.clear();
+				++calls_;
+				std::size_t transferred {0};
+				for (const auto& b : buffers)
+				{
+					const auto n {std::min(b.size(), chunk_ - transferred)};
+					data_.append(static_cast<const char*>(b.data()), n);
+					transferred += n;
+				}
+
+				return transferred;
+			}
+
+			[[nodiscard]] int calls() const noexcept
+			{
+				return calls_;
+			}
+
+			[[nodiscard]] const std::string& data() const noexcept
+			{
+				return data_;
+			}
+		private:
+			std::size_t chunk_;
+			std::string data_;
+			std::size_t position_ {0};
+			int calls_ {0};
+	};
+
+	export
+	class write_buffer_sequence_test : public cmoon::test::test_case
+	{
+		public:
+			write_buffer_sequence_test()
+				: cmoon::test::test_case{"write_buffer_sequence_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::string_view part {"abcd"};
+				std::array<cmoon::net::const_buffer, 16> buffers;
+				buffers.fill(cmoon::net::const_buffer{part.data(), part.size()});
+
+				counting_stream whole {1024};
+				cmoon::test::assert_equal(cmoon::net::write(whole, buffers), std::size_t{64});
+				cmoon::test::assert_equal(whole.calls(), 1);
+
+				counting_stream partial {10};
+				cmoon::test::assert_equal(cmoon::net::write(partial, buffers), std::size_t{64});
+				cmoon::test::assert_equal(partial.calls(), 7);
+				cmoon::test::assert_equal(partial.data(), whole.data());
+			}
+	};
+
+	export
+	class read_buffer_sequence_test : public cmoon::test::test_case
+	{
+		public:
+			read_buffer_sequence_test()
+				: cmoon::test::test_case{"read_buffer_sequence_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::string_view header {"HEAD"};
+				constexpr std::string_view body {"body of the message"};
+
+				counting_stream stream {1024};
+				std::error_code ec;
+				const std::array out {cmoon::net::const_buffer{header.data(), header.size()}, cmoon::net::const_buffer{body.data(), body.size()}};
+				cmoon::net::write(stream, out, ec);
+
+				std::array<char, 4> header_in {};
+				std::array<char, 19> body_in {};
+				const std::array in {cmoon::net::mutable_buffer{header_in.data(), header_in.size()}, cmoon::net::mutable_buffer{body_in.data(), body_in.size()}};
+
+				cmoon::test::assert_equal(cmoon::net::read(stream, in, cmoon::net::transfer_exactly{6}), std::size_t{6});
+				cmoon::test::assert_equal(stream.calls(), 2);
+				cmoon::test::assert_equal(std::string_view{header_in.data(), header_in.size()}, header);
+
+				const cmoon::net::mutable_buffer rest {body_in.data() + 2, body_in.size() - 2};
+				cmoon::test::assert_equal(cmoon::net::read(stream, rest, cmoon::net::transfer_at_least{1}), rest.size());
+				cmoon::test::assert_equal(stream.calls(), 3);
+				cmoon::test::assert_equal(std::string_view{body_in.data(), body_in.size()}, body);
+			}
+	};
+}
@@ -0,0 +1,179 @@
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+import <iostream>;
+import <array>;
+import <format>;
+import <memory>;
+import <optional>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+import cmoon.execution;
+import cmoon.net;
+import cmoon.benchmarking;
+
+// Each connection's thread sends a small message, reads it on the server
+// side, echoes it back and reads the echo, so every round trip is two
+// writes and two reads through the context.
+class loopback_echo_benchmark : public cmoon::benchmarking::benchmark
+{
+	static constexpr std::size_t message_size {64};
+
+	struct connection
+	{
+		int client {-1};
+		int server {-1};
+		cmoon::net::io_descriptor* client_d {nullptr};
+		cmoon::net::io_descriptor* server_d {nullptr};
+		std::array<char, message_size> out {};
+		std::array<char, message_size> in {};
+		std::array<char, message_size> echo {};
+	};
+
+	public:
+		loopback_echo_benchmark(cmoon::net::io_backend backend, std::size_t connections, std::size_t round_trips, std::size_t threads)
+			: cmoon::benchmarking::benchmark{std::format("{} Loopback Echo. Connections: {}, Round Trips: {}, Threads: {}", backend == cmoon::net::io_backend::epoll ? "epoll" : "io_uring", connections, round_trips, threads), 1, 5},
+			  backend{backend}, connections{connections}, round_trips{round_trips}, threads{threads} {}
+
+		void set_up() override
+		{
+			ctx = std::make_unique<cmoon::net::io_context>(backend);
+			work.emplace(*ctx);
+			for (std::size_t i {0}; i < threads; ++i)
+			{
+				runners.emplace_back([this] { ctx->run(); });
+			}
+
+			buffers.resize(connections);
+			std::vector<cmoon::net::mutable_buffer> registered;
+			for (auto& c : buffers)
+			{
+				registered.emplace_back(c.in.data(), c.in.size());
+				registered.emplace_back(c.echo.data(), c.echo.size());
+			}
+
+			ctx->register_buffers(registered);
+
+			const auto listener {::socket(AF_INET, SOCK_STREAM, 0)};
+			::sockaddr_in address {};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+			::socklen_t length {sizeof(address)};
+			::bind(listener, reinterpret_cast<const ::sockaddr*>(&address), length);
+			::listen(listener, static_cast<int>(connections));
+			::getsockname(listener, reinterpret_cast<::sockaddr*>(&address), &length);
+			auto& listener_d {ctx->register_descriptor(listener)};
+
+			for (auto& c : buffers)
+			{
+				c.client = ::socket(AF_INET, SOCK_STREAM, 0);
+				c.client_d = &ctx->register_descriptor(c.client);
+				const auto [server] = cmoon::execution::sync_wait(
+					cmoon::execution::when_all(
+						cmoon::net::async_accept(listener_d),
+						cmoon::net::async_connect(*c.client_d, &address, sizeof(address))
+					)
+				).value();
+
+				c.server = server;
+				c.server_d = &ctx->register_descriptor(server);
+			}
+
+			ctx->deregister_descriptor(listener_d);
+			::close(listener);
+		}
+
+		void tear_down() override
+		{
+			work.reset();
+			for (auto& t : runners)
+			{
+				t.join();
+			}
+
+			runners.clear();
+			for (auto& c : buffers)
+			{
+				ctx->deregister_descriptor(*c.client_d);
+				ctx->deregister_descriptor(*c.server_d);
+				::close(c.client);
+				::close(c.server);
+			}
+
+			buffers.clear();
+			ctx.reset();
+		}
+
+		void operator()() override
+		{
+			std::vector<std::thread> clients;
+			clients.reserve(buffers.size());
+			for (auto& c : buffers)
+			{
+				clients.emplace_back([this, &c] {
+					for (std::size_t i {0}; i < round_trips; ++i)
+					{
+						write_all(*c.client_d, c.out.data());
+						read_all(*c.server_d, c.echo.data());
+						write_all(*c.server_d, c.echo.data());
+						read_all(*c.client_d, c.in.data());
+					}
+				});
+			}
+
+			for (auto& t : clients)
+			{
+				t.join();
+			}
+		}
+	private:
+		cmoon::net::io_backend backend;
+		std::size_t connections;
+		std::size_t round_trips;
+		std::size_t threads;
+		std::unique_ptr<cmoon::net::io_context> ctx;
+		std::optional<cmoon::net::io_context::work_guard> work;
+		std::vector<std::thread> runners;
+		std::vector<connection> buffers;
+
+		static void read_all(cmoon::net::io_descriptor& d, char* data)
+		{
+			std::size_t total {0};
+			while (total < message_size)
+			{
+				const auto [read] = cmoon::execution::sync_wait(cmoon::net::async_read_some(d, cmoon::net::mutable_buffer{data + total, message_size - total})).value();
+				total += read;
+			}
+		}
+
+		static void write_all(cmoon::net::io_descriptor& d, const char* data)
+		{
+			std::size_t total {0};
+			while (total < message_size)
+			{
+				const auto [written] = cmoon::execution::sync_wait(cmoon::net::async_write_some(d, cmoon::net::const_buffer{data + total, message_size - total})).value();
+				total += written;
+			}
+		}
+};
+
+void compare_backends(std::size_t connections, std::size_t round_trips, std::size_t threads)
+{
+	cmoon::benchmarking::benchmark_compare compare;
+	compare.run(loopback_echo_benchmark{cmoon::net::io_backend::epoll, connections, round_trips, threads});
+	compare.run(loopback_echo_benchmark{cmoon::net::io_backend::io_uring, connections, round_trips, threads});
+
+	std::cout << compare;
+	std::cout << "------------------------------------------\n\n";
+}
+
+int main()
+{
+	compare_backends(1, 10000, 1);
+	compare_backends(16, 2000, 2);
+	compare_backends(64, 500, 4);
+}
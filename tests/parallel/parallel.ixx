@@ -1,5 +1,6 @@
 export module cmoon.tests.parallel;
 export import cmoon.tests.parallel.simd;
+export import cmoon.tests.parallel.simd_algorithm;
 
 import <utility>;
 
@@ -34,6 +35,12 @@ namespace cmoon
 		suite.add_test_case<cmoon::tests::parallel::simd_less_than_equal_test<T>>();
 		suite.add_test_case<cmoon::tests::parallel::simd_greater_than_test<T>>();
 		suite.add_test_case<cmoon::tests::parallel::simd_greater_than_equal_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_mask_reduction_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_where_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_transform_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_reduce_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_copy_if_test<T>>();
+		suite.add_test_case<cmoon::tests::parallel::simd_inclusive_scan_test<T>>();
 	}
 
 	export
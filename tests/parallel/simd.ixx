@@ -518,4 +518,64 @@ namespace cmoon::tests::parallel
 				}
 			}
 	};
+
+	export
+	template<class T>
+	class simd_mask_reduction_test : public cmoon::test::test_case
+	{
+		public:
+			simd_mask_reduction_test()
+				: cmoon::test::test_case{std::format("simd_mask_reduction_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				const cmoon::native_simd<T> s {[](auto i) { return static_cast<T>(i); }};
+				const cmoon::native_simd<T> zero {static_cast<T>(0)};
+
+				cmoon::test::assert_true(all_of(s >= zero));
+				cmoon::test::assert_true(none_of(s < zero));
+				cmoon::test::assert_true(any_of(s == zero));
+				cmoon::test::assert_true(some_of(s == zero));
+				cmoon::test::assert_equal(popcount(s > zero), static_cast<int>(s.size()) - 1);
+				cmoon::test::assert_equal(find_first_set(s > zero), 1);
+				cmoon::test::assert_equal(find_last_set(s > zero), static_cast<int>(s.size()) - 1);
+			}
+	};
+
+	export
+	template<class T>
+	class simd_where_test : public cmoon::test::test_case
+	{
+		public:
+			simd_where_test()
+				: cmoon::test::test_case{std::format("simd_where_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				const cmoon::native_simd<T> s {[](auto i) { return static_cast<T>(i); }};
+				const cmoon::native_simd<T> two {static_cast<T>(2)};
+				const auto small {s < two};
+
+				auto r {s};
+				cmoon::where(small, r) += static_cast<T>(10);
+
+				for (std::size_t i {0}; i < r.size(); ++i)
+				{
+					cmoon::test::assert_equal(r[i], static_cast<T>(i < 2 ? i + 10 : i));
+				}
+
+				T data[cmoon::native_simd<T>::size()];
+				for (auto& d : data)
+				{
+					d = static_cast<T>(100);
+				}
+
+				cmoon::where(!small, s).copy_to(data, cmoon::element_aligned);
+
+				for (std::size_t i {0}; i < r.size(); ++i)
+				{
+					cmoon::test::assert_equal(data[i], static_cast<T>(i < 2 ? 100 : i));
+				}
+			}
+	};
 }
\ No newline at end of file
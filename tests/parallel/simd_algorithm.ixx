@@ -0,0 +1,174 @@
+export module cmoon.tests.parallel.simd_algorithm;
+
+import <format>;
+import <vector>;
+import <algorithm>;
+import <functional>;
+import <iterator>;
+import <numeric>;
+import <limits>;
+import <type_traits>;
+
+import cmoon.test;
+import cmoon.parallel;
+
+namespace cmoon::tests::parallel
+{
+	// Sizes that leave a partial last block for any vector width.
+	template<class T>
+	[[nodiscard]] std::vector<std::size_t> algorithm_test_sizes()
+	{
+		constexpr auto w {cmoon::native_simd<T>::size()};
+		return {1, 3, std::max<std::size_t>(w - 1, 1), w + 1, 3 * w + 5, 255};
+	}
+
+	// Small enough that no sum or product overflows std::int8_t.
+	template<class T>
+	[[nodiscard]] std::vector<T> algorithm_test_values(std::size_t n)
+	{
+		std::vector<T> values(n);
+		for (std::size_t i {0}; i < n; ++i)
+		{
+			values[i] = static_cast<T>(static_cast<int>(i % 3) - 1);
+		}
+
+		return values;
+	}
+
+	export
+	template<class T>
+	class simd_transform_test : public cmoon::test::test_case
+	{
+		public:
+			simd_transform_test()
+				: cmoon::test::test_case{std::format("simd_transform_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				const auto f = [](const auto& v) { return v * v + v; };
+				const auto g = [](const auto& a, const auto& b) { return a - b; };
+
+				for (const auto n : algorithm_test_sizes<T>())
+				{
+					const auto values {algorithm_test_values<T>(n)};
+					std::vector<T> others(n);
+					for (std::size_t i {0}; i < n; ++i)
+					{
+						others[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+					}
+
+					std::vector<T> expected(n);
+					std::vector<T> actual(n);
+
+					std::transform(values.begin(), values.end(), expected.begin(), f);
+					cmoon::test::assert_true(cmoon::transform(values, actual.begin(), f) == actual.end());
+					cmoon::test::assert_sequence_equal(actual.begin(), actual.end(), expected.begin(), std::format("size {}", n));
+
+					std::transform(values.begin(), values.end(), others.begin(), expected.begin(), g);
+					cmoon::test::assert_true(cmoon::transform(values, others, actual.begin(), g) == actual.end());
+					cmoon::test::assert_sequence_equal(actual.begin(), actual.end(), expected.begin(), std::format("size {}", n));
+				}
+			}
+	};
+
+	export
+	template<class T>
+	class simd_reduce_test : public cmoon::test::test_case
+	{
+		public:
+			simd_reduce_test()
+				: cmoon::test::test_case{std::format("simd_reduce_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				for (const auto n : algorithm_test_sizes<T>())
+				{
+					auto values {algorithm_test_values<T>(n)};
+					values[n / 2] = static_cast<T>(9);
+
+					cmoon::test::assert_equal(cmoon::reduce(values), std::accumulate(values.begin(), values.end(), T{}), std::format("size {}", n));
+					cmoon::test::assert_equal(cmoon::reduce(values, static_cast<T>(5)), std::accumulate(values.begin(), values.end(), static_cast<T>(5)), std::format("size {}", n));
+
+					constexpr auto lowest {std::numeric_limits<T>::lowest()};
+					cmoon::test::assert_equal(cmoon::reduce(values, lowest, cmoon::simd_maximum{}), static_cast<T>(9), std::format("size {}", n));
+					cmoon::test::assert_equal(cmoon::reduce(values, static_cast<T>(1), cmoon::simd_minimum{}), std::accumulate(values.begin(), values.end(), static_cast<T>(1), cmoon::simd_minimum{}), std::format("size {}", n));
+				}
+			}
+	};
+
+	export
+	template<class T>
+	class simd_copy_if_test : public cmoon::test::test_case
+	{
+		public:
+			simd_copy_if_test()
+				: cmoon::test::test_case{std::format("simd_copy_if_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				constexpr auto w {cmoon::native_simd<T>::size()};
+				const auto positive = [](const auto& v) { return v > std::remove_cvref_t<decltype(v)>{static_cast<T>(0)}; };
+
+				for (const auto n : algorithm_test_sizes<T>())
+				{
+					// Whole blocks that all match, none match and some match,
+					// so that each way a block is compacted is taken.
+					std::vector<T> values(n);
+					for (std::size_t i {0}; i < n; ++i)
+					{
+						switch ((i / w) % 3)
+						{
+							case 0:
+								values[i] = static_cast<T>(1 + i % 3);
+								break;
+							case 1:
+								values[i] = static_cast<T>(-static_cast<int>(i % 3));
+								break;
+							default:
+								values[i] = static_cast<T>(static_cast<int>(i % 3) - 1);
+								break;
+						}
+					}
+
+					std::vector<T> expected;
+					std::copy_if(values.begin(), values.end(), std::back_inserter(expected), positive);
+
+					std::vector<T> actual(n);
+					const auto last {cmoon::copy_if(values, actual.begin(), positive)};
+					cmoon::test::assert_equal(static_cast<std::size_t>(last - actual.begin()), expected.size(), std::format("size {}", n));
+					cmoon::test::assert_sequence_equal(expected.begin(), expected.end(), actual.begin(), std::format("size {}", n));
+				}
+			}
+	};
+
+	export
+	template<class T>
+	class simd_inclusive_scan_test : public cmoon::test::test_case
+	{
+		public:
+			simd_inclusive_scan_test()
+				: cmoon::test::test_case{std::format("simd_inclusive_scan_test ({})", typeid(T).name())} {}
+
+			void operator()() final
+			{
+				for (const auto n : algorithm_test_sizes<T>())
+				{
+					const auto values {algorithm_test_values<T>(n)};
+					std::vector<T> expected(n);
+					std::vector<T> actual(n);
+
+					std::inclusive_scan(values.begin(), values.end(), expected.begin());
+					cmoon::test::assert_true(cmoon::inclusive_scan(values, actual.begin()) == actual.end());
+					cmoon::test::assert_sequence_equal(actual.begin(), actual.end(), expected.begin(), std::format("size {}", n));
+
+					std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<>{}, static_cast<T>(2));
+					cmoon::test::assert_true(cmoon::inclusive_scan(values, actual.begin(), std::plus<>{}, static_cast<T>(2)) == actual.end());
+					cmoon::test::assert_sequence_equal(actual.begin(), actual.end(), expected.begin(), std::format("size {}", n));
+
+					std::inclusive_scan(values.begin(), values.end(), expected.begin(), cmoon::simd_maximum{});
+					cmoon::inclusive_scan(values, actual.begin(), cmoon::simd_maximum{});
+					cmoon::test::assert_sequence_equal(actual.begin(), actual.end(), expected.begin(), std::format("size {}", n));
+				}
+			}
+	};
+}
\ No newline at end of file
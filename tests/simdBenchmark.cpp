@@ -0,0 +1,237 @@
+import <iostream>;
+import <algorithm>;
+import <cstdint>;
+import <format>;
+import <functional>;
+import <numeric>;
+import <random>;
+import <string_view>;
+import <typeinfo>;
+import <type_traits>;
+import <vector>;
+
+import cmoon.parallel;
+import cmoon.benchmarking;
+
+struct transform_algorithm
+{
+	static constexpr std::string_view name {"transform"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>& out)
+	{
+		return std::transform(in.begin(), in.end(), out.begin(), [](T x) { return static_cast<T>(x * 3 + 1); });
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>& out)
+	{
+		return cmoon::transform(in, out.begin(), [](const auto& x) { return x * static_cast<T>(3) + static_cast<T>(1); });
+	}
+};
+
+struct reduce_algorithm
+{
+	static constexpr std::string_view name {"reduce"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>&)
+	{
+		return std::reduce(in.begin(), in.end());
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>&)
+	{
+		return cmoon::reduce(in);
+	}
+};
+
+struct dot_algorithm
+{
+	static constexpr std::string_view name {"dot"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>&)
+	{
+		return std::transform_reduce(in.begin(), in.end(), in.begin(), T{});
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>&)
+	{
+		return cmoon::dot(in, in);
+	}
+};
+
+struct minmax_algorithm
+{
+	static constexpr std::string_view name {"minmax"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>&)
+	{
+		return std::minmax_element(in.begin(), in.end());
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>&)
+	{
+		return cmoon::minmax(in);
+	}
+};
+
+// Looks for a value that is not there, so the whole range is scanned.
+struct find_algorithm
+{
+	static constexpr std::string_view name {"find"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>&)
+	{
+		return std::find(in.begin(), in.end(), static_cast<T>(-1));
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>&)
+	{
+		return cmoon::find(in, static_cast<T>(-1));
+	}
+};
+
+struct count_algorithm
+{
+	static constexpr std::string_view name {"count"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>&)
+	{
+		return std::count(in.begin(), in.end(), static_cast<T>(7));
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>&)
+	{
+		return cmoon::count(in, static_cast<T>(7));
+	}
+};
+
+// Keeps about half of the elements, scattered, which is the worst case for
+// skipping whole blocks.
+struct copy_if_algorithm
+{
+	static constexpr std::string_view name {"copy_if"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>& out)
+	{
+		return std::copy_if(in.begin(), in.end(), out.begin(), [](T x) { return x < static_cast<T>(50); });
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>& out)
+	{
+		using V = cmoon::native_simd<T>;
+		return cmoon::copy_if(in, out.begin(), [](const V& x) { return x < V{static_cast<T>(50)}; });
+	}
+};
+
+struct inclusive_scan_algorithm
+{
+	static constexpr std::string_view name {"inclusive_scan"};
+
+	template<class T>
+	static auto standard(const std::vector<T>& in, std::vector<T>& out)
+	{
+		return std::inclusive_scan(in.begin(), in.end(), out.begin());
+	}
+
+	template<class T>
+	static auto simd(const std::vector<T>& in, std::vector<T>& out)
+	{
+		return cmoon::inclusive_scan(in, out.begin());
+	}
+};
+
+template<class T, class Algorithm, bool Vectorized>
+class algorithm_benchmark : public cmoon::benchmarking::benchmark
+{
+	public:
+		algorithm_benchmark(std::size_t size)
+			: cmoon::benchmarking::benchmark{std::format("{} {} ({}). Size: {}", Vectorized ? "cmoon::" : "std::", Algorithm::name, typeid(T).name(), size), 5, 100}, size{size} {}
+
+		void set_up() override
+		{
+			std::mt19937 gen {12345};
+			std::conditional_t<std::is_integral_v<T>,
+				std::uniform_int_distribution<int>,
+				std::uniform_real_distribution<T>> d {0, 100};
+
+			in.resize(size);
+			out.resize(size);
+			for (auto& v : in)
+			{
+				v = static_cast<T>(d(gen));
+			}
+		}
+
+		void tear_down() override
+		{
+			in = {};
+			out = {};
+		}
+
+		void operator()() override
+		{
+			if constexpr (Vectorized)
+			{
+				const auto r {Algorithm::simd(in, out)};
+				cmoon::benchmarking::do_not_optimize(r);
+			}
+			else
+			{
+				const auto r {Algorithm::standard(in, out)};
+				cmoon::benchmarking::do_not_optimize(r);
+			}
+		}
+	private:
+		std::size_t size;
+		std::vector<T> in;
+		std::vector<T> out;
+};
+
+template<class T, class Algorithm>
+void compare_algorithm(std::size_t size)
+{
+	cmoon::benchmarking::benchmark_compare compare;
+	compare.run(algorithm_benchmark<T, Algorithm, false>{size});
+	compare.run(algorithm_benchmark<T, Algorithm, true>{size});
+
+	std::cout << compare;
+	std::cout << "------------------------------------------\n\n";
+}
+
+template<class T>
+void compare_algorithms(std::size_t size)
+{
+	compare_algorithm<T, transform_algorithm>(size);
+	compare_algorithm<T, reduce_algorithm>(size);
+	compare_algorithm<T, dot_algorithm>(size);
+	compare_algorithm<T, minmax_algorithm>(size);
+	compare_algorithm<T, find_algorithm>(size);
+	compare_algorithm<T, count_algorithm>(size);
+	compare_algorithm<T, copy_if_algorithm>(size);
+	compare_algorithm<T, inclusive_scan_algorithm>(size);
+}
+
+int main()
+{
+	std::cout << std::format("Instruction set: {}\n\n", static_cast<int>(cmoon::simd_abi::supported_instruction_set()));
+
+	for (const std::size_t size : {1000, 100000, 1000003})
+	{
+		compare_algorithms<float>(size);
+		compare_algorithms<double>(size);
+		compare_algorithms<std::int32_t>(size);
+	}
+}
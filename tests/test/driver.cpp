@@ -0,0 +1,18 @@
+import <iostream>;
+import <algorithm>;
+
+import cmoon.test;
+import cmoon.library;
+
+import cmoon.tests.test;
+
+// These tests start runners and capture output of their own, so they are
+// run one after another rather than through a parallel runner.
+int main()
+{
+	auto suite = cmoon::library_traits<cmoon::library::test>::tests();
+
+	cmoon::test::text_test_runner runner{std::cout};
+
+	return std::ranges::any_of(runner.run(suite), [](const auto& r) { return !r.passed(); });
+}
\ No newline at end of file
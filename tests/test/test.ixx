@@ -0,0 +1,28 @@
+export module cmoon.tests.test;
+export import cmoon.tests.test.test_run_options;
+export import cmoon.tests.test.text_test_runner;
+
+import <utility>;
+
+import cmoon.test;
+import cmoon.library;
+
+namespace cmoon
+{
+	export
+	template<>
+	struct library_traits<library::test>
+	{
+		static cmoon::test::test_suite tests()
+		{
+			cmoon::test::test_suite suite{"test library tests"};
+			suite.add_test_case<cmoon::tests::test::parse_test_run_options_test>();
+			suite.add_test_case<cmoon::tests::test::parse_test_run_options_error_test>();
+			suite.add_test_case<cmoon::tests::test::test_shard_test>();
+			suite.add_test_case<cmoon::tests::test::test_output_capture_test>();
+			suite.add_test_case<cmoon::tests::test::test_runner_output_test>();
+
+			return std::move(suite);
+		}
+	};
+}
\ No newline at end of file
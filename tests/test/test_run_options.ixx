@@ -0,0 +1,79 @@
+export module cmoon.tests.test.test_run_options;
+
+import <vector>;
+import <initializer_list>;
+import <stdexcept>;
+
+import cmoon.test;
+
+namespace cmoon::tests::test
+{
+	[[nodiscard]] cmoon::test::test_run_options parse(std::initializer_list<const char*> args)
+	{
+		const std::vector<const char*> argv {args};
+		return cmoon::test::parse_test_run_options(static_cast<int>(argv.size()), argv.data());
+	}
+
+	[[nodiscard]] bool rejects(std::initializer_list<const char*> args)
+	{
+		try
+		{
+			(void) parse(args);
+		}
+		catch (const std::invalid_argument&)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	export
+	class parse_test_run_options_test : public cmoon::test::test_case
+	{
+		public:
+			parse_test_run_options_test()
+				: cmoon::test::test_case{"parse_test_run_options_test"} {}
+
+			void operator()() override
+			{
+				const auto defaults {parse({"tests"})};
+				cmoon::test::assert_equal(defaults.threads, 0);
+				cmoon::test::assert_equal(defaults.shard_index, 0);
+				cmoon::test::assert_equal(defaults.shard_count, 1);
+				cmoon::test::assert_equal(defaults.slowest, 10);
+
+				const auto options {parse({"tests", "--verbose", "--jobs", "4", "--shard", "1/3", "input.json", "--slowest", "0"})};
+				cmoon::test::assert_equal(options.threads, 4);
+				cmoon::test::assert_equal(options.shard_index, 1);
+				cmoon::test::assert_equal(options.shard_count, 3);
+				cmoon::test::assert_equal(options.slowest, 0);
+
+				cmoon::test::assert_equal(parse({"tests", "-j", "2"}).threads, 2);
+				cmoon::test::assert_equal(parse({"tests", "-j", "2", "--jobs", "6"}).threads, 6);
+			}
+	};
+
+	export
+	class parse_test_run_options_error_test : public cmoon::test::test_case
+	{
+		public:
+			parse_test_run_options_error_test()
+				: cmoon::test::test_case{"parse_test_run_options_error_test"} {}
+
+			void operator()() override
+			{
+				cmoon::test::assert_true(rejects({"tests", "--jobs"}), "missing value");
+				cmoon::test::assert_true(rejects({"tests", "--shard"}), "missing value");
+				cmoon::test::assert_true(rejects({"tests", "--jobs", "many"}), "not a number");
+				cmoon::test::assert_true(rejects({"tests", "-j", "4x"}), "trailing characters");
+				cmoon::test::assert_true(rejects({"tests", "--slowest", "-1"}), "negative");
+				cmoon::test::assert_true(rejects({"tests", "--shard", "2"}), "no slash");
+				cmoon::test::assert_true(rejects({"tests", "--shard", "a/2"}), "bad index");
+				cmoon::test::assert_true(rejects({"tests", "--shard", "1/"}), "no count");
+				cmoon::test::assert_true(rejects({"tests", "--shard", "0/0"}), "zero shards");
+				cmoon::test::assert_true(rejects({"tests", "--shard", "3/3"}), "index past count");
+				cmoon::test::assert_false(rejects({"tests", "--shard", "2/3"}));
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+export module cmoon.tests.test.text_test_runner;
+
+import <iostream>;
+import <sstream>;
+import <string>;
+import <vector>;
+import <format>;
+import <cstddef>;
+
+import cmoon.test;
+import cmoon.scope;
+
+namespace cmoon::tests::test
+{
+	class counting_test_case : public cmoon::test::test_case
+	{
+		public:
+			counting_test_case(std::vector<int>& runs, std::size_t index)
+				: cmoon::test::test_case{std::format("counting_test_case {}", index)}, runs{runs}, index{index} {}
+
+			void operator()() override
+			{
+				++runs[index];
+			}
+		private:
+			std::vector<int>& runs;
+			std::size_t index;
+	};
+
+	// Odd ones fail.
+	class writing_test_case : public cmoon::test::test_case
+	{
+		public:
+			writing_test_case(std::size_t index)
+				: cmoon::test::test_case{std::format("writing_test_case {}", index)}, index{index} {}
+
+			void operator()() override
+			{
+				std::cout << "out " << index << '\n';
+				std::cerr << "err " << index << '\n';
+				cmoon::test::assert_true(index % 2 == 0);
+			}
+		private:
+			std::size_t index;
+	};
+
+	export
+	class test_shard_test : public cmoon::test::test_case
+	{
+		public:
+			test_shard_test()
+				: cmoon::test::test_case{"test_shard_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t count {11};
+
+				// More shards than test cases leaves some of them empty.
+				for (const std::size_t shards : {1, 2, 3, 4, 13})
+				{
+					std::vector<int> runs(count);
+					cmoon::test::test_suite suite;
+					for (std::size_t i {0}; i < count; ++i)
+					{
+						suite.add_test_case<counting_test_case>(runs, i);
+					}
+
+					std::size_t results {0};
+					for (std::size_t shard {0}; shard < shards; ++shard)
+					{
+						std::ostringstream report;
+						cmoon::test::text_test_runner runner {report};
+						results += runner.run(suite, {.threads = 3, .shard_index = shard, .shard_count = shards}).size();
+					}
+
+					// Each test case ran in exactly one shard.
+					cmoon::test::assert_equal(results, count, std::format("{} shards", shards));
+					for (std::size_t i {0}; i < count; ++i)
+					{
+						cmoon::test::assert_equal(runs[i], 1, std::format("test case {} of {} shards", i, shards));
+					}
+				}
+			}
+	};
+
+	export
+	class test_output_capture_test : public cmoon::test::test_case
+	{
+		public:
+			test_output_capture_test()
+				: cmoon::test::test_case{"test_output_capture_test"} {}
+
+			void operator()() override
+			{
+				std::ostringstream through;
+				const auto original {std::cout.rdbuf(through.rdbuf())};
+				cmoon::scope_exit restore {[original] {
+					std::cout.rdbuf(original);
+				}};
+
+				std::string captured;
+				{
+					cmoon::test::output_capture capture;
+					capture.redirect(captured, [] {
+						std::cout << "captured" << std::flush;
+					});
+					std::cout << "through";
+				}
+
+				cmoon::test::assert_equal(captured, "captured");
+				cmoon::test::assert_equal(through.str(), "through");
+			}
+	};
+
+	export
+	class test_runner_output_test : public cmoon::test::test_case
+	{
+		public:
+			test_runner_output_test()
+				: cmoon::test::test_case{"test_runner_output_test"} {}
+
+			void operator()() override
+			{
+				constexpr std::size_t count {8};
+				cmoon::test::test_suite suite;
+				for (std::size_t i {0}; i < count; ++i)
+				{
+					suite.add_test_case<writing_test_case>(i);
+				}
+
+				std::ostringstream report;
+				cmoon::test::text_test_runner runner {report};
+				const auto results {runner.run(suite, {.threads = 4})};
+
+				cmoon::test::assert_equal(results.size(), count);
+				for (std::size_t i {0}; i < count; ++i)
+				{
+					cmoon::test::assert_equal(results[i].output(), std::format("out {}\nerr {}\n", i, i));
+					cmoon::test::assert_equal(results[i].passed(), i % 2 == 0);
+				}
+
+				// Only failed test cases have their output reported.
+				const auto text {report.str()};
+				cmoon::test::assert_not_equal(text.find("writing_test_case 1\n"), std::string::npos);
+				cmoon::test::assert_not_equal(text.find("Output:\nout 1\nerr 1\n"), std::string::npos);
+				cmoon::test::assert_equal(text.find("out 2\n"), std::string::npos);
+			}
+	};
+}
\ No newline at end of file
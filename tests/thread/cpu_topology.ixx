@@ -0,0 +1,50 @@
+export module cmoon.tests.thread.cpu_topology;
+
+import <cstddef>;
+import <vector>;
+import <stdexcept>;
+
+import cmoon.test;
+import cmoon.thread;
+
+namespace cmoon::tests::thread
+{
+	export
+	class parse_cpu_list_test : public cmoon::test::test_case
+	{
+		public:
+			parse_cpu_list_test()
+				: cmoon::test::test_case{"parse_cpu_list_test"} {}
+
+			void operator()() override
+			{
+				cmoon::test::assert_sequence_equal(cmoon::parse_cpu_list("0-3,8,10-11\n"), std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11});
+				cmoon::test::assert_sequence_equal(cmoon::parse_cpu_list("4,2-3,2"), std::vector<unsigned>{2, 3, 4});
+				cmoon::test::assert_true(cmoon::parse_cpu_list("").empty());
+				cmoon::test::assert_throws<std::invalid_argument>([] { (void) cmoon::parse_cpu_list("3-1"); });
+				cmoon::test::assert_throws<std::invalid_argument>([] { (void) cmoon::parse_cpu_list("0,a"); });
+			}
+	};
+
+	export
+	class cpu_topology_test : public cmoon::test::test_case
+	{
+		public:
+			cpu_topology_test()
+				: cmoon::test::test_case{"cpu_topology_test"} {}
+
+			void operator()() override
+			{
+				const cmoon::cpu_topology t {{{0, 1}, {}, {2, 3}}};
+				cmoon::test::assert_equal(t.node_count(), std::size_t{2});
+				cmoon::test::assert_equal(t.cpu_count(), std::size_t{4});
+				cmoon::test::assert_equal(*t.node_of(1), std::size_t{0});
+				cmoon::test::assert_equal(*t.node_of(3), std::size_t{1});
+				cmoon::test::assert_false(t.node_of(4).has_value());
+
+				const auto detected {cmoon::cpu_topology::detect()};
+				cmoon::test::assert_greater_equal(detected.node_count(), std::size_t{1});
+				cmoon::test::assert_greater_equal(detected.cpu_count(), std::size_t{1});
+			}
+	};
+}
\ No newline at end of file
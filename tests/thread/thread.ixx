@@ -1,4 +1,5 @@
 export module cmoon.tests.thread;
+export import cmoon.tests.thread.cpu_topology;
 
 import <utility>;
 
@@ -14,6 +15,8 @@ namespace cmoon
 		static cmoon::test::test_suite tests()
 		{
 			cmoon::test::test_suite suite{"thread library tests"};
+			suite.add_test_case<tests::thread::parse_cpu_list_test>();
+			suite.add_test_case<tests::thread::cpu_topology_test>();
 
 			return std::move(suite);
 		}